@@ -755,11 +755,11 @@ void CFileItem::Serialize(CVariant& value) const
   if (m_gameInfoTag)
     (*m_gameInfoTag).Serialize(value["gameInfoTag"]);
 
-  if (!m_mapProperties.empty())
+  if (!m_properties.empty())
   {
     auto& customProperties = value["customproperties"];
-    for (const auto& prop : m_mapProperties)
-      customProperties[prop.first] = prop.second;
+    for (const auto& prop : m_properties)
+      customProperties[prop.first.Get()] = prop.second;
   }
 }
 
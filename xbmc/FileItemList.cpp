@@ -249,7 +249,7 @@ void CFileItemList::Assign(const CFileItemList& itemlist, bool append)
   m_sortDescription = itemlist.m_sortDescription;
   m_replaceListing = itemlist.m_replaceListing;
   m_content = itemlist.m_content;
-  m_mapProperties = itemlist.m_mapProperties;
+  m_properties = itemlist.m_properties;
   m_cacheToDisc = itemlist.m_cacheToDisc;
 }
 
@@ -261,7 +261,7 @@ bool CFileItemList::Copy(const CFileItemList& items, bool copyItems /* = true */
   // assign the rest of the CFileItemList properties
   m_replaceListing = items.m_replaceListing;
   m_content = items.m_content;
-  m_mapProperties = items.m_mapProperties;
+  m_properties = items.m_properties;
   m_cacheToDisc = items.m_cacheToDisc;
   m_sortDetails = items.m_sortDetails;
   m_sortDescription = items.m_sortDescription;
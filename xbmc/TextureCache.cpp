@@ -11,8 +11,10 @@
 #include "ServiceBroker.h"
 #include "TextureCacheJob.h"
 #include "URL.h"
+#include "XBDateTime.h"
 #include "commons/ilog.h"
 #include "dialogs/GUIDialogProgress.h"
+#include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "filesystem/IFileTypes.h"
 #include "guilib/GUIComponent.h"
@@ -20,7 +22,9 @@
 #include "guilib/Texture.h"
 #include "imagefiles/ImageCacheCleaner.h"
 #include "imagefiles/ImageFileURL.h"
+#include "filesystem/SpecialProtocol.h"
 #include "profiles/ProfileManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/Crc32.h"
 #include "utils/Job.h"
@@ -29,6 +33,7 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <mutex>
@@ -38,6 +43,14 @@
 using namespace XFILE;
 using namespace std::chrono_literals;
 
+namespace
+{
+constexpr const char* IMAGE_PACK_FILE = "Textures.pack";
+//! packed images handed to code reading outside of the VFS, removed on exit
+constexpr const char* EXPORTED_IMAGES_FOLDER = "special://temp/packedimages/";
+constexpr size_t MAX_EXPORTED_IMAGES = 8;
+} // unnamed namespace
+
 CTextureCache::CTextureCache()
   : CJobQueue(false, 1, CJob::PRIORITY_LOW_PAUSABLE), m_cleanTimer{[this]() { CleanTimer(); }}
 {
@@ -48,17 +61,127 @@ CTextureCache::~CTextureCache() = default;
 void CTextureCache::Initialize()
 {
   m_cleanTimer.Start(60s);
-  std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  if (!m_database.IsOpen())
-    m_database.Open();
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    if (!m_database.IsOpen())
+      m_database.Open();
+    // the database may belong to a different profile now
+    m_index.Clear();
+  }
+  RemoveExportedImages();
+
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCachePacked)
+  {
+    // the pack object is kept for the lifetime of the cache, only its file changes on profile switch
+    if (!m_imagePack)
+      m_imagePack = std::make_unique<IMAGE_FILES::CImageCachePack>();
+    if (!m_imagePack->Open(CSpecialProtocol::TranslatePath(GetCachedPath(IMAGE_PACK_FILE))))
+      CLog::LogF(LOGERROR, "unable to open the image cache pack, storing images as files");
+  }
 }
 
 void CTextureCache::Deinitialize()
 {
   CancelJobs();
 
+  if (m_imagePack)
+    m_imagePack->Close();
+  RemoveExportedImages();
+
+  LogIndexStats();
+
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
   m_database.Close();
+  m_index.Clear();
+}
+
+bool CTextureCache::IsImagePackEnabled() const
+{
+  return m_imagePack && m_imagePack->IsOpen();
+}
+
+bool CTextureCache::AddPackedImage(const std::string& file, const std::vector<uint8_t>& data)
+{
+  return m_imagePack && m_imagePack->Add(file, data.data(), data.size());
+}
+
+std::optional<IMAGE_FILES::CImageCachePack::Blob> CTextureCache::GetPackedImage(
+    const std::string& cachedPath)
+{
+  if (!m_imagePack)
+    return {};
+
+  const std::string folder = URIUtils::AddFileToFolder(
+      CServiceBroker::GetSettingsComponent()->GetProfileManager()->GetThumbnailsFolder(), "");
+  if (!StringUtils::StartsWith(cachedPath, folder))
+    return {};
+
+  return m_imagePack->Get(cachedPath.substr(folder.size()));
+}
+
+std::string CTextureCache::GetCachedImageFile(const std::string& cachedPath)
+{
+  if (!GetPackedImage(cachedPath))
+    return cachedPath;
+
+  // cached file names are unique, an image exported before is reused as is
+  const std::string dest = EXPORTED_IMAGES_FOLDER + URIUtils::GetFileName(cachedPath);
+
+  std::unique_lock<CCriticalSection> lock(m_exportSection);
+  auto it = std::find(m_exportedImages.begin(), m_exportedImages.end(), dest);
+  if (it != m_exportedImages.end())
+  {
+    m_exportedImages.erase(it);
+    m_exportedImages.push_back(dest);
+    return dest;
+  }
+
+  if (m_exportedImages.empty())
+    CDirectory::Create(EXPORTED_IMAGES_FOLDER);
+  if (!ExportCachedFile(cachedPath, dest))
+  {
+    CLog::Log(LOGERROR, "{} failed exporting '{}' to '{}'", __FUNCTION__, cachedPath, dest);
+    return "";
+  }
+
+  m_exportedImages.push_back(dest);
+  if (m_exportedImages.size() > MAX_EXPORTED_IMAGES)
+  {
+    CFile::Delete(m_exportedImages.front());
+    m_exportedImages.pop_front();
+  }
+  return dest;
+}
+
+void CTextureCache::RemoveExportedImages()
+{
+  std::unique_lock<CCriticalSection> lock(m_exportSection);
+  m_exportedImages.clear();
+  // also removes what was left behind by a crash
+  if (CDirectory::Exists(EXPORTED_IMAGES_FOLDER))
+    CDirectory::RemoveRecursive(EXPORTED_IMAGES_FOLDER);
+}
+
+void CTextureCache::CompactImagePack()
+{
+  if (m_imagePack && m_imagePack->NeedsCompaction())
+    m_imagePack->Compact();
+}
+
+void CTextureCache::LogIndexStats() const
+{
+  const auto stats = m_index.GetStats();
+  const uint64_t lookups = stats.hits + stats.misses;
+  if (lookups == 0)
+    return;
+
+  using us = std::chrono::duration<double, std::micro>;
+  CLog::LogF(LOGDEBUG,
+             "{} indexed images, {} lookups, {:.1f}% hit rate, average lookup {:.1f}us (hit), "
+             "{:.1f}us (miss)",
+             stats.entries, lookups, 100.0 * stats.hits / lookups,
+             stats.hits ? us(stats.hitTime).count() / stats.hits : 0.0,
+             stats.misses ? us(stats.missTime).count() / stats.misses : 0.0);
 }
 
 bool CTextureCache::IsCachedImage(const std::string &url) const
@@ -218,7 +341,11 @@ void CTextureCache::ClearCachedImage(const std::string& image, bool deleteSource
   std::string path = deleteSource ? url : "";
   std::string cachedFile;
   if (ClearCachedTexture(url, cachedFile))
+  {
+    if (m_imagePack)
+      m_imagePack->Remove(cachedFile);
     path = GetCachedPath(cachedFile);
+  }
   if (CFile::Exists(path))
     CFile::Delete(path);
   path = URIUtils::ReplaceExtension(path, ".dds");
@@ -231,6 +358,8 @@ bool CTextureCache::ClearCachedImage(int id)
   std::string cachedFile;
   if (ClearCachedTexture(id, cachedFile))
   {
+    if (m_imagePack)
+      m_imagePack->Remove(cachedFile);
     cachedFile = GetCachedPath(cachedFile);
     if (CFile::Exists(cachedFile))
       CFile::Delete(cachedFile);
@@ -244,14 +373,55 @@ bool CTextureCache::ClearCachedImage(int id)
 
 bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
-  std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.GetCachedTexture(url, details);
+  const auto start = std::chrono::steady_clock::now();
+
+  auto entry = m_index.Lookup(url);
+  const bool hit = entry.has_value();
+  if (!hit)
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    entry.emplace();
+    entry->cached = m_database.GetCachedTexture(url, entry->details, entry->lastHashCheck);
+    // don't remember misses caused by the database being unavailable
+    if (entry->cached || m_database.IsOpen())
+      m_index.Insert(url, *entry);
+  }
+
+  if (entry->cached)
+  {
+    details = entry->details;
+    if (!CTextureDatabase::IsHashCheckDue(entry->lastHashCheck))
+      details.hash.clear();
+  }
+
+  m_index.RecordLookup(hit, std::chrono::steady_clock::now() - start);
+  return entry->cached;
 }
 
 bool CTextureCache::AddCachedTexture(const std::string &url, const CTextureDetails &details)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.AddCachedTexture(url, details);
+  const bool added = m_database.AddCachedTexture(url, details);
+  // the database assigns a new id, read the entry back on the next lookup
+  m_index.Erase(url);
+  return added;
+}
+
+void CTextureCache::InvalidateCachedImages(const std::vector<std::string>& images)
+{
+  const CDateTime lastHashCheck = CTextureDatabase::GetInvalidatedHashCheck();
+
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  m_database.BeginMultipleExecute();
+  for (const auto& image : images)
+  {
+    m_database.InvalidateCachedTexture(image);
+    m_index.Update(image, [&lastHashCheck](CTextureCacheIndex::Entry& entry) {
+      if (entry.cached)
+        entry.lastHashCheck = lastHashCheck;
+    });
+  }
+  m_database.CommitMultipleExecute();
 }
 
 void CTextureCache::IncrementUseCount(const CTextureDetails &details)
@@ -270,19 +440,33 @@ void CTextureCache::IncrementUseCount(const CTextureDetails &details)
 bool CTextureCache::SetCachedTextureValid(const std::string &url, bool updateable)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.SetCachedTextureValid(url, updateable);
+  if (!m_database.SetCachedTextureValid(url, updateable))
+  {
+    m_index.Erase(url);
+    return false;
+  }
+
+  const CDateTime lastHashCheck = updateable ? CDateTime::GetCurrentDateTime() : CDateTime();
+  m_index.Update(url, [&lastHashCheck](CTextureCacheIndex::Entry& entry) {
+    entry.lastHashCheck = lastHashCheck;
+  });
+  return true;
 }
 
 bool CTextureCache::ClearCachedTexture(const std::string &url, std::string &cachedURL)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.ClearCachedTexture(url, cachedURL);
+  const bool cleared = m_database.ClearCachedTexture(url, cachedURL);
+  m_index.Insert(url, {});
+  return cleared;
 }
 
 bool CTextureCache::ClearCachedTexture(int id, std::string &cachedURL)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.ClearCachedTexture(id, cachedURL);
+  const bool cleared = m_database.ClearCachedTexture(id, cachedURL);
+  m_index.EraseById(id);
+  return cleared;
 }
 
 std::string CTextureCache::GetCacheFile(const std::string &url)
@@ -336,7 +520,7 @@ bool CTextureCache::Export(const std::string &image, const std::string &destinat
     std::string dest = destination + URIUtils::GetExtension(cachedImage);
     if (overwrite || !CFile::Exists(dest))
     {
-      if (CFile::Copy(cachedImage, dest))
+      if (ExportCachedFile(cachedImage, dest))
         return true;
       CLog::Log(LOGERROR, "{} failed exporting '{}' to '{}'", __FUNCTION__, cachedImage, dest);
     }
@@ -350,13 +534,24 @@ bool CTextureCache::Export(const std::string &image, const std::string &destinat
   std::string cachedImage(GetCachedImage(image, details));
   if (!cachedImage.empty())
   {
-    if (CFile::Copy(cachedImage, destination))
+    if (ExportCachedFile(cachedImage, destination))
       return true;
     CLog::Log(LOGERROR, "{} failed exporting '{}' to '{}'", __FUNCTION__, cachedImage, destination);
   }
   return false;
 }
 
+bool CTextureCache::ExportCachedFile(const std::string& cachedImage, const std::string& destination)
+{
+  const auto packed = GetPackedImage(cachedImage);
+  if (!packed)
+    return CFile::Copy(cachedImage, destination);
+
+  CFile file;
+  return file.OpenForWrite(destination, true) &&
+         file.Write(packed->data, packed->size) == static_cast<ssize_t>(packed->size);
+}
+
 bool CTextureCache::CleanAllUnusedImages()
 {
   if (m_cleaningInProgress.test_and_set())
@@ -426,6 +621,8 @@ bool CTextureCache::CleanAllUnusedImagesJob(CGUIDialogProgress* progress)
     }
   }
 
+  CompactImagePack();
+
   if (progress)
     progress->Close();
   return true;
@@ -455,6 +652,8 @@ std::chrono::milliseconds CTextureCache::ScanOldestCache()
   {
     ClearCachedImage(image);
   }
+  CompactImagePack();
+  LogIndexStats();
 
   // update in the next 6 - 48 hours depending on number of items processed
   const auto minTime = 6;
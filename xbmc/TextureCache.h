@@ -8,9 +8,11 @@
 
 #pragma once
 
+#include "TextureCacheIndex.h"
 #include "TextureCacheJob.h"
 #include "TextureDatabase.h"
 #include "guilib/AspectRatio.h"
+#include "imagefiles/ImageCachePack.h"
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
 #include "threads/Timer.h"
@@ -18,7 +20,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -155,6 +159,12 @@ public:
    */
   bool AddCachedTexture(const std::string &image, const CTextureDetails &details);
 
+  /*! \brief Force the given images to be checked for updates the next time they are loaded
+   Thread-safe wrapper of CTextureDatabase::InvalidateCachedTexture
+   \param images urls of the original images
+   */
+  void InvalidateCachedImages(const std::vector<std::string>& images);
+
   /*! \brief Export a (possibly) cached image to a file
    \param image url of the original image
    \param destination url of the destination image, excluding extension.
@@ -166,6 +176,32 @@ public:
 
   bool CleanAllUnusedImages();
 
+  /*! \brief Whether cached images are stored in the image pack rather than as separate files
+   \sa IMAGE_FILES::CImageCachePack
+   */
+  bool IsImagePackEnabled() const;
+
+  /*! \brief Store an encoded cached image in the image pack
+   \param file name of the cache file, relative to the cache path
+   \param data the encoded image
+   \return true if the image was stored, false otherwise.
+   */
+  bool AddPackedImage(const std::string& file, const std::vector<uint8_t>& data);
+
+  /*! \brief Get a cached image from the image pack, without copying
+   \param cachedPath full path of the cached image, as returned by GetCachedPath
+   \return the image bytes if the image is in the pack, empty otherwise
+   */
+  std::optional<IMAGE_FILES::CImageCachePack::Blob> GetPackedImage(const std::string& cachedPath);
+
+  /*! \brief Get a file with the cached image, for code reading it outside of the VFS.
+   Packed images are exported to the temp folder, only the most recently requested ones are kept
+   and they are removed on exit.
+   \param cachedPath full path of the cached image, as returned by GetCachedPath
+   \return the path of the file, empty on failure
+   */
+  std::string GetCachedImageFile(const std::string& cachedPath);
+
 private:
   // private construction, and no assignments; use the provided singleton methods
   CTextureCache(const CTextureCache&) = delete;
@@ -186,7 +222,7 @@ private:
    */
   std::string GetCachedImage(const std::string &image, CTextureDetails &details, bool trackUsage = false);
 
-  /*! \brief Get an image from the database
+  /*! \brief Get an image from the index, or the database if not indexed yet
    Thread-safe wrapper of CTextureDatabase::GetCachedTexture
    \param image url of the original image
    \param details [out] texture details from the database (if available)
@@ -231,14 +267,31 @@ private:
   std::chrono::milliseconds ScanOldestCache();
   bool CleanAllUnusedImagesJob(CGUIDialogProgress* progress);
 
+  /*! \brief Reclaim the space of cleaned images in the image pack, if worthwhile
+   */
+  void CompactImagePack();
+
+  void LogIndexStats() const;
+
+  /*! \brief Copy a cached image, packed or not, to the given destination
+   */
+  bool ExportCachedFile(const std::string& cachedImage, const std::string& destination);
+
+  void RemoveExportedImages();
+
   std::atomic_flag m_cleaningInProgress;
   CTimer m_cleanTimer;
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
+  CTextureCacheIndex m_index; ///< In-memory copy of looked up database entries, written under m_databaseSection
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
   CCriticalSection     m_processingSection;
   CEvent               m_completeEvent; ///< Set whenever a job has finished
   std::vector<CTextureDetails> m_useCounts; ///< Use count tracking
   CCriticalSection             m_useCountSection;
+
+  std::unique_ptr<IMAGE_FILES::CImageCachePack> m_imagePack; ///< Pack of cached images, if enabled
+  std::deque<std::string> m_exportedImages; ///< Exported packed images, least recently used first
+  CCriticalSection m_exportSection;
 };
 
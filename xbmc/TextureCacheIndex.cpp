@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureCacheIndex.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+CTextureCacheIndex::CTextureCacheIndex(size_t maxEntries /* = 65536 */)
+  : m_maxStripeEntries(std::max<size_t>(maxEntries / STRIPES, 1))
+{
+}
+
+CTextureCacheIndex::Stripe& CTextureCacheIndex::GetStripe(const std::string& url)
+{
+  return m_stripes[std::hash<std::string>{}(url) % STRIPES];
+}
+
+std::optional<CTextureCacheIndex::Entry> CTextureCacheIndex::Lookup(const std::string& url)
+{
+  Stripe& stripe = GetStripe(url);
+  std::unique_lock<CCriticalSection> lock(stripe.section);
+  const auto it = stripe.entries.find(url);
+  if (it == stripe.entries.end())
+    return {};
+
+  it->second.lastUse = std::chrono::steady_clock::now();
+  return it->second.entry;
+}
+
+void CTextureCacheIndex::Insert(const std::string& url, const Entry& entry)
+{
+  Stripe& stripe = GetStripe(url);
+  std::unique_lock<CCriticalSection> lock(stripe.section);
+  if (stripe.entries.size() >= m_maxStripeEntries && stripe.entries.find(url) == stripe.entries.end())
+    EvictLeastRecentlyUsed(stripe);
+
+  stripe.entries[url] = {entry, std::chrono::steady_clock::now()};
+}
+
+bool CTextureCacheIndex::Update(const std::string& url, const std::function<void(Entry&)>& update)
+{
+  Stripe& stripe = GetStripe(url);
+  std::unique_lock<CCriticalSection> lock(stripe.section);
+  const auto it = stripe.entries.find(url);
+  if (it == stripe.entries.end())
+    return false;
+
+  update(it->second.entry);
+  return true;
+}
+
+void CTextureCacheIndex::Erase(const std::string& url)
+{
+  Stripe& stripe = GetStripe(url);
+  std::unique_lock<CCriticalSection> lock(stripe.section);
+  stripe.entries.erase(url);
+}
+
+void CTextureCacheIndex::EraseById(int textureID)
+{
+  // only used when cleaning the cache, not worth a second map
+  for (Stripe& stripe : m_stripes)
+  {
+    std::unique_lock<CCriticalSection> lock(stripe.section);
+    const auto it = std::find_if(stripe.entries.begin(), stripe.entries.end(),
+                                 [textureID](const auto& indexed) {
+                                   return indexed.second.entry.cached &&
+                                          indexed.second.entry.details.id == textureID;
+                                 });
+    if (it != stripe.entries.end())
+    {
+      stripe.entries.erase(it);
+      return;
+    }
+  }
+}
+
+void CTextureCacheIndex::Clear()
+{
+  for (Stripe& stripe : m_stripes)
+  {
+    std::unique_lock<CCriticalSection> lock(stripe.section);
+    stripe.entries.clear();
+  }
+}
+
+void CTextureCacheIndex::EvictLeastRecentlyUsed(Stripe& stripe) const
+{
+  // drop the oldest quarter at once so eviction cost is amortized over many inserts
+  std::vector<std::chrono::steady_clock::time_point> lastUse;
+  lastUse.reserve(stripe.entries.size());
+  for (const auto& indexed : stripe.entries)
+    lastUse.emplace_back(indexed.second.lastUse);
+
+  const size_t evict = std::max<size_t>(lastUse.size() / 4, 1);
+  std::nth_element(lastUse.begin(), lastUse.begin() + (evict - 1), lastUse.end());
+  const auto threshold = lastUse[evict - 1];
+
+  size_t evicted = 0;
+  for (auto it = stripe.entries.begin(); it != stripe.entries.end() && evicted < evict;)
+  {
+    if (it->second.lastUse <= threshold)
+    {
+      it = stripe.entries.erase(it);
+      ++evicted;
+    }
+    else
+      ++it;
+  }
+}
+
+void CTextureCacheIndex::RecordLookup(bool hit, std::chrono::nanoseconds duration)
+{
+  if (hit)
+  {
+    m_hits++;
+    m_hitTime += duration.count();
+  }
+  else
+  {
+    m_misses++;
+    m_missTime += duration.count();
+  }
+}
+
+CTextureCacheIndex::Stats CTextureCacheIndex::GetStats() const
+{
+  Stats stats;
+  for (const Stripe& stripe : m_stripes)
+  {
+    std::unique_lock<CCriticalSection> lock(stripe.section);
+    stats.entries += stripe.entries.size();
+  }
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.hitTime = std::chrono::nanoseconds(m_hitTime);
+  stats.missTime = std::chrono::nanoseconds(m_missTime);
+  return stats;
+}
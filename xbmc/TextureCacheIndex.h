@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "TextureCacheJob.h"
+#include "XBDateTime.h"
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+/*!
+ \ingroup textures
+ \brief In-memory index of the texture database, keyed by original image url.
+
+ Sits in front of CTextureDatabase so that looking up the cached version of an
+ image doesn't need a database query once the url has been seen. Entries are
+ filled lazily on lookup and must be kept up to date by the owner whenever it
+ writes to the database. Urls known not to be cached are indexed as well.
+
+ The index is split into independently locked stripes so that concurrent
+ lookups (e.g. from the GUI and texture loader threads) rarely contend. When a
+ stripe is full its least recently used entries are dropped.
+
+ \sa CTextureCache
+ */
+class CTextureCacheIndex
+{
+public:
+  struct Entry
+  {
+    bool cached{false}; ///< false if the image is known not to be in the database
+    CTextureDetails details; ///< includes the stored image hash
+    CDateTime lastHashCheck;
+  };
+
+  struct Stats
+  {
+    size_t entries{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+    std::chrono::nanoseconds hitTime{0}; ///< total time spent in lookups served by the index
+    std::chrono::nanoseconds missTime{0}; ///< total time spent in lookups that went to the database
+  };
+
+  explicit CTextureCacheIndex(size_t maxEntries = 65536);
+
+  /*! \brief Find an image in the index, marking it as recently used
+   \param url original url of the image
+   \return the indexed entry, empty if the url isn't indexed
+   */
+  std::optional<Entry> Lookup(const std::string& url);
+
+  /*! \brief Add or replace the entry of an image */
+  void Insert(const std::string& url, const Entry& entry);
+
+  /*! \brief Modify the entry of an image, if it is indexed
+   \return true if the url was indexed, false otherwise.
+   */
+  bool Update(const std::string& url, const std::function<void(Entry&)>& update);
+
+  void Erase(const std::string& url);
+
+  /*! \brief Erase the entry with the given texture database id */
+  void EraseById(int textureID);
+
+  void Clear();
+
+  /*! \brief Account a lookup in the statistics
+   \param hit whether the lookup was served by the index
+   \param duration time taken by the lookup, including any database query
+   */
+  void RecordLookup(bool hit, std::chrono::nanoseconds duration);
+
+  Stats GetStats() const;
+
+private:
+  static constexpr size_t STRIPES = 16;
+
+  struct IndexedEntry
+  {
+    Entry entry;
+    std::chrono::steady_clock::time_point lastUse;
+  };
+
+  struct Stripe
+  {
+    mutable CCriticalSection section;
+    std::unordered_map<std::string, IndexedEntry> entries;
+  };
+
+  Stripe& GetStripe(const std::string& url);
+  void EvictLeastRecentlyUsed(Stripe& stripe) const;
+
+  const size_t m_maxStripeEntries;
+  std::array<Stripe, STRIPES> m_stripes;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<int64_t> m_hitTime{0};
+  std::atomic<int64_t> m_missTime{0};
+};
@@ -26,10 +26,12 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <exception>
 #include <utility>
+#include <vector>
 
 #include "PlatformDefs.h"
 
@@ -114,7 +116,11 @@ bool CTextureCacheJob::CacheTexture(std::unique_ptr<CTexture>* out_texture)
     }
   }
 
-  std::unique_ptr<CTexture> texture = LoadImage(imageURL);
+  // cached images are at most the image or fanart resolution, see CPicture::CacheTexture
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const unsigned int maxHeight = std::max(advancedSettings->m_imageRes, advancedSettings->m_fanartRes);
+  std::unique_ptr<CTexture> texture = LoadImage(imageURL, maxHeight * 16 / 9, maxHeight);
   if (texture)
   {
     if (texture->HasAlpha())
@@ -127,8 +133,20 @@ bool CTextureCacheJob::CacheTexture(std::unique_ptr<CTexture>* out_texture)
 
     unsigned int cached_width = 0;
     unsigned int cached_height = 0;
-    if (CPicture::CacheTexture(texture.get(), cached_width, cached_height,
-                               CTextureCache::GetCachedPath(m_details.file)))
+    bool cached = false;
+    const std::shared_ptr<CTextureCache> textureCache = CServiceBroker::GetTextureCache();
+    if (textureCache->IsImagePackEnabled())
+    {
+      std::vector<uint8_t> encoded;
+      cached = CPicture::CacheTextureToMemory(texture.get(), cached_width, cached_height,
+                                              m_details.file, encoded) &&
+               textureCache->AddPackedImage(m_details.file, encoded);
+    }
+    else
+      cached = CPicture::CacheTexture(texture.get(), cached_width, cached_height,
+                                      CTextureCache::GetCachedPath(m_details.file));
+
+    if (cached)
     {
       m_details.width = cached_width;
       m_details.height = cached_height;
@@ -155,7 +173,7 @@ bool CTextureCacheJob::ResizeTexture(const std::string& url,
   if (image.empty())
     return false;
 
-  std::unique_ptr<CTexture> texture = LoadImage(imageURL);
+  std::unique_ptr<CTexture> texture = LoadImage(imageURL, width, height);
   if (texture == NULL)
     return false;
 
@@ -165,7 +183,9 @@ bool CTextureCacheJob::ResizeTexture(const std::string& url,
   return success;
 }
 
-std::unique_ptr<CTexture> CTextureCacheJob::LoadImage(const IMAGE_FILES::CImageFileURL& imageURL)
+std::unique_ptr<CTexture> CTextureCacheJob::LoadImage(const IMAGE_FILES::CImageFileURL& imageURL,
+                                                      unsigned int fitWidth /* = 0 */,
+                                                      unsigned int fitHeight /* = 0 */)
 {
   if (imageURL.IsSpecialImage())
   {
@@ -186,8 +206,8 @@ std::unique_ptr<CTexture> CTextureCacheJob::LoadImage(const IMAGE_FILES::CImageF
     return {};
   }
 
-  auto texture = CTexture::LoadFromFile(imageURL.GetTargetFile(), 0, 0, CAspectRatio::CENTER,
-                                        file.GetMimeType());
+  auto texture = CTexture::LoadFromFileForDownscale(imageURL.GetTargetFile(), fitWidth, fitHeight,
+                                                    file.GetMimeType());
   if (!texture)
     return {};
 
@@ -91,9 +91,13 @@ private:
    or smaller than the desired size for speed reasons.
 
    \param image the URL of the image file.
+   \param fitWidth,fitHeight size the image will be scaled down to fit in, allows decoding at a
+   reduced resolution (defaults to 0, full resolution).
    \return a pointer to a CTexture object, NULL if failed.
    */
-  static std::unique_ptr<CTexture> LoadImage(const IMAGE_FILES::CImageFileURL& imageURL);
+  static std::unique_ptr<CTexture> LoadImage(const IMAGE_FILES::CImageFileURL& imageURL,
+                                             unsigned int fitWidth = 0,
+                                             unsigned int fitHeight = 0);
 
   std::string    m_cachePath;
 };
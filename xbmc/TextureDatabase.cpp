@@ -211,6 +211,19 @@ bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
 }
 
 bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails &details)
+{
+  CDateTime lastHashCheck;
+  if (!GetCachedTexture(url, details, lastHashCheck))
+    return false;
+
+  if (!IsHashCheckDue(lastHashCheck))
+    details.hash.clear();
+  return true;
+}
+
+bool CTextureDatabase::GetCachedTexture(const std::string& url,
+                                        CTextureDetails& details,
+                                        CDateTime& lastHashCheck)
 {
   try
   {
@@ -225,10 +238,8 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
     { // have some information
       details.id = m_pDS->fv(0).get_asInt();
       details.file  = m_pDS->fv(1).get_asString();
-      CDateTime lastCheck;
-      lastCheck.SetFromDBDateTime(m_pDS->fv(2).get_asString());
-      if (lastCheck.IsValid() && lastCheck + CDateTimeSpan(1,0,0,0) < CDateTime::GetCurrentDateTime())
-        details.hash = m_pDS->fv(3).get_asString();
+      lastHashCheck.SetFromDBDateTime(m_pDS->fv(2).get_asString());
+      details.hash = m_pDS->fv(3).get_asString();
       details.width = m_pDS->fv(4).get_asInt();
       details.height = m_pDS->fv(5).get_asInt();
       m_pDS->close();
@@ -422,9 +433,20 @@ bool CTextureDatabase::ClearCachedTexture(int id, std::string &cacheFile)
   return false;
 }
 
+bool CTextureDatabase::IsHashCheckDue(const CDateTime& lastHashCheck)
+{
+  return lastHashCheck.IsValid() &&
+         lastHashCheck + CDateTimeSpan(1, 0, 0, 0) < CDateTime::GetCurrentDateTime();
+}
+
+CDateTime CTextureDatabase::GetInvalidatedHashCheck()
+{
+  return CDateTime::GetCurrentDateTime() - CDateTimeSpan(2, 0, 0, 0);
+}
+
 bool CTextureDatabase::InvalidateCachedTexture(const std::string &url)
 {
-  std::string date = (CDateTime::GetCurrentDateTime() - CDateTimeSpan(2, 0, 0, 0)).GetAsDBDateTime();
+  std::string date = GetInvalidatedHashCheck().GetAsDBDateTime();
   std::string sql = PrepareSQL("UPDATE texture SET lasthashcheck='%s' WHERE url='%s'", date.c_str(), url.c_str());
   return ExecuteQuery(sql);
 }
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+class CDateTime;
 class CVariant;
 
 class CTextureRule : public CDatabaseQueryRule
@@ -43,6 +44,17 @@ public:
   bool Open() override;
 
   bool GetCachedTexture(const std::string &originalURL, CTextureDetails &details);
+
+  /*! \brief Get a cached texture, including its image hash regardless of whether it needs checking
+   \param originalURL url of the original image
+   \param details [out] texture details, with the stored image hash
+   \param lastHashCheck [out] time the hash was last checked, invalid if the image isn't updateable
+   \return true if we have a cached version of this image, false otherwise.
+   \sa IsHashCheckDue
+   */
+  bool GetCachedTexture(const std::string& originalURL,
+                        CTextureDetails& details,
+                        CDateTime& lastHashCheck);
   bool AddCachedTexture(const std::string &originalURL, const CTextureDetails &details);
   bool SetCachedTextureValid(const std::string &originalURL, bool updateable);
   bool ClearCachedTexture(const std::string &originalURL, std::string &cacheFile);
@@ -56,6 +68,14 @@ public:
    */
   bool InvalidateCachedTexture(const std::string &originalURL);
 
+  /*! \brief Whether the image hash of a cached texture should be checked for updates
+   \param lastHashCheck time the hash was last checked
+   */
+  static bool IsHashCheckDue(const CDateTime& lastHashCheck);
+
+  /*! \brief The hash check time InvalidateCachedTexture stores, forcing the next check */
+  static CDateTime GetInvalidatedHashCheck();
+
   /*! \brief Get a texture associated with the given path
    Used for retrieval of previously discovered images to save
    stat() on the filesystem all the time
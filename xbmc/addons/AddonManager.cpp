@@ -23,13 +23,13 @@
 #include "addons/IAddon.h"
 #include "addons/addoninfo/AddonInfo.h"
 #include "addons/addoninfo/AddonInfoBuilder.h"
+#include "addons/addoninfo/AddonManifestCache.h"
 #include "addons/addoninfo/AddonType.h"
 #include "events/AddonManagementEvent.h"
 #include "events/EventLog.h"
 #include "events/NotificationEvent.h"
 #include "filesystem/Directory.h"
 #include "filesystem/SpecialProtocol.h"
-#include "utils/FileUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/XBMCTinyXML2.h"
@@ -38,6 +38,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <mutex>
 #include <set>
 #include <utility>
@@ -87,7 +88,8 @@ static bool LoadManifest(std::set<std::string>& system, std::set<std::string>& o
 
 CAddonMgr::CAddonMgr()
   : m_database(std::make_unique<CAddonDatabase>()),
-    m_updateRules(std::make_unique<CAddonUpdateRules>())
+    m_updateRules(std::make_unique<CAddonUpdateRules>()),
+    m_manifestCache(std::make_unique<CAddonManifestCache>())
 {
 }
 
@@ -705,12 +707,24 @@ bool CAddonMgr::FindAddons()
 {
   ADDON_INFO_LIST installedAddons;
 
+  auto start = std::chrono::steady_clock::now();
+  const unsigned int hits = m_manifestCache->GetHits();
+
   FindAddons(installedAddons, "special://xbmcbin/addons");
   // Confirm special://xbmcbin/addons and special://xbmc/addons are not the same
   if (!CSpecialProtocol::ComparePath("special://xbmcbin/addons", "special://xbmc/addons"))
     FindAddons(installedAddons, "special://xbmc/addons");
   FindAddons(installedAddons, "special://home/addons");
 
+  auto end = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+  CLog::Log(LOGINFO, "CAddonMgr::{}: found {} add-ons in {} ms ({} from manifest cache)",
+            __FUNCTION__, installedAddons.size(), duration.count(),
+            m_manifestCache->GetHits() - hits);
+
+  // Only a full scan knows which add-ons are gone
+  m_manifestCache->Save();
+
   std::set<std::string> installed;
   for (const auto& addon : installedAddons)
     installed.insert(addon.second->ID());
@@ -1293,26 +1307,23 @@ void CAddonMgr::FindAddons(ADDON_INFO_LIST& addonmap, const std::string& path)
     for (int i = 0; i < items.Size(); ++i)
     {
       std::string path = items[i]->GetPath();
-      if (CFileUtils::Exists(path + "addon.xml"))
+      AddonInfoPtr addonInfo = m_manifestCache->Generate(path);
+      if (addonInfo)
       {
-        AddonInfoPtr addonInfo = CAddonInfoBuilder::Generate(path);
-        if (addonInfo)
+        const auto& it = addonmap.find(addonInfo->ID());
+        if (it != addonmap.end())
         {
-          const auto& it = addonmap.find(addonInfo->ID());
-          if (it != addonmap.end())
+          if (it->second->Version() > addonInfo->Version())
           {
-            if (it->second->Version() > addonInfo->Version())
-            {
-              CLog::Log(LOGWARNING, "CAddonMgr::{}: Addon '{}' already present with higher version {} at '{}' - other version {} at '{}' will be ignored",
-                           __FUNCTION__, addonInfo->ID(), it->second->Version().asString(), it->second->Path(), addonInfo->Version().asString(), addonInfo->Path());
-              continue;
-            }
-            CLog::Log(LOGDEBUG, "CAddonMgr::{}: Addon '{}' already present with version {} at '{}' replaced with version {} at '{}'",
+            CLog::Log(LOGWARNING, "CAddonMgr::{}: Addon '{}' already present with higher version {} at '{}' - other version {} at '{}' will be ignored",
                          __FUNCTION__, addonInfo->ID(), it->second->Version().asString(), it->second->Path(), addonInfo->Version().asString(), addonInfo->Path());
+            continue;
           }
-
-          addonmap[addonInfo->ID()] = addonInfo;
+          CLog::Log(LOGDEBUG, "CAddonMgr::{}: Addon '{}' already present with version {} at '{}' replaced with version {} at '{}'",
+                       __FUNCTION__, addonInfo->ID(), it->second->Version().asString(), it->second->Path(), addonInfo->Version().asString(), addonInfo->Path());
         }
+
+        addonmap[addonInfo->ID()] = addonInfo;
       }
     }
   }
@@ -29,6 +29,7 @@ enum class AddonUpdateRule;
 enum class AllowCheckForUpdates : bool;
 
 class CAddonDatabase;
+class CAddonManifestCache;
 class CAddonUpdateRules;
 class CAddonVersion;
 class IAddonMgrCallback;
@@ -681,6 +682,7 @@ private:
   mutable CCriticalSection m_critSection;
   std::unique_ptr<CAddonDatabase> m_database;
   std::unique_ptr<CAddonUpdateRules> m_updateRules;
+  std::unique_ptr<CAddonManifestCache> m_manifestCache;
   CEventSource<AddonEvent> m_events;
   CBlockingEventSource<AddonEvent> m_unloadEvents;
   std::set<std::string> m_systemAddons;
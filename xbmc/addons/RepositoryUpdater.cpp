@@ -9,7 +9,7 @@
 #include "RepositoryUpdater.h"
 
 #include "ServiceBroker.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "addons/AddonDatabase.h"
 #include "addons/AddonEvents.h"
 #include "addons/AddonInstaller.h"
@@ -91,9 +91,7 @@ bool CRepositoryUpdateJob::DoWork()
 
   //Invalidate art.
   {
-    CTextureDatabase textureDB;
-    textureDB.Open();
-    textureDB.BeginMultipleExecute();
+    std::vector<std::string> images;
 
     for (const auto& addon : addons)
     {
@@ -106,16 +104,16 @@ bool CRepositoryUpdateJob::DoWork()
           CLog::Log(LOGDEBUG, "CRepository: invalidating cached art for '{}'", addon->ID());
 
         if (!oldAddon->Icon().empty())
-          textureDB.InvalidateCachedTexture(oldAddon->Icon());
+          images.emplace_back(oldAddon->Icon());
 
         for (const auto& path : oldAddon->Screenshots())
-          textureDB.InvalidateCachedTexture(path);
+          images.emplace_back(path);
 
         for (const auto& art : oldAddon->Art())
-          textureDB.InvalidateCachedTexture(art.second);
+          images.emplace_back(art.second);
       }
     }
-    textureDB.CommitMultipleExecute();
+    CServiceBroker::GetTextureCache()->InvalidateCachedImages(images);
   }
 
   database.UpdateRepositoryContent(m_repo->ID(), m_repo->Version(), newChecksum, addons);
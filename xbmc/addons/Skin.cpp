@@ -283,6 +283,7 @@ void CSkinInfo::LoadIncludes()
   CLog::Log(LOGINFO, "Loading skin includes from {}", includesPath);
   m_includes.Clear();
   m_includes.Load(includesPath);
+  m_windowCache.Reset(ID(), Version().asString(), m_includes);
 }
 
 void CSkinInfo::LoadTimers()
@@ -308,6 +309,20 @@ void CSkinInfo::ResolveIncludes(TiXmlElement* node,
   m_includes.Resolve(node, xmlIncludeConditions);
 }
 
+std::unique_ptr<TiXmlElement> CSkinInfo::GetResolvedWindow(
+    const std::string& windowFile, std::map<INFO::InfoPtr, bool>& xmlIncludeConditions)
+{
+  return m_windowCache.Get(windowFile, m_includes, xmlIncludeConditions);
+}
+
+void CSkinInfo::StoreResolvedWindow(const std::string& windowFile,
+                                    const std::string& loadedFile,
+                                    const TiXmlElement& resolved,
+                                    const std::map<INFO::InfoPtr, bool>& xmlIncludeConditions)
+{
+  m_windowCache.Store(windowFile, loadedFile, resolved, m_includes, xmlIncludeConditions);
+}
+
 int CSkinInfo::GetStartWindow() const
 {
   int windowID = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_LOOKANDFEEL_STARTUPWINDOW);
@@ -11,6 +11,7 @@
 #include "addons/Addon.h"
 #include "addons/gui/skin/SkinTimerManager.h"
 #include "guilib/GUIIncludes.h" // needed for the GUIInclude member
+#include "guilib/GUIWindowCache.h"
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 
 #include <map>
@@ -158,6 +159,26 @@ public:
   void ResolveIncludes(TiXmlElement* node,
                        std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = nullptr);
 
+  /*! \brief Get a window with resolved includes from the window cache
+   \param windowFile the path of the window XML
+   \param xmlIncludeConditions [out] the conditions used to resolve the includes
+   \return the resolved window XML, nullptr if it has to be resolved
+   \sa CGUIWindowCache
+   */
+  std::unique_ptr<TiXmlElement> GetResolvedWindow(
+      const std::string& windowFile, std::map<INFO::InfoPtr, bool>& xmlIncludeConditions);
+
+  /*! \brief Keep a window with resolved includes in the window cache
+   \param windowFile the path of the window XML
+   \param loadedFile the path the window XML was loaded from
+   \param resolved the window XML after resolving its includes
+   \param xmlIncludeConditions the conditions used to resolve the includes
+   */
+  void StoreResolvedWindow(const std::string& windowFile,
+                           const std::string& loadedFile,
+                           const TiXmlElement& resolved,
+                           const std::map<INFO::InfoPtr, bool>& xmlIncludeConditions);
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; }
 
   const std::vector<CStartupWindow>& GetStartupWindows() const { return m_startupWindows; }
@@ -278,6 +299,7 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  CGUIWindowCache m_windowCache;
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
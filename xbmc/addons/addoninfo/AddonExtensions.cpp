@@ -8,6 +8,7 @@
 
 #include "AddonExtensions.h"
 
+#include "utils/Archive.h"
 #include "utils/StringUtils.h"
 
 using namespace ADDON;
@@ -66,3 +67,62 @@ void CAddonExtensions::Insert(const std::string& id, const std::string& value)
   extension.emplace_back(id, SExtValue(value));
   m_values.emplace_back(id, extension);
 }
+
+void CAddonExtensions::Archive(CArchive& ar)
+{
+  if (ar.IsStoring())
+  {
+    ar << m_point;
+    ar << m_values.size();
+    for (const auto& values : m_values)
+    {
+      ar << values.first;
+      ar << values.second.size();
+      for (const auto& value : values.second)
+      {
+        ar << value.first;
+        ar << value.second.str;
+      }
+    }
+    ar << m_children.size();
+    for (auto& child : m_children)
+    {
+      ar << child.first;
+      ar << child.second;
+    }
+  }
+  else
+  {
+    size_t count;
+    ar >> m_point;
+    ar >> count;
+    m_values.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      std::string id;
+      size_t valueCount;
+      ar >> id;
+      ar >> valueCount;
+      EXT_VALUE values;
+      for (size_t j = 0; j < valueCount; ++j)
+      {
+        std::string name;
+        std::string value;
+        ar >> name;
+        ar >> value;
+        values.emplace_back(name, SExtValue(value));
+      }
+      m_values.emplace_back(id, values);
+    }
+    ar >> count;
+    m_children.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      std::string id;
+      CAddonExtensions child;
+      ar >> id;
+      ar >> child;
+      m_children.emplace_back(id, child);
+    }
+  }
+}
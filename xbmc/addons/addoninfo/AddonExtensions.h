@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "utils/IArchivable.h"
+
 #include <stdlib.h>
 #include <string>
 #include <vector>
@@ -51,11 +53,11 @@ public:
   }
 };
 
-class CAddonExtensions
+class CAddonExtensions : public IArchivable
 {
 public:
   CAddonExtensions() = default;
-  ~CAddonExtensions() = default;
+  ~CAddonExtensions() override = default;
 
   const SExtValue GetValue(const std::string& id) const;
   const EXT_VALUES& GetValues() const;
@@ -64,6 +66,8 @@ public:
 
   void Insert(const std::string& id, const std::string& value);
 
+  void Archive(CArchive& ar) override;
+
 private:
   friend class CAddonInfoBuilder;
   friend class CAddonDatabaseSerializer;
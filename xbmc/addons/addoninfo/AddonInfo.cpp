@@ -17,6 +17,7 @@
 #include "addons/addoninfo/AddonType.h"
 #include "filesystem/Directory.h"
 #include "guilib/LocalizeStrings.h"
+#include "utils/Archive.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
@@ -277,6 +278,150 @@ bool CAddonInfo::SupportsMultipleInstances() const
   }
 }
 
+namespace
+{
+template<typename Map>
+void ArchiveMap(CArchive& ar, Map& map)
+{
+  if (ar.IsStoring())
+  {
+    ar << map.size();
+    for (const auto& [key, value] : map)
+    {
+      ar << key;
+      ar << value;
+    }
+  }
+  else
+  {
+    size_t count;
+    ar >> count;
+    map.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      std::string key;
+      ar >> key;
+      ar >> map[key];
+    }
+  }
+}
+
+void ArchiveVersion(CArchive& ar, CAddonVersion& version)
+{
+  if (ar.IsStoring())
+  {
+    ar << version.asString();
+  }
+  else
+  {
+    std::string str;
+    ar >> str;
+    version = CAddonVersion(str);
+  }
+}
+} // unnamed namespace
+
+void CAddonInfo::Archive(CArchive& ar)
+{
+  if (ar.IsStoring())
+  {
+    ar << m_id;
+    ar << static_cast<int>(m_mainType);
+    ar << m_types.size();
+    for (auto& type : m_types)
+      ar << type;
+    ar << m_isBinary;
+    ar << m_name;
+    ar << m_license;
+    ar << m_author;
+    ar << m_source;
+    ar << m_website;
+    ar << m_forum;
+    ar << m_email;
+    ar << m_path;
+    ar << m_profilePath;
+    ar << m_icon;
+    ar << m_screenshots;
+    ar << m_dependencies.size();
+    for (const auto& dependency : m_dependencies)
+    {
+      ar << dependency.id;
+      ar << dependency.versionMin.asString();
+      ar << dependency.version.asString();
+      ar << dependency.optional;
+    }
+    ar << static_cast<int>(m_lifecycleState);
+    ar << m_packageSize;
+    ar << m_libname;
+    ar << m_platforms;
+    ar << static_cast<int>(m_addonInstanceSupportType);
+    ar << m_supportsAddonSettings;
+    ar << m_supportsInstanceSettings;
+  }
+  else
+  {
+    int value;
+    size_t count;
+    ar >> m_id;
+    ar >> value;
+    m_mainType = static_cast<AddonType>(value);
+    ar >> count;
+    m_types.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      CAddonType type;
+      ar >> type;
+      m_types.emplace_back(std::move(type));
+    }
+    ar >> m_isBinary;
+    ar >> m_name;
+    ar >> m_license;
+    ar >> m_author;
+    ar >> m_source;
+    ar >> m_website;
+    ar >> m_forum;
+    ar >> m_email;
+    ar >> m_path;
+    ar >> m_profilePath;
+    ar >> m_icon;
+    ar >> m_screenshots;
+    ar >> count;
+    m_dependencies.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      std::string id;
+      std::string versionMin;
+      std::string version;
+      bool optional;
+      ar >> id;
+      ar >> versionMin;
+      ar >> version;
+      ar >> optional;
+      m_dependencies.emplace_back(id, CAddonVersion(versionMin), CAddonVersion(version),
+                                  optional);
+    }
+    ar >> value;
+    m_lifecycleState = static_cast<AddonLifecycleState>(value);
+    ar >> m_packageSize;
+    ar >> m_libname;
+    ar >> m_platforms;
+    ar >> value;
+    m_addonInstanceSupportType = static_cast<AddonInstanceSupport>(value);
+    ar >> m_supportsAddonSettings;
+    ar >> m_supportsInstanceSettings;
+  }
+
+  ArchiveVersion(ar, m_version);
+  ArchiveVersion(ar, m_minversion);
+  ArchiveMap(ar, m_summary);
+  ArchiveMap(ar, m_description);
+  ArchiveMap(ar, m_changelog);
+  ArchiveMap(ar, m_art);
+  ArchiveMap(ar, m_disclaimer);
+  ArchiveMap(ar, m_lifecycleStateDescription);
+  ArchiveMap(ar, m_extrainfo);
+}
+
 std::vector<AddonInstanceId> CAddonInfo::GetKnownInstanceIds() const
 {
   static const std::vector<AddonInstanceId> singletonInstance = {ADDON_SINGLETON_INSTANCE_ID};
@@ -10,6 +10,7 @@
 
 #include "XBDateTime.h"
 #include "addons/AddonVersion.h"
+#include "utils/IArchivable.h"
 
 #include <map>
 #include <memory>
@@ -138,7 +139,7 @@ typedef std::map<std::string, std::string> ArtMap;
 
 class CAddonInfoBuilder;
 
-class CAddonInfo
+class CAddonInfo : public IArchivable
 {
 public:
   CAddonInfo() = default;
@@ -249,6 +250,12 @@ public:
   bool SupportsInstanceSettings() const { return m_supportsInstanceSettings; }
   std::vector<AddonInstanceId> GetKnownInstanceIds() const;
 
+  /*!
+   * @brief Store or load the information read from the add-on folder, the install data kept in
+   * the add-on database is not part of it.
+   */
+  void Archive(CArchive& ar) override;
+
   /*!
     * @brief Utilities to translate add-on parts to his requested part.
     */
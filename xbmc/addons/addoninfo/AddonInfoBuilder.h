@@ -46,6 +46,11 @@ public:
                                const RepositoryDirInfo& repo,
                                bool platformCheck = true);
 
+  /*!
+   * @brief Check whether an add-on can run on this platform
+   */
+  static bool PlatformSupportsAddon(const AddonInfoPtr& addon);
+
   /*!
     * @brief Parts used from CAddonDatabase
     */
@@ -70,7 +75,6 @@ private:
                           const std::string& tag,
                           std::unordered_map<std::string, std::string>& translatedValues);
   static const char* GetPlatformLibraryName(const tinyxml2::XMLElement* element);
-  static bool PlatformSupportsAddon(const AddonInfoPtr& addon);
 };
 
 class CAddonInfoBuilderFromDB
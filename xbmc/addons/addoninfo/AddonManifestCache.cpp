@@ -0,0 +1,208 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AddonManifestCache.h"
+
+#include "CompileInfo.h"
+#include "addons/addoninfo/AddonInfo.h"
+#include "addons/addoninfo/AddonInfoBuilder.h"
+#include "addons/addoninfo/AddonType.h"
+#include "filesystem/File.h"
+#include "utils/Archive.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+using namespace ADDON;
+using XFILE::CFile;
+
+namespace
+{
+constexpr char CACHE_MAGIC[] = "KODI_ADDON_MANIFESTS";
+constexpr int CACHE_VERSION = 2;
+constexpr char CACHE_END[] = "END";
+} // unnamed namespace
+
+CAddonManifestCache::CAddonManifestCache(std::string cacheFile) : m_cacheFile(std::move(cacheFile))
+{
+}
+
+CAddonManifestCache::FileStamps CAddonManifestCache::GetFileStamps(const std::string& addonPath)
+{
+  // the files CAddonInfoBuilder reads from an add-on folder
+  const std::array<std::string, std::tuple_size_v<FileStamps>> files = {
+      URIUtils::AddFileToFolder(addonPath, "addon.xml"),
+      URIUtils::AddFileToFolder(addonPath, "changelog.txt"),
+      URIUtils::AddFileToFolder(addonPath, "resources", "settings.xml"),
+      URIUtils::AddFileToFolder(addonPath, "resources", "instance-settings.xml"),
+  };
+
+  FileStamps stamps;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    struct __stat64 st;
+    if (CFile::Stat(files[i], &st) == 0)
+    {
+      stamps[i].time = static_cast<int64_t>(st.st_mtime);
+      stamps[i].size = static_cast<int64_t>(st.st_size);
+    }
+  }
+  return stamps;
+}
+
+AddonInfoPtr CAddonManifestCache::Generate(const std::string& addonPath)
+{
+  // stat before parsing, a file changed meanwhile is parsed again on the next start
+  const FileStamps stamps = GetFileStamps(addonPath);
+  if (stamps[0].time < 0)
+    return nullptr;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!m_loaded)
+    Load();
+
+  Entry& entry = m_entries[addonPath];
+  entry.used = true;
+  if (entry.stamps == stamps)
+  {
+    ++m_hits;
+  }
+  else
+  {
+    ++m_misses;
+    entry.stamps = stamps;
+    entry.info = CAddonInfoBuilder::Generate(addonPath, false);
+    m_modified = true;
+  }
+
+  // checked on every start, unsupported add-ons are cached as well
+  if (entry.info && CAddonInfoBuilder::PlatformSupportsAddon(entry.info))
+    return entry.info;
+
+  return nullptr;
+}
+
+void CAddonManifestCache::Load()
+{
+  m_loaded = true;
+
+  CFile file;
+  if (!file.Open(m_cacheFile))
+    return;
+
+  std::unordered_map<std::string, Entry> entries;
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+
+    std::string magic;
+    int version;
+    std::string build;
+    ar >> magic;
+    ar >> version;
+    ar >> build;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || build != CCompileInfo::GetSCMID())
+    {
+      CLog::Log(LOGDEBUG, "CAddonManifestCache::{}: Ignoring cache of another version", __func__);
+      return;
+    }
+
+    unsigned int count;
+    ar >> count;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string path;
+      Entry entry;
+      bool hasInfo;
+      ar >> path;
+      for (FileStamp& stamp : entry.stamps)
+      {
+        ar >> stamp.time;
+        ar >> stamp.size;
+      }
+      ar >> hasInfo;
+      if (hasInfo)
+      {
+        entry.info = std::make_shared<CAddonInfo>();
+        ar >> *entry.info;
+      }
+      entries.emplace(std::move(path), std::move(entry));
+    }
+
+    std::string end;
+    ar >> end;
+    ar.Close();
+    if (end != CACHE_END)
+    {
+      CLog::Log(LOGERROR, "CAddonManifestCache::{}: Corrupt cache '{}'", __func__, m_cacheFile);
+      return;
+    }
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "CAddonManifestCache::{}: Corrupt cache '{}'", __func__, m_cacheFile);
+    return;
+  }
+
+  m_entries = std::move(entries);
+}
+
+void CAddonManifestCache::Save()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (!it->second.used)
+    {
+      it = m_entries.erase(it);
+      m_modified = true;
+    }
+    else
+    {
+      // the next scan marks the add-ons still installed
+      it->second.used = false;
+      ++it;
+    }
+  }
+
+  if (!m_modified)
+    return;
+
+  CFile file;
+  if (!file.OpenForWrite(m_cacheFile, true))
+  {
+    CLog::Log(LOGERROR, "CAddonManifestCache::{}: Unable to write '{}'", __func__, m_cacheFile);
+    return;
+  }
+
+  CArchive ar(&file, CArchive::store);
+  ar << std::string(CACHE_MAGIC);
+  ar << CACHE_VERSION;
+  ar << std::string(CCompileInfo::GetSCMID());
+  ar << static_cast<unsigned int>(m_entries.size());
+  for (const auto& [path, entry] : m_entries)
+  {
+    ar << path;
+    for (const FileStamp& stamp : entry.stamps)
+    {
+      ar << stamp.time;
+      ar << stamp.size;
+    }
+    ar << (entry.info != nullptr);
+    if (entry.info)
+      ar << *entry.info;
+  }
+  ar << std::string(CACHE_END);
+  ar.Close();
+
+  m_modified = false;
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace ADDON
+{
+
+class CAddonInfo;
+using AddonInfoPtr = std::shared_ptr<CAddonInfo>;
+
+/*!
+ * @brief Cache of the manifests of installed add-ons.
+ *
+ * Keeps the add-on information created from each add-on folder, keyed by folder. An entry is
+ * used as long as the modification time and size of every file read to create it didn't
+ * change, so a startup only parses the manifests of new or changed add-ons. The cache of
+ * another build is ignored, as its parser may create different information.
+ */
+class CAddonManifestCache
+{
+public:
+  explicit CAddonManifestCache(std::string cacheFile = "special://temp/addonmanifests.cache");
+
+  /*!
+   * @brief Create the information of the add-on installed in a folder.
+   *
+   * @param[in] addonPath path of the add-on folder
+   * @return the add-on information, nullptr if the folder contains no valid add-on or the add-on
+   * doesn't run on this platform. The same instance is returned while the add-on is unchanged.
+   */
+  AddonInfoPtr Generate(const std::string& addonPath);
+
+  /*!
+   * @brief Write the cache, dropping the entries of add-ons not found since it was loaded.
+   */
+  void Save();
+
+  unsigned int GetHits() const { return m_hits; }
+  unsigned int GetMisses() const { return m_misses; }
+
+private:
+  struct FileStamp
+  {
+    int64_t time{-1}; // -1 if the file doesn't exist
+    int64_t size{-1};
+
+    bool operator==(const FileStamp& other) const = default;
+  };
+
+  // addon.xml, changelog.txt, resources/settings.xml and resources/instance-settings.xml
+  using FileStamps = std::array<FileStamp, 4>;
+
+  struct Entry
+  {
+    FileStamps stamps;
+    AddonInfoPtr info; // nullptr if the folder contains no valid add-on
+    bool used{false};
+  };
+
+  static FileStamps GetFileStamps(const std::string& addonPath);
+  void Load();
+
+  const std::string m_cacheFile;
+  mutable CCriticalSection m_critSection;
+  std::unordered_map<std::string, Entry> m_entries;
+  bool m_loaded{false};
+  bool m_modified{false};
+  unsigned int m_hits{0};
+  unsigned int m_misses{0};
+};
+
+} // namespace ADDON
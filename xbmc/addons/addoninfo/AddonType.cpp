@@ -9,6 +9,7 @@
 #include "AddonType.h"
 
 #include "addons/addoninfo/AddonInfo.h"
+#include "utils/Archive.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
@@ -57,3 +58,34 @@ bool CAddonType::IsDependencyType(AddonType type)
 {
   return dependencyTypes.find(type) != dependencyTypes.end();
 }
+
+void CAddonType::Archive(CArchive& ar)
+{
+  CAddonExtensions::Archive(ar);
+
+  if (ar.IsStoring())
+  {
+    ar << static_cast<int>(m_type);
+    ar << m_path;
+    ar << m_libname;
+    ar << m_providedSubContent.size();
+    for (AddonType content : m_providedSubContent)
+      ar << static_cast<int>(content);
+  }
+  else
+  {
+    int type;
+    size_t count;
+    ar >> type;
+    m_type = static_cast<AddonType>(type);
+    ar >> m_path;
+    ar >> m_libname;
+    ar >> count;
+    m_providedSubContent.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      ar >> type;
+      m_providedSubContent.insert(static_cast<AddonType>(type));
+    }
+  }
+}
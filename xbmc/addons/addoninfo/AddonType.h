@@ -107,6 +107,8 @@ public:
    */
   static bool IsDependencyType(AddonType type);
 
+  void Archive(CArchive& ar) override;
+
 private:
   friend class CAddonInfoBuilder;
   friend class CAddonInfoBuilderFromDB;
@@ -1526,6 +1526,43 @@ public:
   virtual DEMUX_PACKET* DemuxRead() { return nullptr; }
   //----------------------------------------------------------------------------
 
+  //============================================================================
+  /// @brief Read the next packets from the demultiplexer, as many as there are
+  /// up to the given count.
+  ///
+  /// Only called if @ref INPUTSTREAM_SUPPORTS_DEMUX_BATCH is set in the
+  /// capabilities. Kodi then hands out the packets of a batch one after another,
+  /// which saves a call into the add-on per packet on high bitrate streams.
+  ///
+  /// The packets are the same as returned by @ref DemuxRead(). A batch has to
+  /// end with a packet Kodi has to handle before the add-on may go on reading,
+  /// i.e. an empty packet or a packet with a special stream id like
+  /// DMX_SPECIALID_STREAMCHANGE. Packets not handed out yet are freed by Kodi
+  /// when it flushes, resets or seeks the demuxer.
+  ///
+  /// @param[out] packets The array to store the packets in
+  /// @param[in] maxPackets The size of the array
+  /// @return The count of packets stored, 0 if an error occurred
+  ///
+  /// @remarks The default implementation calls @ref DemuxRead() for every packet.
+  ///
+  virtual int DemuxReadBatch(DEMUX_PACKET** packets, int maxPackets)
+  {
+    int count = 0;
+    while (count < maxPackets)
+    {
+      DEMUX_PACKET* packet = DemuxRead();
+      if (!packet)
+        break;
+
+      packets[count++] = packet;
+      if (packet->iSize == 0 || packet->iStreamId < 0)
+        break;
+    }
+    return count;
+  }
+  //----------------------------------------------------------------------------
+
   //============================================================================
   /// @brief Notify the InputStream addon/demuxer that Kodi wishes to seek the stream by time
   ///
@@ -1794,6 +1831,7 @@ private:
     instance->inputstream->toAddon->demux_abort = ADDON_DemuxAbort;
     instance->inputstream->toAddon->demux_flush = ADDON_DemuxFlush;
     instance->inputstream->toAddon->demux_read = ADDON_DemuxRead;
+    instance->inputstream->toAddon->demux_read_batch = ADDON_DemuxReadBatch;
     instance->inputstream->toAddon->demux_seek_time = ADDON_DemuxSeekTime;
     instance->inputstream->toAddon->demux_set_speed = ADDON_DemuxSetSpeed;
     instance->inputstream->toAddon->set_video_resolution = ADDON_SetVideoResolution;
@@ -1924,6 +1962,14 @@ private:
     return static_cast<CInstanceInputStream*>(instance->toAddon->addonInstance)->DemuxRead();
   }
 
+  inline static int ADDON_DemuxReadBatch(const AddonInstance_InputStream* instance,
+                                         DEMUX_PACKET** packets,
+                                         int maxPackets)
+  {
+    return static_cast<CInstanceInputStream*>(instance->toAddon->addonInstance)
+        ->DemuxReadBatch(packets, maxPackets);
+  }
+
   inline static bool ADDON_DemuxSeekTime(const AddonInstance_InputStream* instance,
                                          double time,
                                          bool backwards,
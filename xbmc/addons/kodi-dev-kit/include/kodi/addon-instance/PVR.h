@@ -2450,6 +2450,43 @@ public:
   virtual DEMUX_PACKET* DemuxRead() { return nullptr; }
   //----------------------------------------------------------------------------
 
+  //============================================================================
+  /// @brief Read the next packets from the demultiplexer, as many as there are
+  /// up to the given count.
+  ///
+  /// Only called if @ref PVRCapabilities::SetSupportsDemuxBatch() is set to
+  /// **true**. Kodi then hands out the packets of a batch one after another,
+  /// which saves a call into the add-on per packet on high bitrate streams.
+  ///
+  /// The packets are the same as returned by @ref DemuxRead(). A batch has to
+  /// end with a packet Kodi has to handle before the add-on may go on reading,
+  /// i.e. an empty packet or a packet with a special stream id like
+  /// @ref DMX_SPECIALID_STREAMCHANGE. Packets not handed out yet are freed by
+  /// Kodi when it flushes, resets or seeks the demuxer.
+  ///
+  /// @param[out] packets The array to store the packets in
+  /// @param[in] maxPackets The size of the array
+  /// @return The count of packets stored, 0 if an error occurred
+  ///
+  /// @remarks The default implementation calls @ref DemuxRead() for every packet.
+  ///
+  virtual int DemuxReadBatch(DEMUX_PACKET** packets, int maxPackets)
+  {
+    int count = 0;
+    while (count < maxPackets)
+    {
+      DEMUX_PACKET* packet = DemuxRead();
+      if (!packet)
+        break;
+
+      packets[count++] = packet;
+      if (packet->iSize == 0 || packet->iStreamId < 0)
+        break;
+    }
+    return count;
+  }
+  //----------------------------------------------------------------------------
+
   //============================================================================
   /// @brief Reset the demultiplexer in the add-on.
   ///
@@ -2912,6 +2949,7 @@ private:
     instance->pvr->toAddon->DemuxAbort = ADDON_DemuxAbort;
     instance->pvr->toAddon->DemuxFlush = ADDON_DemuxFlush;
     instance->pvr->toAddon->DemuxRead = ADDON_DemuxRead;
+    instance->pvr->toAddon->DemuxReadBatch = ADDON_DemuxReadBatch;
     //--==----==----==----==----==----==----==----==----==----==----==----==----==
     instance->pvr->toAddon->CanPauseStream = ADDON_CanPauseStream;
     instance->pvr->toAddon->PauseStream = ADDON_PauseStream;
@@ -3635,6 +3673,14 @@ private:
     return static_cast<CInstancePVRClient*>(instance->toAddon->addonInstance)->DemuxRead();
   }
 
+  inline static int ADDON_DemuxReadBatch(const AddonInstance_PVR* instance,
+                                         DEMUX_PACKET** packets,
+                                         int maxPackets)
+  {
+    return static_cast<CInstancePVRClient*>(instance->toAddon->addonInstance)
+        ->DemuxReadBatch(packets, maxPackets);
+  }
+
   inline static bool ADDON_CanPauseStream(const AddonInstance_PVR* instance)
   {
     return static_cast<CInstancePVRClient*>(instance->toAddon->addonInstance)->CanPauseStream();
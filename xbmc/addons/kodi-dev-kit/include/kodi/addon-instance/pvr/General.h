@@ -1113,6 +1113,7 @@ public:
   /// | **Supports recording size** | `boolean` | @ref PVRCapabilities::SetSupportsRecordingSize "SetSupportsRecordingSize" | @ref PVRCapabilities::GetSupportsRecordingSize "GetSupportsRecordingSize"
   /// | **Supports recordings delete** | `boolean` | @ref PVRCapabilities::SetSupportsRecordingsDelete "SetSupportsRecordingsDelete" | @ref PVRCapabilities::GetSupportsRecordingsDelete "SetSupportsRecordingsDelete"
   /// | **Supports multiple recorded streams** | `boolean` | @ref PVRCapabilities::SetSupportsMultipleRecordedStreams "SetSupportsMultipleRecordedStreams" | @ref PVRCapabilities::GetSupportsMultipleRecordedStreams "GetSupportsMultipleRecordedStreams"
+  /// | **Supports demux batch** | `boolean` | @ref PVRCapabilities::SetSupportsDemuxBatch "SetSupportsDemuxBatch" | @ref PVRCapabilities::GetSupportsDemuxBatch "GetSupportsDemuxBatch"
   /// | **Recordings lifetime values** | @ref cpp_kodi_addon_pvr_Defs_PVRTypeIntValue "PVRTypeIntValue" | @ref PVRCapabilities::SetRecordingsLifetimeValues "SetRecordingsLifetimeValues" | @ref PVRCapabilities::GetRecordingsLifetimeValues "GetRecordingsLifetimeValues"
   ///
   /// @warning This class can not be used outside of @ref kodi::addon::CInstancePVRClient::GetCapabilities()
@@ -1351,6 +1352,18 @@ public:
     return m_cStructure->bSupportsMultipleRecordedStreams;
   }
 
+  /// @brief Set **true** if this add-on reads many demux packets at once with
+  /// @ref kodi::addon::CInstancePVRClient::DemuxReadBatch().
+  ///
+  /// @note Only used if @ref SetHandlesDemuxing() is set to **true**.
+  void SetSupportsDemuxBatch(bool supportsDemuxBatch)
+  {
+    m_cStructure->bSupportsDemuxBatch = supportsDemuxBatch;
+  }
+
+  /// @brief To get with @ref SetSupportsDemuxBatch changed values.
+  bool GetSupportsDemuxBatch() const { return m_cStructure->bSupportsDemuxBatch; }
+
   /// @brief **optional**\n
   /// Set array containing the possible values for @ref PVRRecording::SetLifetime().
   ///
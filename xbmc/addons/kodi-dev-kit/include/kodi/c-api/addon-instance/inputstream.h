@@ -84,6 +84,12 @@ extern "C"
     ///
     /// If set must be @ref cpp_kodi_addon_inputstream_Chapter "Chapter support" included.
     INPUTSTREAM_SUPPORTS_ICHAPTER = (1 << 6),
+
+    /// @brief **0000 0000 1000 0000 :** Supports reading many demux packets at once.
+    ///
+    /// Kodi then reads packets with @ref kodi::addon::CInstanceInputStream::DemuxReadBatch()
+    /// instead of @ref kodi::addon::CInstanceInputStream::DemuxRead(), ahead of playback.
+    INPUTSTREAM_SUPPORTS_DEMUX_BATCH = (1 << 7),
   };
   ///@}
   //----------------------------------------------------------------------------
@@ -692,6 +698,11 @@ extern "C"
     bool(__cdecl* seek_chapter)(const struct AddonInstance_InputStream* instance, int ch);
 
     int(__cdecl* block_size_stream)(const struct AddonInstance_InputStream* instance);
+
+    // IDemux, appended to keep the layout for add-ons built against older versions
+    int(__cdecl* demux_read_batch)(const struct AddonInstance_InputStream* instance,
+                                   struct DEMUX_PACKET** packets,
+                                   int max_packets);
   } KodiToAddonFuncTable_InputStream;
 
   typedef struct AddonInstance_InputStream /* internal */
@@ -356,6 +356,7 @@ extern "C"
     //--==----==----==----==----==----==----==----==----==----==----==----==----==
     // New functions becomes added below and can be on another API change (where
     // breaks min API version) moved up.
+    int(__cdecl* DemuxReadBatch)(const struct AddonInstance_PVR*, struct DEMUX_PACKET**, int);
   } KodiToAddonFuncTable_PVR;
 
   typedef struct AddonInstance_PVR
@@ -374,6 +374,9 @@ extern "C"
 
     unsigned int iRecordingsLifetimesSize;
     struct PVR_ATTRIBUTE_INT_VALUE* recordingsLifetimeValues;
+
+    // appended to keep the layout for add-ons built against older versions
+    bool bSupportsDemuxBatch;
   } PVR_ADDON_CAPABILITIES;
 
   /*!
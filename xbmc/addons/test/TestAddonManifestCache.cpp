@@ -0,0 +1,254 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/addoninfo/AddonInfo.h"
+#include "addons/addoninfo/AddonManifestCache.h"
+#include "addons/addoninfo/AddonType.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace ADDON;
+using namespace XFILE;
+
+namespace
+{
+std::string AddonXML(const std::string& id, const std::string& version)
+{
+  return StringUtils::Format(R"xml(
+<addon id="{}" name="Test add-on {}" version="{}" provider-name="Team Kodi">
+  <requires>
+    <import addon="xbmc.python" version="3.0.0"/>
+    <import addon="script.module.requests" minversion="2.0.0" version="2.22.0" optional="true"/>
+  </requires>
+  <extension point="xbmc.python.script" library="default.py">
+    <provides>video audio</provides>
+  </extension>
+  <extension point="xbmc.service" library="service.py" start="login"/>
+  <extension point="kodi.addon.metadata">
+    <summary lang="en_GB">Summary</summary>
+    <description lang="en_GB">Description</description>
+    <platform>all</platform>
+    <license>GPL-2.0-or-later</license>
+    <assets>
+      <icon>resources/icon.png</icon>
+    </assets>
+  </extension>
+</addon>
+)xml",
+                             id, id, version);
+}
+
+bool WriteFile(const std::string& path, const std::string& content)
+{
+  CFile file;
+  return file.OpenForWrite(path, true) && file.Write(content.data(), content.size()) ==
+                                              static_cast<ssize_t>(content.size());
+}
+} // unnamed namespace
+
+class TestAddonManifestCache : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_root = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                       "TestAddonManifestCache");
+    URIUtils::AddSlashAtEnd(m_root);
+    ASSERT_TRUE(CDirectory::Create(m_root));
+    m_cacheFile = URIUtils::AddFileToFolder(m_root, "addonmanifests.cache");
+    m_addonPath = CreateAddon("script.test");
+  }
+
+  void TearDown() override { CDirectory::RemoveRecursive(m_root); }
+
+  std::string CreateAddon(const std::string& id, const std::string& version = "1.0.0")
+  {
+    const std::string path = URIUtils::AddFileToFolder(m_root, id);
+    EXPECT_TRUE(CDirectory::Create(URIUtils::AddFileToFolder(path, "resources")));
+    EXPECT_TRUE(WriteFile(URIUtils::AddFileToFolder(path, "addon.xml"), AddonXML(id, version)));
+    return path;
+  }
+
+  // a cache as on the next start, loaded from the file the last one saved
+  AddonInfoPtr GenerateAndSave(CAddonManifestCache& cache, const std::string& path)
+  {
+    AddonInfoPtr info = cache.Generate(path);
+    cache.Save();
+    return info;
+  }
+
+  std::string m_root;
+  std::string m_cacheFile;
+  std::string m_addonPath;
+};
+
+TEST_F(TestAddonManifestCache, Hit)
+{
+  CAddonManifestCache first(m_cacheFile);
+  const AddonInfoPtr parsed = GenerateAndSave(first, m_addonPath);
+  ASSERT_NE(nullptr, parsed);
+  EXPECT_EQ(0u, first.GetHits());
+  EXPECT_EQ(1u, first.GetMisses());
+
+  CAddonManifestCache second(m_cacheFile);
+  const AddonInfoPtr cached = second.Generate(m_addonPath);
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(1u, second.GetHits());
+  EXPECT_EQ(0u, second.GetMisses());
+
+  // the information loaded from the cache matches the parsed one
+  EXPECT_EQ(parsed->ID(), cached->ID());
+  EXPECT_EQ(parsed->Name(), cached->Name());
+  EXPECT_EQ(parsed->Version(), cached->Version());
+  EXPECT_EQ(parsed->MainType(), cached->MainType());
+  EXPECT_EQ(parsed->Path(), cached->Path());
+  EXPECT_EQ(parsed->Icon(), cached->Icon());
+  EXPECT_EQ(parsed->License(), cached->License());
+  EXPECT_EQ(parsed->Summary(), cached->Summary());
+  EXPECT_EQ(parsed->Description(), cached->Description());
+  EXPECT_EQ(parsed->ExtraInfo(), cached->ExtraInfo());
+
+  ASSERT_EQ(parsed->Types().size(), cached->Types().size());
+  for (size_t i = 0; i < parsed->Types().size(); ++i)
+  {
+    const CAddonType& type = parsed->Types()[i];
+    EXPECT_EQ(type.Type(), cached->Types()[i].Type());
+    EXPECT_EQ(type.LibName(), cached->Types()[i].LibName());
+    EXPECT_EQ(type.ProvidedSubContents(), cached->Types()[i].ProvidedSubContents());
+    EXPECT_EQ(type.GetValue("start").asString(), cached->Types()[i].GetValue("start").asString());
+  }
+  EXPECT_TRUE(cached->Type(AddonType::SCRIPT)->ProvidesSubContent(AddonType::VIDEO));
+
+  ASSERT_EQ(parsed->GetDependencies().size(), cached->GetDependencies().size());
+  for (size_t i = 0; i < parsed->GetDependencies().size(); ++i)
+  {
+    const DependencyInfo& dependency = parsed->GetDependencies()[i];
+    EXPECT_EQ(dependency.id, cached->GetDependencies()[i].id);
+    EXPECT_EQ(dependency.versionMin, cached->GetDependencies()[i].versionMin);
+    EXPECT_EQ(dependency.version, cached->GetDependencies()[i].version);
+    EXPECT_EQ(dependency.optional, cached->GetDependencies()[i].optional);
+  }
+}
+
+TEST_F(TestAddonManifestCache, Miss)
+{
+  CAddonManifestCache first(m_cacheFile);
+  ASSERT_NE(nullptr, GenerateAndSave(first, m_addonPath));
+
+  // an add-on installed since the last start
+  CAddonManifestCache second(m_cacheFile);
+  const std::string newPath = CreateAddon("script.test.new");
+  const AddonInfoPtr info = second.Generate(newPath);
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ("script.test.new", info->ID());
+  EXPECT_EQ(0u, second.GetHits());
+  EXPECT_EQ(1u, second.GetMisses());
+
+  // a folder without add-on
+  const std::string emptyPath = URIUtils::AddFileToFolder(m_root, "empty");
+  ASSERT_TRUE(CDirectory::Create(emptyPath));
+  EXPECT_EQ(nullptr, second.Generate(emptyPath));
+
+  // an invalid add-on is cached as such
+  const std::string invalidPath = URIUtils::AddFileToFolder(m_root, "invalid");
+  ASSERT_TRUE(CDirectory::Create(invalidPath));
+  ASSERT_TRUE(WriteFile(URIUtils::AddFileToFolder(invalidPath, "addon.xml"), "<addon/>"));
+  EXPECT_EQ(nullptr, GenerateAndSave(second, invalidPath));
+
+  CAddonManifestCache third(m_cacheFile);
+  EXPECT_EQ(nullptr, third.Generate(invalidPath));
+  EXPECT_EQ(1u, third.GetHits());
+}
+
+TEST_F(TestAddonManifestCache, Invalidation)
+{
+  CAddonManifestCache first(m_cacheFile);
+  AddonInfoPtr info = GenerateAndSave(first, m_addonPath);
+  ASSERT_NE(nullptr, info);
+  EXPECT_TRUE(info->ChangeLog().empty());
+  EXPECT_FALSE(info->SupportsAddonSettings());
+
+  // a changelog.txt replaces the missing news
+  ASSERT_TRUE(WriteFile(URIUtils::AddFileToFolder(m_addonPath, "changelog.txt"), "v1.0.0"));
+  CAddonManifestCache second(m_cacheFile);
+  info = GenerateAndSave(second, m_addonPath);
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ(1u, second.GetMisses());
+  EXPECT_EQ("v1.0.0", info->ChangeLog());
+
+  // settings added to the resources
+  ASSERT_TRUE(WriteFile(URIUtils::AddFileToFolder(m_addonPath, "resources", "settings.xml"),
+                        "<settings version=\"1\"/>"));
+  CAddonManifestCache third(m_cacheFile);
+  info = GenerateAndSave(third, m_addonPath);
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ(1u, third.GetMisses());
+  EXPECT_TRUE(info->SupportsAddonSettings());
+
+  // an update of the add-on
+  ASSERT_TRUE(WriteFile(URIUtils::AddFileToFolder(m_addonPath, "addon.xml"),
+                        AddonXML("script.test", "1.0.10")));
+  CAddonManifestCache fourth(m_cacheFile);
+  info = GenerateAndSave(fourth, m_addonPath);
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ(1u, fourth.GetMisses());
+  EXPECT_EQ(CAddonVersion("1.0.10"), info->Version());
+
+  // the add-on is removed
+  ASSERT_TRUE(CFile::Delete(URIUtils::AddFileToFolder(m_addonPath, "addon.xml")));
+  CAddonManifestCache fifth(m_cacheFile);
+  EXPECT_EQ(nullptr, fifth.Generate(m_addonPath));
+
+  // unchanged since the last start
+  ASSERT_TRUE(WriteFile(URIUtils::AddFileToFolder(m_addonPath, "addon.xml"),
+                        AddonXML("script.test", "1.0.10")));
+  CAddonManifestCache sixth(m_cacheFile);
+  ASSERT_NE(nullptr, GenerateAndSave(sixth, m_addonPath));
+  CAddonManifestCache seventh(m_cacheFile);
+  info = seventh.Generate(m_addonPath);
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ(1u, seventh.GetHits());
+  EXPECT_EQ("v1.0.0", info->ChangeLog());
+  EXPECT_TRUE(info->SupportsAddonSettings());
+}
+
+// Add-on discovery of a start without cache vs. one with the cache of the last start, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestAddonManifestCache.DISABLED_Benchmark
+TEST_F(TestAddonManifestCache, DISABLED_Benchmark)
+{
+  constexpr int ADDONS = 500;
+  std::vector<std::string> paths;
+  for (int i = 0; i < ADDONS; ++i)
+    paths.emplace_back(CreateAddon("script.test." + std::to_string(i)));
+
+  auto measure = [&paths, this]()
+  {
+    CAddonManifestCache cache(m_cacheFile);
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::string& path : paths)
+      EXPECT_NE(nullptr, cache.Generate(path));
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    cache.Save();
+    return elapsed.count();
+  };
+
+  const double cold = measure();
+  const double warm = measure();
+  std::cout << "Add-on discovery, " << ADDONS << " add-ons: cold " << cold << " ms, warm " << warm
+            << " ms" << std::endl;
+}
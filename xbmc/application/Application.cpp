@@ -134,6 +134,7 @@
 #include "utils/CharsetConverter.h"
 #include "utils/ContentUtils.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/FrameTracer.h"
 #include "utils/JobManager.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/PlayerUtils.h"
@@ -800,6 +801,8 @@ bool CApplication::OnSettingsSaving() const
 
 void CApplication::Render()
 {
+  FRAME_TRACE_SCOPE("CApplication::Render");
+
   // do not render if we are stopped or in background
   if (m_bStop)
     return;
@@ -1774,6 +1777,8 @@ void CApplication::UnlockFrameMoveGuard()
 
 void CApplication::FrameMove(bool processEvents, bool processGUI)
 {
+  FRAME_TRACE_SCOPE("CApplication::FrameMove");
+
   const auto appPlayer = GetComponent<CApplicationPlayer>();
   bool renderGUI = GetComponent<CApplicationPowerHandling>()->GetRenderGUI();
   if (processEvents)
@@ -3200,6 +3205,8 @@ void CApplication::ConfigureAndEnableAddons()
 
 void CApplication::Process()
 {
+  FRAME_TRACE_SCOPE("CApplication::Process");
+
   // dispatch the messages generated by python or other threads to the current window
   CServiceBroker::GetGUI()->GetWindowManager().DispatchThreadMessages();
 
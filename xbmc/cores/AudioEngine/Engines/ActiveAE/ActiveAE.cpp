@@ -20,6 +20,7 @@
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/FrameTracer.h"
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 
@@ -1895,6 +1896,8 @@ void CActiveAE::UnconfigureSink()
 
 bool CActiveAE::RunStages()
 {
+  FRAME_TRACE_SCOPE("CActiveAE::RunStages");
+
   bool busy = false;
 
   // serve input streams
@@ -132,19 +132,21 @@ void CAEBitstreamPacker::PackDTSHD(CAEStreamInfo &info, uint8_t* data, int size)
   static const uint8_t dtshd_start_code[10] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xfe };
   unsigned int dataSize = sizeof(dtshd_start_code) + 2 + size;
 
-  if (dataSize > m_dtsHDSize)
+  if (dataSize > MAX_IEC61937_PACKET - IEC61937_DATA_OFFSET)
   {
-    m_dtsHDSize = dataSize;
-    m_dtsHD.resize(dataSize);
-    memcpy(m_dtsHD.data(), dtshd_start_code, sizeof(dtshd_start_code));
+    CLog::Log(LOGERROR, "CAEBitstreamPacker::PackDTSHD - frame too large ({} bytes)", size);
+    m_dataSize = 0;
+    return;
   }
 
-  m_dtsHD[sizeof(dtshd_start_code) + 0] = ((uint16_t)size & 0xFF00) >> 8;
-  m_dtsHD[sizeof(dtshd_start_code) + 1] = ((uint16_t)size & 0x00FF);
-  memcpy(m_dtsHD.data() + sizeof(dtshd_start_code) + 2, data, size);
+  // assemble the payload in place and have it packed there, rather than in a buffer of its own
+  uint8_t* payload = m_packedBuffer + IEC61937_DATA_OFFSET;
+  memcpy(payload, dtshd_start_code, sizeof(dtshd_start_code));
+  payload[sizeof(dtshd_start_code) + 0] = ((uint16_t)size & 0xFF00) >> 8;
+  payload[sizeof(dtshd_start_code) + 1] = ((uint16_t)size & 0x00FF);
+  memcpy(payload + sizeof(dtshd_start_code) + 2, data, size);
 
-  m_dataSize =
-      CAEPackIEC61937::PackDTSHD(m_dtsHD.data(), dataSize, m_packedBuffer, info.m_dtsPeriod);
+  m_dataSize = CAEPackIEC61937::PackDTSHD(nullptr, dataSize, m_packedBuffer, info.m_dtsPeriod);
 }
 
 void CAEBitstreamPacker::PackEAC3(CAEStreamInfo &info, uint8_t* data, int size)
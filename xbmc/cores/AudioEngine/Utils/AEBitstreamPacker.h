@@ -35,9 +35,6 @@ private:
   void PackDTSHD(CAEStreamInfo &info, uint8_t* data, int size);
   void PackEAC3(CAEStreamInfo &info, uint8_t* data, int size);
 
-  std::vector<uint8_t> m_dtsHD;
-  unsigned int m_dtsHDSize = 0;
-
   std::vector<uint8_t> m_eac3;
   unsigned int m_eac3Size = 0;
   unsigned int m_eac3FramesCount = 0;
@@ -8,6 +8,8 @@
 
 #include "AEPackIEC61937.h"
 
+#include "utils/EndianSwap.h"
+
 #include <cassert>
 #include <string.h>
 
@@ -16,8 +18,8 @@
 
 inline void SwapEndian(uint16_t *dst, uint16_t *src, unsigned int size)
 {
-  for (unsigned int i = 0; i < size; ++i, ++dst, ++src)
-    *dst = ((*src & 0xFF00) >> 8) | ((*src & 0x00FF) << 8);
+  // vectorized where the CPU supports it
+  Endian_Swap16_buf(dst, src, size);
 }
 
 int CAEPackIEC61937::PackAC3(uint8_t *data, unsigned int size, uint8_t *dest)
@@ -164,22 +164,25 @@ bool CPackerMAT::PackTrueHD(const uint8_t* data, int size)
   return !m_outputQueue.empty();
 }
 
-std::vector<uint8_t> CPackerMAT::GetOutputFrame()
+bool CPackerMAT::GetOutputFrame(std::vector<uint8_t>& frame)
 {
-  std::vector<uint8_t> buffer;
-
   if (m_outputQueue.empty())
-    return {};
+    return false;
+
+  std::swap(frame, m_outputQueue.front());
 
-  buffer = std::move(m_outputQueue.front());
+  // every byte of a MAT frame gets written, so the buffer of a previous frame can be reused as is
+  if (m_outputQueue.front().size() == MAT_BUFFER_SIZE)
+    m_freeBuffers.emplace_back(std::move(m_outputQueue.front()));
 
   m_outputQueue.pop_front();
 
-  return buffer;
+  return true;
 }
 
 void CPackerMAT::WriteHeader()
 {
+  // a no-op for a reused buffer, only a new buffer is allocated and zeroed
   m_buffer.resize(MAT_BUFFER_SIZE);
 
   // reserve size for the IEC header and the MAT start code
@@ -218,8 +221,7 @@ void CPackerMAT::WritePadding()
   if (m_state.padding == 0)
     return;
 
-  // for padding not writes any data (nullptr) as buffer is already zeroed
-  // only counts/skip bytes
+  // for padding not writes any data (nullptr), it's zeroed when appended
   const int remaining = FillDataBuffer(nullptr, m_state.padding, Type::PADDING);
 
   // not all padding could be written to the buffer, write it later
@@ -239,9 +241,11 @@ void CPackerMAT::WritePadding()
 
 void CPackerMAT::AppendData(const uint8_t* data, int size, Type type)
 {
-  // for padding not write anything, only skip bytes
+  // the buffer may be reused, so padding has to be zeroed
   if (type == Type::DATA)
     memcpy(m_buffer.data() + m_bufferCount, data, size);
+  else
+    memset(m_buffer.data() + m_bufferCount, 0, size);
 
   m_state.matFramesize += size;
   m_bufferCount += size;
@@ -317,5 +321,10 @@ void CPackerMAT::FlushPacket()
   m_outputQueue.emplace_back(std::move(m_buffer));
 
   m_buffer.clear();
+  if (!m_freeBuffers.empty())
+  {
+    m_buffer = std::move(m_freeBuffers.back());
+    m_freeBuffers.pop_back();
+  }
   m_bufferCount = 0;
 }
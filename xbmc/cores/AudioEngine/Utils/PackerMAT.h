@@ -25,7 +25,14 @@ public:
   ~CPackerMAT() = default;
 
   bool PackTrueHD(const uint8_t* data, int size);
-  std::vector<uint8_t> GetOutputFrame();
+
+  /*!
+   * @brief Get the next MAT frame packed.
+   * @param frame Receives the frame. The buffer it held before is reused for the frames to come,
+   * so it must not be used any more.
+   * @return True if a frame was available, false otherwise.
+   */
+  bool GetOutputFrame(std::vector<uint8_t>& frame);
 
 private:
   struct MATState
@@ -63,4 +70,5 @@ private:
   uint32_t m_bufferCount{0};
   std::vector<uint8_t> m_buffer;
   std::deque<std::vector<uint8_t>> m_outputQueue;
+  std::vector<std::vector<uint8_t>> m_freeBuffers; // frames handed back, for reuse
 };
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEBitstreamPacker.h"
+#include "cores/AudioEngine/Utils/AEPackIEC61937.h"
+#include "cores/AudioEngine/Utils/AEStreamInfo.h"
+#include "cores/AudioEngine/Utils/PackerMAT.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// The expected hashes were taken from the scalar packers, the output has to stay bit-exact.
+namespace
+{
+// TrueHD access units at 48 kHz, only the fields read by the MAT packer are real
+std::vector<std::vector<uint8_t>> CreateTrueHDUnits(int count)
+{
+  std::vector<std::vector<uint8_t>> units;
+  uint32_t random = 12345;
+  uint16_t frameTime = 1000;
+
+  for (int i = 0; i < count; ++i)
+  {
+    random = random * 1103515245 + 12345;
+    std::vector<uint8_t> unit(600 + ((random >> 16) % 900) * 2);
+    for (size_t j = 0; j < unit.size(); ++j)
+      unit[j] = static_cast<uint8_t>((random >> 8) + j * 7);
+
+    // a gap in the input timing, which has to be padded
+    frameTime += (i == 100) ? 80 : 40;
+    unit[2] = frameTime >> 8;
+    unit[3] = frameTime & 0xFF;
+
+    if (i % 8 == 0)
+    {
+      const uint8_t majorSync[] = {0xF8, 0x72, 0x6F, 0xBA, 0x00};
+      std::memcpy(unit.data() + 4, majorSync, sizeof(majorSync));
+    }
+    units.emplace_back(std::move(unit));
+  }
+  return units;
+}
+
+std::vector<uint8_t> CreateFrame(unsigned int size, uint8_t seed)
+{
+  std::vector<uint8_t> frame(size);
+  for (unsigned int i = 0; i < size; ++i)
+    frame[i] = static_cast<uint8_t>(seed + i * 13 + (i >> 8));
+  return frame;
+}
+
+// FNV-1a
+uint64_t Hash(const uint8_t* data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+  for (size_t i = 0; i < size; ++i)
+    hash = (hash ^ data[i]) * 1099511628211ULL;
+  return hash;
+}
+
+std::vector<std::vector<uint8_t>> PackMAT(const std::vector<std::vector<uint8_t>>& units)
+{
+  CPackerMAT packer;
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<uint8_t> frame;
+
+  for (const auto& unit : units)
+  {
+    if (!packer.PackTrueHD(unit.data(), static_cast<int>(unit.size())))
+      continue;
+
+    while (packer.GetOutputFrame(frame))
+      frames.emplace_back(frame);
+  }
+  return frames;
+}
+} // namespace
+
+#ifndef __BIG_ENDIAN__
+TEST(TestAEPackIEC61937, PackAC3)
+{
+  uint8_t dest[MAX_IEC61937_PACKET];
+  std::vector<uint8_t> frame = CreateFrame(1000, 1);
+  const int size = CAEPackIEC61937::PackAC3(frame.data(), frame.size(), dest);
+  ASSERT_EQ(6144, size);
+  EXPECT_EQ(0xa634b42487ef6504ULL, Hash(dest, size));
+}
+
+TEST(TestAEPackIEC61937, PackEAC3)
+{
+  uint8_t dest[MAX_IEC61937_PACKET];
+  std::vector<uint8_t> frame = CreateFrame(3000, 2);
+  const int size = CAEPackIEC61937::PackEAC3(frame.data(), frame.size(), dest);
+  ASSERT_EQ(24576, size);
+  EXPECT_EQ(0x578a601d889170a2ULL, Hash(dest, size));
+}
+
+TEST(TestAEPackIEC61937, PackDTS)
+{
+  uint8_t dest[MAX_IEC61937_PACKET];
+  std::vector<uint8_t> frame = CreateFrame(1000, 3);
+  int size = CAEPackIEC61937::PackDTS_512(frame.data(), frame.size(), dest, false);
+  ASSERT_EQ(2048, size);
+  EXPECT_EQ(0xd849546a8fd59fe4ULL, Hash(dest, size));
+
+  frame = CreateFrame(1000, 4);
+  size = CAEPackIEC61937::PackDTS_512(frame.data(), frame.size(), dest, true);
+  ASSERT_EQ(2048, size);
+  EXPECT_EQ(0x9cf5a305a8939fa4ULL, Hash(dest, size));
+}
+
+TEST(TestAEPackIEC61937, PackDTSHD)
+{
+  uint8_t dest[MAX_IEC61937_PACKET];
+  std::vector<uint8_t> frame = CreateFrame(5000, 5);
+  const int size = CAEPackIEC61937::PackDTSHD(frame.data(), frame.size(), dest, 2048);
+  ASSERT_EQ(8192, size);
+  EXPECT_EQ(0x5f564f4d36d81c48ULL, Hash(dest, size));
+}
+
+TEST(TestAEPackIEC61937, BitstreamPackerDTSHD)
+{
+  CAEBitstreamPacker packer;
+  CAEStreamInfo info;
+  info.m_type = CAEStreamInfo::STREAM_TYPE_DTSHD_MA;
+  info.m_dtsPeriod = 2048;
+
+  std::vector<uint8_t> frame = CreateFrame(5000, 6);
+  packer.Pack(info, frame.data(), frame.size());
+  ASSERT_EQ(8192u, packer.GetSize());
+  EXPECT_EQ(0x4e3f66f8fb3312f6ULL, Hash(packer.GetBuffer(), packer.GetSize()));
+}
+
+TEST(TestAEPackIEC61937, PackMAT)
+{
+  const std::vector<std::vector<uint8_t>> frames = PackMAT(CreateTrueHDUnits(400));
+  ASSERT_EQ(16u, frames.size());
+
+  uint64_t hash = 14695981039346656037ULL;
+  for (const auto& frame : frames)
+  {
+    ASSERT_EQ(61440u, frame.size());
+    hash = Hash(frame.data(), frame.size(), hash);
+  }
+  EXPECT_EQ(0x6695b2d1d311eb09ULL, hash);
+
+  // and as the sink packs it
+  uint8_t dest[MAX_IEC61937_PACKET];
+  const int size = CAEPackIEC61937::PackTrueHD(frames[0].data() + IEC61937_DATA_OFFSET,
+                                               frames[0].size() - IEC61937_DATA_OFFSET, dest);
+  ASSERT_EQ(61440, size);
+  EXPECT_EQ(0x5624648b6e1006b4ULL, Hash(dest, size));
+}
+#endif
+
+// Bytes per second packed for TrueHD and E-AC3 passthrough, run with --gtest_also_run_disabled_tests
+// --gtest_filter=TestAEPackIEC61937.DISABLED_Benchmark
+TEST(TestAEPackIEC61937, DISABLED_Benchmark)
+{
+  constexpr int ROUNDS = 50;
+  const std::vector<std::vector<uint8_t>> units = CreateTrueHDUnits(2400);
+
+  // what the codec and the sink do for TrueHD
+  uint8_t dest[MAX_IEC61937_PACKET];
+  CPackerMAT packer;
+  std::vector<uint8_t> frame;
+  size_t trueHDBytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; ++i)
+  {
+    for (const auto& unit : units)
+    {
+      if (packer.PackTrueHD(unit.data(), static_cast<int>(unit.size())) &&
+          packer.GetOutputFrame(frame))
+        trueHDBytes += CAEPackIEC61937::PackTrueHD(frame.data() + IEC61937_DATA_OFFSET,
+                                                   frame.size() - IEC61937_DATA_OFFSET, dest);
+    }
+  }
+  const std::chrono::duration<double> trueHDElapsed = std::chrono::steady_clock::now() - start;
+
+  const std::vector<uint8_t> eac3 = CreateFrame(6000, 7);
+  size_t eac3Bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS * 100; ++i)
+    eac3Bytes += CAEPackIEC61937::PackEAC3(const_cast<uint8_t*>(eac3.data()), eac3.size(), dest);
+  const std::chrono::duration<double> eac3Elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "TrueHD: " << trueHDBytes / trueHDElapsed.count() / 1000000
+            << " MB/s, E-AC3: " << eac3Bytes / eac3Elapsed.count() / 1000000 << " MB/s"
+            << std::endl;
+}
@@ -195,9 +195,9 @@ bool CDVDAudioCodecPassthrough::AddData(const DemuxPacket &packet)
     }
     else // IEC
     {
-      if (m_packerMAT->PackTrueHD(m_buffer, m_dataSize))
+      if (m_packerMAT->PackTrueHD(m_buffer, m_dataSize) &&
+          m_packerMAT->GetOutputFrame(m_trueHDBuffer))
       {
-        m_trueHDBuffer = m_packerMAT->GetOutputFrame();
         m_dataSize = TRUEHD_BUF_SIZE;
       }
       else
@@ -419,6 +419,18 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     m_pCodecContext->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
   }
 
+  // thumbnails only need a single picture, skip everything that isn't required to decode it
+  if (hints.codecOptions & CODEC_KEYFRAMES_ONLY)
+  {
+    m_pCodecContext->skip_frame = AVDISCARD_NONKEY;
+    m_pCodecContext->skip_loop_filter = AVDISCARD_ALL;
+    m_pCodecContext->flags2 |= AV_CODEC_FLAG2_FAST;
+    int lowres = 0;
+    while (lowres < pCodec->max_lowres && (hints.width >> (lowres + 1)) >= 960)
+      lowres++;
+    m_pCodecContext->lowres = lowres;
+  }
+
   // set any special options
   for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
   {
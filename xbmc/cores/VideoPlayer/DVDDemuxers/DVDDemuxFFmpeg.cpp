@@ -14,6 +14,7 @@
 #include "DVDInputStreams/DVDInputStreamBluray.h"
 #endif
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
+#include "DemuxProbeCache.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "Util.h"
@@ -34,9 +35,11 @@
 #include "utils/URIUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
+#include "video/VideoDatabase.h"
 
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <tuple>
 #include <utility>
@@ -484,26 +487,40 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
-    CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
-    int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
-    if (iErr < 0)
+    // transport streams are probed again on reopen, see below. Only playback is cached,
+    // the file info of thumbnail and stream details extraction is read once
+    std::optional<CDemuxProbeCache> probeCache;
+    if (!m_checkTransportStream && !fileinfo)
+      probeCache.emplace(*m_pInput);
+
+    if (!probeCache || !probeCache->Apply(m_pFormatContext))
     {
-      CLog::Log(LOGWARNING, "could not find codec parameters for {}", CURL::GetRedacted(strFile));
-      if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) ||
-          m_pInput->IsStreamType(DVDSTREAM_TYPE_BLURAY) ||
-          (m_pFormatContext->nb_streams == 1 &&
-           m_pFormatContext->streams[0]->codecpar->codec_id == AV_CODEC_ID_AC3) ||
-          m_checkTransportStream)
+      CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
+      int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+      if (iErr < 0)
       {
-        // special case, our codecs can still handle it.
+        CLog::Log(LOGWARNING, "could not find codec parameters for {}",
+                  CURL::GetRedacted(strFile));
+        if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) ||
+            m_pInput->IsStreamType(DVDSTREAM_TYPE_BLURAY) ||
+            (m_pFormatContext->nb_streams == 1 &&
+             m_pFormatContext->streams[0]->codecpar->codec_id == AV_CODEC_ID_AC3) ||
+            m_checkTransportStream)
+        {
+          // special case, our codecs can still handle it.
+        }
+        else
+        {
+          Dispose();
+          return false;
+        }
       }
-      else
+      else if (probeCache)
       {
-        Dispose();
-        return false;
+        probeCache->Store(m_pFormatContext);
       }
+      CLog::Log(LOGDEBUG, "{} - av_find_stream_info finished", __FUNCTION__);
     }
-    CLog::Log(LOGDEBUG, "{} - av_find_stream_info finished", __FUNCTION__);
 
     // print some extra information
     av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(strFile).c_str(), 0);
@@ -603,14 +620,104 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     m_pFormatContext->duration = duration;
   }
 
+  if (!m_keyframeIndex)
+    OpenKeyframeIndex();
+
   return true;
 }
 
+void CDVDDemuxFFmpeg::OpenKeyframeIndex()
+{
+  // byte positions stay valid for plain files only
+  if (!m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) || m_pInput->IsRealtime() || !m_ioContext ||
+      !m_ioContext->seekable || (m_pFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK))
+    return;
+
+  // formats with an index of their own seek well already
+  if (strcmp(m_pFormatContext->iformat->name, "mpegts") != 0)
+  {
+    bool hasVideo = false;
+    for (unsigned int i = 0; i < m_pFormatContext->nb_streams; ++i)
+    {
+      const AVStream* st = m_pFormatContext->streams[i];
+      if (st->codecpar->codec_type != AVMEDIA_TYPE_VIDEO ||
+          (st->disposition & AV_DISPOSITION_ATTACHED_PIC))
+        continue;
+      if (avformat_index_get_entries_count(st) > 0)
+        return;
+      hasVideo = true;
+    }
+    if (!hasVideo)
+      return;
+  }
+
+  const std::string path = m_pInput->GetFileName();
+  struct __stat64 buffer = {};
+  if (URIUtils::IsInternetStream(path) || XFILE::CFile::Stat(path, &buffer) != 0)
+    return;
+
+  m_keyframeIndex = std::make_unique<CKeyframeIndex>();
+  m_keyframeIndexStream = -1;
+  m_keyframeIndexFile = path;
+  m_keyframeIndexFileSize = static_cast<int64_t>(buffer.st_size);
+  m_keyframeIndexFileTime = static_cast<int64_t>(buffer.st_mtime);
+
+  CVideoDatabase db;
+  if (db.Open())
+  {
+    std::string data;
+    if (db.GetKeyframeIndex(path, m_keyframeIndexFileSize, m_keyframeIndexFileTime, data) &&
+        m_keyframeIndex->Deserialize(data))
+      CLog::Log(LOGDEBUG, "{} - loaded seek index with {} keyframes", __FUNCTION__,
+                m_keyframeIndex->Size());
+    db.Close();
+  }
+}
+
+void CDVDDemuxFFmpeg::SaveKeyframeIndex()
+{
+  if (!m_keyframeIndex || !m_keyframeIndex->IsModified())
+    return;
+
+  CVideoDatabase db;
+  if (db.Open())
+  {
+    db.SetKeyframeIndex(m_keyframeIndexFile, m_keyframeIndexFileSize, m_keyframeIndexFileTime,
+                        m_keyframeIndex->Serialize());
+    db.Close();
+  }
+}
+
+void CDVDDemuxFFmpeg::AddKeyframe(const AVStream* stream, const DemuxPacket* packet)
+{
+  if (stream->codecpar->codec_type != AVMEDIA_TYPE_VIDEO ||
+      (stream->disposition & AV_DISPOSITION_ATTACHED_PIC))
+    return;
+
+  // index the first video stream read
+  if (m_keyframeIndexStream < 0)
+    m_keyframeIndexStream = stream->index;
+  else if (m_keyframeIndexStream != stream->index)
+    return;
+
+  const double time = packet->pts != DVD_NOPTS_VALUE ? packet->pts : packet->dts;
+  if (time == DVD_NOPTS_VALUE || m_pkt.pkt.pos < 0)
+  {
+    m_keyframeIndex->Break();
+    return;
+  }
+
+  m_keyframeIndex->Add(DVD_TIME_TO_MSEC(time), m_pkt.pkt.pos);
+}
+
 void CDVDDemuxFFmpeg::Dispose()
 {
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  SaveKeyframeIndex();
+  m_keyframeIndex.reset();
+
   if (m_pFormatContext)
   {
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
@@ -660,6 +767,9 @@ void CDVDDemuxFFmpeg::Flush()
   m_displayTime = 0;
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
   m_seekToKeyFrame = false;
+
+  if (m_keyframeIndex)
+    m_keyframeIndex->Break();
 }
 
 void CDVDDemuxFFmpeg::Abort()
@@ -1085,6 +1195,9 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
 
           CDVDDemuxUtils::StoreSideData(pPacket, &m_pkt.pkt);
 
+          if (m_keyframeIndex && (m_pkt.pkt.flags & AV_PKT_FLAG_KEY))
+            AddKeyframe(stream, pPacket);
+
           CDVDInputStream::IDisplayTime* inputStream = m_pInput->GetIDisplayTime();
           if (inputStream)
           {
@@ -1253,10 +1366,26 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   else if (m_pFormatContext->start_time != (int64_t)AV_NOPTS_VALUE && !ismp3 && !m_bSup)
     seek_pts += m_pFormatContext->start_time;
 
-  int ret;
+  int ret = -1;
   {
     std::unique_lock<CCriticalSection> lock(m_critSection);
-    ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
+    if (m_keyframeIndex)
+    {
+      // go straight to the keyframe if it is known, instead of searching the file
+      CKeyframeIndex::Entry keyframe;
+      m_keyframeIndex->Break();
+      if (m_keyframeIndex->Lookup(static_cast<int64_t>(time), backwards, keyframe))
+      {
+        ret = av_seek_frame(m_pFormatContext, -1, keyframe.pos, AVSEEK_FLAG_BYTE);
+        if (ret >= 0)
+          CLog::Log(LOGDEBUG, "{} - seeking to indexed keyframe at {} ms", __FUNCTION__,
+                    keyframe.time);
+      }
+    }
+
+    if (ret < 0)
+      ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts,
+                          backwards ? AVSEEK_FLAG_BACKWARD : 0);
 
     if (ret < 0)
     {
@@ -1333,6 +1462,8 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_keyframeIndex)
+    m_keyframeIndex->Break();
   int ret = av_seek_frame(m_pFormatContext, -1, pos, AVSEEK_FLAG_BYTE);
 
   if (ret >= 0)
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "KeyframeIndex.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
@@ -142,6 +143,10 @@ protected:
 
   StreamHdrType DetermineHdrType(AVStream* pStream);
 
+  void OpenKeyframeIndex();
+  void SaveKeyframeIndex();
+  void AddKeyframe(const AVStream* stream, const DemuxPacket* packet);
+
   CCriticalSection m_critSection;
   std::map<int, CDemuxStream*> m_streams;
   std::map<int, std::unique_ptr<CDemuxParserFFmpeg>> m_parsers;
@@ -177,5 +182,12 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  // seek index for containers without one, built while reading and kept per file
+  std::unique_ptr<CKeyframeIndex> m_keyframeIndex;
+  int m_keyframeIndexStream = -1;
+  std::string m_keyframeIndexFile;
+  int64_t m_keyframeIndexFileSize = -1;
+  int64_t m_keyframeIndexFileTime = -1;
 };
 
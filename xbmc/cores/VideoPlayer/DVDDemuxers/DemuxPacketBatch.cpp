@@ -0,0 +1,25 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxPacketBatch.h"
+
+#include "DVDDemuxUtils.h"
+
+CDemuxPacketBatch::~CDemuxPacketBatch()
+{
+  Clear();
+}
+
+void CDemuxPacketBatch::Clear()
+{
+  while (m_next < m_count)
+    CDVDDemuxUtils::FreeDemuxPacket(m_packets[m_next++]);
+
+  m_next = 0;
+  m_count = 0;
+}
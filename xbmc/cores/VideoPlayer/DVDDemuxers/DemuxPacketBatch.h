@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+
+struct DemuxPacket;
+
+/*!
+ \brief Packets read from an add-on many at a time, handed out one at a time.
+
+ Reading a batch replaces one call into the add-on per packet by one call per
+ batch. The packets still belong to the demuxer which read them, so they have
+ to be dropped whenever the demuxer is flushed, reset or seeks.
+ */
+class CDemuxPacketBatch
+{
+public:
+  //! the most packets read at once, more packets in flight make allocation slower than calls save
+  static constexpr int MAX_PACKETS = 8;
+
+  CDemuxPacketBatch() = default;
+  ~CDemuxPacketBatch();
+
+  CDemuxPacketBatch(const CDemuxPacketBatch&) = delete;
+  CDemuxPacketBatch& operator=(const CDemuxPacketBatch&) = delete;
+
+  /*! \brief Get the next packet, reading the next batch once all packets were handed out
+   \param readBatch called as int(DemuxPacket** packets, int maxPackets), stores up to
+   maxPackets packets and returns how many it stored
+   \return the packet, or nullptr if the batch read was empty
+   */
+  template<typename F>
+  DemuxPacket* Read(F&& readBatch)
+  {
+    if (m_next == m_count)
+    {
+      m_next = 0;
+      m_count = readBatch(m_packets.data(), MAX_PACKETS);
+      if (m_count < 0 || m_count > MAX_PACKETS)
+        m_count = 0;
+      if (m_count == 0)
+        return nullptr;
+    }
+    return m_packets[m_next++];
+  }
+
+  /*! \brief Free the packets read but not handed out yet
+   */
+  void Clear();
+
+  bool IsEmpty() const { return m_next == m_count; }
+
+private:
+  std::array<DemuxPacket*, MAX_PACKETS> m_packets{};
+  int m_next{0};
+  int m_count{0};
+};
@@ -0,0 +1,264 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxProbeCache.h"
+
+#include "DVDInputStreams/DVDInputStream.h"
+#include "URL.h"
+#include "filesystem/File.h"
+#include "utils/Base64.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+#include "video/VideoDatabase.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+}
+
+namespace
+{
+// bump when the stored parameters change, older entries are probed again
+constexpr int PROBE_CACHE_VERSION = 1;
+
+CVariant RationalToVariant(AVRational value)
+{
+  CVariant result(CVariant::VariantTypeArray);
+  result.push_back(value.num);
+  result.push_back(value.den);
+  return result;
+}
+
+AVRational RationalFromVariant(const CVariant& value)
+{
+  if (!value.isArray() || value.size() != 2)
+    return {0, 1};
+  return {value[0].asInteger32(), value[1].asInteger32(1)};
+}
+
+CVariant StreamToVariant(const AVStream* stream)
+{
+  const AVCodecParameters* par = stream->codecpar;
+
+  CVariant result(CVariant::VariantTypeObject);
+  result["codec_type"] = static_cast<int>(par->codec_type);
+  result["codec_id"] = static_cast<int>(par->codec_id);
+  result["codec_tag"] = par->codec_tag;
+  if (par->extradata && par->extradata_size > 0)
+    result["extradata"] = Base64::Encode(reinterpret_cast<const char*>(par->extradata),
+                                         static_cast<unsigned int>(par->extradata_size));
+  result["format"] = par->format;
+  result["bit_rate"] = par->bit_rate;
+  result["bits_per_coded_sample"] = par->bits_per_coded_sample;
+  result["bits_per_raw_sample"] = par->bits_per_raw_sample;
+  result["profile"] = par->profile;
+  result["level"] = par->level;
+  result["width"] = par->width;
+  result["height"] = par->height;
+  result["sample_aspect_ratio"] = RationalToVariant(par->sample_aspect_ratio);
+  result["field_order"] = static_cast<int>(par->field_order);
+  result["color_range"] = static_cast<int>(par->color_range);
+  result["color_primaries"] = static_cast<int>(par->color_primaries);
+  result["color_trc"] = static_cast<int>(par->color_trc);
+  result["color_space"] = static_cast<int>(par->color_space);
+  result["chroma_location"] = static_cast<int>(par->chroma_location);
+  result["video_delay"] = par->video_delay;
+  result["channels"] = par->ch_layout.nb_channels;
+  if (par->ch_layout.order == AV_CHANNEL_ORDER_NATIVE)
+    result["channel_mask"] = par->ch_layout.u.mask;
+  result["sample_rate"] = par->sample_rate;
+  result["block_align"] = par->block_align;
+  result["frame_size"] = par->frame_size;
+  result["initial_padding"] = par->initial_padding;
+  result["seek_preroll"] = par->seek_preroll;
+
+  result["stream_sample_aspect_ratio"] = RationalToVariant(stream->sample_aspect_ratio);
+  result["r_frame_rate"] = RationalToVariant(stream->r_frame_rate);
+  result["avg_frame_rate"] = RationalToVariant(stream->avg_frame_rate);
+  result["start_time"] = stream->start_time;
+  result["duration"] = stream->duration;
+  return result;
+}
+
+void StreamFromVariant(const CVariant& value, AVStream* stream)
+{
+  AVCodecParameters* par = stream->codecpar;
+
+  par->codec_type = static_cast<AVMediaType>(value["codec_type"].asInteger32());
+  par->codec_id = static_cast<AVCodecID>(value["codec_id"].asInteger32());
+  par->codec_tag = static_cast<uint32_t>(value["codec_tag"].asUnsignedInteger());
+
+  if (value.isMember("extradata"))
+  {
+    const std::string extradata = Base64::Decode(value["extradata"].asString());
+    av_freep(&par->extradata);
+    par->extradata_size = 0;
+    par->extradata =
+        static_cast<uint8_t*>(av_mallocz(extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+    if (par->extradata)
+    {
+      std::memcpy(par->extradata, extradata.data(), extradata.size());
+      par->extradata_size = static_cast<int>(extradata.size());
+    }
+  }
+
+  par->format = value["format"].asInteger32(-1);
+  par->bit_rate = value["bit_rate"].asInteger();
+  par->bits_per_coded_sample = value["bits_per_coded_sample"].asInteger32();
+  par->bits_per_raw_sample = value["bits_per_raw_sample"].asInteger32();
+  par->profile = value["profile"].asInteger32();
+  par->level = value["level"].asInteger32();
+  par->width = value["width"].asInteger32();
+  par->height = value["height"].asInteger32();
+  par->sample_aspect_ratio = RationalFromVariant(value["sample_aspect_ratio"]);
+  par->field_order = static_cast<AVFieldOrder>(value["field_order"].asInteger32());
+  par->color_range = static_cast<AVColorRange>(value["color_range"].asInteger32());
+  par->color_primaries = static_cast<AVColorPrimaries>(value["color_primaries"].asInteger32());
+  par->color_trc = static_cast<AVColorTransferCharacteristic>(value["color_trc"].asInteger32());
+  par->color_space = static_cast<AVColorSpace>(value["color_space"].asInteger32());
+  par->chroma_location = static_cast<AVChromaLocation>(value["chroma_location"].asInteger32());
+  par->video_delay = value["video_delay"].asInteger32();
+
+  av_channel_layout_uninit(&par->ch_layout);
+  if (value.isMember("channel_mask"))
+    av_channel_layout_from_mask(&par->ch_layout, value["channel_mask"].asUnsignedInteger());
+  else if (value["channels"].asInteger32() > 0)
+    av_channel_layout_default(&par->ch_layout, value["channels"].asInteger32());
+
+  par->sample_rate = value["sample_rate"].asInteger32();
+  par->block_align = value["block_align"].asInteger32();
+  par->frame_size = value["frame_size"].asInteger32();
+  par->initial_padding = value["initial_padding"].asInteger32();
+  par->seek_preroll = value["seek_preroll"].asInteger32();
+
+  stream->sample_aspect_ratio = RationalFromVariant(value["stream_sample_aspect_ratio"]);
+  stream->r_frame_rate = RationalFromVariant(value["r_frame_rate"]);
+  stream->avg_frame_rate = RationalFromVariant(value["avg_frame_rate"]);
+  stream->start_time = value["start_time"].asInteger(AV_NOPTS_VALUE);
+  stream->duration = value["duration"].asInteger(AV_NOPTS_VALUE);
+}
+} // unnamed namespace
+
+CDemuxProbeCache::CDemuxProbeCache(CDVDInputStream& input)
+{
+  // only plain files, anything else may change without its size or time changing
+  if (!input.IsStreamType(DVDSTREAM_TYPE_FILE) || input.IsRealtime())
+    return;
+
+  const std::string path = input.GetFileName();
+  if (path.empty() || URIUtils::IsInternetStream(path))
+    return;
+
+  struct __stat64 buffer = {};
+  if (XFILE::CFile::Stat(path, &buffer) != 0 || buffer.st_size <= 0)
+    return;
+
+  m_path = path;
+  m_size = static_cast<int64_t>(buffer.st_size);
+  m_mtime = static_cast<int64_t>(buffer.st_mtime);
+
+  // the database only has files of the library, others are neither looked up nor stored
+  CVideoDatabase db;
+  if (db.Open())
+  {
+    if (!db.GetProbeData(m_path, m_size, m_mtime, m_data))
+      m_data.clear();
+    db.Close();
+  }
+}
+
+bool CDemuxProbeCache::Apply(AVFormatContext* context) const
+{
+  if (m_data.empty())
+    return false;
+
+  CVariant data;
+  if (!CJSONVariantParser::Parse(m_data, data) ||
+      data["version"].asInteger32() != PROBE_CACHE_VERSION)
+    return false;
+
+  // the streams found when opening have to be the ones that were probed, otherwise
+  // the file was replaced without its size or time changing
+  const CVariant& streams = data["streams"];
+  if (!streams.isArray() || streams.size() != context->nb_streams)
+    return false;
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    const AVCodecParameters* par = context->streams[i]->codecpar;
+    const CVariant& stream = streams[i];
+    if (par->codec_type != static_cast<AVMediaType>(stream["codec_type"].asInteger32()) ||
+        (par->codec_id != AV_CODEC_ID_NONE &&
+         par->codec_id != static_cast<AVCodecID>(stream["codec_id"].asInteger32())))
+    {
+      CLog::Log(LOGDEBUG, "CDemuxProbeCache::{} - streams of {} changed, probing", __func__,
+                CURL::GetRedacted(m_path));
+      return false;
+    }
+  }
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+    StreamFromVariant(streams[i], context->streams[i]);
+
+  if (data["duration"].asInteger(AV_NOPTS_VALUE) != AV_NOPTS_VALUE)
+    context->duration = data["duration"].asInteger();
+  if (data["start_time"].asInteger(AV_NOPTS_VALUE) != AV_NOPTS_VALUE)
+    context->start_time = data["start_time"].asInteger();
+  if (data["bit_rate"].asInteger() > 0)
+    context->bit_rate = data["bit_rate"].asInteger();
+
+  CLog::Log(LOGDEBUG, "CDemuxProbeCache::{} - using cached stream info for {}", __func__,
+            CURL::GetRedacted(m_path));
+  return true;
+}
+
+void CDemuxProbeCache::Store(const AVFormatContext* context) const
+{
+  if (m_path.empty())
+    return;
+
+  // streams of these formats are only found while reading, the cache could never be applied
+  if (context->ctx_flags & AVFMTCTX_NOHEADER || context->nb_streams == 0)
+    return;
+
+  const bool hasVideo = std::any_of(context->streams, context->streams + context->nb_streams,
+                                    [](const AVStream* stream)
+                                    {
+                                      return stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO &&
+                                             !(stream->disposition & AV_DISPOSITION_ATTACHED_PIC);
+                                    });
+  if (!hasVideo)
+    return;
+
+  CVariant data(CVariant::VariantTypeObject);
+  data["version"] = PROBE_CACHE_VERSION;
+  data["duration"] = context->duration;
+  data["start_time"] = context->start_time;
+  data["bit_rate"] = context->bit_rate;
+  data["streams"] = CVariant(CVariant::VariantTypeArray);
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+    data["streams"].push_back(StreamToVariant(context->streams[i]));
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(data, json, true) || json == m_data)
+    return;
+
+  CVideoDatabase db;
+  if (db.Open())
+  {
+    db.SetProbeData(m_path, m_size, m_mtime, json);
+    db.Close();
+  }
+}
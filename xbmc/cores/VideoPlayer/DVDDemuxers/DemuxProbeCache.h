@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+struct AVFormatContext;
+class CDVDInputStream;
+
+/*!
+ \brief Cache of the stream parameters found by avformat_find_stream_info.
+
+ Probing the streams of a file reads and decodes the start of every stream,
+ which takes seconds on network shares. The parameters found are stored in
+ the video database, keyed by the path, size and modification time of the
+ file, and used to seed the streams when the file is opened again. Only files
+ with video which are in the library already are cached.
+ */
+class CDemuxProbeCache
+{
+public:
+  /*! \brief Look up the cached parameters of the file read by the input stream
+   \param input the input stream, only plain files of the video library are cached
+   */
+  explicit CDemuxProbeCache(CDVDInputStream& input);
+
+  /*! \brief Set the cached parameters on the streams of an opened format context
+   \return true if the cached parameters match the streams found when opening and the
+   context needs no further probing, false if it has to be probed
+   */
+  bool Apply(AVFormatContext* context) const;
+
+  /*! \brief Store the parameters of a probed format context */
+  void Store(const AVFormatContext* context) const;
+
+private:
+  std::string m_path;
+  int64_t m_size{-1};
+  int64_t m_mtime{-1};
+  std::string m_data;
+};
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "KeyframeIndex.h"
+
+#include "utils/Base64.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+constexpr char MAGIC[] = {'K', 'F', 'I', 1};
+
+// entries are stored as deltas to the previous entry in LEB128 variable length integers,
+// a keyframe takes about 6 bytes for common GOP lengths and bitrates, 8 once base64 encoded
+void WriteVarint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const std::string& in, size_t& offset, uint64_t& value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64 && offset < in.size(); shift += 7)
+  {
+    const uint8_t byte = static_cast<uint8_t>(in[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+uint64_t ZigZagEncode(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool CompareTime(const CKeyframeIndex::Entry& entry, int64_t time)
+{
+  return entry.time < time;
+}
+} // unnamed namespace
+
+void CKeyframeIndex::Add(int64_t time, int64_t pos)
+{
+  if (time < 0 || pos < 0)
+  {
+    Break();
+    return;
+  }
+
+  if (m_lastTime != NO_TIME && time <= m_lastTime)
+  {
+    // e.g. the second field of an interlaced keyframe
+    if (time == m_lastTime)
+      return;
+    // timestamps of a continuous read increase, anything else is a discontinuity
+    Break();
+  }
+
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), time, CompareTime);
+  const bool linked =
+      m_lastTime != NO_TIME && it != m_entries.begin() && std::prev(it)->time == m_lastTime;
+
+  if (it != m_entries.end() && it->time == time)
+  {
+    // known keyframe, reading from the previous one closes the gap between them
+    if (linked && !it->linked)
+    {
+      it->linked = true;
+      m_modified = true;
+    }
+    m_lastTime = time;
+    return;
+  }
+
+  if (m_entries.size() >= MAX_ENTRIES)
+  {
+    Break();
+    return;
+  }
+
+  // the next keyframe can't be known to follow the previous one anymore
+  if (it != m_entries.end())
+    it->linked = false;
+
+  m_entries.insert(it, {time, pos, linked});
+  m_lastTime = time;
+  m_modified = true;
+}
+
+bool CKeyframeIndex::Lookup(int64_t time, bool backwards, Entry& entry) const
+{
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), time, CompareTime);
+  if (it != m_entries.end() && it->time == time)
+  {
+    entry = *it;
+    return true;
+  }
+
+  // the keyframes around time have to be known to be neighbours
+  if (it == m_entries.begin() || it == m_entries.end() || !it->linked)
+    return false;
+
+  entry = backwards ? *std::prev(it) : *it;
+  return true;
+}
+
+std::string CKeyframeIndex::Serialize() const
+{
+  std::string data(MAGIC, sizeof(MAGIC));
+  data.reserve(sizeof(MAGIC) + m_entries.size() * 5);
+  WriteVarint(data, m_entries.size());
+
+  Entry previous{0, 0, false};
+  for (const auto& entry : m_entries)
+  {
+    WriteVarint(data, static_cast<uint64_t>(entry.time - previous.time) << 1 |
+                          (entry.linked ? 1 : 0));
+    WriteVarint(data, ZigZagEncode(entry.pos - previous.pos));
+    previous = entry;
+  }
+
+  // the database stores text, which ends at the first zero byte
+  return Base64::Encode(data);
+}
+
+bool CKeyframeIndex::Deserialize(const std::string& text)
+{
+  m_entries.clear();
+  m_lastTime = NO_TIME;
+  m_modified = false;
+
+  // base64 comes in blocks of 4 characters
+  if (text.size() % 4 != 0)
+    return false;
+
+  const std::string data = Base64::Decode(text);
+  if (data.size() < sizeof(MAGIC) || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+
+  size_t offset = sizeof(MAGIC);
+  uint64_t count;
+  if (!ReadVarint(data, offset, count) || count > MAX_ENTRIES)
+    return false;
+
+  std::vector<Entry> entries;
+  entries.reserve(count);
+  Entry previous{0, 0, false};
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    uint64_t time;
+    uint64_t pos;
+    if (!ReadVarint(data, offset, time) || !ReadVarint(data, offset, pos))
+      return false;
+
+    Entry entry;
+    entry.time = previous.time + static_cast<int64_t>(time >> 1);
+    entry.linked = (time & 1) != 0;
+    entry.pos = previous.pos + ZigZagDecode(pos);
+    if ((i > 0 && entry.time <= previous.time) || entry.pos < 0)
+      return false;
+
+    entries.push_back(entry);
+    previous = entry;
+  }
+
+  if (offset != data.size())
+    return false;
+
+  m_entries = std::move(entries);
+  return true;
+}
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Index of the keyframes of a stream, mapping their time to their byte position.
+
+ Built from the keyframes read while demuxing, for containers without an index
+ of their own (e.g. MPEG-TS, Matroska without cues), where seeking otherwise has
+ to search the file. Playback may jump, so the index records for every keyframe
+ whether it directly follows the previous one. A lookup only succeeds if no
+ keyframe can be missing between the neighbours of the requested time, which
+ makes the result the same as a search of the file would give.
+ */
+class CKeyframeIndex
+{
+public:
+  struct Entry
+  {
+    int64_t time; ///< presentation time in ms
+    int64_t pos; ///< byte position of the packet
+    bool linked; ///< no keyframe exists between the previous entry and this one
+
+    bool operator==(const Entry& other) const = default;
+  };
+
+  //! limits the memory used for very long streams, further keyframes are not added
+  static constexpr size_t MAX_ENTRIES = 200000;
+
+  /*! \brief Add a keyframe read while demuxing
+   \param time presentation time in ms
+   \param pos byte position of the packet
+   */
+  void Add(int64_t time, int64_t pos);
+
+  /*! \brief Mark a discontinuity, e.g. a seek. The next keyframe added does not follow the
+   last one.
+   */
+  void Break() { m_lastTime = NO_TIME; }
+
+  /*! \brief Find the keyframe to seek to
+   \param time time to seek to in ms
+   \param backwards true for the last keyframe at or before time, false for the first keyframe
+   at or after time
+   \param[out] entry the keyframe found
+   \return true if the keyframe is known, false if the index doesn't cover the time
+   */
+  bool Lookup(int64_t time, bool backwards, Entry& entry) const;
+
+  bool IsEmpty() const { return m_entries.empty(); }
+  size_t Size() const { return m_entries.size(); }
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+  /*! \brief Whether keyframes were added since the index was created or loaded */
+  bool IsModified() const { return m_modified; }
+
+  /*! \brief Serialize the index into a compact binary form, base64 encoded to be stored as text */
+  std::string Serialize() const;
+
+  /*! \brief Replace the index by a serialized one
+   \return false if the text is invalid, the index is left empty then
+   */
+  bool Deserialize(const std::string& text);
+
+private:
+  static constexpr int64_t NO_TIME = INT64_MIN;
+
+  std::vector<Entry> m_entries;
+  int64_t m_lastTime{NO_TIME};
+  bool m_modified{false};
+};
@@ -42,10 +42,16 @@
 #include "Util.h"
 #include "cores/FFmpeg.h"
 #include "filesystem/File.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "utils/CPUInfo.h"
 #include "utils/LangCodeExpander.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -93,11 +99,96 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+namespace
+{
+/*!
+ * @brief Limits the extractions running at once, each one keeps a core busy. Extractions wait
+ * for a slot in the order they were requested.
+ *
+ * Waiting blocks the calling thread. Extractions are run by image loading jobs, whose result is
+ * the texture, so there is nothing else the thread could do meanwhile. The job manager caps its
+ * workers per priority, so at most that many threads wait here and jobs of higher priorities
+ * still get workers of their own.
+ */
+class CExtractionSlot
+{
+public:
+  CExtractionSlot()
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    const uint64_t ticket = m_nextTicket++;
+    m_released.wait(lock, [ticket] { return ticket == m_admitted && m_active < GetMaxActive(); });
+    m_admitted++;
+    m_active++;
+    // the next in line may fit as well
+    m_released.notifyAll();
+  }
+
+  ~CExtractionSlot()
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_active--;
+    m_released.notifyAll();
+  }
+
+private:
+  static int GetMaxActive() { return std::max(1, CServiceBroker::GetCPUInfo()->GetCPUCount() / 2); }
+
+  static inline CCriticalSection m_section;
+  static inline XbmcThreads::ConditionVariable m_released;
+  static inline int m_active = 0;
+  static inline uint64_t m_nextTicket = 0;
+  static inline uint64_t m_admitted = 0;
+};
+
+std::unique_ptr<CTexture> PictureToTexture(VideoPicture& picture, const CDVDStreamInfo& hint)
+{
+  unsigned int nWidth =
+      std::min(picture.iDisplayWidth,
+               CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if (hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  std::unique_ptr<CTexture> result = CTexture::CreateTexture(nWidth, nHeight);
+  result->SetAlpha(false);
+  struct SwsContext* context =
+      sws_getContext(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P, nWidth, nHeight,
+                     AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
+
+  if (context)
+  {
+    uint8_t* planes[YuvImage::MAX_PLANES];
+    int stride[YuvImage::MAX_PLANES];
+    picture.videoBuffer->GetPlanes(planes);
+    picture.videoBuffer->GetStrides(stride);
+    uint8_t* src[4] = {planes[0], planes[1], planes[2], 0};
+    int srcStride[] = {stride[0], stride[1], stride[2], 0};
+    uint8_t* dst[] = {result->GetPixels(), 0, 0, 0};
+    int dstStride[] = {static_cast<int>(result->GetPitch()), 0, 0, 0};
+    result->SetOrientation(DegreeToOrientation(hint.orientation));
+    sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+    sws_freeContext(context);
+  }
+  return result;
+}
+} // unnamed namespace
+
 std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& fileItem,
                                                               int chapterNumber)
 {
-  if (!CanExtract(fileItem))
-    return {};
+  return std::move(ExtractThumbsToTextures(fileItem, {chapterNumber}).front());
+}
+
+std::vector<std::unique_ptr<CTexture>> CDVDFileInfo::ExtractThumbsToTextures(
+    const CFileItem& fileItem, const std::vector<int>& chapterNumbers)
+{
+  std::vector<std::unique_ptr<CTexture>> result(chapterNumbers.size());
+  if (!CanExtract(fileItem) || chapterNumbers.empty())
+    return result;
+
+  CExtractionSlot slot;
 
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
   auto start = std::chrono::steady_clock::now();
@@ -108,20 +199,20 @@ std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& f
   if (!pInputStream)
   {
     CLog::Log(LOGERROR, "InputStream: Error creating stream for {}", redactPath);
-    return {};
+    return result;
   }
 
   if (!pInputStream->Open())
   {
     CLog::Log(LOGERROR, "InputStream: Error opening, {}", redactPath);
-    return {};
+    return result;
   }
 
   std::unique_ptr<CDVDDemux> demuxer{CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true)};
   if (!demuxer)
   {
     CLog::LogF(LOGERROR, "Error creating demuxer");
-    return {};
+    return result;
   }
 
   int nVideoStream = -1;
@@ -142,8 +233,8 @@ std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& f
   }
 
   int packetsTried = 0;
+  int thumbs = 0;
 
-  std::unique_ptr<CTexture> result{};
   if (nVideoStream != -1)
   {
     std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
@@ -152,7 +243,8 @@ std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& f
     pProcessInfo->SetPixFormats(pixFmts);
 
     CDVDStreamInfo hint(*demuxer->GetStream(demuxerId, nVideoStream), true);
-    hint.codecOptions = CODEC_FORCE_SOFTWARE;
+    // the picture after a seek is the keyframe seeked to, everything else can be skipped
+    hint.codecOptions = CODEC_FORCE_SOFTWARE | CODEC_KEYFRAMES_ONLY;
 
     std::unique_ptr<CDVDVideoCodec> pVideoCodec =
         CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
@@ -160,16 +252,26 @@ std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& f
     if (pVideoCodec)
     {
       int nTotalLen = demuxer->GetStreamLength();
+      int nChapters = demuxer->GetChapterCount();
 
-      bool seekToChapter = chapterNumber > 0 && demuxer->GetChapterCount() > 0;
-      int64_t nSeekTo =
-          seekToChapter ? demuxer->GetChapterPos(chapterNumber) * 1000 : nTotalLen / 3;
+      for (size_t i = 0; i < chapterNumbers.size(); i++)
+      {
+        const int chapterNumber = chapterNumbers[i];
+        bool seekToChapter = chapterNumber > 0 && nChapters > 0;
+        if (seekToChapter && chapterNumber > nChapters)
+          continue;
 
-      CLog::LogF(LOGDEBUG, "seeking to pos {}ms (total: {}ms) in {}", nSeekTo, nTotalLen,
-                 redactPath);
+        int64_t nSeekTo =
+            seekToChapter ? demuxer->GetChapterPos(chapterNumber) * 1000 : nTotalLen / 3;
+
+        CLog::LogF(LOGDEBUG, "seeking to pos {}ms (total: {}ms) in {}", nSeekTo, nTotalLen,
+                   redactPath);
+
+        if (!demuxer->SeekTime(static_cast<double>(nSeekTo), true))
+          continue;
+
+        pVideoCodec->Reset();
 
-      if (demuxer->SeekTime(static_cast<double>(nSeekTo), true))
-      {
         CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
         VideoPicture picture = {};
 
@@ -208,38 +310,13 @@ std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& f
 
         if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
         {
-          unsigned int nWidth =
-              std::min(picture.iDisplayWidth,
-                       CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-          double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-          if (hint.forced_aspect && hint.aspect != 0)
-            aspect = hint.aspect;
-          unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-          result = CTexture::CreateTexture(nWidth, nHeight);
-          result->SetAlpha(false);
-          struct SwsContext* context =
-              sws_getContext(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P, nWidth, nHeight,
-                             AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-          if (context)
-          {
-            uint8_t* planes[YuvImage::MAX_PLANES];
-            int stride[YuvImage::MAX_PLANES];
-            picture.videoBuffer->GetPlanes(planes);
-            picture.videoBuffer->GetStrides(stride);
-            uint8_t* src[4] = {planes[0], planes[1], planes[2], 0};
-            int srcStride[] = {stride[0], stride[1], stride[2], 0};
-            uint8_t* dst[] = {result->GetPixels(), 0, 0, 0};
-            int dstStride[] = {static_cast<int>(result->GetPitch()), 0, 0, 0};
-            result->SetOrientation(DegreeToOrientation(hint.orientation));
-            sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-            sws_freeContext(context);
-          }
+          result[i] = PictureToTexture(picture, hint);
+          thumbs++;
         }
         else
         {
-          CLog::LogF(LOGDEBUG, "decode failed in {} after {} packets.", redactPath, packetsTried);
+          CLog::LogF(LOGDEBUG, "decode failed in {} after {} packets.", redactPath,
+                     packetsTried);
         }
       }
     }
@@ -247,8 +324,8 @@ std::unique_ptr<CTexture> CDVDFileInfo::ExtractThumbToTexture(const CFileItem& f
 
   auto end = std::chrono::steady_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-  CLog::LogF(LOGDEBUG, "measured {} ms to extract thumb from file <{}> in {} packets. ",
-             duration.count(), redactPath, packetsTried);
+  CLog::LogF(LOGDEBUG, "measured {} ms to extract {} thumbs from file <{}> in {} packets. ",
+             duration.count(), thumbs, redactPath, packetsTried);
 
   return result;
 }
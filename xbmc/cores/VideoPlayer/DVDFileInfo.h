@@ -26,6 +26,15 @@ public:
   static std::unique_ptr<CTexture> ExtractThumbToTexture(const CFileItem& fileItem,
                                                          int chapterNumber = 0);
 
+  /*!
+   * @brief Extract thumbnails of several chapters with a single open of the file. Only the
+   * keyframe a chapter starts at is decoded.
+   * @param chapterNumbers the chapters, 0 for a frame approx 1/3 into the video
+   * @return a texture per chapter, empty if none could be extracted for it
+  */
+  static std::vector<std::unique_ptr<CTexture>> ExtractThumbsToTextures(
+      const CFileItem& fileItem, const std::vector<int>& chapterNumbers);
+
   /*!
    * @brief Can a thumbnail image and file stream details be extracted from this file item?
   */
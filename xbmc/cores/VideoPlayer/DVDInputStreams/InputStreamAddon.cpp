@@ -201,6 +201,8 @@ bool CInputStreamAddon::Open()
 
 void CInputStreamAddon::Close()
 {
+  m_packetBatch.Clear();
+
   if (m_ifc.inputstream->toAddon->close)
     m_ifc.inputstream->toAddon->close(m_ifc.inputstream);
   DestroyInstance();
@@ -327,6 +329,8 @@ CDVDInputStream::IPosTime* CInputStreamAddon::GetIPosTime()
 
 bool CInputStreamAddon::PosTime(int ms)
 {
+  m_packetBatch.Clear();
+
   if (!m_ifc.inputstream->toAddon->pos_time)
     return false;
 
@@ -352,6 +356,17 @@ bool CInputStreamAddon::OpenDemux()
 
 DemuxPacket* CInputStreamAddon::ReadDemux()
 {
+  if ((m_caps.m_mask & INPUTSTREAM_SUPPORTS_DEMUX_BATCH) != 0 &&
+      m_ifc.inputstream->toAddon->demux_read_batch)
+  {
+    return m_packetBatch.Read(
+        [this](DemuxPacket** packets, int maxPackets)
+        {
+          return m_ifc.inputstream->toAddon->demux_read_batch(
+              m_ifc.inputstream, reinterpret_cast<DEMUX_PACKET**>(packets), maxPackets);
+        });
+  }
+
   if (!m_ifc.inputstream->toAddon->demux_read)
     return nullptr;
 
@@ -591,6 +606,8 @@ bool CInputStreamAddon::SeekTime(double time, bool backward, double* startpts)
   if (!m_ifc.inputstream->toAddon->demux_seek_time)
     return false;
 
+  m_packetBatch.Clear();
+
   if ((m_caps.m_mask & INPUTSTREAM_SUPPORTS_IPOSTIME) != 0)
   {
     if (!PosTime(static_cast<int>(time)))
@@ -614,6 +631,8 @@ void CInputStreamAddon::AbortDemux()
 
 void CInputStreamAddon::FlushDemux()
 {
+  m_packetBatch.Clear();
+
   if (m_ifc.inputstream->toAddon->demux_flush)
     m_ifc.inputstream->toAddon->demux_flush(m_ifc.inputstream);
 }
@@ -682,6 +701,8 @@ int64_t CInputStreamAddon::GetChapterPos(int ch)
 
 bool CInputStreamAddon::SeekChapter(int ch)
 {
+  m_packetBatch.Clear();
+
   if (m_ifc.inputstream->toAddon->seek_chapter)
     return m_ifc.inputstream->toAddon->seek_chapter(m_ifc.inputstream, ch);
 
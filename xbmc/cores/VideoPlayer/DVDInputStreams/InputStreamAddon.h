@@ -13,6 +13,7 @@
 #include "addons/AddonProvider.h"
 #include "addons/binary-addons/AddonInstanceHandler.h"
 #include "addons/kodi-dev-kit/include/kodi/addon-instance/Inputstream.h"
+#include "cores/VideoPlayer/DVDDemuxers/DemuxPacketBatch.h"
 
 #include <memory>
 #include <vector>
@@ -120,6 +121,9 @@ private:
 
   int m_streamCount = 0;
 
+  //! packets read ahead, if the add-on reads packets in batches
+  CDemuxPacketBatch m_packetBatch;
+
   std::shared_ptr<CInputStreamProvider> m_subAddonProvider;
 
   /*!
@@ -57,6 +57,7 @@ void CInputStreamPVRBase::Close()
 {
   if (m_isOpen)
   {
+    m_packetBatch.Clear();
     ClosePVRStream();
     CDVDInputStream::Close();
     m_eof = true;
@@ -113,7 +114,11 @@ bool CInputStreamPVRBase::GetTimes(Times &times)
 
 CDVDInputStream::ENextStream CInputStreamPVRBase::NextStream()
 {
-  return NextPVRStream();
+  const ENextStream next = NextPVRStream();
+  if (next != NEXTSTREAM_NONE)
+    m_packetBatch.Clear();
+
+  return next;
 }
 
 bool CInputStreamPVRBase::CanPause()
@@ -156,7 +161,21 @@ DemuxPacket* CInputStreamPVRBase::ReadDemux()
     return nullptr;
 
   DemuxPacket* pPacket = nullptr;
-  m_client->DemuxRead(pPacket);
+  if (m_client->GetClientCapabilities().SupportsDemuxBatch())
+  {
+    pPacket = m_packetBatch.Read(
+        [this](DemuxPacket** packets, int maxPackets)
+        {
+          int count = 0;
+          m_client->DemuxReadBatch(packets, maxPackets, count);
+          return count;
+        });
+  }
+  else
+  {
+    m_client->DemuxRead(pPacket);
+  }
+
   if (!pPacket)
   {
     return nullptr;
@@ -214,6 +233,8 @@ void CInputStreamPVRBase::FillBuffer(bool mode)
 
 bool CInputStreamPVRBase::SeekTime(double timems, bool backwards, double *startpts)
 {
+  m_packetBatch.Clear();
+
   if (m_client)
     return m_client->SeekTime(timems, backwards, startpts) == PVR_ERROR_NO_ERROR;
   else
@@ -228,6 +249,8 @@ void CInputStreamPVRBase::AbortDemux()
 
 void CInputStreamPVRBase::FlushDemux()
 {
+  m_packetBatch.Clear();
+
   if (m_client)
     m_client->DemuxFlush();
 }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDInputStream.h"
+#include "cores/VideoPlayer/DVDDemuxers/DemuxPacketBatch.h"
 
 #include <map>
 #include <memory>
@@ -84,4 +85,7 @@ protected:
   std::map<int, std::shared_ptr<CDemuxStream>> m_streamMap;
   std::shared_ptr<PVR::CPVRClient> m_client;
   bool m_isOpen{false};
+
+  //! packets read ahead, if the client reads packets in batches
+  CDemuxPacketBatch m_packetBatch;
 };
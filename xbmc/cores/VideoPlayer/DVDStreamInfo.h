@@ -18,6 +18,7 @@ extern "C"
 
 #define CODEC_FORCE_SOFTWARE 0x01
 #define CODEC_ALLOW_FALLBACK 0x02
+#define CODEC_KEYFRAMES_ONLY 0x04 // thumbnail extraction, decode keyframes only at lower quality
 
 class CDemuxStream;
 struct DemuxCryptoSession;
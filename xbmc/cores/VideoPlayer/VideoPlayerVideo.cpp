@@ -18,6 +18,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/FrameTracer.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
@@ -582,6 +583,7 @@ void CVideoPlayerVideo::Process()
         codecControl |= DVD_CODEC_CTRL_ROTATE;
       m_pVideoCodec->SetCodecControl(codecControl);
 
+      FRAME_TRACE_SCOPE("CVideoPlayerVideo::Decode");
       if (m_pVideoCodec->AddData(*pPacket))
       {
         // buffer packets so we can recover should decoder flush for some reason
@@ -29,6 +29,8 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/GLUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -52,6 +54,10 @@
 //! is a multiple of 128 and deinterlacing is on
 #define PBO_OFFSET 16
 
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
 using namespace Shaders;
 using namespace Shaders::GL;
 
@@ -96,6 +102,10 @@ CLinuxRendererGL::CPictureBuffer::CPictureBuffer()
   memset(&fields, 0, sizeof(fields));
   memset(&image , 0, sizeof(image));
   memset(&pbo   , 0, sizeof(pbo));
+  pboPersistent = false;
+  memset(&pboMapped, 0, sizeof(pboMapped));
+  fence = nullptr;
+  copied = false;
   videoBuffer = nullptr;
   loaded = false;
 }
@@ -249,6 +259,17 @@ bool CLinuxRendererGL::Configure(const VideoPicture &picture, float fps, unsigne
   m_pixelRatio = 1.0;
 
   m_pboSupported = CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_pixel_buffer_object");
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+  // immutable buffer storage is core since OpenGL 4.4
+  unsigned int major, minor;
+  CServiceBroker::GetRenderSystem()->GetRenderVersion(major, minor);
+  m_pboPersistentSupported =
+      major > 4 || (major == 4 && minor >= 4) ||
+      CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_buffer_storage");
+#else
+  // not in the headers, e.g. macOS only has OpenGL 4.1, the pbos are streamed instead
+  m_pboPersistentSupported = false;
+#endif
 
   // setup the background colour
   m_clearColour = CServiceBroker::GetWinSystem()->UseLimitedColor() ? (16.0f / 0xff) : 0.0f;
@@ -302,11 +323,21 @@ void CLinuxRendererGL::AddVideoPicture(const VideoPicture &picture, int index)
   buf.lightMetadata = picture.lightMetadata;
   if (picture.hasLightMetadata && picture.lightMetadata.MaxCLL)
     buf.hasLightMetadata = picture.hasLightMetadata;
+
+  // copy the picture now instead of when it is rendered, this keeps the render thread free
+  // for the upload of the previous pictures
+  std::unique_lock<CCriticalSection> lock(m_copySection);
+  if (buf.pboPersistent)
+  {
+    buf.copied = false;
+    m_copyThread.Queue(index, [this, index] { CopyToPersistentPbo(index, true); });
+  }
 }
 
 void CLinuxRendererGL::ReleaseBuffer(int idx)
 {
   CPictureBuffer &buf = m_buffers[idx];
+  m_copyThread.Wait(idx);
   if (buf.videoBuffer)
   {
     buf.videoBuffer->Release();
@@ -314,6 +345,22 @@ void CLinuxRendererGL::ReleaseBuffer(int idx)
   }
 }
 
+bool CLinuxRendererGL::NeedBuffer(int idx)
+{
+  // keep the buffer until the gpu read its pbos, they are written again when it is reused
+  CPictureBuffer& buf = m_buffers[idx];
+  std::unique_lock<CCriticalSection> lock(m_copySection);
+  if (!buf.fence)
+    return false;
+
+  if (glClientWaitSync(buf.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+    return true;
+
+  glDeleteSync(buf.fence);
+  buf.fence = nullptr;
+  return false;
+}
+
 void CLinuxRendererGL::GetPlaneTextureSize(CYuvPlane& plane)
 {
   /* texture is assumed to be bound */
@@ -1029,6 +1076,14 @@ void CLinuxRendererGL::LoadShaders(int field)
   }
   else
     m_pboUsed = false;
+
+  if (m_pboUsed && m_pboPersistentSupported)
+  {
+    CLog::Log(LOGINFO, "GL: Using GL_ARB_buffer_storage");
+    m_pboPersistentUsed = true;
+  }
+  else
+    m_pboPersistentUsed = false;
 }
 
 void CLinuxRendererGL::UnInit()
@@ -1802,6 +1857,8 @@ GLint CLinuxRendererGL::GetInternalFormat(GLint format, int bpp)
 
 bool CLinuxRendererGL::CreateTexture(int index)
 {
+  ReleasePersistentPbo(index);
+
   if (m_format == AV_PIX_FMT_NV12)
     return CreateNV12Texture(index);
   else if (m_format == AV_PIX_FMT_YUYV422 ||
@@ -1815,6 +1872,7 @@ void CLinuxRendererGL::DeleteTexture(int index)
 {
   CPictureBuffer& buf = m_buffers[index];
   buf.loaded = false;
+  ReleasePersistentPbo(index);
 
   if (m_format == AV_PIX_FMT_NV12)
     DeleteNV12Texture(index);
@@ -1827,42 +1885,55 @@ void CLinuxRendererGL::DeleteTexture(int index)
 
 bool CLinuxRendererGL::UploadTexture(int index)
 {
-  if (!m_buffers[index].videoBuffer)
+  CPictureBuffer& buf = m_buffers[index];
+  if (!buf.videoBuffer)
     return false;
 
   bool ret = true;
 
-  if (!m_buffers[index].loaded)
+  if (!buf.loaded)
   {
-    YuvImage &dst = m_buffers[index].image;
-    YuvImage src;
-    m_buffers[index].videoBuffer->GetPlanes(src.plane);
-    m_buffers[index].videoBuffer->GetStrides(src.stride);
-
-    UnBindPbo(m_buffers[index]);
+    if (buf.pboPersistent)
+    {
+      // usually the copy thread filled the pbos when the picture was added
+      m_copyThread.Wait(index);
+      std::unique_lock<CCriticalSection> lock(m_copySection);
+      if (!buf.copied)
+      {
+        WaitPboFence(buf);
+        lock.unlock();
+        CopyToPersistentPbo(index, false);
+      }
+    }
+    else
+    {
+      const int64_t start = CurrentHostCounter();
+      UnBindPbo(buf);
+      CopyPicture(buf, buf.image);
+      BindPbo(buf);
+      buf.copyTime = (CurrentHostCounter() - start) * 1000.0 / CurrentHostFrequency();
+      buf.copyAsync = false;
+    }
 
+    const int64_t start = CurrentHostCounter();
     if (m_format == AV_PIX_FMT_NV12)
-    {
-      CVideoBuffer::CopyNV12Picture(&dst, &src);
-      BindPbo(m_buffers[index]);
       ret = UploadNV12Texture(index);
-    }
     else if (m_format == AV_PIX_FMT_YUYV422 ||
              m_format == AV_PIX_FMT_UYVY422)
-    {
-      CVideoBuffer::CopyYUV422PackedPicture(&dst, &src);
-      BindPbo(m_buffers[index]);
       ret = UploadYUV422PackedTexture(index);
-    }
     else
-    {
-      CVideoBuffer::CopyPicture(&dst, &src);
-      BindPbo(m_buffers[index]);
       ret = UploadYV12Texture(index);
+    buf.uploadTime = (CurrentHostCounter() - start) * 1000.0 / CurrentHostFrequency();
+
+    if (buf.pboPersistent)
+    {
+      std::unique_lock<CCriticalSection> lock(m_copySection);
+      buf.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      buf.copied = false;
     }
 
     if (ret)
-      m_buffers[index].loaded = true;
+      buf.loaded = true;
   }
 
   if (ret)
@@ -1871,6 +1942,21 @@ bool CLinuxRendererGL::UploadTexture(int index)
   return ret;
 }
 
+void CLinuxRendererGL::CopyPicture(CPictureBuffer& buff, YuvImage& dst)
+{
+  YuvImage src;
+  buff.videoBuffer->GetPlanes(src.plane);
+  buff.videoBuffer->GetStrides(src.stride);
+
+  if (m_format == AV_PIX_FMT_NV12)
+    CVideoBuffer::CopyNV12Picture(&dst, &src);
+  else if (m_format == AV_PIX_FMT_YUYV422 ||
+           m_format == AV_PIX_FMT_UYVY422)
+    CVideoBuffer::CopyYUV422PackedPicture(&dst, &src);
+  else
+    CVideoBuffer::CopyPicture(&dst, &src);
+}
+
 //********************************************************************************************************
 // YV12 Texture creation, deletion, copying + clearing
 //********************************************************************************************************
@@ -1925,7 +2011,10 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
   im.planesize[2] = im.stride[2] * (im.height >> im.cshift_y);
 
   bool pboSetup = false;
-  if (m_pboUsed)
+  if (m_pboPersistentUsed)
+    pboSetup = CreatePersistentPbo(index, 3);
+
+  if (m_pboUsed && !pboSetup)
   {
     pboSetup = true;
     glGenBuffers(3, pbo);
@@ -2231,7 +2320,10 @@ bool CLinuxRendererGL::CreateNV12Texture(int index)
   im.planesize[2] = 0;
 
   bool pboSetup = false;
-  if (m_pboUsed)
+  if (m_pboPersistentUsed)
+    pboSetup = CreatePersistentPbo(index, 2);
+
+  if (m_pboUsed && !pboSetup)
   {
     pboSetup = true;
     glGenBuffers(2, pbo);
@@ -2691,6 +2783,10 @@ void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
 
 void CLinuxRendererGL::UnBindPbo(CPictureBuffer& buff)
 {
+  // persistent pbos stay mapped
+  if (buff.pboPersistent)
+    return;
+
   bool pbo = false;
   for(int plane = 0; plane < YuvImage::MAX_PLANES; plane++)
   {
@@ -2706,6 +2802,147 @@ void CLinuxRendererGL::UnBindPbo(CPictureBuffer& buff)
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
+bool CLinuxRendererGL::CreatePersistentPbo(int index, int planes)
+{
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+  CPictureBuffer& buf = m_buffers[index];
+  YuvImage& im = buf.image;
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  glGenBuffers(planes, buf.pbo);
+
+  bool pboSetup = true;
+  uint8_t* mapped[3] = {};
+  for (int i = 0; i < planes; i++)
+  {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buf.pbo[i]);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, nullptr, flags);
+    void* pboPtr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, im.planesize[i] + PBO_OFFSET, flags);
+    if (!pboPtr)
+    {
+      CLog::Log(LOGWARNING, "GL: failed to set up persistent pixel buffer object");
+      pboSetup = false;
+      break;
+    }
+    mapped[i] = static_cast<uint8_t*>(pboPtr) + PBO_OFFSET;
+    memset(mapped[i], 0, im.planesize[i]);
+  }
+
+  if (!pboSetup)
+  {
+    for (int i = 0; i < planes; i++)
+    {
+      if (!mapped[i])
+        continue;
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buf.pbo[i]);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    glDeleteBuffers(planes, buf.pbo);
+    memset(buf.pbo, 0, sizeof(buf.pbo));
+  }
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  if (!pboSetup)
+    return false;
+
+  // textures are loaded from the start of the bound pbos, the planes are only written through
+  // the mapped pointers
+  for (int i = 0; i < planes; i++)
+    im.plane[i] = (uint8_t*)PBO_OFFSET;
+
+  std::unique_lock<CCriticalSection> lock(m_copySection);
+  memcpy(buf.pboMapped, mapped, sizeof(buf.pboMapped));
+  buf.copied = false;
+  buf.pboPersistent = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CLinuxRendererGL::ReleasePersistentPbo(int index)
+{
+  CPictureBuffer& buf = m_buffers[index];
+  {
+    std::unique_lock<CCriticalSection> lock(m_copySection);
+    if (!buf.pboPersistent)
+      return;
+    buf.pboPersistent = false;
+    buf.copied = false;
+  }
+
+  // a copy that started before can still write to the pbos
+  m_copyThread.Wait(index);
+
+  std::unique_lock<CCriticalSection> lock(m_copySection);
+  if (buf.fence)
+  {
+    glDeleteSync(buf.fence);
+    buf.fence = nullptr;
+  }
+  memset(buf.pboMapped, 0, sizeof(buf.pboMapped));
+}
+
+void CLinuxRendererGL::WaitPboFence(CPictureBuffer& buff)
+{
+  if (!buff.fence)
+    return;
+
+  if (glClientWaitSync(buff.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000) == GL_TIMEOUT_EXPIRED)
+    CLog::Log(LOGWARNING, "CLinuxRendererGL::{} - timeout waiting for pixel buffer object",
+              __FUNCTION__);
+
+  glDeleteSync(buff.fence);
+  buff.fence = nullptr;
+}
+
+void CLinuxRendererGL::CopyToPersistentPbo(int index, bool async)
+{
+  CPictureBuffer& buf = m_buffers[index];
+  YuvImage dst;
+  {
+    std::unique_lock<CCriticalSection> lock(m_copySection);
+    // the gpu still reads the pbos or they are gone, the render thread copies when uploading
+    if (!buf.pboPersistent || buf.copied || buf.fence || !buf.videoBuffer)
+      return;
+
+    dst = buf.image;
+    for (int i = 0; i < YuvImage::MAX_PLANES; i++)
+      dst.plane[i] = buf.pboMapped[i];
+  }
+
+  const int64_t start = CurrentHostCounter();
+  CopyPicture(buf, dst);
+  const double copyTime = (CurrentHostCounter() - start) * 1000.0 / CurrentHostFrequency();
+
+  std::unique_lock<CCriticalSection> lock(m_copySection);
+  buf.copyTime = copyTime;
+  buf.copyAsync = async;
+  buf.copied = true;
+}
+
+DEBUG_INFO_VIDEO CLinuxRendererGL::GetDebugInfo(int idx)
+{
+  if (!m_bConfigured)
+    return {};
+
+  const CPictureBuffer& buf = m_buffers[idx];
+  const char* px = av_get_pix_fmt_name(m_format);
+
+  DEBUG_INFO_VIDEO info;
+  info.videoSource = StringUtils::Format("Source: {}x{}, fr: {:.3f}, pixel: {} {}-bit",
+                                         m_sourceWidth, m_sourceHeight, m_fps,
+                                         px ? px : "unknown", buf.m_srcBits);
+
+  std::unique_lock<CCriticalSection> lock(m_copySection);
+  info.render = StringUtils::Format(
+      "Upload: copy {:.2f} ms ({}), texture {:.2f} ms, pbo: {}", buf.copyTime,
+      buf.copyAsync ? "copy thread" : "render thread", buf.uploadTime,
+      buf.pboPersistent ? "persistent" : (buf.pbo[0] ? "streamed" : "none"));
+  return info;
+}
+
 CRenderInfo CLinuxRendererGL::GetRenderInfo()
 {
   CRenderInfo info;
@@ -17,6 +17,8 @@
 #include "RenderInfo.h"
 #include "BaseRenderer.h"
 #include "ColorManager.h"
+#include "PictureCopyThread.h"
+#include "threads/CriticalSection.h"
 #include "utils/Geometry.h"
 
 extern "C" {
@@ -70,6 +72,7 @@ public:
   bool Flush(bool saveBuffers) override;
   void SetBufferSize(int numBuffers) override { m_NumYV12Buffers = numBuffers; }
   void ReleaseBuffer(int idx) override;
+  bool NeedBuffer(int idx) override;
   void RenderUpdate(int index, int index2, bool clear, unsigned int flags, unsigned int alpha) override;
   void Update() override;
   bool RenderCapture(int index, CRenderCapture* capture) override;
@@ -82,6 +85,7 @@ public:
   bool Supports(ESCALINGMETHOD method) const override;
 
   CRenderCapture* GetRenderCapture() override;
+  DEBUG_INFO_VIDEO GetDebugInfo(int idx) override;
 
 protected:
 
@@ -129,6 +133,11 @@ protected:
 
   void BindPbo(CPictureBuffer& buff);
   void UnBindPbo(CPictureBuffer& buff);
+  bool CreatePersistentPbo(int index, int planes);
+  void ReleasePersistentPbo(int index);
+  void WaitPboFence(CPictureBuffer& buff);
+  void CopyPicture(CPictureBuffer& buff, YuvImage& dst);
+  void CopyToPersistentPbo(int index, bool async);
   void LoadPlane(CYuvPlane& plane, int type,
                  unsigned width,  unsigned height,
                  int stride, int bpp, void* data);
@@ -188,9 +197,20 @@ protected:
     YuvImage image;
     GLuint pbo[3]; // one pbo for 3 planes
 
+    // pbos mapped for the lifetime of the buffer, written by the copy thread
+    bool pboPersistent;
+    uint8_t* pboMapped[3];
+    GLsync fence; // gpu finished reading the pbos
+    bool copied; // pbos hold the current picture
+
     CVideoBuffer *videoBuffer;
     bool loaded;
 
+    // debug info, in ms
+    double copyTime = 0.0;
+    double uploadTime = 0.0;
+    bool copyAsync = false;
+
     AVColorPrimaries m_srcPrimaries;
     AVColorSpace m_srcColSpace;
     AVColorTransferCharacteristic m_srcColTransfer;
@@ -209,6 +229,11 @@ protected:
   // field index 0 is full image, 1 is odd scanlines, 2 is even scanlines
   CPictureBuffer m_buffers[NUM_BUFFERS];
 
+  // copies pictures into persistent pbos when they are added, m_copySection guards the
+  // persistent pbo state of the buffers shared with the copy thread
+  CPictureCopyThread m_copyThread;
+  CCriticalSection m_copySection;
+
   Shaders::GL::BaseYUV2RGBGLSLShader* m_pYUVShader = nullptr;
   Shaders::GL::BaseVideoFilterShader* m_pVideoFilterShader = nullptr;
   ESCALINGMETHOD m_scalingMethod = VS_SCALINGMETHOD_LINEAR;
@@ -222,6 +247,8 @@ protected:
   float m_clearColour = 0.0f;
   bool m_pboSupported = true;
   bool m_pboUsed = false;
+  bool m_pboPersistentSupported = false;
+  bool m_pboPersistentUsed = false;
   bool m_nonLinStretch = false;
   bool m_nonLinStretchGui = false;
   float m_pixelRatio = 0.0f;
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PictureCopyThread.h"
+
+#include <algorithm>
+#include <mutex>
+
+CPictureCopyThread::CPictureCopyThread() : CThread("PictureCopy")
+{
+}
+
+CPictureCopyThread::~CPictureCopyThread()
+{
+  StopThread();
+}
+
+void CPictureCopyThread::Queue(int index, std::function<void()> copy)
+{
+  if (!IsRunning())
+    Create();
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  m_copies.push_back({index, std::move(copy)});
+  m_queued.notifyAll();
+}
+
+bool CPictureCopyThread::Wait(int index)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (!IsPending(index))
+    return false;
+
+  m_done.wait(lock, [this, index] { return !IsPending(index); });
+  return true;
+}
+
+void CPictureCopyThread::WaitAll()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  m_done.wait(lock, [this] { return m_copies.empty() && m_current < 0; });
+}
+
+void CPictureCopyThread::StopThread(bool bWait /* = true */)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_bStop = true;
+    m_queued.notifyAll();
+  }
+  CThread::StopThread(bWait);
+
+  // nothing runs the copies left anymore
+  std::unique_lock<CCriticalSection> lock(m_section);
+  m_copies.clear();
+  m_done.notifyAll();
+}
+
+bool CPictureCopyThread::IsPending(int index) const
+{
+  return m_current == index ||
+         std::any_of(m_copies.begin(), m_copies.end(),
+                     [index](const Copy& copy) { return copy.index == index; });
+}
+
+void CPictureCopyThread::Process()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  while (!m_bStop)
+  {
+    m_queued.wait(lock, [this] { return m_bStop || !m_copies.empty(); });
+    if (m_bStop)
+      break;
+
+    Copy copy = std::move(m_copies.front());
+    m_copies.pop_front();
+    m_current = copy.index;
+
+    lock.unlock();
+    copy.copy();
+    lock.lock();
+
+    m_current = -1;
+    m_done.notifyAll();
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <functional>
+
+/*!
+ \brief Worker copying decoded pictures into upload buffers off the render thread.
+
+ Copies are queued per render buffer index when the player adds a picture, the
+ renderer waits for the copy of a buffer before it uploads or releases it.
+ */
+class CPictureCopyThread : private CThread
+{
+public:
+  CPictureCopyThread();
+  ~CPictureCopyThread() override;
+
+  /*! \brief Queue the copy of a render buffer, starts the thread if needed */
+  void Queue(int index, std::function<void()> copy);
+
+  /*! \brief Wait until a queued copy of a render buffer is done
+   \return true if a copy was queued for the buffer
+   */
+  bool Wait(int index);
+
+  /*! \brief Wait until all queued copies are done */
+  void WaitAll();
+
+  void StopThread(bool bWait = true) override;
+
+private:
+  struct Copy
+  {
+    int index;
+    std::function<void()> copy;
+  };
+
+  void Process() override;
+  bool IsPending(int index) const;
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_queued;
+  XbmcThreads::ConditionVariable m_done;
+  std::deque<Copy> m_copies;
+  int m_current{-1};
+};
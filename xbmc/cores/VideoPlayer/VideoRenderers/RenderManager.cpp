@@ -17,10 +17,12 @@
 #include "application/Application.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "messaging/ApplicationMessenger.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/FrameTracer.h"
 #include "utils/StringUtils.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
@@ -697,6 +699,11 @@ RESOLUTION CRenderManager::GetResolution()
 
 void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
 {
+  FRAME_TRACE_SCOPE("CRenderManager::Render");
+
+  // the video is drawn directly, anything the GUI queued before has to be drawn first
+  CServiceBroker::GetRenderSystem()->FlushGUIRenderQueue();
+
   CSingleExit exitLock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   {
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/VideoRenderers/PictureCopyThread.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(TestPictureCopyThread, CopiesInQueueOrder)
+{
+  CPictureCopyThread thread;
+  std::vector<int> copied;
+
+  for (int i = 0; i < 4; ++i)
+    thread.Queue(i, [&copied, i] { copied.push_back(i); });
+  thread.WaitAll();
+
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), copied);
+}
+
+TEST(TestPictureCopyThread, WaitForBuffer)
+{
+  CPictureCopyThread thread;
+  CEvent started;
+  CEvent release;
+  std::atomic<bool> copied{false};
+
+  // nothing queued for the buffer, like a buffer the render thread copies itself
+  EXPECT_FALSE(thread.Wait(0));
+
+  thread.Queue(0, [&] {
+    started.Set();
+    release.Wait();
+    copied = true;
+  });
+  ASSERT_TRUE(started.Wait(std::chrono::seconds(10)));
+
+  // waiting for another buffer doesn't block on the running copy
+  EXPECT_FALSE(thread.Wait(1));
+  EXPECT_FALSE(copied);
+
+  // waiting for the buffer returns once its copy is done
+  release.Set();
+  thread.Wait(0);
+  EXPECT_TRUE(copied);
+  EXPECT_FALSE(thread.Wait(0));
+}
+
+TEST(TestPictureCopyThread, StopDropsQueuedCopies)
+{
+  CPictureCopyThread thread;
+  CEvent started;
+  CEvent release;
+  std::atomic<int> copies{0};
+
+  thread.Queue(0, [&] {
+    started.Set();
+    release.Wait();
+    ++copies;
+  });
+  thread.Queue(1, [&] { ++copies; });
+  ASSERT_TRUE(started.Wait(std::chrono::seconds(10)));
+
+  // the queued copy is dropped and waiting for it doesn't block, the running one completes
+  thread.StopThread(false);
+  EXPECT_FALSE(thread.Wait(1));
+  release.Set();
+  thread.StopThread();
+  EXPECT_EQ(1, copies);
+
+  // queueing starts the thread again
+  thread.Queue(2, [&] { ++copies; });
+  thread.WaitAll();
+  EXPECT_EQ(2, copies);
+}
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/inputstream.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDDemuxers/DemuxPacketBatch.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// an add-on demuxing a stream of packets, through the add-on interface
+class CStubAddon
+{
+public:
+  CStubAddon(int packets, int packetSize, int streamChangeAt = -1)
+    : m_packets(packets), m_streamChangeAt(streamChangeAt), m_payload(packetSize)
+  {
+    for (size_t i = 0; i < m_payload.size(); ++i)
+      m_payload[i] = static_cast<uint8_t>(i);
+
+    m_toAddon.addonInstance = this;
+    m_toAddon.demux_read = DemuxRead;
+    m_toAddon.demux_read_batch = DemuxReadBatch;
+    m_instance.toAddon = &m_toAddon;
+  }
+
+  const AddonInstance_InputStream* Instance() const { return &m_instance; }
+
+private:
+  static CStubAddon* Get(const AddonInstance_InputStream* instance)
+  {
+    return static_cast<CStubAddon*>(instance->toAddon->addonInstance);
+  }
+
+  static DEMUX_PACKET* DemuxRead(const AddonInstance_InputStream* instance)
+  {
+    CStubAddon* addon = Get(instance);
+    if (addon->m_read == addon->m_packets)
+      return CDVDDemuxUtils::AllocateDemuxPacket(0);
+
+    if (addon->m_read == addon->m_streamChangeAt)
+    {
+      ++addon->m_read;
+      DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(0);
+      packet->iStreamId = DMX_SPECIALID_STREAMCHANGE;
+      return packet;
+    }
+
+    DemuxPacket* packet =
+        CDVDDemuxUtils::AllocateDemuxPacket(static_cast<int>(addon->m_payload.size()));
+    std::memcpy(packet->pData, addon->m_payload.data(), addon->m_payload.size());
+    packet->iSize = static_cast<int>(addon->m_payload.size());
+    packet->iStreamId = 1;
+    packet->pts = addon->m_read++;
+    return packet;
+  }
+
+  // what the dev-kit does by default
+  static int DemuxReadBatch(const AddonInstance_InputStream* instance,
+                            DEMUX_PACKET** packets,
+                            int maxPackets)
+  {
+    int count = 0;
+    while (count < maxPackets)
+    {
+      DEMUX_PACKET* packet = DemuxRead(instance);
+      if (!packet)
+        break;
+
+      packets[count++] = packet;
+      if (packet->iSize == 0 || packet->iStreamId < 0)
+        break;
+    }
+    return count;
+  }
+
+  const int m_packets;
+  const int m_streamChangeAt;
+  int m_read{0};
+  std::vector<uint8_t> m_payload;
+  KodiToAddonFuncTable_InputStream m_toAddon{};
+  AddonInstance_InputStream m_instance{};
+};
+
+// like CPVRClient::DoAddonCall, which checks the state of the add-on and counts the calls running
+class CCallGuard
+{
+public:
+  template<typename R>
+  R Call(const std::function<R()>& function)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      ++m_calls;
+    }
+    const R result = function();
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      --m_calls;
+    }
+    return result;
+  }
+
+private:
+  std::mutex m_mutex;
+  int m_calls{0};
+};
+
+DemuxPacket* ReadBatched(CDemuxPacketBatch& batch, const CStubAddon& addon, CCallGuard& guard)
+{
+  return batch.Read(
+      [&addon, &guard](DemuxPacket** packets, int maxPackets)
+      {
+        return guard.Call<int>(
+            [&addon, packets, maxPackets]()
+            {
+              return addon.Instance()->toAddon->demux_read_batch(
+                  addon.Instance(), reinterpret_cast<DEMUX_PACKET**>(packets), maxPackets);
+            });
+      });
+}
+
+DemuxPacket* ReadBatched(CDemuxPacketBatch& batch, const CStubAddon& addon)
+{
+  CCallGuard guard;
+  return ReadBatched(batch, addon, guard);
+}
+
+DemuxPacket* ReadSingle(const CStubAddon& addon, CCallGuard& guard)
+{
+  return guard.Call<DemuxPacket*>(
+      [&addon]()
+      {
+        return static_cast<DemuxPacket*>(
+            addon.Instance()->toAddon->demux_read(addon.Instance()));
+      });
+}
+} // namespace
+
+TEST(TestDemuxPacketBatch, ReadsInOrder)
+{
+  CStubAddon addon(100, 188);
+  CDemuxPacketBatch batch;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    DemuxPacket* packet = ReadBatched(batch, addon);
+    ASSERT_NE(nullptr, packet);
+    EXPECT_EQ(188, packet->iSize);
+    EXPECT_EQ(i, packet->pts);
+    CDVDDemuxUtils::FreeDemuxPacket(packet);
+  }
+
+  DemuxPacket* packet = ReadBatched(batch, addon);
+  ASSERT_NE(nullptr, packet);
+  EXPECT_EQ(0, packet->iSize);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+}
+
+TEST(TestDemuxPacketBatch, EndsAtStreamChange)
+{
+  CStubAddon addon(100, 188, 5);
+  CDemuxPacketBatch batch;
+
+  for (int i = 0; i < 5; ++i)
+    CDVDDemuxUtils::FreeDemuxPacket(ReadBatched(batch, addon));
+
+  DemuxPacket* packet = ReadBatched(batch, addon);
+  ASSERT_NE(nullptr, packet);
+  EXPECT_EQ(DMX_SPECIALID_STREAMCHANGE, packet->iStreamId);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+  // nothing read beyond the stream change before it was handed out
+  EXPECT_TRUE(batch.IsEmpty());
+}
+
+TEST(TestDemuxPacketBatch, ClearDropsReadAhead)
+{
+  CStubAddon addon(100, 188);
+  CDemuxPacketBatch batch;
+
+  CDVDDemuxUtils::FreeDemuxPacket(ReadBatched(batch, addon));
+  EXPECT_FALSE(batch.IsEmpty());
+
+  batch.Clear();
+  EXPECT_TRUE(batch.IsEmpty());
+
+  // the next read starts after the packets read ahead
+  DemuxPacket* packet = ReadBatched(batch, addon);
+  ASSERT_NE(nullptr, packet);
+  EXPECT_EQ(CDemuxPacketBatch::MAX_PACKETS, packet->pts);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+}
+
+// Packets per second read from a stub add-on like a UHD live stream, one by one and batched, run
+// with --gtest_also_run_disabled_tests --gtest_filter=TestDemuxPacketBatch.DISABLED_Benchmark
+TEST(TestDemuxPacketBatch, DISABLED_Benchmark)
+{
+  constexpr int PACKETS = 1000000;
+  constexpr int PACKET_SIZE = 7 * 188;
+
+  CCallGuard guard;
+
+  CStubAddon singleAddon(PACKETS, PACKET_SIZE);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < PACKETS; ++i)
+    CDVDDemuxUtils::FreeDemuxPacket(ReadSingle(singleAddon, guard));
+  const std::chrono::duration<double> singleElapsed = std::chrono::steady_clock::now() - start;
+
+  CStubAddon batchAddon(PACKETS, PACKET_SIZE);
+  CDemuxPacketBatch batch;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < PACKETS; ++i)
+    CDVDDemuxUtils::FreeDemuxPacket(ReadBatched(batch, batchAddon, guard));
+  const std::chrono::duration<double> batchElapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << PACKETS << " packets of " << PACKET_SIZE << " bytes, one by one: "
+            << PACKETS / singleElapsed.count() / 1000 << "k packets/s, batched: "
+            << PACKETS / batchElapsed.count() / 1000 << "k packets/s" << std::endl;
+}
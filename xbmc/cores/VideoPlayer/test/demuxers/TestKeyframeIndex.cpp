@@ -0,0 +1,229 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/KeyframeIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Keyframe
+{
+  int64_t time;
+  int64_t pos;
+};
+
+// a stream of about an hour with a variable GOP length and bitrate
+std::vector<Keyframe> CreateStream()
+{
+  std::vector<Keyframe> keyframes;
+  int64_t time = 40;
+  int64_t pos = 564;
+  for (int i = 0; time < 3600 * 1000; ++i)
+  {
+    keyframes.push_back({time, pos});
+    time += 480 + (i * 7919) % 9600;
+    pos += 188 * (1000 + (i * 104729) % 60000);
+  }
+  return keyframes;
+}
+
+void Play(CKeyframeIndex& index, const std::vector<Keyframe>& keyframes, size_t from, size_t to)
+{
+  index.Break();
+  for (size_t i = from; i < to && i < keyframes.size(); ++i)
+    index.Add(keyframes[i].time, keyframes[i].pos);
+}
+
+// what a search of the file would find
+const Keyframe* Search(const std::vector<Keyframe>& keyframes, int64_t time, bool backwards)
+{
+  const Keyframe* result = nullptr;
+  for (const auto& keyframe : keyframes)
+  {
+    if (backwards && keyframe.time <= time)
+      result = &keyframe;
+    else if (!backwards && keyframe.time >= time)
+      return &keyframe;
+  }
+  return result;
+}
+
+// the stream as a file, counting the packets read to find keyframes
+class CFixtureFile
+{
+public:
+  explicit CFixtureFile(const std::vector<Keyframe>& keyframes) : m_keyframes(keyframes) {}
+
+  // read from a byte position up to the next keyframe
+  const Keyframe* ReadKeyframe(int64_t pos)
+  {
+    ++m_reads;
+    const auto it = std::lower_bound(m_keyframes.begin(), m_keyframes.end(), pos,
+                                     [](const Keyframe& keyframe, int64_t pos)
+                                     { return keyframe.pos < pos; });
+    return it != m_keyframes.end() ? &*it : nullptr;
+  }
+
+  // a seek without index, bisecting the file by the timestamps read like avformat does
+  const Keyframe* Search(int64_t time)
+  {
+    int64_t low = 0;
+    int64_t high = m_keyframes.back().pos;
+    const Keyframe* found = ReadKeyframe(low);
+    while (low < high)
+    {
+      const int64_t middle = low + (high - low + 1) / 2;
+      const Keyframe* keyframe = ReadKeyframe(middle);
+      if (keyframe && keyframe->time <= time)
+      {
+        found = keyframe;
+        low = keyframe->pos;
+        if (keyframe->pos == high)
+          break;
+      }
+      else
+        high = middle - 1;
+    }
+    return found;
+  }
+
+  unsigned int GetReads() const { return m_reads; }
+
+private:
+  const std::vector<Keyframe>& m_keyframes;
+  unsigned int m_reads = 0;
+};
+} // namespace
+
+TEST(TestKeyframeIndex, SeeksToKeyframesOfPlayedRange)
+{
+  const std::vector<Keyframe> keyframes = CreateStream();
+  CKeyframeIndex index;
+  Play(index, keyframes, 0, keyframes.size());
+  EXPECT_EQ(keyframes.size(), index.Size());
+
+  unsigned int seeks = 0;
+  for (int64_t time = keyframes.front().time; time <= keyframes.back().time; time += 997)
+  {
+    for (bool backwards : {true, false})
+    {
+      CKeyframeIndex::Entry entry;
+      ASSERT_TRUE(index.Lookup(time, backwards, entry)) << time;
+      const Keyframe* expected = Search(keyframes, time, backwards);
+      ASSERT_NE(nullptr, expected);
+      // exact keyframe, so a seek takes a single positioning of the input
+      EXPECT_EQ(expected->time, entry.time);
+      EXPECT_EQ(expected->pos, entry.pos);
+      ++seeks;
+    }
+  }
+  EXPECT_GT(seeks, 7000u);
+}
+
+TEST(TestKeyframeIndex, DoesNotSeekIntoGaps)
+{
+  const std::vector<Keyframe> keyframes = CreateStream();
+  CKeyframeIndex index;
+  // played the start, then skipped ahead
+  Play(index, keyframes, 0, 100);
+  Play(index, keyframes, 200, 300);
+
+  CKeyframeIndex::Entry entry;
+  EXPECT_TRUE(index.Lookup(keyframes[50].time + 1, true, entry));
+  EXPECT_EQ(keyframes[50].time, entry.time);
+  EXPECT_FALSE(index.Lookup(keyframes[150].time, true, entry));
+  EXPECT_FALSE(index.Lookup(keyframes[99].time + 1, true, entry));
+  EXPECT_FALSE(index.Lookup(keyframes[199].time + 1, false, entry));
+  // a known keyframe is found even next to a gap
+  EXPECT_TRUE(index.Lookup(keyframes[200].time, false, entry));
+  EXPECT_EQ(keyframes[200].pos, entry.pos);
+  // nothing is known beyond the last keyframe read
+  EXPECT_FALSE(index.Lookup(keyframes[299].time + 1, true, entry));
+
+  // playing the gap closes it
+  Play(index, keyframes, 99, 201);
+  EXPECT_TRUE(index.Lookup(keyframes[150].time + 1, true, entry));
+  EXPECT_EQ(keyframes[150].time, entry.time);
+  EXPECT_TRUE(index.Lookup(keyframes[199].time + 1, false, entry));
+  EXPECT_EQ(keyframes[200].time, entry.time);
+  EXPECT_EQ(300u, index.Size());
+}
+
+TEST(TestKeyframeIndex, IgnoresDiscontinuities)
+{
+  CKeyframeIndex index;
+  index.Add(1000, 100);
+  index.Add(2000, 200);
+  // timestamps jumping back, e.g. a wrap around, don't link to the previous keyframe
+  index.Add(1500, 300);
+  index.Add(3000, 400);
+
+  CKeyframeIndex::Entry entry;
+  EXPECT_FALSE(index.Lookup(1200, true, entry));
+  EXPECT_FALSE(index.Lookup(1700, true, entry));
+  EXPECT_FALSE(index.Lookup(2500, true, entry));
+}
+
+TEST(TestKeyframeIndex, Serialize)
+{
+  const std::vector<Keyframe> keyframes = CreateStream();
+  CKeyframeIndex index;
+  Play(index, keyframes, 0, 100);
+  Play(index, keyframes, 200, keyframes.size());
+  EXPECT_TRUE(index.IsModified());
+
+  const std::string data = index.Serialize();
+  EXPECT_LT(data.size(), index.Size() * 9);
+  // stored as text, which ends at the first zero byte
+  EXPECT_TRUE(std::all_of(data.begin(), data.end(), [](char c) { return std::isprint(c); }));
+
+  CKeyframeIndex restored;
+  ASSERT_TRUE(restored.Deserialize(data));
+  EXPECT_FALSE(restored.IsModified());
+  EXPECT_EQ(index.GetEntries(), restored.GetEntries());
+
+  EXPECT_FALSE(restored.Deserialize(data.substr(0, data.size() - 1)));
+  EXPECT_TRUE(restored.IsEmpty());
+  EXPECT_FALSE(restored.Deserialize(data.substr(0, data.size() - 4)));
+  EXPECT_FALSE(restored.Deserialize("garbage"));
+  EXPECT_FALSE(restored.Deserialize(""));
+}
+
+TEST(TestKeyframeIndex, ReadsPerSeek)
+{
+  const std::vector<Keyframe> keyframes = CreateStream();
+  CKeyframeIndex index;
+  Play(index, keyframes, 0, keyframes.size());
+
+  CFixtureFile indexed(keyframes);
+  CFixtureFile searched(keyframes);
+  unsigned int seeks = 0;
+  for (int64_t time = keyframes.front().time; time <= keyframes.back().time; time += 9973)
+  {
+    CKeyframeIndex::Entry entry;
+    ASSERT_TRUE(index.Lookup(time, true, entry));
+    const Keyframe* keyframe = indexed.ReadKeyframe(entry.pos);
+    ASSERT_NE(nullptr, keyframe);
+    EXPECT_EQ(entry.time, keyframe->time);
+
+    const Keyframe* expected = searched.Search(time);
+    ASSERT_NE(nullptr, expected);
+    EXPECT_EQ(expected->time, keyframe->time) << time;
+    ++seeks;
+  }
+
+  // a single read per seek, where searching the file takes one for every halving
+  EXPECT_EQ(seeks, indexed.GetReads());
+  EXPECT_GT(searched.GetReads(), seeks * 10);
+}
@@ -14,6 +14,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/Thread.h"
+#include "utils/FrameTracer.h"
 #include "utils/log.h"
 
 #include <mutex>
@@ -338,7 +339,10 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (maxSourceRead > 0)
+    {
+      FRAME_TRACE_SCOPE("CFileCache::Read");
       iRead = m_source.Read(buffer.get(), maxSourceRead);
+    }
     if (iRead <= 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
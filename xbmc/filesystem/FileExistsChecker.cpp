@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileExistsChecker.h"
+
+#include "FileItemList.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "threads/Event.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+CFileExistsChecker::CFileExistsChecker(unsigned int maxThreads /* = DEFAULT_THREADS */)
+  : m_maxThreads(std::max(maxThreads, 1u))
+{
+}
+
+void CFileExistsChecker::Add(const std::string& path)
+{
+  m_files.emplace(path, false);
+}
+
+bool CFileExistsChecker::Exists(const std::string& path) const
+{
+  const auto it = m_files.find(path);
+  return it != m_files.end() && it->second;
+}
+
+bool CFileExistsChecker::Run(const ProgressCallback& progress /* = {} */)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::map<std::string, std::vector<FileIterator>> folders;
+  for (auto it = m_files.begin(); it != m_files.end(); ++it)
+    folders[URIUtils::GetDirectory(it->first)].push_back(it);
+
+  std::vector<const std::pair<const std::string, std::vector<FileIterator>>*> jobs;
+  jobs.reserve(folders.size());
+  for (const auto& folder : folders)
+    jobs.push_back(&folder);
+
+  const auto threads = static_cast<unsigned int>(std::min<size_t>(m_maxThreads, jobs.size()));
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> checked{0};
+  std::atomic<unsigned int> running{threads};
+  std::atomic<bool> cancelled{false};
+  CEvent done(true);
+
+  auto worker = [&]()
+  {
+    while (!cancelled)
+    {
+      const size_t job = next++;
+      if (job >= jobs.size())
+        break;
+
+      CheckFolder(jobs[job]->first, jobs[job]->second);
+      checked += jobs[job]->second.size();
+    }
+    if (--running == 0)
+      done.Set();
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (unsigned int i = 0; i < threads; ++i)
+    workers.emplace_back(worker);
+
+  // progress is reported from the calling thread, it may drive a progress dialog
+  while (threads > 0 && !done.Wait(100ms))
+  {
+    if (progress && !progress(checked, m_files.size()))
+    {
+      cancelled = true;
+      break;
+    }
+  }
+
+  for (std::thread& thread : workers)
+    thread.join();
+
+  CLog::Log(LOGDEBUG, "CFileExistsChecker::{} - checked {} files in {} folders in {} ms{}",
+            __func__, checked.load(), folders.size(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count(),
+            cancelled ? " (cancelled)" : "");
+
+  return !cancelled;
+}
+
+void CFileExistsChecker::CheckFolder(const std::string& folder,
+                                     const std::vector<FileIterator>& files)
+{
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(folder, items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO))
+  {
+    // a folder may be unlistable while its files can still be opened, e.g. without read
+    // permission on it, so a failed listing alone doesn't mean the files are gone
+    for (const FileIterator& file : files)
+      file->second = CFile::Exists(file->first, false);
+    return;
+  }
+
+  items.SetFastLookup(true);
+  for (const FileIterator& file : files)
+  {
+    // files the listing doesn't have as such, e.g. hidden ones, get checked on their own
+    file->second = items.Contains(file->first) || CFile::Exists(file->first, true);
+  }
+}
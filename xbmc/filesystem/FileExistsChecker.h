@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace XFILE
+{
+/*!
+ \brief Checks whether many files exist, e.g. when cleaning a library.
+
+ The files are grouped by their folder. Every folder is listed once and its files are looked
+ up in the listing, rather than every file being checked on its own. Folders are listed by a
+ few threads at once, which hides the latency of network shares. Listings go through
+ CDirectory, so they are taken from and added to the directory cache.
+
+ The files of a folder which can't be listed are checked on their own, as they did exist before
+ (callers delete what is reported missing).
+ */
+class CFileExistsChecker
+{
+public:
+  static constexpr unsigned int DEFAULT_THREADS = 4;
+
+  /*!
+   \brief Called while checking with the number of files checked so far and the number of files.
+   \return false to cancel the check
+   */
+  using ProgressCallback = std::function<bool(size_t checked, size_t total)>;
+
+  explicit CFileExistsChecker(unsigned int maxThreads = DEFAULT_THREADS);
+
+  /*!
+   \brief Add a file to check.
+   */
+  void Add(const std::string& path);
+
+  /*!
+   \brief Check the files added.
+   \param progress called regularly from the calling thread while checking
+   \return false if the check was cancelled
+   */
+  bool Run(const ProgressCallback& progress = {});
+
+  /*!
+   \brief Whether a checked file exists.
+   */
+  bool Exists(const std::string& path) const;
+
+  size_t Size() const { return m_files.size(); }
+
+private:
+  using FileIterator = std::map<std::string, bool>::iterator;
+
+  static void CheckFolder(const std::string& folder, const std::vector<FileIterator>& files);
+
+  const unsigned int m_maxThreads;
+  std::map<std::string, bool> m_files;
+};
+} // namespace XFILE
@@ -12,6 +12,9 @@
 #include "TextureCache.h"
 #include "URL.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace XFILE;
 
 CImageFile::CImageFile(void) = default;
@@ -33,6 +36,10 @@ bool CImageFile::Open(const CURL& url)
   }
   if (!cachedFile.empty())
   { // in the cache, return what we have
+    m_packed = CServiceBroker::GetTextureCache()->GetPackedImage(cachedFile);
+    m_packedPosition = 0;
+    if (m_packed)
+      return true;
     if (m_file.Open(cachedFile))
       return true;
   }
@@ -46,7 +53,8 @@ bool CImageFile::Exists(const CURL& url)
       CServiceBroker::GetTextureCache()->CheckCachedImage(url.Get(), needsRecaching);
   if (!cachedFile.empty())
   {
-    if (CFile::Exists(cachedFile, false))
+    if (CServiceBroker::GetTextureCache()->GetPackedImage(cachedFile) ||
+        CFile::Exists(cachedFile, false))
       return true;
     else
       // Remove from cache so it gets cached again on next Open()
@@ -63,7 +71,17 @@ int CImageFile::Stat(const CURL& url, struct __stat64* buffer)
   std::string cachedFile =
       CServiceBroker::GetTextureCache()->CheckCachedImage(url.Get(), needsRecaching);
   if (!cachedFile.empty())
+  {
+    const auto packed = CServiceBroker::GetTextureCache()->GetPackedImage(cachedFile);
+    if (packed && buffer)
+    {
+      *buffer = {};
+      buffer->st_size = static_cast<int64_t>(packed->size);
+      buffer->st_mode = _S_IFREG;
+      return 0;
+    }
     return CFile::Stat(cachedFile, buffer);
+  }
 
   /*
    Doesn't exist in the cache yet. We have 3 options here:
@@ -79,25 +97,51 @@ int CImageFile::Stat(const CURL& url, struct __stat64* buffer)
 
 ssize_t CImageFile::Read(void* lpBuf, size_t uiBufSize)
 {
+  if (m_packed)
+  {
+    const size_t size = std::min(uiBufSize, m_packed->size - static_cast<size_t>(m_packedPosition));
+    memcpy(lpBuf, m_packed->data + m_packedPosition, size);
+    m_packedPosition += size;
+    return static_cast<ssize_t>(size);
+  }
   return m_file.Read(lpBuf, uiBufSize);
 }
 
 int64_t CImageFile::Seek(int64_t iFilePosition, int iWhence /*=SEEK_SET*/)
 {
+  if (m_packed)
+  {
+    if (iWhence == SEEK_CUR)
+      iFilePosition += m_packedPosition;
+    else if (iWhence == SEEK_END)
+      iFilePosition += static_cast<int64_t>(m_packed->size);
+    else if (iWhence != SEEK_SET)
+      return -1;
+    if (iFilePosition < 0 || iFilePosition > static_cast<int64_t>(m_packed->size))
+      return -1;
+    m_packedPosition = iFilePosition;
+    return m_packedPosition;
+  }
   return m_file.Seek(iFilePosition, iWhence);
 }
 
 void CImageFile::Close()
 {
+  m_packed.reset();
+  m_packedPosition = 0;
   m_file.Close();
 }
 
 int64_t CImageFile::GetPosition()
 {
+  if (m_packed)
+    return m_packedPosition;
   return m_file.GetPosition();
 }
 
 int64_t CImageFile::GetLength()
 {
+  if (m_packed)
+    return static_cast<int64_t>(m_packed->size);
   return m_file.GetLength();
 }
@@ -10,6 +10,9 @@
 
 #include "File.h"
 #include "IFile.h"
+#include "imagefiles/ImageCachePack.h"
+
+#include <optional>
 
 namespace XFILE
 {
@@ -30,5 +33,7 @@ namespace XFILE
 
   protected:
     CFile m_file;
+    std::optional<IMAGE_FILES::CImageCachePack::Blob> m_packed; //!< set when cached in the image pack
+    int64_t m_packedPosition = 0;
   };
 }
@@ -12,6 +12,7 @@
 
 #include "NFSFile.h"
 
+#include "NFSReadAhead.h"
 #include "ServiceBroker.h"
 #include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
@@ -600,19 +601,12 @@ CNFSFile::~CNFSFile()
 
 int64_t CNFSFile::GetPosition()
 {
-  int ret = 0;
-  uint64_t offset = 0;
   std::unique_lock<CCriticalSection> lock(gNfsConnection);
 
   if (gNfsConnection.GetNfsContext() == NULL || m_pFileHandle == NULL) return 0;
 
-  ret = nfs_lseek(gNfsConnection.GetNfsContext(), m_pFileHandle, 0, SEEK_CUR, &offset);
-
-  if (ret < 0)
-  {
-    CLog::Log(LOGERROR, "NFS: Failed to lseek({})", nfs_get_error(gNfsConnection.GetNfsContext()));
-  }
-  return offset;
+  // reads ahead don't move the offset of the file handle, so the position is tracked here
+  return m_position;
 }
 
 int64_t CNFSFile::GetLength()
@@ -679,6 +673,9 @@ bool CNFSFile::Open(const CURL& url)
   }
 
   m_fileSize = tmpBuffer.st_size;//cache the size of this file
+  m_position = 0;
+  m_readAhead = std::make_unique<CNFSReadAhead>(m_pNfsContext, m_pFileHandle,
+                                                gNfsConnection.GetMaxReadChunkSize());
   // We've successfully opened the file!
   return true;
 }
@@ -745,12 +742,18 @@ ssize_t CNFSFile::Read(void *lpBuf, size_t uiBufSize)
 
   if (m_pFileHandle == NULL || m_pNfsContext == NULL )
     return -1;
+  if (m_readAhead)
+    numberOfBytesRead = m_readAhead->Read(m_position, static_cast<uint8_t*>(lpBuf), uiBufSize);
+  else
 #ifdef LIBNFS_API_V2
-  numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, lpBuf, uiBufSize);
+    numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, lpBuf, uiBufSize);
 #else
-  numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, uiBufSize, (char *)lpBuf);
+    numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, uiBufSize, (char *)lpBuf);
 #endif
 
+  if (numberOfBytesRead > 0)
+    m_position += numberOfBytesRead;
+
   lock.unlock(); //no need to keep the connection lock after that
 
   gNfsConnection.resetKeepAlive(m_exportPath, m_pFileHandle);//triggers keep alive timer reset for this filehandle
@@ -771,6 +774,12 @@ int64_t CNFSFile::Seek(int64_t iFilePosition, int iWhence)
   std::unique_lock<CCriticalSection> lock(gNfsConnection);
   if (m_pFileHandle == NULL || m_pNfsContext == NULL) return -1;
 
+  // the offset of the file handle lags behind when reading ahead
+  if (iWhence == SEEK_CUR)
+  {
+    iFilePosition += m_position;
+    iWhence = SEEK_SET;
+  }
 
   ret = nfs_lseek(m_pNfsContext, m_pFileHandle, iFilePosition, iWhence, &offset);
   if (ret < 0)
@@ -779,7 +788,8 @@ int64_t CNFSFile::Seek(int64_t iFilePosition, int iWhence)
               iFilePosition, iWhence, m_fileSize, nfs_get_error(m_pNfsContext));
     return -1;
   }
-  return (int64_t)offset;
+  m_position = static_cast<int64_t>(offset);
+  return m_position;
 }
 
 int CNFSFile::Truncate(int64_t iSize)
@@ -811,6 +821,8 @@ void CNFSFile::Close()
     // remove it from keep alive list before closing
     // so keep alive code doesn't process it anymore
     gNfsConnection.removeFromKeepAliveList(m_pFileHandle);
+    // reads still in flight have to be done before the handle goes away
+    m_readAhead.reset();
     ret = nfs_close(m_pNfsContext, m_pFileHandle);
 
 	  if (ret < 0)
@@ -821,6 +833,7 @@ void CNFSFile::Close()
     m_pFileHandle = NULL;
     m_pNfsContext = NULL;
     m_fileSize = 0;
+    m_position = 0;
     m_exportPath.clear();
   }
 }
@@ -875,6 +888,7 @@ ssize_t CNFSFile::Write(const void* lpBuf, size_t uiBufSize)
       break;
     }
   }
+  m_position += numberOfBytesWritten;
   //return total number of written bytes
   return numberOfBytesWritten;
 }
@@ -983,6 +997,7 @@ bool CNFSFile::OpenForWrite(const CURL& url, bool bOverWrite)
   {
     m_fileSize = 0;
   }
+  m_position = 0;
 
   // We've successfully opened the file!
   return true;
@@ -17,6 +17,7 @@
 #include <chrono>
 #include <list>
 #include <map>
+#include <memory>
 
 struct nfs_stat_64;
 
@@ -108,6 +109,8 @@ extern CNfsConnection gNfsConnection;
 
 namespace XFILE
 {
+  class CNFSReadAhead;
+
   class CNFSFile : public IFile
   {
   public:
@@ -140,9 +143,11 @@ namespace XFILE
     CURL m_url;
     bool IsValidFile(const std::string& strFileName);
     int64_t m_fileSize = 0;
+    int64_t m_position = 0;
     struct nfsfh *m_pFileHandle;
     struct nfs_context *m_pNfsContext;//current nfs context
     std::string m_exportPath;
+    std::unique_ptr<CNFSReadAhead> m_readAhead;//pipelined reads for files opened for reading
   };
 }
 
@@ -0,0 +1,312 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "NFSReadAhead.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include <nfsc/libnfs.h>
+
+#ifdef TARGET_WINDOWS
+#include <WinSock2.h>
+#else
+#include <poll.h>
+#endif
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+CNFSReadWindow::CNFSReadWindow(uint64_t chunkSize, unsigned int maxWindow)
+  : m_chunkSize(std::max<uint64_t>(chunkSize, 1)),
+    m_maxWindow(std::max(maxWindow, MIN_WINDOW))
+{
+}
+
+void CNFSReadWindow::AddSample(uint64_t bytes,
+                               std::chrono::microseconds rtt,
+                               std::chrono::steady_clock::time_point now)
+{
+  m_minRtt = std::min(m_minRtt, std::max(rtt, std::chrono::microseconds(1)));
+
+  // an interval starts when its first read was issued
+  if (m_intervalStart == std::chrono::steady_clock::time_point{})
+    m_intervalStart = now - rtt;
+  m_intervalBytes += bytes;
+
+  // measure over a few round trips, single completions come in bursts
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_intervalStart);
+  if (elapsed < std::max<std::chrono::microseconds>(2 * m_minRtt, 10ms))
+    return;
+
+  m_maxBandwidth = std::max(m_maxBandwidth, m_intervalBytes * 1000000 / elapsed.count());
+  m_intervalStart = now;
+  m_intervalBytes = 0;
+  Update();
+}
+
+void CNFSReadWindow::Restart()
+{
+  m_intervalStart = {};
+  m_intervalBytes = 0;
+}
+
+void CNFSReadWindow::Update()
+{
+  const double bytesInFlight =
+      static_cast<double>(m_maxBandwidth) * static_cast<double>(m_minRtt.count()) / 1000000.0;
+  const auto window =
+      static_cast<unsigned int>(std::ceil(bytesInFlight / static_cast<double>(m_chunkSize))) +
+      HEADROOM;
+  m_window = std::clamp(window, MIN_WINDOW, m_maxWindow);
+}
+
+CNFSReadAhead::CNFSReadAhead(nfs_context* context, nfsfh* fileHandle, uint64_t chunkSize)
+  : m_context(context),
+    m_fileHandle(fileHandle),
+    m_chunkSize(std::max<uint64_t>(chunkSize, 4096)),
+    m_window(m_chunkSize, static_cast<unsigned int>(MAX_BYTES_IN_FLIGHT / m_chunkSize)),
+    m_created(std::chrono::steady_clock::now())
+{
+}
+
+CNFSReadAhead::~CNFSReadAhead()
+{
+  Restart(0);
+
+  // the buffers of reads in flight have to stay valid until libnfs is done with them
+  const auto end = std::chrono::steady_clock::now() + 5s;
+  while (!m_dropped.empty() && std::chrono::steady_clock::now() < end)
+  {
+    if (!Service())
+      break;
+  }
+
+  // reads which don't complete in time free themselves, e.g. when the context is destroyed
+  for (auto& request : m_dropped)
+    request.release()->owner = nullptr;
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - m_created);
+  if (m_bytesRead > 0)
+    CLog::Log(LOGDEBUG,
+              "CNFSReadAhead::{} - read {} bytes in {} ms, link bandwidth {} KiB/s, window {} "
+              "reads of {} bytes",
+              __func__, m_bytesRead, elapsed.count(), m_window.GetBandwidth() / 1024,
+              m_window.GetWindow(), m_chunkSize);
+}
+
+ssize_t CNFSReadAhead::Read(int64_t position, uint8_t* buffer, size_t size)
+{
+  if (size == 0)
+    return 0;
+
+  if (m_requests.empty() || position < m_requests.front()->offset || position >= m_nextOffset)
+  {
+    Restart(position);
+  }
+  else
+  {
+    // skip the reads before the position
+    while (m_requests.front()->offset + static_cast<int64_t>(m_chunkSize) <= position)
+    {
+      Drop(std::move(m_requests.front()));
+      m_requests.pop_front();
+    }
+  }
+
+  size_t copied = 0;
+  while (copied < size)
+  {
+    Fill();
+    if (m_requests.empty())
+      break;
+
+    Request& front = *m_requests.front();
+    // return what we have rather than waiting for the next read
+    if (!front.done && copied > 0)
+      break;
+
+    while (!front.done)
+    {
+      if (!Service())
+      {
+        Restart(position + copied);
+        return copied > 0 ? static_cast<ssize_t>(copied) : -1;
+      }
+    }
+
+    if (front.result < 0)
+    {
+      Restart(position + copied);
+      return copied > 0 ? static_cast<ssize_t>(copied) : -1;
+    }
+
+    const int64_t current = position + copied;
+    const size_t offset = static_cast<size_t>(current - front.offset);
+    if (static_cast<size_t>(front.result) <= offset)
+    {
+      // end of the file or a short read, read ahead from here again on the next call
+      Restart(current);
+      break;
+    }
+
+    const size_t length = std::min(static_cast<size_t>(front.result) - offset, size - copied);
+    std::memcpy(buffer + copied, front.data.data() + offset, length);
+    copied += length;
+
+    if (offset + length == front.data.size())
+    {
+      Recycle(std::move(m_requests.front()));
+      m_requests.pop_front();
+      m_consumed++;
+    }
+  }
+
+  m_bytesRead += copied;
+  return static_cast<ssize_t>(copied);
+}
+
+void CNFSReadAhead::Restart(int64_t position)
+{
+  for (auto& request : m_requests)
+    Drop(std::move(request));
+  m_requests.clear();
+
+  m_nextOffset = position;
+  m_consumed = 0;
+  m_window.Restart();
+}
+
+void CNFSReadAhead::Fill()
+{
+  // start with a single read after a seek and double up to the window while reading on
+  const unsigned int limit = std::min(m_window.GetWindow(), 1u << std::min(m_consumed, 16u));
+  while (m_requests.size() < limit)
+  {
+    if (!Issue())
+      break;
+  }
+}
+
+bool CNFSReadAhead::Issue()
+{
+  auto request = std::make_unique<Request>();
+  request->owner = this;
+  request->offset = m_nextOffset;
+  if (!m_buffers.empty())
+  {
+    request->data = std::move(m_buffers.back());
+    m_buffers.pop_back();
+  }
+  request->data.resize(m_chunkSize);
+  request->issued = std::chrono::steady_clock::now();
+
+#ifdef LIBNFS_API_V2
+  const int ret = nfs_pread_async(m_context, m_fileHandle, request->data.data(),
+                                  request->data.size(), request->offset, OnRead, request.get());
+#else
+  const int ret = nfs_pread_async(m_context, m_fileHandle, request->offset, request->data.size(),
+                                  OnRead, request.get());
+#endif
+  if (ret != 0)
+  {
+    CLog::Log(LOGERROR, "CNFSReadAhead::{} - unable to read at {}: {}", __func__,
+              request->offset, nfs_get_error(m_context));
+    Recycle(std::move(request));
+    return false;
+  }
+
+  m_nextOffset += m_chunkSize;
+  m_requests.push_back(std::move(request));
+  return true;
+}
+
+bool CNFSReadAhead::Service()
+{
+  pollfd pfd = {};
+  pfd.fd = nfs_get_fd(m_context);
+  pfd.events = static_cast<short>(nfs_which_events(m_context));
+
+#ifdef TARGET_WINDOWS
+  const int ret = WSAPoll(&pfd, 1, POLL_TIMEOUT_MS);
+#else
+  const int ret = poll(&pfd, 1, POLL_TIMEOUT_MS);
+#endif
+  if (ret < 0 && errno != EINTR)
+  {
+    CLog::Log(LOGERROR, "CNFSReadAhead::{} - poll failed: {}", __func__, strerror(errno));
+    return false;
+  }
+
+  if (nfs_service(m_context, ret > 0 ? pfd.revents : 0) < 0)
+  {
+    CLog::Log(LOGERROR, "CNFSReadAhead::{} - {}", __func__, nfs_get_error(m_context));
+    return false;
+  }
+
+  for (auto it = m_dropped.begin(); it != m_dropped.end();)
+  {
+    if ((*it)->done)
+    {
+      Recycle(std::move(*it));
+      it = m_dropped.erase(it);
+    }
+    else
+      ++it;
+  }
+  return true;
+}
+
+void CNFSReadAhead::Drop(std::unique_ptr<Request> request)
+{
+  if (request->done)
+    Recycle(std::move(request));
+  else
+    m_dropped.push_back(std::move(request));
+}
+
+void CNFSReadAhead::Recycle(std::unique_ptr<Request> request)
+{
+  m_buffers.push_back(std::move(request->data));
+}
+
+void CNFSReadAhead::OnRead(int status, nfs_context* context, void* data, void* privateData)
+{
+  auto* request = static_cast<Request*>(privateData);
+  if (!request->owner)
+  {
+    delete request;
+    return;
+  }
+
+  request->done = true;
+  if (status < 0)
+  {
+    request->result = -1;
+    CLog::Log(LOGERROR, "CNFSReadAhead::{} - read at {} failed: {}", __func__, request->offset,
+              data ? static_cast<const char*>(data) : "");
+    return;
+  }
+
+  request->result = std::min<ssize_t>(status, request->data.size());
+#ifndef LIBNFS_API_V2
+  // the data is only valid during the callback
+  std::memcpy(request->data.data(), data, request->result);
+#endif
+
+  const auto now = std::chrono::steady_clock::now();
+  request->owner->m_window.AddSample(
+      request->result, std::chrono::duration_cast<std::chrono::microseconds>(now - request->issued),
+      now);
+}
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <sys/types.h>
+
+struct nfs_context;
+struct nfsfh;
+
+namespace XFILE
+{
+/*!
+ \brief Estimates how many reads to keep in flight from the observed bandwidth and latency.
+
+ The window covers the bandwidth-delay product of the link, the highest bandwidth seen
+ times the lowest round trip time, plus some headroom. As long as the link is not
+ saturated the delivered bandwidth grows with the window, so the window keeps growing
+ until more reads in flight no longer raise the bandwidth.
+ */
+class CNFSReadWindow
+{
+public:
+  static constexpr unsigned int MIN_WINDOW = 2;
+  static constexpr unsigned int HEADROOM = 2;
+
+  CNFSReadWindow(uint64_t chunkSize, unsigned int maxWindow);
+
+  /*!
+   \brief Add a completed read.
+   \param bytes the number of bytes read
+   \param rtt the time from issuing the read until it completed
+   \param now the time the read completed
+   */
+  void AddSample(uint64_t bytes,
+                 std::chrono::microseconds rtt,
+                 std::chrono::steady_clock::time_point now);
+
+  /*!
+   \brief Start a new measurement interval, e.g. after a seek. The estimates are kept.
+   */
+  void Restart();
+
+  unsigned int GetWindow() const { return m_window; }
+  uint64_t GetBandwidth() const { return m_maxBandwidth; } ///< bytes per second
+
+private:
+  void Update();
+
+  const uint64_t m_chunkSize;
+  const unsigned int m_maxWindow;
+  unsigned int m_window{MIN_WINDOW};
+  uint64_t m_maxBandwidth{0};
+  std::chrono::microseconds m_minRtt{std::chrono::microseconds::max()};
+  std::chrono::steady_clock::time_point m_intervalStart;
+  uint64_t m_intervalBytes{0};
+};
+
+/*!
+ \brief Sequential read-ahead on an NFS file handle, using the asynchronous libnfs API.
+
+ Reads of a chunk each are kept in flight ahead of the read position, as many as
+ CNFSReadWindow estimates the link needs. Reading from another position drops the reads
+ ahead and starts with a single read again, so random access does not waste bandwidth.
+
+ All methods have to be called with the lock of the connection held, as the context is
+ shared with the other files of the export.
+ */
+class CNFSReadAhead
+{
+public:
+  CNFSReadAhead(nfs_context* context, nfsfh* fileHandle, uint64_t chunkSize);
+  ~CNFSReadAhead();
+  CNFSReadAhead(const CNFSReadAhead&) = delete;
+  CNFSReadAhead& operator=(const CNFSReadAhead&) = delete;
+
+  /*!
+   \brief Read from the file.
+   \param position the position to read from
+   \param buffer the buffer to read to
+   \param size the size of the buffer
+   \return the number of bytes read, 0 at the end of the file, -1 on error
+   */
+  ssize_t Read(int64_t position, uint8_t* buffer, size_t size);
+
+  unsigned int GetWindow() const { return m_window.GetWindow(); }
+
+private:
+  struct Request
+  {
+    CNFSReadAhead* owner;
+    int64_t offset;
+    std::vector<uint8_t> data;
+    ssize_t result{0};
+    bool done{false};
+    std::chrono::steady_clock::time_point issued;
+  };
+
+  static constexpr uint64_t MAX_BYTES_IN_FLIGHT = 16 * 1024 * 1024;
+  static constexpr int POLL_TIMEOUT_MS = 100;
+
+  void Restart(int64_t position);
+  void Fill();
+  bool Issue();
+  bool Service();
+  void Drop(std::unique_ptr<Request> request);
+  void Recycle(std::unique_ptr<Request> request);
+  static void OnRead(int status, nfs_context* context, void* data, void* privateData);
+
+  nfs_context* m_context;
+  nfsfh* m_fileHandle;
+  const uint64_t m_chunkSize;
+  CNFSReadWindow m_window;
+  std::deque<std::unique_ptr<Request>> m_requests; ///< reads ahead, in order of their offsets
+  std::vector<std::unique_ptr<Request>> m_dropped; ///< reads still in flight after a seek
+  std::vector<std::vector<uint8_t>> m_buffers;
+  int64_t m_nextOffset{0};
+  unsigned int m_consumed{0}; ///< chunks consumed since the last seek
+  uint64_t m_bytesRead{0};
+  std::chrono::steady_clock::time_point m_created;
+};
+} // namespace XFILE
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/FileExistsChecker.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/URIUtils.h"
+
+#include <string>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include <sys/stat.h>
+#endif
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+class TestFileExistsChecker : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_root = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                       "TestFileExistsChecker");
+    URIUtils::AddSlashAtEnd(m_root);
+    for (int folder = 0; folder < 10; ++folder)
+    {
+      const std::string path = URIUtils::AddFileToFolder(m_root, std::to_string(folder));
+      ASSERT_TRUE(CDirectory::Create(path));
+      for (int file = 0; file < 5; ++file)
+      {
+        CFile out;
+        const std::string filePath =
+            URIUtils::AddFileToFolder(path, std::to_string(file) + ".mkv");
+        ASSERT_TRUE(out.OpenForWrite(filePath, true));
+        m_files.push_back(filePath);
+      }
+    }
+  }
+
+  void TearDown() override { CDirectory::RemoveRecursive(m_root); }
+
+  std::string m_root;
+  std::vector<std::string> m_files;
+};
+
+TEST_F(TestFileExistsChecker, Exists)
+{
+  CFileExistsChecker checker(3);
+  for (const std::string& file : m_files)
+    checker.Add(file);
+
+  const std::string missingFile = URIUtils::AddFileToFolder(m_root, "0", "missing.mkv");
+  const std::string missingFolder = URIUtils::AddFileToFolder(m_root, "missing", "0.mkv");
+  checker.Add(missingFile);
+  checker.Add(missingFolder);
+  EXPECT_EQ(m_files.size() + 2, checker.Size());
+
+  EXPECT_TRUE(checker.Run());
+
+  for (const std::string& file : m_files)
+    EXPECT_TRUE(checker.Exists(file)) << file;
+  EXPECT_FALSE(checker.Exists(missingFile));
+  EXPECT_FALSE(checker.Exists(missingFolder));
+  EXPECT_FALSE(checker.Exists("not/added.mkv"));
+}
+
+#if defined(TARGET_POSIX)
+TEST_F(TestFileExistsChecker, UnlistableFolder)
+{
+  // the files of a folder without read permission can be opened, but not listed
+  const std::string folder = URIUtils::AddFileToFolder(m_root, "0");
+  ASSERT_EQ(0, chmod(folder.c_str(), S_IWUSR | S_IXUSR));
+
+  CFileExistsChecker checker;
+  for (const std::string& file : m_files)
+    checker.Add(file);
+  const std::string missingFile = URIUtils::AddFileToFolder(folder, "missing.mkv");
+  checker.Add(missingFile);
+
+  EXPECT_TRUE(checker.Run());
+  chmod(folder.c_str(), S_IRWXU);
+
+  for (const std::string& file : m_files)
+    EXPECT_TRUE(checker.Exists(file)) << file;
+  EXPECT_FALSE(checker.Exists(missingFile));
+}
+#endif
+
+TEST_F(TestFileExistsChecker, Progress)
+{
+  CFileExistsChecker checker;
+  for (const std::string& file : m_files)
+    checker.Add(file);
+
+  size_t last = 0;
+  EXPECT_TRUE(checker.Run(
+      [&last](size_t checked, size_t total)
+      {
+        EXPECT_GE(checked, last);
+        EXPECT_LE(checked, total);
+        last = checked;
+        return true;
+      }));
+}
+
+TEST_F(TestFileExistsChecker, Cancel)
+{
+  CFileExistsChecker checker(1);
+  for (const std::string& file : m_files)
+    checker.Add(file);
+
+  // cancelling stops the check, unless it's done before the first progress report
+  bool reported = false;
+  const bool done = checker.Run(
+      [&reported](size_t, size_t)
+      {
+        reported = true;
+        return false;
+      });
+  EXPECT_EQ(!reported, done);
+}
+
+TEST(TestFileExistsCheckerEmpty, Run)
+{
+  CFileExistsChecker checker;
+  EXPECT_TRUE(checker.Run([](size_t, size_t) { return false; }));
+  EXPECT_EQ(0u, checker.Size());
+}
@@ -8,10 +8,17 @@
 
 #include "URL.h"
 #include "filesystem/NFSFile.h"
+#include "filesystem/NFSReadAhead.h"
 #include "test/TestUtils.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <errno.h>
+#include <iostream>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -82,3 +89,138 @@ TEST_P(TestNfs, splitUrlIntoExportAndPath)
 }
 
 INSTANTIATE_TEST_SUITE_P(NfsFile, TestNfs, ValuesIn(g_TestData));
+
+using namespace std::chrono_literals;
+
+TEST(TestNfsReadWindow, GrowsWithBandwidth)
+{
+  constexpr uint64_t CHUNK = 128 * 1024;
+  XFILE::CNFSReadWindow window(CHUNK, 64);
+  EXPECT_EQ(XFILE::CNFSReadWindow::MIN_WINDOW, window.GetWindow());
+
+  // the delivered bandwidth follows the window as long as the link is not saturated
+  auto now = std::chrono::steady_clock::now();
+  for (int round = 0; round < 20; ++round)
+  {
+    const unsigned int reads = window.GetWindow();
+    now += 10ms;
+    for (unsigned int i = 0; i < reads; ++i)
+      window.AddSample(CHUNK, 10ms, now);
+    EXPECT_GE(window.GetWindow(), reads);
+  }
+  EXPECT_GT(window.GetWindow(), 10u);
+}
+
+TEST(TestNfsReadWindow, CoversBandwidthDelayProduct)
+{
+  constexpr uint64_t CHUNK = 1024 * 1024;
+  XFILE::CNFSReadWindow window(CHUNK, 64);
+
+  // 100 MiB/s with 20 ms round trips, 2 MiB in flight
+  auto now = std::chrono::steady_clock::now();
+  for (int i = 0; i < 100; ++i)
+  {
+    now += 10ms;
+    window.AddSample(CHUNK, 20ms, now);
+  }
+  EXPECT_EQ(100u * 1024 * 1024, window.GetBandwidth());
+  EXPECT_EQ(2 + XFILE::CNFSReadWindow::HEADROOM, window.GetWindow());
+}
+
+TEST(TestNfsReadWindow, Limited)
+{
+  constexpr uint64_t CHUNK = 64 * 1024;
+  XFILE::CNFSReadWindow window(CHUNK, 8);
+
+  auto now = std::chrono::steady_clock::now();
+  for (int i = 0; i < 100; ++i)
+  {
+    now += 1ms;
+    window.AddSample(CHUNK * 100, 50ms, now);
+  }
+  EXPECT_EQ(8u, window.GetWindow());
+}
+
+namespace
+{
+// KODI_TEST_NFS_FILE has to hold the url of a large file on an NFS server, e.g. of a
+// local nfsd exporting a folder: nfs://127.0.0.1/srv/test/large.bin
+bool GetTestFile(CURL& url)
+{
+  const char* file = getenv("KODI_TEST_NFS_FILE");
+  if (!file || file[0] == '\0')
+    return false;
+  url = CURL(file);
+  return true;
+}
+} // unnamed namespace
+
+TEST(TestNfsReadAhead, SeekAndRead)
+{
+  CURL url;
+  if (!GetTestFile(url))
+    GTEST_SKIP() << "KODI_TEST_NFS_FILE is not set";
+
+  XFILE::CNFSFile sequential;
+  ASSERT_TRUE(sequential.Open(url));
+  std::vector<uint8_t> data(
+      static_cast<size_t>(std::min<int64_t>(sequential.GetLength(), 64 * 1024 * 1024)));
+  size_t offset = 0;
+  while (offset < data.size())
+  {
+    const ssize_t read = sequential.Read(data.data() + offset, data.size() - offset);
+    ASSERT_GT(read, 0);
+    offset += read;
+  }
+  EXPECT_EQ(static_cast<int64_t>(data.size()), sequential.GetPosition());
+
+  XFILE::CNFSFile random;
+  ASSERT_TRUE(random.Open(url));
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<size_t> position(0, data.size() - 1);
+  std::vector<uint8_t> buffer(256 * 1024);
+  for (int i = 0; i < 100; ++i)
+  {
+    const size_t start = position(generator);
+    ASSERT_EQ(static_cast<int64_t>(start), random.Seek(start, SEEK_SET));
+    // a few reads on, to get reads ahead dropped on the next seek
+    for (int j = 0; j < 4 && start + j * buffer.size() < data.size(); ++j)
+    {
+      const size_t current = start + j * buffer.size();
+      const size_t size = std::min(buffer.size(), data.size() - current);
+      size_t got = 0;
+      while (got < size)
+      {
+        const ssize_t read = random.Read(buffer.data() + got, size - got);
+        ASSERT_GT(read, 0);
+        got += read;
+      }
+      ASSERT_TRUE(std::equal(buffer.begin(), buffer.begin() + size, data.begin() + current))
+          << "at " << current;
+    }
+  }
+}
+
+// Sequential read throughput against an NFS server, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestNfsReadAhead.DISABLED_Benchmark
+TEST(TestNfsReadAhead, DISABLED_Benchmark)
+{
+  CURL url;
+  if (!GetTestFile(url))
+    GTEST_SKIP() << "KODI_TEST_NFS_FILE is not set";
+
+  XFILE::CNFSFile file;
+  ASSERT_TRUE(file.Open(url));
+
+  std::vector<uint8_t> buffer(file.GetChunkSize());
+  uint64_t total = 0;
+  const auto start = std::chrono::steady_clock::now();
+  ssize_t read;
+  while ((read = file.Read(buffer.data(), buffer.size())) > 0)
+    total += read;
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(file.GetLength(), static_cast<int64_t>(total));
+  std::cout << total / (1024 * 1024) << " MiB in " << elapsed.count() << " s: "
+            << total / (1024 * 1024) / elapsed.count() << " MiB/s" << std::endl;
+}
@@ -114,6 +114,65 @@ static int64_t mem_file_seek(void *h, int64_t pos, int whence)
   return mbuf->pos;
 }
 
+namespace
+{
+// Reads the image size from the start of frame segment of a JPEG file
+bool GetJpegSize(const uint8_t* buffer, size_t size, unsigned int& width, unsigned int& height)
+{
+  size_t pos = 2; // skip SOI
+  while (pos + 4 <= size)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+    const uint8_t marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    { // fill byte
+      pos++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+    { // standalone markers
+      pos += 2;
+      continue;
+    }
+    if (marker == 0xDA) // start of scan without a frame header
+      return false;
+
+    const size_t length = (buffer[pos + 2] << 8) | buffer[pos + 3];
+    // SOF0 - SOF15, except DHT, JPG and DAC
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+    {
+      if (pos + 9 > size)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    pos += 2 + length;
+  }
+  return false;
+}
+
+/*!
+ \brief Largest power of two to reduce the resolution by while decoding, so that the image still
+ covers its size when scaled down to fit within fitWidth x fitHeight
+ */
+int GetLowres(unsigned int width,
+              unsigned int height,
+              unsigned int fitWidth,
+              unsigned int fitHeight,
+              int maxLowres)
+{
+  const double scale = std::min({1.0, static_cast<double>(fitWidth) / width,
+                                 static_cast<double>(fitHeight) / height});
+  int lowres = 0;
+  while (lowres < maxLowres && (width >> (lowres + 1)) >= scale * width &&
+         (height >> (lowres + 1)) >= scale * height)
+    lowres++;
+  return lowres;
+}
+} // unnamed namespace
+
 CFFmpegImage::CFFmpegImage(const std::string& strMimeType) : m_strMimeType(strMimeType)
 {
   m_hasAlpha = false;
@@ -143,7 +202,7 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
                                       unsigned int width, unsigned int height)
 {
 
-  if (!Initialize(buffer, bufSize))
+  if (!Initialize(buffer, bufSize, width, height))
   {
     //log
     return false;
@@ -155,7 +214,10 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   return !(m_pFrame == nullptr);
 }
 
-bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
+bool CFFmpegImage::Initialize(unsigned char* buffer,
+                              size_t bufSize,
+                              unsigned int fitWidth /* = 0 */,
+                              unsigned int fitHeight /* = 0 */)
 {
   int bufferSize = 4096;
   uint8_t* fbuffer = (uint8_t*)av_malloc(bufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
@@ -262,6 +324,18 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
+  // let the JPEG decoder skip detail that won't survive downscaling (IDCT scaling)
+  unsigned int jpegWidth = 0;
+  unsigned int jpegHeight = 0;
+  if (is_jpeg && fitWidth > 0 && fitHeight > 0 && codec->max_lowres > 0 &&
+      GetJpegSize(buffer, bufSize, jpegWidth, jpegHeight))
+  {
+    m_codec_ctx->lowres = GetLowres(jpegWidth, jpegHeight, fitWidth, fitHeight, codec->max_lowres);
+    if (m_codec_ctx->lowres > 0)
+      CLog::LogF(LOGDEBUG, "decoding {}x{} image at 1/{} resolution", jpegWidth, jpegHeight,
+                 1 << m_codec_ctx->lowres);
+  }
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
@@ -314,8 +388,16 @@ AVFrame* CFFmpegImage::ExtractFrame()
 
   m_height = frame->height;
   m_width = frame->width;
-  m_originalWidth = m_width;
-  m_originalHeight = m_height;
+  if (m_codec_ctx->lowres > 0)
+  { // coded size is the size before reducing the resolution
+    m_originalWidth = m_codec_ctx->coded_width;
+    m_originalHeight = m_codec_ctx->coded_height;
+  }
+  else
+  {
+    m_originalWidth = m_width;
+    m_originalHeight = m_height;
+  }
 
   const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
   if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -487,7 +569,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
   AVColorRange range = frame->color_range;
   AVPixelFormat pixFormat = ConvertFormats(frame);
 
-  SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat, width, height,
+  SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat, width, height,
                                        AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -500,7 +582,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
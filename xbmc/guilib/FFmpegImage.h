@@ -60,6 +60,11 @@ public:
   explicit CFFmpegImage(const std::string& strMimeType);
   ~CFFmpegImage() override;
 
+  /*!
+   \brief Load an image, see IImage::LoadImageFromMemory
+   JPEG images are decoded at a resolution reduced by a power of two where that still covers the
+   image scaled down to fit within width x height. Width() and Height() return the decoded size.
+   */
   bool LoadImageFromMemory(unsigned char* buffer, unsigned int bufSize,
                            unsigned int width, unsigned int height) override;
   bool Decode(unsigned char * const pixels, unsigned int width, unsigned int height,
@@ -71,7 +76,10 @@ public:
                                   unsigned int &bufferoutSize) override;
   void ReleaseThumbnailBuffer() override;
 
-  bool Initialize(unsigned char* buffer, size_t bufSize);
+  bool Initialize(unsigned char* buffer,
+                  size_t bufSize,
+                  unsigned int fitWidth = 0,
+                  unsigned int fitHeight = 0);
 
   std::shared_ptr<Frame> ReadFrame();
 
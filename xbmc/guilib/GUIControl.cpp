@@ -180,7 +180,7 @@ void CGUIControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregio
 // 3. reset the animation transform
 void CGUIControl::DoRender()
 {
-  if (IsControlRenderable() &&
+  if (IsRenderRegionBounding() &&
       !m_renderRegion.Intersects(CServiceBroker::GetWinSystem()->GetGfxContext().GetScissors()))
     return;
 
@@ -981,6 +981,13 @@ bool CGUIControl::IsControlRenderable()
   }
 }
 
+bool CGUIControl::IsRenderRegionBounding() const
+{
+  // groups and lists union the render regions of their children, containers clip their
+  // items to their own region. The EPG grid lays out rulers and channels on its own.
+  return ControlType != GUICONTAINER_EPGGRID;
+}
+
 void CGUIControl::SetHitRect(const CRect& rect, const KODI::UTILS::COLOR::Color& color)
 {
   m_hitRect = rect;
@@ -312,6 +312,14 @@ public:
    */
   bool IsControlRenderable();
 
+  /*! \brief Test whether everything the control renders lies within its render region.
+   Groups include their children in their render region, so whole subtrees can be skipped
+   when rendering areas of the screen they don't intersect. The render regions computed in
+   Process() are used as they are, there is no separate spatial index of the controls.
+   \return true if rendering can be skipped when the render region is outside the scissors
+   */
+  virtual bool IsRenderRegionBounding() const;
+
   enum GUIVISIBLE { HIDDEN = 0, DELAYED, VISIBLE };
 
   enum GUISCROLLVALUE { FOCUS = 0, NEVER, ALWAYS };
@@ -11,6 +11,7 @@
 #include "GUIMessage.h"
 #include "input/mouse/MouseEvent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
@@ -500,6 +501,8 @@ void CGUIControlGroup::AddControl(CGUIControl *control, int position /* = -1*/)
   control->SetControlStats(m_controlStats);
   control->SetPushUpdates(m_pushedUpdates);
   AddLookup(control);
+  if (!control->IsRenderRegionBounding())
+    UpdateRenderRegionBounding();
   SetInvalid();
 }
 
@@ -542,6 +545,8 @@ bool CGUIControlGroup::RemoveControl(const CGUIControl *control)
     {
       m_children.erase(it);
       RemoveLookup(child);
+      if (!child->IsRenderRegionBounding())
+        UpdateRenderRegionBounding();
       SetInvalid();
       return true;
     }
@@ -554,17 +559,33 @@ void CGUIControlGroup::ClearAll()
   // first remove from the lookup table
   RemoveLookup();
 
-  // and delete all our children
-  for (auto *control : m_children)
+  // and delete all our children, which are already out of the list when their
+  // ClearAll() updates our render region bounding
+  std::vector<CGUIControl*> children;
+  children.swap(m_children);
+  for (auto *control : children)
   {
     delete control;
   }
   m_focusedControl = 0;
-  m_children.clear();
   ClearLookup();
+  UpdateRenderRegionBounding();
   SetInvalid();
 }
 
+void CGUIControlGroup::UpdateRenderRegionBounding()
+{
+  const bool bounding = std::all_of(m_children.begin(), m_children.end(),
+                                    [](const CGUIControl* control)
+                                    { return control->IsRenderRegionBounding(); });
+  if (bounding == m_renderRegionBounding)
+    return;
+
+  m_renderRegionBounding = bounding;
+  if (m_parentControl && m_parentControl->IsGroup())
+    static_cast<CGUIControlGroup*>(m_parentControl)->UpdateRenderRegionBounding();
+}
+
 #ifdef _DEBUG
 void CGUIControlGroup::DumpTextureUse()
 {
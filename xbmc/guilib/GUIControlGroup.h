@@ -73,6 +73,9 @@ public:
 
   bool IsGroup() const override { return true; }
 
+  // the group bounds its children, unless one of them renders outside its own region
+  bool IsRenderRegionBounding() const override { return m_renderRegionBounding; }
+
 #ifdef _DEBUG
   void DumpTextureUse() override;
 #endif
@@ -90,6 +93,13 @@ protected:
   int m_focusedControl;
   bool m_renderFocusedLast;
 private:
+  /*! \brief Recompute whether all children are bounded by their render region, and pass changes
+   on to the parent groups
+   */
+  void UpdateRenderRegionBounding();
+
+  bool m_renderRegionBounding = true;
+
   typedef std::vector< std::vector<CGUIControl *> * > COLLECTORTYPE;
 
   struct IDCollectorList
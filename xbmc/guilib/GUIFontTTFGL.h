@@ -9,6 +9,8 @@
 #pragma once
 
 #include "GUIFontTTF.h"
+#include "rendering/MatrixGL.h"
+#include "utils/Geometry.h"
 
 #include <string>
 #include <vector>
@@ -56,5 +58,16 @@ private:
 
   static bool m_staticVertexBufferCreated;
 
+  //! text drawn from the GUI render queue
+  struct CQueuedText
+  {
+    GLuint bufferHandle;
+    size_t size;
+    CRect clip;
+    float clipBoundaries[4];
+    CMatrixGL matrix;
+    float depth;
+  };
+
   bool m_scissorClip{false};
 };
@@ -22,8 +22,13 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 // stuff for freetype
 #include <ft2build.h>
@@ -56,23 +61,9 @@ CGUIFontTTFGLES::~CGUIFontTTFGLES(void)
 
 bool CGUIFontTTFGLES::FirstBegin()
 {
-  CRenderSystemGLES* renderSystem =
-      dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
-  renderSystem->EnableGUIShader(ShaderMethodGLES::SM_FONTS);
   GLenum pixformat = GL_ALPHA; // deprecated
   GLenum internalFormat = GL_ALPHA;
 
-  if (renderSystem->ScissorsCanEffectClipping())
-  {
-    m_scissorClip = true;
-  }
-  else
-  {
-    m_scissorClip = false;
-    renderSystem->ResetScissors();
-    renderSystem->EnableGUIShader(ShaderMethodGLES::SM_FONTS_SHADER_CLIP);
-  }
-
   if (m_textureStatus == TEXTURE_REALLOCATED)
   {
     if (glIsTexture(m_nTexture))
@@ -124,12 +115,7 @@ bool CGUIFontTTFGLES::FirstBegin()
     m_textureStatus = TEXTURE_READY;
   }
 
-  // Turn Blending On
-  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-  glEnable(GL_BLEND);
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, m_nTexture);
-
+  // shader, blending and texture are set up when the text is drawn from the render queue
   return true;
 }
 
@@ -145,147 +131,227 @@ void CGUIFontTTFGLES::LastEnd()
   CRenderSystemGLES* renderSystem =
       dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
 
-  GLint posLoc = renderSystem->GUIShaderGetPos();
-  GLint colLoc = renderSystem->GUIShaderGetCol();
-  GLint tex0Loc = renderSystem->GUIShaderGetCoord0();
-  GLint clipUniformLoc = renderSystem->GUIShaderGetClip();
-  GLint coordStepUniformLoc = renderSystem->GUIShaderGetCoordStep();
-  GLint matrixUniformLoc = renderSystem->GUIShaderGetMatrix();
-  GLint depthLoc = renderSystem->GUIShaderGetDepth();
+  // the clip factors of the shader decide whether scissors can be used for clipping
+  ShaderMethodGLES shader = ShaderMethodGLES::SM_FONTS;
+  renderSystem->EnableQueuedGUIShader(shader);
+  m_scissorClip = renderSystem->ScissorsCanEffectClipping();
+  if (!m_scissorClip)
+  {
+    shader = ShaderMethodGLES::SM_FONTS_SHADER_CLIP;
+    renderSystem->EnableQueuedGUIShader(shader);
+  }
 
   CreateStaticVertexBuffers();
 
-  // Enable the attributes used by this shader
-  glEnableVertexAttribArray(posLoc);
-  glEnableVertexAttribArray(colLoc);
-  glEnableVertexAttribArray(tex0Loc);
+  CGraphicContext& context = winSystem->GetGfxContext();
+  const TransformMatrix& guiMatrix = context.GetGUIMatrix();
+  // Store current scissor
+  const CRect scissor = context.StereoCorrection(context.GetScissors());
+
+  // The text is drawn from the GUI render queue, everything it needs from the
+  // current context is captured here
+  std::vector<CQueuedText> queued;
+  queued.reserve(m_vertexTrans.size());
+  CRect bounds;
 
-  if (!m_vertexTrans.empty())
+  for (size_t i = 0; i < m_vertexTrans.size(); i++)
   {
-    // Deal with the vertices that can be hardware clipped and therefore translated
+    const CVertexBuffer* vertexBuffer = m_vertexTrans[i].m_vertexBuffer;
+    if (vertexBuffer->bufferHandle == 0)
+    {
+      continue;
+    }
 
-    // Bind our pre-calculated array to GL_ELEMENT_ARRAY_BUFFER
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
-    // Store current scissor
-    CGraphicContext& context = winSystem->GetGfxContext();
-    CRect scissor = context.StereoCorrection(context.GetScissors());
+    CQueuedText text{};
+    text.bufferHandle = vertexBuffer->bufferHandle;
+    text.size = vertexBuffer->size;
 
-    for (size_t i = 0; i < m_vertexTrans.size(); i++)
+    // Apply the clip rectangle
+    text.clip = renderSystem->ClipRectToScissorRect(m_vertexTrans[i].m_clip);
+    if (!text.clip.IsEmpty())
     {
-      if (m_vertexTrans[i].m_vertexBuffer->bufferHandle == 0)
-      {
+      // intersect with current scissor
+      text.clip.Intersect(scissor);
+      // skip empty clip
+      if (text.clip.IsEmpty())
         continue;
-      }
+    }
 
-      // Apply the clip rectangle
-      CRect clip = renderSystem->ClipRectToScissorRect(m_vertexTrans[i].m_clip);
-      if (!clip.IsEmpty())
-      {
-        // intersect with current scissor
-        clip.Intersect(scissor);
-        // skip empty clip
-        if (clip.IsEmpty())
-          continue;
-      }
-      if (m_scissorClip)
-      {
-        // clip using scissors
-        renderSystem->SetScissors(clip);
-      }
-      else
-      {
-        // clip using vertex shader
-        renderSystem->ResetScissors();
-
-        const float clipBoundaries[4] = {
-            (m_vertexTrans[i].m_clip.x1 - m_vertexTrans[i].m_translateX -
-             m_vertexTrans[i].m_offsetX) /
-                context.GetGUIScaleX(),
-            (m_vertexTrans[i].m_clip.y1 - m_vertexTrans[i].m_translateY -
-             m_vertexTrans[i].m_offsetY) /
-                context.GetGUIScaleY(),
-            (m_vertexTrans[i].m_clip.x2 - m_vertexTrans[i].m_translateX -
-             m_vertexTrans[i].m_offsetX) /
-                context.GetGUIScaleX(),
-            (m_vertexTrans[i].m_clip.y2 - m_vertexTrans[i].m_translateY -
-             m_vertexTrans[i].m_offsetY) /
-                context.GetGUIScaleY()};
-
-        glUniform4fv(clipUniformLoc, 1, clipBoundaries);
-
-        const float textureSteps[4] = {1.f / static_cast<float>(m_textureWidth),
-                                       1.f / static_cast<float>(m_textureHeight), 1.f, 1.f};
-
-        glUniform4fv(coordStepUniformLoc, 1, textureSteps);
-      }
+    if (!m_scissorClip)
+    {
+      // clip using vertex shader
+      text.clipBoundaries[0] =
+          (m_vertexTrans[i].m_clip.x1 - m_vertexTrans[i].m_translateX - m_vertexTrans[i].m_offsetX) /
+          context.GetGUIScaleX();
+      text.clipBoundaries[1] =
+          (m_vertexTrans[i].m_clip.y1 - m_vertexTrans[i].m_translateY - m_vertexTrans[i].m_offsetY) /
+          context.GetGUIScaleY();
+      text.clipBoundaries[2] =
+          (m_vertexTrans[i].m_clip.x2 - m_vertexTrans[i].m_translateX - m_vertexTrans[i].m_offsetX) /
+          context.GetGUIScaleX();
+      text.clipBoundaries[3] =
+          (m_vertexTrans[i].m_clip.y2 - m_vertexTrans[i].m_translateY - m_vertexTrans[i].m_offsetY) /
+          context.GetGUIScaleY();
+    }
 
-      // calculate the fractional offset to the ideal position
-      float fractX =
-          context.ScaleFinalXCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
-      float fractY =
-          context.ScaleFinalYCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
-      fractX = -fractX + std::round(fractX);
-      fractY = -fractY + std::round(fractY);
-
-      // proj * model * gui * scroll * translation * scaling * correction factor
-      CMatrixGL matrix = glMatrixProject.Get();
-      matrix.MultMatrixf(glMatrixModview.Get());
-      matrix.MultMatrixf(CMatrixGL(context.GetGUIMatrix()));
-      matrix.Translatef(m_vertexTrans[i].m_offsetX, m_vertexTrans[i].m_offsetY, 0.0f);
-      matrix.Translatef(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY, 0.0f);
-      // the gui matrix messes with the scale. correct it here for now.
-      matrix.Scalef(context.GetGUIScaleX(), context.GetGUIScaleY(), 1.0f);
-      // the gui matrix doesn't align to exact pixel coords atm. correct it here for now.
-      matrix.Translatef(fractX, fractY, 0.0f);
-
-      // Apply the depth value of the layer
-      float depth = CServiceBroker::GetWinSystem()->GetGfxContext().GetTransformDepth();
-      glUniform1f(depthLoc, depth);
-
-      glUniformMatrix4fv(matrixUniformLoc, 1, GL_FALSE, matrix);
-
-      // Bind the buffer to the OpenGL context's GL_ARRAY_BUFFER binding point
-      glBindBuffer(GL_ARRAY_BUFFER, m_vertexTrans[i].m_vertexBuffer->bufferHandle);
-
-      // Do the actual drawing operation, split into groups of characters no
-      // larger than the pre-determined size of the element array
-      for (size_t character = 0; m_vertexTrans[i].m_vertexBuffer->size > character;
-           character += ELEMENT_ARRAY_MAX_CHAR_INDEX)
+    // calculate the fractional offset to the ideal position
+    float fractX =
+        context.ScaleFinalXCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
+    float fractY =
+        context.ScaleFinalYCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
+    fractX = -fractX + std::round(fractX);
+    fractY = -fractY + std::round(fractY);
+
+    // proj * model * gui * scroll * translation * scaling * correction factor
+    CMatrixGL matrix = glMatrixProject.Get();
+    matrix.MultMatrixf(glMatrixModview.Get());
+    matrix.MultMatrixf(CMatrixGL(guiMatrix));
+    matrix.Translatef(m_vertexTrans[i].m_offsetX, m_vertexTrans[i].m_offsetY, 0.0f);
+    matrix.Translatef(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY, 0.0f);
+    // the gui matrix messes with the scale. correct it here for now.
+    matrix.Scalef(context.GetGUIScaleX(), context.GetGUIScaleY(), 1.0f);
+    // the gui matrix doesn't align to exact pixel coords atm. correct it here for now.
+    matrix.Translatef(fractX, fractY, 0.0f);
+    text.matrix = matrix;
+
+    // Apply the depth value of the layer
+    text.depth = context.GetTransformDepth();
+
+    // screen area of the text, in the coordinates used for GUI textures
+    const CRect& local = vertexBuffer->bounds;
+    if (local.IsEmpty())
+    {
+      bounds = CRect(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    }
+    else
+    {
+      const float originX = m_vertexTrans[i].m_offsetX + m_vertexTrans[i].m_translateX;
+      const float originY = m_vertexTrans[i].m_offsetY + m_vertexTrans[i].m_translateY;
+      const float xs[2] = {originX + context.GetGUIScaleX() * (local.x1 + fractX),
+                           originX + context.GetGUIScaleX() * (local.x2 + fractX)};
+      const float ys[2] = {originY + context.GetGUIScaleY() * (local.y1 + fractY),
+                           originY + context.GetGUIScaleY() * (local.y2 + fractY)};
+      for (float x : xs)
       {
-        size_t count = m_vertexTrans[i].m_vertexBuffer->size - character;
-        count = std::min<size_t>(count, ELEMENT_ARRAY_MAX_CHAR_INDEX);
-
-        // Set up the offsets of the various vertex attributes within the buffer
-        // object bound to GL_ARRAY_BUFFER
-        glVertexAttribPointer(
-            posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, x)));
-        glVertexAttribPointer(
-            colLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, r)));
-        glVertexAttribPointer(
-            tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
-
-        glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+        for (float y : ys)
+        {
+          const float screenX = guiMatrix.TransformXCoord(x, y, 0);
+          const float screenY = guiMatrix.TransformYCoord(x, y, 0);
+          // a pixel of slack for filtering
+          const CRect corner(screenX - 1, screenY - 1, screenX + 1, screenY + 1);
+          if (bounds.IsEmpty())
+            bounds = corner;
+          else
+            bounds.Union(corner);
+        }
       }
-
-      glMatrixModview.Pop();
     }
-    // Restore the original scissor rectangle
-    if (m_scissorClip)
-      renderSystem->SetScissors(scissor);
-    // Unbind GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-  }
 
-  // Disable the attributes used by this shader
-  glDisableVertexAttribArray(posLoc);
-  glDisableVertexAttribArray(colLoc);
-  glDisableVertexAttribArray(tex0Loc);
+    queued.emplace_back(text);
+  }
 
   renderSystem->DisableGUIShader();
+
+  if (queued.empty())
+    return;
+
+  // with shader clipping the scissors are reset, nothing may be moved across the text
+  if (!m_scissorClip)
+    bounds = CRect(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                   std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+
+  CGUIRenderQueue::State state;
+  state.shader = static_cast<int>(shader);
+  state.texture = m_nTexture;
+  state.blend = CGUIRenderQueue::BlendMode::ALPHA_KEEP_DEST;
+
+  const float textureSteps[4] = {1.f / static_cast<float>(m_textureWidth),
+                                 1.f / static_cast<float>(m_textureHeight), 1.f, 1.f};
+
+  renderSystem->QueueGUICommand(
+      state, bounds,
+      [renderSystem, queued = std::move(queued), scissorClip = m_scissorClip, scissor,
+       textureSteps]() -> unsigned int
+      {
+        GLint posLoc = renderSystem->GUIShaderGetPos();
+        GLint colLoc = renderSystem->GUIShaderGetCol();
+        GLint tex0Loc = renderSystem->GUIShaderGetCoord0();
+        GLint clipUniformLoc = renderSystem->GUIShaderGetClip();
+        GLint coordStepUniformLoc = renderSystem->GUIShaderGetCoordStep();
+        GLint matrixUniformLoc = renderSystem->GUIShaderGetMatrix();
+        GLint depthLoc = renderSystem->GUIShaderGetDepth();
+
+        // Enable the attributes used by this shader
+        glEnableVertexAttribArray(posLoc);
+        glEnableVertexAttribArray(colLoc);
+        glEnableVertexAttribArray(tex0Loc);
+
+        // Bind our pre-calculated array to GL_ELEMENT_ARRAY_BUFFER
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
+
+        unsigned int drawCalls = 0;
+        for (const CQueuedText& text : queued)
+        {
+          if (scissorClip)
+          {
+            // clip using scissors
+            renderSystem->SetScissors(text.clip);
+          }
+          else
+          {
+            // clip using vertex shader
+            renderSystem->ResetScissors();
+            glUniform4fv(clipUniformLoc, 1, text.clipBoundaries);
+            glUniform4fv(coordStepUniformLoc, 1, textureSteps);
+          }
+
+          glUniform1f(depthLoc, text.depth);
+          glUniformMatrix4fv(matrixUniformLoc, 1, GL_FALSE, text.matrix);
+
+          // Bind the buffer to the OpenGL context's GL_ARRAY_BUFFER binding point
+          glBindBuffer(GL_ARRAY_BUFFER, text.bufferHandle);
+
+          // Do the actual drawing operation, split into groups of characters no
+          // larger than the pre-determined size of the element array
+          for (size_t character = 0; text.size > character;
+               character += ELEMENT_ARRAY_MAX_CHAR_INDEX)
+          {
+            size_t count = text.size - character;
+            count = std::min<size_t>(count, ELEMENT_ARRAY_MAX_CHAR_INDEX);
+
+            // Set up the offsets of the various vertex attributes within the buffer
+            // object bound to GL_ARRAY_BUFFER
+            glVertexAttribPointer(
+                posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(SVertex),
+                reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, x)));
+            glVertexAttribPointer(
+                colLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SVertex),
+                reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, r)));
+            glVertexAttribPointer(
+                tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex),
+                reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
+
+            glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+            drawCalls++;
+          }
+        }
+
+        // Restore the original scissor rectangle
+        if (scissorClip)
+          renderSystem->SetScissors(scissor);
+
+        // Unbind GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        // Disable the attributes used by this shader
+        glDisableVertexAttribArray(posLoc);
+        glDisableVertexAttribArray(colLoc);
+        glDisableVertexAttribArray(tex0Loc);
+
+        return drawCalls;
+      });
 }
 
 CVertexBuffer CGUIFontTTFGLES::CreateVertexBuffer(const std::vector<SVertex>& vertices) const
@@ -309,13 +375,30 @@ CVertexBuffer CGUIFontTTFGLES::CreateVertexBuffer(const std::vector<SVertex>& ve
     glBindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
-  return CVertexBuffer(bufferHandle, vertices.size() / 4, this);
+  CRect bounds;
+  if (!vertices.empty())
+  {
+    bounds = CRect(vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y);
+    for (const SVertex& vertex : vertices)
+    {
+      bounds.x1 = std::min(bounds.x1, vertex.x);
+      bounds.y1 = std::min(bounds.y1, vertex.y);
+      bounds.x2 = std::max(bounds.x2, vertex.x);
+      bounds.y2 = std::max(bounds.y2, vertex.y);
+    }
+  }
+
+  return CVertexBuffer(bufferHandle, vertices.size() / 4, this, bounds);
 }
 
 void CGUIFontTTFGLES::DestroyVertexBuffer(CVertexBuffer& buffer) const
 {
   if (buffer.bufferHandle != 0)
   {
+    // queued text may still refer to the buffer
+    if (CRenderSystemBase* renderSystem = CServiceBroker::GetRenderSystem())
+      renderSystem->FlushGUIRenderQueue();
+
     // Release the buffer name for reuse
     glDeleteBuffers(1, static_cast<GLuint*>(&buffer.bufferHandle));
     buffer.bufferHandle = 0;
@@ -457,6 +540,9 @@ void CGUIFontTTFGLES::DestroyStaticVertexBuffers(void)
   if (!m_staticVertexBufferCreated)
     return;
 
+  if (CRenderSystemBase* renderSystem = CServiceBroker::GetRenderSystem())
+    renderSystem->FlushGUIRenderQueue();
+
   glDeleteBuffers(1, &m_elementArrayHandle);
   m_staticVertexBufferCreated = false;
 }
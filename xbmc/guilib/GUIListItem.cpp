@@ -14,11 +14,62 @@
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
 #include <utility>
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
+namespace
+{
+// keys set on many items by the core, the only ones interned. Keys are set by add-ons and skins
+// as well, interning those would keep every key ever set for the lifetime of the process.
+constexpr const char* CORE_PROPERTY_KEYS[] = {
+    "Addon.ID",
+    "Addon.Status",
+    "addoncategory",
+    "has_resolved_video_asset",
+    "icon_never_overlay",
+    "inprogressepisodes",
+    "IsHTTPDirectory",
+    "IsPlayable",
+    "IsRadio",
+    "item_start",
+    "libraryartfilled",
+    "numepisodes",
+    "original_listitem_url",
+    "playlist_type_hint",
+    "ResumeTime",
+    "StartOffset",
+    "total",
+    "TotalTime",
+    "totalepisodes",
+    "unplayable",
+    "unwatchedepisodes",
+    "watchedepisodepercent",
+    "watchedepisodes",
+};
+
+void InternCorePropertyKeys()
+{
+  static const bool interned = []
+  {
+    for (const char* key : CORE_PROPERTY_KEYS)
+      CStringAtom::Intern(key);
+    return true;
+  }();
+  (void)interned;
+}
+} // unnamed namespace
+
+CGUIListItem::CPropertyKey::CPropertyKey(const std::string& key)
 {
-  return StringUtils::CompareNoCase(s1, s2) < 0;
+  InternCorePropertyKeys();
+  m_atom = CStringAtom::Find(key);
+  if (!m_atom)
+    m_key = std::make_shared<const std::string>(key);
+}
+
+bool CGUIListItem::CPropertyKey::Matches(const std::string& key) const
+{
+  return StringUtils::EqualsNoCase(Get(), key);
 }
 
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
@@ -113,13 +164,15 @@ void CGUIListItem::SetArt(const ArtMap &art)
 
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
-  m_artFallbacks[from] = to;
+  if (!m_artFallbacks)
+    m_artFallbacks = std::make_unique<ArtMap>();
+  (*m_artFallbacks)[from] = to;
 }
 
 void CGUIListItem::ClearArt()
 {
   m_art.clear();
-  m_artFallbacks.clear();
+  m_artFallbacks.reset();
   SetProperty("libraryartfilled", false);
 }
 
@@ -134,8 +187,10 @@ std::string CGUIListItem::GetArt(const std::string &type) const
   ArtMap::const_iterator i = m_art.find(type);
   if (i != m_art.end())
     return i->second;
-  i = m_artFallbacks.find(type);
-  if (i != m_artFallbacks.end())
+  if (!m_artFallbacks)
+    return "";
+  i = m_artFallbacks->find(type);
+  if (i != m_artFallbacks->end())
   {
     ArtMap::const_iterator j = m_art.find(i->second);
     if (j != m_art.end())
@@ -208,9 +263,12 @@ CGUIListItem& CGUIListItem::operator =(const CGUIListItem& item)
   m_bSelected = item.m_bSelected;
   m_overlayIcon = item.m_overlayIcon;
   m_bIsFolder = item.m_bIsFolder;
-  m_mapProperties = item.m_mapProperties;
+  m_properties = item.m_properties;
   m_art = item.m_art;
-  m_artFallbacks = item.m_artFallbacks;
+  if (item.m_artFallbacks)
+    m_artFallbacks = std::make_unique<ArtMap>(*item.m_artFallbacks);
+  else
+    m_artFallbacks.reset();
   SetInvalid();
   return *this;
 }
@@ -225,10 +283,10 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << m_sortLabel;
     ar << m_bSelected;
     ar << m_overlayIcon;
-    ar << (int)m_mapProperties.size();
-    for (const auto& it : m_mapProperties)
+    ar << (int)m_properties.size();
+    for (const auto& it : m_properties)
     {
-      ar << it.first;
+      ar << it.first.Get();
       ar << it.second;
     }
     ar << (int)m_art.size();
@@ -237,12 +295,17 @@ void CGUIListItem::Archive(CArchive &ar)
       ar << i.first;
       ar << i.second;
     }
-    ar << (int)m_artFallbacks.size();
-    for (const auto& i : m_artFallbacks)
+    if (m_artFallbacks)
     {
-      ar << i.first;
-      ar << i.second;
+      ar << (int)m_artFallbacks->size();
+      for (const auto& i : *m_artFallbacks)
+      {
+        ar << i.first;
+        ar << i.second;
+      }
     }
+    else
+      ar << 0;
   }
   else
   {
@@ -280,7 +343,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_artFallbacks.insert(make_pair(key, value));
+      SetArtFallback(key, value);
     }
     SetInvalid();
   }
@@ -293,9 +356,9 @@ void CGUIListItem::Serialize(CVariant &value)
   value["sortLabel"] = m_sortLabel;
   value["selected"] = m_bSelected;
 
-  for (const auto& it : m_mapProperties)
+  for (const auto& it : m_properties)
   {
-    value["properties"][it.first] = it.second;
+    value["properties"][it.first.Get()] = it.second;
   }
   for (const auto& it : m_art)
     value["art"][it.first] = it.second;
@@ -348,12 +411,26 @@ void CGUIListItem::SetInvalid()
   if (m_focusedLayout) m_focusedLayout->SetInvalid();
 }
 
+CGUIListItem::PropertyList::iterator CGUIListItem::FindProperty(const std::string& strKey)
+{
+  // looked up for every item on every frame, so compare the keys directly rather than taking the
+  // lock of the atom table
+  return std::find_if(m_properties.begin(), m_properties.end(),
+                      [&strKey](const auto& property) { return property.first.Matches(strKey); });
+}
+
+CGUIListItem::PropertyList::const_iterator CGUIListItem::FindProperty(
+    const std::string& strKey) const
+{
+  return const_cast<CGUIListItem*>(this)->FindProperty(strKey);
+}
+
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
+  PropertyList::iterator iter = FindProperty(strKey);
+  if (iter == m_properties.end())
   {
-    m_mapProperties.insert(make_pair(strKey, value));
+    m_properties.emplace_back(CPropertyKey(strKey), value);
     SetInvalid();
   }
   else if (iter->second != value)
@@ -365,10 +442,10 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyList::const_iterator iter = FindProperty(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
-  if (iter == m_mapProperties.end())
+  if (iter == m_properties.end())
     return nullVariant;
 
   return iter->second;
@@ -376,28 +453,29 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
-    return false;
+  return FindProperty(strKey) != m_properties.end();
+}
 
-  return true;
+bool CGUIListItem::HasProperties() const
+{
+  return !m_properties.empty();
 }
 
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter != m_mapProperties.end())
+  PropertyList::iterator iter = FindProperty(strKey);
+  if (iter != m_properties.end())
   {
-    m_mapProperties.erase(iter);
+    m_properties.erase(iter);
     SetInvalid();
   }
 }
 
 void CGUIListItem::ClearProperties()
 {
-  if (!m_mapProperties.empty())
+  if (!m_properties.empty())
   {
-    m_mapProperties.clear();
+    m_properties.clear();
     SetInvalid();
   }
 }
@@ -425,8 +503,8 @@ void CGUIListItem::IncrementProperty(const std::string &strKey, double dVal)
 
 void CGUIListItem::AppendProperties(const CGUIListItem &item)
 {
-  for (const auto& i : item.m_mapProperties)
-    SetProperty(i.first, i.second);
+  for (const auto& i : item.m_properties)
+    SetProperty(i.first.Get(), i.second);
 }
 
 void CGUIListItem::SetCurrentItem(unsigned int position)
@@ -13,9 +13,13 @@
 \brief
 */
 
+#include "utils/StringAtom.h"
+
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -155,7 +159,7 @@ public:
   void Serialize(CVariant& value);
 
   bool       HasProperty(const std::string &strKey) const;
-  bool HasProperties() const { return !m_mapProperties.empty(); }
+  bool HasProperties() const;
   void       ClearProperty(const std::string &strKey);
 
   const CVariant &GetProperty(const std::string &strKey) const;
@@ -183,18 +187,41 @@ protected:
   bool m_bSelected;     // item is selected or not
   unsigned int m_currentItem; // current item number within container (starting at 1)
 
-  struct icompare
+  /*! \brief Key of a property.
+   The keys the core sets on every item of a list are interned, anything else (e.g. the keys set
+   by add-ons) is a string owned by the key, shared by the copies of the item.
+   */
+  class CPropertyKey
   {
-    bool operator()(const std::string &s1, const std::string &s2) const;
+  public:
+    explicit CPropertyKey(const std::string& key);
+
+    const std::string& Get() const { return m_atom ? m_atom.Get() : *m_key; }
+
+    /*!
+     \brief Compare the key ignoring case.
+     */
+    bool Matches(const std::string& key) const;
+
+  private:
+    CStringAtom m_atom;
+    std::shared_ptr<const std::string> m_key;
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
-  PropertyMap m_mapProperties;
+  /*! \brief Properties in the order they were set, keys are compared ignoring case.
+   Items have a handful of properties, so a vector searched linearly is both smaller and faster
+   than a map.
+   */
+  typedef std::vector<std::pair<CPropertyKey, CVariant>> PropertyList;
+  PropertyList m_properties;
 private:
+  PropertyList::iterator FindProperty(const std::string& strKey);
+  PropertyList::const_iterator FindProperty(const std::string& strKey) const;
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
   ArtMap m_art;
-  ArtMap m_artFallbacks;
+  std::unique_ptr<ArtMap> m_artFallbacks; // rarely used, allocated when the first one is set
 };
 
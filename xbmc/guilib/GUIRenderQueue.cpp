@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIRenderQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+void CGUIRenderQueue::AddQuads(const State& state, const Vertex* vertices, size_t count)
+{
+  if (count == 0)
+    return;
+
+  CRect bounds(vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y);
+  for (size_t i = 1; i < count; ++i)
+  {
+    bounds.x1 = std::min(bounds.x1, vertices[i].x);
+    bounds.y1 = std::min(bounds.y1, vertices[i].y);
+    bounds.x2 = std::max(bounds.x2, vertices[i].x);
+    bounds.y2 = std::max(bounds.y2, vertices[i].y);
+  }
+
+  m_stats.items++;
+
+  // look for an earlier batch with the same state. The quads may only be moved
+  // in front of the items queued after it if they don't overlap any of them.
+  const size_t last = m_count > MAX_LOOKBACK ? m_count - MAX_LOOKBACK : 0;
+  for (size_t i = m_count; i > last; --i)
+  {
+    Batch& batch = m_batches[i - 1];
+    if (!batch.command && batch.state == state)
+    {
+      batch.vertices.insert(batch.vertices.end(), vertices, vertices + count);
+      batch.bounds.Union(bounds);
+      return;
+    }
+    if (batch.bounds.Intersects(bounds))
+      break;
+  }
+
+  Batch& batch = NewBatch(state, bounds);
+  batch.vertices.assign(vertices, vertices + count);
+}
+
+void CGUIRenderQueue::AddCommand(const State& state, const CRect& bounds, Command command)
+{
+  m_stats.items++;
+  Batch& batch = NewBatch(state, bounds);
+  batch.command = std::move(command);
+}
+
+CGUIRenderQueue::Batch& CGUIRenderQueue::NewBatch(const State& state, const CRect& bounds)
+{
+  if (m_count == m_batches.size())
+    m_batches.emplace_back();
+
+  Batch& batch = m_batches[m_count++];
+  batch.state = state;
+  batch.bounds = bounds;
+  batch.vertices.clear();
+  batch.command = nullptr;
+  return batch;
+}
+
+void CGUIRenderQueue::Flush(IRenderer& renderer)
+{
+  const State* current = nullptr;
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    Batch& batch = m_batches[i];
+    if (!current || !(*current == batch.state))
+    {
+      renderer.ApplyState(batch.state);
+      current = &batch.state;
+      m_stats.stateChanges++;
+    }
+
+    if (batch.command)
+    {
+      m_stats.drawCalls += batch.command();
+      batch.command = nullptr;
+    }
+    else
+    {
+      m_stats.drawCalls += renderer.DrawQuads(batch.state, batch.vertices);
+      m_stats.quads += batch.vertices.size() / 4;
+    }
+  }
+  m_count = 0;
+}
+
+void CGUIRenderQueue::Clear()
+{
+  for (size_t i = 0; i < m_count; ++i)
+    m_batches[i].command = nullptr;
+  m_count = 0;
+}
+
+void CGUIRenderQueue::EndFrame()
+{
+  m_frameStats = m_stats;
+  m_stats = {};
+}
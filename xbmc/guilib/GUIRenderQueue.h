@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/ColorUtils.h"
+#include "utils/Geometry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Collects the quads drawn by the GUI during a frame and submits them in batches.
+
+ Instead of issuing a draw call per texture, GUI textures add their quads to
+ the queue together with the render state they need. Quads sharing the same
+ state are merged into one batch, even if other items were queued in between,
+ as long as those items don't overlap on screen and the result is therefore
+ identical to drawing in submission order.
+
+ Items that can't be expressed as quads (e.g. text, which is drawn from cached
+ vertex buffers) are queued as commands. They are never merged, but take part
+ in the ordering and reuse the render state of the batch before them if it
+ matches.
+
+ The queue is render system agnostic, the actual state changes and draw calls
+ are done by an IRenderer passed to Flush().
+ */
+class CGUIRenderQueue
+{
+public:
+  enum class BlendMode : uint8_t
+  {
+    NONE,
+    ALPHA, ///< source alpha over destination
+    ALPHA_KEEP_DEST, ///< source alpha over destination, destination alpha is accumulated
+  };
+
+  struct State
+  {
+    int shader{0}; ///< render system specific shader method
+    uintptr_t texture{0}; ///< render system specific texture handle, 0 if none
+    uintptr_t diffuse{0}; ///< texture handle of the diffuse texture, 0 if none
+    BlendMode blend{BlendMode::NONE};
+    KODI::UTILS::COLOR::Color color{0xffffffff};
+    float depth{0.0f};
+
+    bool operator==(const State& other) const = default;
+  };
+
+  struct Vertex
+  {
+    float x, y, z;
+    float u1, v1;
+    float u2, v2;
+  };
+
+  struct Stats
+  {
+    unsigned int drawCalls{0};
+    unsigned int stateChanges{0};
+    unsigned int quads{0}; ///< number of quads drawn in batches
+    unsigned int items{0}; ///< number of items queued, before merging
+  };
+
+  /*!
+   \brief Draws the contents of the queue, implemented by the render system.
+   */
+  class IRenderer
+  {
+  public:
+    virtual ~IRenderer() = default;
+    virtual void ApplyState(const State& state) = 0;
+    /*! \brief Draw quads, 4 vertices each, in clockwise or counter clockwise order
+     \return the number of draw calls made
+     */
+    virtual unsigned int DrawQuads(const State& state, const std::vector<Vertex>& vertices) = 0;
+  };
+
+  /*! \brief A custom draw, called after the state it was queued with is applied
+   \return the number of draw calls made
+   */
+  using Command = std::function<unsigned int()>;
+
+  /*! \brief Queue quads for drawing
+   \param state render state needed by the quads
+   \param vertices 4 vertices per quad, in screen coordinates
+   \param count number of vertices
+   */
+  void AddQuads(const State& state, const Vertex* vertices, size_t count);
+
+  /*! \brief Queue a custom draw
+   \param state render state needed by the command
+   \param bounds screen area the command may draw to
+   \param command the draw to run when the queue is flushed
+   */
+  void AddCommand(const State& state, const CRect& bounds, Command command);
+
+  bool IsEmpty() const { return m_count == 0; }
+
+  /*! \brief Draw everything queued and empty the queue */
+  void Flush(IRenderer& renderer);
+
+  /*! \brief Drop everything queued without drawing it, e.g. after losing the render context */
+  void Clear();
+
+  /*! \brief Mark the end of a frame, making the statistics of the frame available
+   through GetFrameStats().
+   */
+  void EndFrame();
+
+  /*! \brief Statistics of the last complete frame */
+  const Stats& GetFrameStats() const { return m_frameStats; }
+
+private:
+  //! number of queued items checked for a batch to merge with
+  static constexpr size_t MAX_LOOKBACK = 64;
+
+  struct Batch
+  {
+    State state;
+    CRect bounds;
+    std::vector<Vertex> vertices;
+    Command command;
+  };
+
+  Batch& NewBatch(const State& state, const CRect& bounds);
+
+  // batches are reused across flushes to keep the vertex storage allocated
+  std::vector<Batch> m_batches;
+  size_t m_count{0};
+
+  Stats m_stats;
+  Stats m_frameStats;
+};
@@ -10,6 +10,7 @@
 
 #include "ServiceBroker.h"
 #include "Texture.h"
+#include "TextureGL.h"
 #include "rendering/gl/RenderSystemGL.h"
 #include "utils/GLUtils.h"
 #include "utils/Geometry.h"
@@ -50,122 +51,58 @@ void CGUITextureGL::Begin(KODI::UTILS::COLOR::Color color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
+  // the quads are drawn by the render system, batched with others using the same state
+  m_state = {};
+  m_state.texture = static_cast<CGLTexture*>(texture)->GetTextureObject();
+  m_state.depth = m_depth;
 
-  // Setup Colors
-  m_col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  m_col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  m_col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  m_col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
-
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  bool hasAlpha = texture->HasAlpha() || KODI::UTILS::GL::GetChannelFromARGB(
+                                             KODI::UTILS::GL::ColorChannel::A, color) < 255;
 
   if (m_diffuse.size())
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
+    if (color == 0xffffffff)
     {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_MULTI);
+      m_state.shader = static_cast<int>(ShaderMethodGL::SM_MULTI);
     }
     else
     {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_MULTI_BLENDCOLOR);
+      m_state.shader = static_cast<int>(ShaderMethodGL::SM_MULTI_BLENDCOLOR);
+      m_state.color = color;
     }
 
     hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
 
-    m_diffuse.m_textures[0]->BindToUnit(1);
+    m_state.diffuse = static_cast<CGLTexture*>(m_diffuse.m_textures[0].get())->GetTextureObject();
   }
   else
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
+    if (color == 0xffffffff)
     {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE_NOBLEND);
+      m_state.shader = static_cast<int>(ShaderMethodGL::SM_TEXTURE_NOBLEND);
     }
     else
     {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE);
+      m_state.shader = static_cast<int>(ShaderMethodGL::SM_TEXTURE);
+      m_state.color = color;
     }
   }
 
-  if (hasAlpha)
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable(GL_BLEND);
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
+  m_state.blend =
+      hasAlpha ? CGUIRenderQueue::BlendMode::ALPHA_KEEP_DEST : CGUIRenderQueue::BlendMode::NONE;
+
   m_packedVertices.clear();
-  m_idx.clear();
 }
 
 void CGUITextureGL::End()
 {
   if (m_packedVertices.size())
-  {
-    GLint posLoc  = m_renderSystem->ShaderGetPos();
-    GLint tex0Loc = m_renderSystem->ShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->ShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->ShaderGetUniCol();
-    GLint depthLoc = m_renderSystem->ShaderGetDepth();
-
-    GLuint VertexVBO;
-    GLuint IndexVBO;
-
-    glGenBuffers(1, &VertexVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VertexVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex)*m_packedVertices.size(), &m_packedVertices[0], GL_STATIC_DRAW);
-
-    glUniform1f(depthLoc, m_depth);
-
-    if (uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
-
-    if (m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                            reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u2)));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glGenBuffers(1, &IndexVBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IndexVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ushort)*m_idx.size(), m_idx.data(), GL_STATIC_DRAW);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, 0);
-
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
-
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &VertexVBO);
-    glDeleteBuffers(1, &IndexVBO);
-  }
-
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-
-  m_renderSystem->DisableShader();
+    m_renderSystem->QueueGUIQuads(m_state, m_packedVertices.data(), m_packedVertices.size());
 }
 
 void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
 {
-  PackedVertex vertices[4];
+  CGUIRenderQueue::Vertex vertices[4] = {};
 
   // Setup texture coordinates
   // TopLeft
@@ -242,17 +179,6 @@ void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, con
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGL::DrawQuad(const CRect& rect,
@@ -263,73 +189,39 @@ void CGUITextureGL::DrawQuad(const CRect& rect,
                              const bool blending)
 {
   CRenderSystemGL *renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+
+  CGUIRenderQueue::State state;
   if (texture)
   {
     texture->LoadToGPU();
-    texture->BindToUnit(0);
-  }
-
-  if (blending)
-  {
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_BLEND);
+    state.shader = static_cast<int>(ShaderMethodGL::SM_TEXTURE);
+    state.texture = static_cast<CGLTexture*>(texture)->GetTextureObject();
   }
   else
   {
-    glDisable(GL_BLEND);
+    state.shader = static_cast<int>(ShaderMethodGL::SM_DEFAULT);
   }
+  state.blend = blending ? CGUIRenderQueue::BlendMode::ALPHA : CGUIRenderQueue::BlendMode::NONE;
+  state.color = color;
+  state.depth = depth;
 
-  VerifyGLState();
-
-  GLubyte col[4];
-  GLubyte idx[4] = {0, 1, 3, 2};  //determines order of the vertices
-  GLuint vertexVBO;
-  GLuint indexVBO;
-
-  struct PackedVertex
-  {
-    float x, y, z;
-    float u1, v1;
-  }vertex[4];
-
-  if (texture)
-    renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE);
-  else
-    renderSystem->EnableShader(ShaderMethodGL::SM_DEFAULT);
-
-  GLint posLoc = renderSystem->ShaderGetPos();
-  GLint tex0Loc = renderSystem->ShaderGetCoord0();
-  GLint uniColLoc = renderSystem->ShaderGetUniCol();
-  GLint depthLoc = renderSystem->ShaderGetDepth();
-
-  // Setup Colors
-  col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
-
-  glUniform4f(uniColLoc, col[0] / 255.0f, col[1] / 255.0f, col[2] / 255.0f, col[3] / 255.0f);
-  glUniform1f(depthLoc, depth);
+  CGUIRenderQueue::Vertex vertex[4] = {};
 
   // bottom left
   vertex[0].x = rect.x1;
   vertex[0].y = rect.y1;
-  vertex[0].z = 0;
 
   // bottom right
   vertex[1].x = rect.x2;
   vertex[1].y = rect.y1;
-  vertex[1].z = 0;
 
   // top right
   vertex[2].x = rect.x2;
   vertex[2].y = rect.y2;
-  vertex[2].z = 0;
 
   // top left
   vertex[3].x = rect.x1;
   vertex[3].y = rect.y2;
-  vertex[3].z = 0;
 
   if (texture)
   {
@@ -340,36 +232,5 @@ void CGUITextureGL::DrawQuad(const CRect& rect,
     vertex[2].v1 = vertex[3].v1 = coords.y2;
   }
 
-  glGenBuffers(1, &vertexVBO);
-  glBindBuffer(GL_ARRAY_BUFFER, vertexVBO);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex)*4, &vertex[0], GL_STATIC_DRAW);
-
-  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
-                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
-  glEnableVertexAttribArray(posLoc);
-
-  if (texture)
-  {
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
-    glEnableVertexAttribArray(tex0Loc);
-  }
-
-  glGenBuffers(1, &indexVBO);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLubyte)*4, idx, GL_STATIC_DRAW);
-
-  glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, 0);
-
-  glDisableVertexAttribArray(posLoc);
-  if (texture)
-    glDisableVertexAttribArray(tex0Loc);
-
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glDeleteBuffers(1, &vertexVBO);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-  glDeleteBuffers(1, &indexVBO);
-
-  renderSystem->DisableShader();
+  renderSystem->QueueGUIQuads(state, vertex, 4);
 }
-
@@ -8,10 +8,11 @@
 
 #pragma once
 
+#include "GUIRenderQueue.h"
 #include "GUITexture.h"
 #include "utils/ColorUtils.h"
 
-#include <array>
+#include <vector>
 
 #include "system_gl.h"
 
@@ -44,17 +45,8 @@ protected:
 private:
   CGUITextureGL(const CGUITextureGL& texture) = default;
 
-  std::array<GLubyte, 4> m_col;
-
-  struct PackedVertex
-  {
-    float x, y, z;
-    float u1, v1;
-    float u2, v2;
-  };
-
-  std::vector<PackedVertex> m_packedVertices;
-  std::vector<GLushort> m_idx;
+  CGUIRenderQueue::State m_state;
+  std::vector<CGUIRenderQueue::Vertex> m_packedVertices;
   CRenderSystemGL *m_renderSystem;
 };
 
@@ -10,6 +10,7 @@
 
 #include "ServiceBroker.h"
 #include "Texture.h"
+#include "TextureGLES.h"
 #include "guilib/TextureFormats.h"
 #include "rendering/gles/RenderSystemGLES.h"
 #include "utils/GLUtils.h"
@@ -19,6 +20,7 @@
 #include "windowing/WinSystem.h"
 
 #include <cstddef>
+#include <utility>
 
 void CGUITextureGLES::Register()
 {
@@ -70,6 +72,14 @@ void CGUITextureGLES::Begin(KODI::UTILS::COLOR::Color color)
   const bool hasBlendColor =
       m_col[0] != 255 || m_col[1] != 255 || m_col[2] != 255 || m_col[3] != 255;
 
+  // the quads are drawn by the render system, batched with others using the same state
+  m_state = {};
+  m_state.texture = static_cast<CGLESTexture*>(texture)->GetTextureObject();
+  m_state.color = static_cast<KODI::UTILS::COLOR::Color>(m_col[3]) << 24 | m_col[0] << 16 |
+                  m_col[1] << 8 | m_col[2];
+  m_state.depth = m_depth;
+  m_swapTextures = false;
+
   if (m_diffuse.size())
   {
     if (m_isGLES20 && (texture->GetSwizzle() == KD_TEX_SWIZ_111R ||
@@ -77,114 +87,66 @@ void CGUITextureGLES::Begin(KODI::UTILS::COLOR::Color color)
     {
       if (texture->GetSwizzle() == KD_TEX_SWIZ_111R &&
           m_diffuse.m_textures[0]->GetSwizzle() == KD_TEX_SWIZ_111R)
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_111R_111R_BLENDCOLOR);
+        m_state.shader = static_cast<int>(ShaderMethodGLES::SM_MULTI_111R_111R_BLENDCOLOR);
       else if (hasBlendColor)
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R_BLENDCOLOR);
+        m_state.shader = static_cast<int>(ShaderMethodGLES::SM_MULTI_RGBA_111R_BLENDCOLOR);
       else
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R);
+        m_state.shader = static_cast<int>(ShaderMethodGLES::SM_MULTI_RGBA_111R);
     }
     else if (hasBlendColor)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_BLENDCOLOR);
+      m_state.shader = static_cast<int>(ShaderMethodGLES::SM_MULTI_BLENDCOLOR);
     }
     else
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI);
+      m_state.shader = static_cast<int>(ShaderMethodGLES::SM_MULTI);
     }
 
     hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
 
+    m_state.diffuse =
+        static_cast<CGLESTexture*>(m_diffuse.m_textures[0].get())->GetTextureObject();
+
     // We don't need a 111R_RGBA version of the GLES 2.0 shaders, so in the
     // unlikely event of having an alpha-only texture, switch with the
     // diffuse.
     if (texture->GetSwizzle() == KD_TEX_SWIZ_111R)
     {
-      texture->BindToUnit(1);
-      m_diffuse.m_textures[0]->BindToUnit(0);
-    }
-    else
-    {
-      texture->BindToUnit(0);
-      m_diffuse.m_textures[0]->BindToUnit(1);
+      std::swap(m_state.texture, m_state.diffuse);
+      m_swapTextures = true;
     }
   }
   else
   {
     if (m_isGLES20 && texture->GetSwizzle() == KD_TEX_SWIZ_111R)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_111R);
+      m_state.shader = static_cast<int>(ShaderMethodGLES::SM_TEXTURE_111R);
     }
     else if (hasBlendColor)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE);
+      m_state.shader = static_cast<int>(ShaderMethodGLES::SM_TEXTURE);
     }
     else
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_NOBLEND);
+      m_state.shader = static_cast<int>(ShaderMethodGLES::SM_TEXTURE_NOBLEND);
     }
-
-    texture->BindToUnit(0);
   }
 
-  if ( hasAlpha )
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable( GL_BLEND );
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
+  m_state.blend =
+      hasAlpha ? CGUIRenderQueue::BlendMode::ALPHA_KEEP_DEST : CGUIRenderQueue::BlendMode::NONE;
+
   m_packedVertices.clear();
 }
 
 void CGUITextureGLES::End()
 {
   if (m_packedVertices.size())
-  {
-    GLint posLoc  = m_renderSystem->GUIShaderGetPos();
-    GLint tex0Loc = m_renderSystem->GUIShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->GUIShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->GUIShaderGetUniCol();
-    GLint depthLoc = m_renderSystem->GUIShaderGetDepth();
-
-    if(uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
-
-    glUniform1f(depthLoc, m_depth);
-
-    if(m_diffuse.size())
-    {
-      if (m_texture.m_textures[m_currentFrame]->GetSwizzle() == KD_TEX_SWIZ_111R)
-        std::swap(tex0Loc, tex1Loc);
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u2));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, x));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u1));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, m_idx.data());
-
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
-
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-  }
-
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-  m_renderSystem->DisableGUIShader();
+    m_renderSystem->QueueGUIQuads(m_state, m_packedVertices.data(), m_packedVertices.size());
 }
 
 void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
 {
-  PackedVertex vertices[4];
+  CGUIRenderQueue::Vertex vertices[4] = {};
 
   // Setup texture coordinates
   //TopLeft
@@ -250,22 +212,17 @@ void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, c
 
   for (int i=0; i<4; i++)
   {
+    // the alpha-only texture is drawn as the diffuse, see Begin()
+    if (m_swapTextures)
+    {
+      std::swap(vertices[i].u1, vertices[i].u2);
+      std::swap(vertices[i].v1, vertices[i].v2);
+    }
     vertices[i].x = x[i];
     vertices[i].y = y[i];
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGLES::DrawQuad(const CRect& rect,
@@ -276,77 +233,38 @@ void CGUITextureGLES::DrawQuad(const CRect& rect,
                                const bool blending)
 {
   CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+
+  CGUIRenderQueue::State state;
   if (texture)
   {
     texture->LoadToGPU();
-    texture->BindToUnit(0);
-  }
-
-  if (blending)
-  {
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_BLEND);
+    state.shader = static_cast<int>(ShaderMethodGLES::SM_TEXTURE);
+    state.texture = static_cast<CGLESTexture*>(texture)->GetTextureObject();
   }
   else
   {
-    glDisable(GL_BLEND);
+    state.shader = static_cast<int>(ShaderMethodGLES::SM_DEFAULT);
   }
+  state.blend = blending ? CGUIRenderQueue::BlendMode::ALPHA : CGUIRenderQueue::BlendMode::NONE;
+  state.color = color;
+  state.depth = depth;
 
-  VerifyGLState();
+  CGUIRenderQueue::Vertex vertex[4] = {};
 
-  GLubyte col[4];
-  GLfloat ver[4][3];
-  GLfloat tex[4][2];
-  GLubyte idx[4] = {0, 1, 3, 2};        //determines order of triangle strip
-
-  if (texture)
-    renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE);
-  else
-    renderSystem->EnableGUIShader(ShaderMethodGLES::SM_DEFAULT);
-
-  GLint posLoc   = renderSystem->GUIShaderGetPos();
-  GLint tex0Loc  = renderSystem->GUIShaderGetCoord0();
-  GLint uniColLoc= renderSystem->GUIShaderGetUniCol();
-  GLint depthLoc = renderSystem->GUIShaderGetDepth();
-
-  glVertexAttribPointer(posLoc,  3, GL_FLOAT, 0, 0, ver);
-  if (texture)
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, 0, tex);
-
-  glEnableVertexAttribArray(posLoc);
-  if (texture)
-    glEnableVertexAttribArray(tex0Loc);
-
-  // Setup Colors
-  col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
-
-  glUniform4f(uniColLoc, col[0] / 255.0f, col[1] / 255.0f, col[2] / 255.0f, col[3] / 255.0f);
-  glUniform1f(depthLoc, depth);
-
-  ver[0][0] = ver[3][0] = rect.x1;
-  ver[0][1] = ver[1][1] = rect.y1;
-  ver[1][0] = ver[2][0] = rect.x2;
-  ver[2][1] = ver[3][1] = rect.y2;
-  ver[0][2] = ver[1][2] = ver[2][2] = ver[3][2]= 0;
+  vertex[0].x = vertex[3].x = rect.x1;
+  vertex[0].y = vertex[1].y = rect.y1;
+  vertex[1].x = vertex[2].x = rect.x2;
+  vertex[2].y = vertex[3].y = rect.y2;
 
   if (texture)
   {
     // Setup texture coordinates
     CRect coords = texCoords ? *texCoords : CRect(0.0f, 0.0f, 1.0f, 1.0f);
-    tex[0][0] = tex[3][0] = coords.x1;
-    tex[0][1] = tex[1][1] = coords.y1;
-    tex[1][0] = tex[2][0] = coords.x2;
-    tex[2][1] = tex[3][1] = coords.y2;
+    vertex[0].u1 = vertex[3].u1 = coords.x1;
+    vertex[0].v1 = vertex[1].v1 = coords.y1;
+    vertex[1].u1 = vertex[2].u1 = coords.x2;
+    vertex[2].v1 = vertex[3].v1 = coords.y2;
   }
-  glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, idx);
 
-  glDisableVertexAttribArray(posLoc);
-  if (texture)
-    glDisableVertexAttribArray(tex0Loc);
-
-  renderSystem->DisableGUIShader();
+  renderSystem->QueueGUIQuads(state, vertex, 4);
 }
-
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "GUIRenderQueue.h"
 #include "GUITexture.h"
 #include "utils/ColorUtils.h"
 
@@ -16,14 +17,6 @@
 
 #include "system_gl.h"
 
-struct PackedVertex
-{
-  float x, y, z;
-  float u1, v1;
-  float u2, v2;
-};
-typedef std::vector<PackedVertex> PackedVertices;
-
 class CRenderSystemGLES;
 
 class CGUITextureGLES : public CGUITexture
@@ -55,8 +48,10 @@ private:
 
   std::array<GLubyte, 4> m_col;
 
-  PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
+  CGUIRenderQueue::State m_state;
+  // alpha-only texture drawn as the diffuse, with the texture coordinates swapped
+  bool m_swapTextures{false};
+  std::vector<CGUIRenderQueue::Vertex> m_packedVertices;
   CRenderSystemGLES *m_renderSystem;
   bool m_isGLES20{true};
 };
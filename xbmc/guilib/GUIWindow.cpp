@@ -124,13 +124,28 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  // windows resolved before with the same include conditions come from the skin's window cache
+  std::unique_ptr<TiXmlElement> resolvedRoot =
+      g_SkinInfo->GetResolvedWindow(strPath, m_xmlIncludeConditions);
+  if (resolvedRoot)
+  {
+    CLog::Log(LOGDEBUG, "Using cached resolved xml for {}", strPath);
+    return Load(resolvedRoot.get());
+  }
+
   // load window xml if we don't have it stored yet
   if (!m_windowXMLRootElement)
   {
     CXBMCTinyXML xmlDoc;
     std::string strPathLower = strPath;
     StringUtils::ToLower(strPathLower);
-    if (!xmlDoc.LoadFile(strPath) && !xmlDoc.LoadFile(strPathLower) && !xmlDoc.LoadFile(strLowerPath))
+    if (xmlDoc.LoadFile(strPath))
+      m_windowXMLFile = strPath;
+    else if (xmlDoc.LoadFile(strPathLower))
+      m_windowXMLFile = strPathLower;
+    else if (xmlDoc.LoadFile(strLowerPath))
+      m_windowXMLFile = strLowerPath;
+    else
     {
       CLog::Log(LOGERROR, "Unable to load window XML: {}. Line {}\n{}", strPath, xmlDoc.ErrorRow(),
                 xmlDoc.ErrorDesc());
@@ -152,7 +167,12 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for {}", strPath);
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  resolvedRoot = Prepare(m_windowXMLRootElement);
+  if (resolvedRoot)
+    g_SkinInfo->StoreResolvedWindow(strPath, m_windowXMLFile, *resolvedRoot,
+                                    m_xmlIncludeConditions);
+
+  return Load(resolvedRoot.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(const std::unique_ptr<TiXmlElement>& rootElement)
@@ -800,6 +820,7 @@ void CGUIWindow::FreeResources(bool forceUnload /*= false */)
   if (forceUnload)
   {
     m_windowXMLRootElement.reset();
+    m_windowXMLFile.clear();
     m_xmlIncludeConditions.clear();
   }
 }
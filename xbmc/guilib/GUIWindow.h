@@ -77,6 +77,9 @@ public:
    */
   void DoRender() override;
 
+  // windows may render more than their controls, e.g. the slideshow picture
+  bool IsRenderRegionBounding() const override { return false; }
+
   /*! \brief Do any post render activities.
     Check if window closing animation is finished and finalize window closing.
    */
@@ -276,6 +279,7 @@ protected:
     Stored to avoid parsing the XML every time the window is loaded.
    */
   std::unique_ptr<TiXmlElement> m_windowXMLRootElement;
+  std::string m_windowXMLFile; ///< \brief path the window root xml was loaded from
 
   bool m_manualRunActions;
 
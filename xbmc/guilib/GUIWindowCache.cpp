@@ -0,0 +1,508 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIWindowCache.h"
+
+#include "GUIIncludes.h"
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIComponent.h"
+#include "interfaces/info/Info.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+using XFILE::CFile;
+
+namespace
+{
+constexpr char MAGIC[] = {'K', 'W', 'C', 1};
+
+// limits the recursion on corrupt data, skin trees are far less deep
+constexpr unsigned int MAX_DEPTH = 256;
+
+enum NodeType
+{
+  NODE_ELEMENT = 0,
+  NODE_TEXT = 1,
+  NODE_CDATA = 2
+};
+
+void WriteVarint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const std::string& in, size_t& offset, uint64_t& value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64 && offset < in.size(); shift += 7)
+  {
+    const uint8_t byte = static_cast<uint8_t>(in[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+void WriteString(std::string& out, const std::string& str)
+{
+  WriteVarint(out, str.size());
+  out.append(str);
+}
+
+bool ReadString(const std::string& in, size_t& offset, std::string& str)
+{
+  uint64_t size;
+  if (!ReadVarint(in, offset, size) || size > in.size() - offset)
+    return false;
+
+  str.assign(in, offset, size);
+  offset += size;
+  return true;
+}
+
+void WriteFileInfo(std::string& out, const std::string& path, int64_t time, int64_t size)
+{
+  WriteString(out, path);
+  WriteVarint(out, static_cast<uint64_t>(time));
+  WriteVarint(out, static_cast<uint64_t>(size));
+}
+
+bool ReadFileInfo(const std::string& in, size_t& offset, std::string& path, int64_t& time, int64_t& size)
+{
+  uint64_t t;
+  uint64_t s;
+  if (!ReadString(in, offset, path) || !ReadVarint(in, offset, t) || !ReadVarint(in, offset, s))
+    return false;
+
+  time = static_cast<int64_t>(t);
+  size = static_cast<int64_t>(s);
+  return true;
+}
+
+bool GetFileInfo(const std::string& path, int64_t& time, int64_t& size)
+{
+  struct __stat64 st;
+  if (CFile::Stat(path, &st) != 0)
+    return false;
+
+  time = static_cast<int64_t>(st.st_mtime);
+  size = static_cast<int64_t>(st.st_size);
+  return true;
+}
+
+/*!
+ \brief Writes a tree with the names and values of the nodes stored once in a string table,
+ as skin trees repeat the same tags, attributes and values many times.
+ */
+class CTreeWriter
+{
+public:
+  std::string Write(const TiXmlElement& root)
+  {
+    std::string tree;
+    WriteNode(tree, root);
+
+    std::string data;
+    WriteVarint(data, m_strings.size());
+    for (const std::string* str : m_strings)
+      WriteString(data, *str);
+    data.append(tree);
+    return data;
+  }
+
+private:
+  void WriteNode(std::string& out, const TiXmlNode& node)
+  {
+    if (node.Type() == TiXmlNode::TINYXML_ELEMENT)
+    {
+      const TiXmlElement& element = *node.ToElement();
+      WriteVarint(out, NODE_ELEMENT);
+      WriteVarint(out, GetIndex(element.ValueStr()));
+
+      unsigned int attributes = 0;
+      for (auto attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+        ++attributes;
+      WriteVarint(out, attributes);
+      for (auto attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+      {
+        WriteVarint(out, GetIndex(attribute->NameTStr()));
+        WriteVarint(out, GetIndex(attribute->ValueStr()));
+      }
+
+      unsigned int children = 0;
+      for (auto child = element.FirstChild(); child; child = child->NextSibling())
+        if (IsStored(*child))
+          ++children;
+      WriteVarint(out, children);
+      for (auto child = element.FirstChild(); child; child = child->NextSibling())
+        if (IsStored(*child))
+          WriteNode(out, *child);
+    }
+    else
+    {
+      const TiXmlText& text = *node.ToText();
+      WriteVarint(out, text.CDATA() ? NODE_CDATA : NODE_TEXT);
+      WriteVarint(out, GetIndex(text.ValueStr()));
+    }
+  }
+
+  static bool IsStored(const TiXmlNode& node)
+  {
+    // comments and declarations have no meaning for the controls
+    return node.Type() == TiXmlNode::TINYXML_ELEMENT || node.Type() == TiXmlNode::TINYXML_TEXT;
+  }
+
+  size_t GetIndex(const std::string& str)
+  {
+    auto result = m_indices.emplace(str, m_strings.size());
+    if (result.second)
+      m_strings.push_back(&result.first->first);
+    return result.first->second;
+  }
+
+  std::unordered_map<std::string, size_t> m_indices;
+  std::vector<const std::string*> m_strings;
+};
+
+class CTreeReader
+{
+public:
+  explicit CTreeReader(const std::string& data) : m_data(data) {}
+
+  std::unique_ptr<TiXmlElement> Read()
+  {
+    uint64_t count;
+    if (!ReadVarint(m_data, m_offset, count) || count > m_data.size())
+      return nullptr;
+
+    m_strings.resize(count);
+    for (auto& str : m_strings)
+    {
+      if (!ReadString(m_data, m_offset, str))
+        return nullptr;
+    }
+
+    uint64_t type;
+    if (!ReadVarint(m_data, m_offset, type) || type != NODE_ELEMENT)
+      return nullptr;
+
+    auto root = std::make_unique<TiXmlElement>("");
+    if (!ReadElement(*root, 0) || m_offset != m_data.size())
+      return nullptr;
+
+    return root;
+  }
+
+private:
+  bool ReadElement(TiXmlElement& element, unsigned int depth)
+  {
+    const std::string* name;
+    uint64_t attributes;
+    if (depth > MAX_DEPTH || !ReadIndex(name) || !ReadVarint(m_data, m_offset, attributes))
+      return false;
+
+    element.SetValue(*name);
+    for (uint64_t i = 0; i < attributes; ++i)
+    {
+      const std::string* attributeName;
+      const std::string* attributeValue;
+      if (!ReadIndex(attributeName) || !ReadIndex(attributeValue))
+        return false;
+      element.SetAttribute(*attributeName, *attributeValue);
+    }
+
+    uint64_t children;
+    if (!ReadVarint(m_data, m_offset, children))
+      return false;
+
+    for (uint64_t i = 0; i < children; ++i)
+    {
+      uint64_t type;
+      if (!ReadVarint(m_data, m_offset, type))
+        return false;
+
+      if (type == NODE_ELEMENT)
+      {
+        auto* child = new TiXmlElement("");
+        element.LinkEndChild(child);
+        if (!ReadElement(*child, depth + 1))
+          return false;
+      }
+      else if (type == NODE_TEXT || type == NODE_CDATA)
+      {
+        const std::string* value;
+        if (!ReadIndex(value))
+          return false;
+        auto* text = new TiXmlText(*value);
+        text->SetCDATA(type == NODE_CDATA);
+        element.LinkEndChild(text);
+      }
+      else
+        return false;
+    }
+    return true;
+  }
+
+  bool ReadIndex(const std::string*& str)
+  {
+    uint64_t index;
+    if (!ReadVarint(m_data, m_offset, index) || index >= m_strings.size())
+      return false;
+
+    str = &m_strings[index];
+    return true;
+  }
+
+  const std::string& m_data;
+  size_t m_offset{0};
+  std::vector<std::string> m_strings;
+};
+} // unnamed namespace
+
+CGUIWindowCache::CGUIWindowCache(std::string cacheFolder) : m_cacheRoot(std::move(cacheFolder))
+{
+}
+
+bool CGUIWindowCache::FileInfo::IsUnchanged() const
+{
+  int64_t currentTime;
+  int64_t currentSize;
+  return GetFileInfo(path, currentTime, currentSize) && currentTime == time && currentSize == size;
+}
+
+void CGUIWindowCache::Reset(const std::string& skinId,
+                            const std::string& skinVersion,
+                            const CGUIIncludes& includes)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  m_entries.clear();
+  m_skinFiles = includes.GetFiles();
+
+  // cached windows are only valid for the includes they were resolved with
+  m_key = skinId + "|" + skinVersion;
+  for (const auto& file : m_skinFiles)
+  {
+    int64_t time = -1;
+    int64_t size = -1;
+    GetFileInfo(file, time, size);
+    m_key += StringUtils::Format("|{}|{}|{}", file, time, size);
+  }
+
+  m_cacheFolder = URIUtils::AddFileToFolder(m_cacheRoot, skinId);
+  URIUtils::AddSlashAtEnd(m_cacheFolder);
+  if (!XFILE::CDirectory::Exists(m_cacheFolder) && !XFILE::CDirectory::Create(m_cacheFolder))
+  {
+    CLog::Log(LOGWARNING, "CGUIWindowCache::{} - unable to create {}, cached windows are not kept",
+              __func__, m_cacheFolder);
+    m_cacheFolder.clear();
+  }
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowCache::Get(const std::string& windowFile,
+                                                   CGUIIncludes& includes,
+                                                   std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_key.empty())
+    return nullptr;
+
+  auto it = m_entries.find(windowFile);
+  if (it == m_entries.end())
+  {
+    Entry entry;
+    if (!LoadEntry(windowFile, entry))
+      return nullptr;
+    it = m_entries.emplace(windowFile, std::move(entry)).first;
+  }
+
+  const Entry& entry = it->second;
+  if (!entry.file.IsUnchanged() ||
+      !std::all_of(entry.includeFiles.begin(), entry.includeFiles.end(),
+                   [](const FileInfo& file) { return file.IsUnchanged(); }))
+  {
+    m_entries.erase(it);
+    return nullptr;
+  }
+
+  // the includes of the tree depend on the values of their conditions
+  std::map<INFO::InfoPtr, bool> conditions;
+  auto& infoManager = CServiceBroker::GetGUI()->GetInfoManager();
+  for (const auto& [expression, value] : entry.conditions)
+  {
+    INFO::InfoPtr condition = infoManager.Register(expression);
+    if (!condition || condition->Get(INFO::DEFAULT_CONTEXT) != value)
+      return nullptr;
+    conditions.emplace(condition, value);
+  }
+
+  std::unique_ptr<TiXmlElement> tree = DeserializeTree(entry.tree);
+  if (!tree)
+  {
+    CLog::Log(LOGERROR, "CGUIWindowCache::{} - invalid cached window {}", __func__, windowFile);
+    m_entries.erase(it);
+    return nullptr;
+  }
+
+  // the variables of include files loaded by the window are used when creating its controls
+  for (const auto& file : entry.includeFiles)
+    includes.Load(file.path);
+
+  includeConditions = std::move(conditions);
+  return tree;
+}
+
+void CGUIWindowCache::Store(const std::string& windowFile,
+                            const std::string& loadedFile,
+                            const TiXmlElement& resolved,
+                            const CGUIIncludes& includes,
+                            const std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_key.empty())
+    return;
+
+  Entry entry;
+  entry.file.path = loadedFile;
+  if (!GetFileInfo(loadedFile, entry.file.time, entry.file.size))
+    return;
+
+  for (const auto& file : includes.GetFiles())
+  {
+    if (std::find(m_skinFiles.begin(), m_skinFiles.end(), file) != m_skinFiles.end())
+      continue;
+
+    FileInfo info;
+    info.path = file;
+    if (!GetFileInfo(file, info.time, info.size))
+      return;
+    entry.includeFiles.push_back(std::move(info));
+  }
+
+  for (const auto& [condition, value] : includeConditions)
+    entry.conditions.emplace_back(condition->GetExpression(), value);
+
+  entry.tree = SerializeTree(resolved);
+
+  SaveEntry(windowFile, entry);
+  m_entries[windowFile] = std::move(entry);
+}
+
+std::string CGUIWindowCache::SerializeTree(const TiXmlElement& root)
+{
+  return CTreeWriter().Write(root);
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowCache::DeserializeTree(const std::string& data)
+{
+  return CTreeReader(data).Read();
+}
+
+std::string CGUIWindowCache::GetCacheFile(const std::string& windowFile) const
+{
+  return StringUtils::Format("{}{:08x}.bin", m_cacheFolder, Crc32::ComputeFromLowerCase(windowFile));
+}
+
+bool CGUIWindowCache::LoadEntry(const std::string& windowFile, Entry& entry) const
+{
+  if (m_cacheFolder.empty())
+    return false;
+
+  const std::string cacheFile = GetCacheFile(windowFile);
+  if (!CFile::Exists(cacheFile))
+    return false;
+
+  CFile file;
+  std::vector<uint8_t> buffer;
+  if (file.LoadFile(cacheFile, buffer) <= 0)
+    return false;
+
+  const std::string data(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  if (data.size() < sizeof(MAGIC) || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+
+  size_t offset = sizeof(MAGIC);
+  std::string key;
+  std::string window;
+  // written for another skin version, other includes or a window with the same hash
+  if (!ReadString(data, offset, key) || key != m_key || !ReadString(data, offset, window) ||
+      window != windowFile)
+    return false;
+
+  uint64_t count;
+  if (!ReadFileInfo(data, offset, entry.file.path, entry.file.time, entry.file.size) ||
+      !ReadVarint(data, offset, count) || count > data.size())
+    return false;
+
+  entry.includeFiles.resize(count);
+  for (auto& info : entry.includeFiles)
+  {
+    if (!ReadFileInfo(data, offset, info.path, info.time, info.size))
+      return false;
+  }
+
+  if (!ReadVarint(data, offset, count) || count > data.size())
+    return false;
+
+  entry.conditions.resize(count);
+  for (auto& [expression, value] : entry.conditions)
+  {
+    uint64_t result;
+    if (!ReadString(data, offset, expression) || !ReadVarint(data, offset, result))
+      return false;
+    value = result != 0;
+  }
+
+  return ReadString(data, offset, entry.tree) && offset == data.size();
+}
+
+void CGUIWindowCache::SaveEntry(const std::string& windowFile, const Entry& entry) const
+{
+  if (m_cacheFolder.empty())
+    return;
+
+  std::string data(MAGIC, sizeof(MAGIC));
+  WriteString(data, m_key);
+  WriteString(data, windowFile);
+  WriteFileInfo(data, entry.file.path, entry.file.time, entry.file.size);
+  WriteVarint(data, entry.includeFiles.size());
+  for (const auto& info : entry.includeFiles)
+    WriteFileInfo(data, info.path, info.time, info.size);
+  WriteVarint(data, entry.conditions.size());
+  for (const auto& [expression, value] : entry.conditions)
+  {
+    WriteString(data, expression);
+    WriteVarint(data, value ? 1 : 0);
+  }
+  WriteString(data, entry.tree);
+
+  const std::string cacheFile = GetCacheFile(windowFile);
+  CFile file;
+  if (!file.OpenForWrite(cacheFile, true) ||
+      file.Write(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGWARNING, "CGUIWindowCache::{} - unable to write {}", __func__, cacheFile);
+    file.Close();
+    CFile::Delete(cacheFile);
+  }
+}
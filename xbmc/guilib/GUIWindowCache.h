@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/info/InfoBool.h"
+#include "threads/CriticalSection.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CGUIIncludes;
+class TiXmlElement;
+
+/*!
+ \brief Cache of window XML trees with resolved includes, constants and expressions.
+
+ Resolving the includes of a window takes much longer than creating its controls, so
+ the resolved trees are kept in a compact binary form, in memory and in the temp folder.
+ A cached tree is used as long as the window file is unchanged and the conditions of the
+ includes evaluated while resolving it still have the same values. The cache is reset
+ with the includes of the skin, its entries are only valid for the same skin version and
+ unchanged include files.
+ */
+class CGUIWindowCache
+{
+public:
+  explicit CGUIWindowCache(std::string cacheFolder = "special://temp/skincache/");
+
+  /*!
+   \brief Drop all cached windows and start caching for the given skin and includes.
+   \param skinId the id of the skin
+   \param skinVersion the version of the skin
+   \param includes the includes loaded for the skin
+   */
+  void Reset(const std::string& skinId, const std::string& skinVersion, const CGUIIncludes& includes);
+
+  /*!
+   \brief Get the resolved tree of a window.
+   \param windowFile the path of the window XML
+   \param includes the includes of the skin, include files used by the window are loaded
+   \param includeConditions [out] the conditions of the includes of the window with their values
+   \return the resolved tree, nullptr if the window is not cached or has to be resolved again
+   */
+  std::unique_ptr<TiXmlElement> Get(const std::string& windowFile,
+                                    CGUIIncludes& includes,
+                                    std::map<INFO::InfoPtr, bool>& includeConditions);
+
+  /*!
+   \brief Store the resolved tree of a window.
+   \param windowFile the path of the window XML
+   \param loadedFile the path the window XML was loaded from
+   \param resolved the tree after resolving the includes
+   \param includes the includes of the skin
+   \param includeConditions the conditions evaluated while resolving the includes
+   */
+  void Store(const std::string& windowFile,
+             const std::string& loadedFile,
+             const TiXmlElement& resolved,
+             const CGUIIncludes& includes,
+             const std::map<INFO::InfoPtr, bool>& includeConditions);
+
+  /*!
+   \brief Serialize an XML tree, keeping elements, attributes and text.
+   */
+  static std::string SerializeTree(const TiXmlElement& root);
+
+  /*!
+   \brief Create an XML tree from its serialized form.
+   \return the tree, nullptr if the data is invalid
+   */
+  static std::unique_ptr<TiXmlElement> DeserializeTree(const std::string& data);
+
+private:
+  struct FileInfo
+  {
+    std::string path;
+    int64_t time{-1};
+    int64_t size{-1};
+
+    bool IsUnchanged() const;
+  };
+
+  struct Entry
+  {
+    FileInfo file;
+    std::vector<FileInfo> includeFiles; ///< include files loaded while resolving, beyond the skin's
+    std::vector<std::pair<std::string, bool>> conditions;
+    std::string tree;
+  };
+
+  std::string GetCacheFile(const std::string& windowFile) const;
+  bool LoadEntry(const std::string& windowFile, Entry& entry) const;
+  void SaveEntry(const std::string& windowFile, const Entry& entry) const;
+
+  const std::string m_cacheRoot;
+  mutable CCriticalSection m_critSection;
+  std::string m_cacheFolder;
+  std::string m_key;
+  std::vector<std::string> m_skinFiles;
+  std::unordered_map<std::string, Entry> m_entries;
+};
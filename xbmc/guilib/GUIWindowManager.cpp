@@ -43,6 +43,7 @@
 #include "settings/windows/GUIWindowSettingsCategory.h"
 #include "settings/windows/GUIWindowSettingsScreenCalibration.h"
 #include "threads/SingleLock.h"
+#include "utils/FrameTracer.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
@@ -1415,6 +1416,7 @@ void CGUIWindowManager::RenderEx() const
 bool CGUIWindowManager::Render()
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
+  FRAME_TRACE_SCOPE("CGUIWindowManager::Render");
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
   bool triggerRender = false;
 
@@ -1457,6 +1459,10 @@ bool CGUIWindowManager::Render()
   }
   else
   {
+    // One pass per region. Controls outside the scissors are culled with their subtree, see
+    // CGUIControl::IsRenderRegionBounding(). A single traversal rendering each control into every
+    // region it intersects would switch the scissors per control, flushing the GUI render queue
+    // each time, and change the blending order where regions overlap.
     for (const auto& i : dirtyRegions)
     {
       if (i.IsEmpty())
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LocalizeStringTable.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+constexpr char MAGIC[] = {'K', 'L', 'S', 1};
+
+void WriteVarint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const std::string& in, size_t& offset, uint64_t& value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64 && offset < in.size(); shift += 7)
+  {
+    const uint8_t byte = static_cast<uint8_t>(in[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+} // unnamed namespace
+
+CLocalizeStringTable::CLocalizeStringTable(const std::map<uint32_t, std::string>& strings)
+{
+  m_strings.reserve(strings.size());
+  for (const auto& [id, str] : strings)
+    Append(id, str);
+}
+
+void CLocalizeStringTable::Append(uint32_t id, std::string str)
+{
+  const uint32_t page = id >> PAGE_BITS;
+  // ids are added in order, so a new page always goes to the end
+  if (m_pages.empty() || m_pages.back() != page)
+  {
+    m_pages.push_back(page);
+    m_slots.resize(m_slots.size() + PAGE_SIZE, 0);
+  }
+
+  m_strings.push_back(std::move(str));
+  m_slots[(m_pages.size() - 1) * PAGE_SIZE + (id & (PAGE_SIZE - 1))] =
+      static_cast<uint32_t>(m_strings.size());
+}
+
+size_t CLocalizeStringTable::FindPage(uint32_t page) const
+{
+  auto it = std::lower_bound(m_pages.begin(), m_pages.end(), page);
+  if (it == m_pages.end() || *it != page)
+    return m_pages.size();
+  return static_cast<size_t>(it - m_pages.begin());
+}
+
+void CLocalizeStringTable::Clear()
+{
+  m_pages.clear();
+  m_slots.clear();
+  m_strings.clear();
+}
+
+std::string CLocalizeStringTable::Serialize() const
+{
+  std::string data(MAGIC, sizeof(MAGIC));
+  WriteVarint(data, m_strings.size());
+
+  // strings in order of their ids, each id as delta to the previous one
+  uint32_t previous = 0;
+  for (size_t page = 0; page < m_pages.size(); ++page)
+  {
+    for (uint32_t i = 0; i < PAGE_SIZE; ++i)
+    {
+      const uint32_t slot = m_slots[page * PAGE_SIZE + i];
+      if (!slot)
+        continue;
+
+      const uint32_t id = m_pages[page] << PAGE_BITS | i;
+      const std::string& str = m_strings[slot - 1];
+      WriteVarint(data, id - previous);
+      WriteVarint(data, str.size());
+      data.append(str);
+      previous = id;
+    }
+  }
+  return data;
+}
+
+bool CLocalizeStringTable::Deserialize(const std::string& data)
+{
+  Clear();
+
+  if (data.size() < sizeof(MAGIC) || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+
+  size_t offset = sizeof(MAGIC);
+  uint64_t count;
+  if (!ReadVarint(data, offset, count) || count > data.size())
+    return false;
+
+  m_strings.reserve(count);
+  uint64_t id = 0;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    uint64_t delta;
+    uint64_t size;
+    if (!ReadVarint(data, offset, delta) || (i > 0 && delta == 0) || delta > UINT32_MAX - id ||
+        !ReadVarint(data, offset, size) || size > data.size() - offset)
+    {
+      Clear();
+      return false;
+    }
+
+    id += delta;
+    Append(static_cast<uint32_t>(id), data.substr(offset, size));
+    offset += size;
+  }
+
+  if (offset != data.size())
+  {
+    Clear();
+    return false;
+  }
+
+  return true;
+}
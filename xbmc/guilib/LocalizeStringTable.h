@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ \ingroup strings
+ \brief Immutable table of localized strings, indexed by their id.
+
+ Ids of a strings file are clustered in a few ranges, so they are split into pages of
+ PAGE_SIZE ids. Only pages holding strings are kept, as dense arrays mapping the ids of the
+ page to the strings. A lookup is a binary search over the few pages and an array access.
+
+ The table has a compact serialized form, so a strings file is only parsed once and the
+ compiled table is loaded in a single read afterwards.
+ */
+class CLocalizeStringTable
+{
+public:
+  static constexpr unsigned int PAGE_BITS = 6;
+  static constexpr unsigned int PAGE_SIZE = 1 << PAGE_BITS;
+
+  CLocalizeStringTable() = default;
+  explicit CLocalizeStringTable(const std::map<uint32_t, std::string>& strings);
+
+  /*!
+   \brief Find a string
+   \param id the id of the string
+   \return the string, nullptr if the table has no string with the id
+   */
+  const std::string* Find(uint32_t id) const
+  {
+    const uint32_t page = id >> PAGE_BITS;
+    const size_t index = FindPage(page);
+    if (index == m_pages.size())
+      return nullptr;
+
+    const uint32_t slot = m_slots[index * PAGE_SIZE + (id & (PAGE_SIZE - 1))];
+    return slot ? &m_strings[slot - 1] : nullptr;
+  }
+
+  bool IsEmpty() const { return m_strings.empty(); }
+  size_t Size() const { return m_strings.size(); }
+
+  /*!
+   \brief Serialize the table into a compact binary form
+   */
+  std::string Serialize() const;
+
+  /*!
+   \brief Replace the table by a serialized one
+   \return false if the data is invalid, the table is left empty then
+   */
+  bool Deserialize(const std::string& data);
+
+private:
+  size_t FindPage(uint32_t page) const;
+  void Append(uint32_t id, std::string str);
+  void Clear();
+
+  std::vector<uint32_t> m_pages; ///< sorted numbers of the pages holding strings
+  std::vector<uint32_t> m_slots; ///< PAGE_SIZE entries per page, index of the string + 1 or 0
+  std::vector<std::string> m_strings;
+};
@@ -10,9 +10,11 @@
 
 #include "addons/LanguageResource.h"
 #include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
 #include "threads/SharedSection.h"
 #include "utils/CharsetConverter.h"
+#include "utils/Crc32.h"
 #include "utils/POUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -24,6 +26,15 @@
 
 #include <mutex>
 #include <shared_mutex>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t SKIN_STRINGS_START = 31000;
+constexpr uint32_t SKIN_STRINGS_END = 31999;
+
+const std::string COMPILED_STRINGS_FOLDER = "special://temp/languagecache/";
+} // unnamed namespace
 
 /*! \brief Tries to load ids and strings from a strings.po file to the `strings` map.
  * It should only be called from the LoadStr2Mem function to have a fallback.
@@ -96,16 +107,12 @@ static bool LoadPO(const std::string &filename, std::map<uint32_t, LocStr>& stri
   return true;
 }
 
-/*! \brief Loads language ids and strings to memory map `strings`.
+/*! \brief Get the strings file of a language.
  \param pathname The directory name, where we look for the strings file.
- \param language We load the strings for this language. Fallback language is always English.
- \param strings [out] The resulting strings map.
- \param encoding Encoding of the strings. For PO files we only use utf-8.
- \param offset An offset value to place strings from the id value.
- \return false if no strings.po file was loaded.
+ \param language The language of the strings file.
+ \return the path of the strings.po file, empty if the language doesn't exist.
  */
-static bool LoadStr2Mem(const std::string &pathname_in, const std::string &language,
-    std::map<uint32_t, LocStr>& strings,  std::string &encoding, uint32_t offset = 0 )
+static std::string GetStringsFile(const std::string& pathname_in, const std::string& language)
 {
   std::string pathname = CSpecialProtocol::TranslatePathConvertCase(pathname_in + language);
   if (!XFILE::CDirectory::Exists(pathname))
@@ -120,12 +127,30 @@ static bool LoadStr2Mem(const std::string &pathname_in, const std::string &langu
     }
 
     if (!exists)
-      return false;
+      return "";
   }
 
+  return URIUtils::AddFileToFolder(pathname, "strings.po");
+}
+
+/*! \brief Loads language ids and strings to memory map `strings`.
+ \param pathname The directory name, where we look for the strings file.
+ \param language We load the strings for this language. Fallback language is always English.
+ \param strings [out] The resulting strings map.
+ \param encoding Encoding of the strings. For PO files we only use utf-8.
+ \param offset An offset value to place strings from the id value.
+ \return false if no strings.po file was loaded.
+ */
+static bool LoadStr2Mem(const std::string &pathname_in, const std::string &language,
+    std::map<uint32_t, LocStr>& strings,  std::string &encoding, uint32_t offset = 0 )
+{
+  const std::string filename = GetStringsFile(pathname_in, language);
+  if (filename.empty())
+    return false;
+
   bool useSourceLang = StringUtils::EqualsNoCase(language, LANGUAGE_DEFAULT) || StringUtils::EqualsNoCase(language, LANGUAGE_OLD_DEFAULT);
 
-  return LoadPO(URIUtils::AddFileToFolder(pathname, "strings.po"), strings, encoding, offset, useSourceLang);
+  return LoadPO(filename, strings, encoding, offset, useSourceLang);
 }
 
 static bool LoadWithFallback(const std::string& path, const std::string& language, std::map<uint32_t, LocStr>& strings)
@@ -144,6 +169,86 @@ static bool LoadWithFallback(const std::string& path, const std::string& languag
   return true;
 }
 
+/*! \brief Loads language ids and strings with fallback to a string table. The table is compiled
+ once and loaded from the temp folder as long as the strings files don't change.
+ \param path The directory name, where we look for the strings files.
+ \param language We load the strings for this language. Fallback language is always English.
+ \param table [out] The resulting string table.
+ \param constants Strings set in addition to the ones of the strings files.
+ \return false if no strings.po file was loaded.
+ */
+static bool LoadTable(const std::string& path,
+                      const std::string& language,
+                      CLocalizeStringTable& table,
+                      const std::map<uint32_t, std::string>& constants = {})
+{
+  std::vector<std::string> files{GetStringsFile(path, language)};
+  if (!StringUtils::EqualsNoCase(language, LANGUAGE_DEFAULT))
+    files.push_back(GetStringsFile(path, LANGUAGE_DEFAULT));
+#if HAS_DS_PLAYER
+  files.push_back(CMediaSettings::GetInstance().GetCurrentMadvrSettings().m_FileStringPo);
+#endif
+
+  // the compiled table is only valid for the same strings files
+  std::string key = path + "|" + language;
+  for (const auto& file : files)
+  {
+    struct __stat64 st;
+    if (!file.empty() && XFILE::CFile::Stat(file, &st) == 0)
+      key += StringUtils::Format("|{}|{}|{}", file, st.st_mtime, st.st_size);
+    else
+      key += "|";
+  }
+  for (const auto& [id, str] : constants)
+    key += StringUtils::Format("|{}={}", id, str);
+
+  const std::string compiledFile = StringUtils::Format(
+      "{}{:08x}.bin", COMPILED_STRINGS_FOLDER, Crc32::Compute(path + "|" + language));
+
+  XFILE::CFile file;
+  std::vector<uint8_t> buffer;
+  if (XFILE::CFile::Exists(compiledFile) && file.LoadFile(compiledFile, buffer) > 0)
+  {
+    // the key, terminated by a null character, followed by the table
+    const std::string data(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    const size_t end = data.find('\0');
+    if (end != std::string::npos && data.compare(0, end, key) == 0 &&
+        table.Deserialize(data.substr(end + 1)))
+    {
+      CLog::Log(LOGDEBUG, "LocalizeStrings: loaded {} strings from compiled {}", table.Size(),
+                compiledFile);
+      return true;
+    }
+  }
+
+  std::map<uint32_t, LocStr> strings;
+  if (!LoadWithFallback(path, language, strings))
+    return false;
+
+  // the original strings are only needed while loading
+  std::map<uint32_t, std::string> translated;
+  for (auto& [id, str] : strings)
+    translated.emplace_hint(translated.end(), id, std::move(str.strTranslated));
+  for (const auto& [id, str] : constants)
+    translated[id] = str;
+
+  table = CLocalizeStringTable(translated);
+
+  if (!XFILE::CDirectory::Exists(COMPILED_STRINGS_FOLDER))
+    XFILE::CDirectory::Create(COMPILED_STRINGS_FOLDER);
+
+  const std::string data = key + '\0' + table.Serialize();
+  if (!file.OpenForWrite(compiledFile, true) ||
+      file.Write(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGWARNING, "LocalizeStrings: unable to write compiled strings {}", compiledFile);
+    file.Close();
+    XFILE::CFile::Delete(compiledFile);
+  }
+
+  return true;
+}
+
 CLocalizeStrings::CLocalizeStrings(void) = default;
 
 CLocalizeStrings::~CLocalizeStrings(void) = default;
@@ -152,108 +257,102 @@ void CLocalizeStrings::ClearSkinStrings()
 {
   // clear the skin strings
   std::unique_lock<CSharedSection> lock(m_stringsMutex);
-  Clear(31000, 31999);
+  m_skinStrings = {};
 }
 
 bool CLocalizeStrings::LoadSkinStrings(const std::string& path, const std::string& language)
 {
-  //! @todo shouldn't hold lock while loading file
+  CLocalizeStringTable strings;
+  const bool loaded = LoadTable(path, language, strings);
+
   std::unique_lock<CSharedSection> lock(m_stringsMutex);
-  ClearSkinStrings();
-  // load the skin strings in.
-  return LoadWithFallback(path, language, m_strings);
+  m_skinStrings = std::move(strings);
+  return loaded;
 }
 
 bool CLocalizeStrings::Load(const std::string& strPathName, const std::string& strLanguage)
 {
-  std::map<uint32_t, LocStr> strings;
-  if (!LoadWithFallback(strPathName, strLanguage, strings))
-    return false;
+  // the constant strings
+  static const std::map<uint32_t, std::string> constants = {
+      {20022, ""},         {20027, "°F"},       {20028, "K"},        {20029, "°C"},
+      {20030, "°Ré"},      {20031, "°Ra"},      {20032, "°Rø"},      {20033, "°De"},
+      {20034, "°N"},       {20200, "km/h"},     {20201, "m/min"},    {20202, "m/s"},
+      {20203, "ft/h"},     {20204, "ft/min"},   {20205, "ft/s"},     {20206, "mph"},
+      {20207, "kts"},      {20208, "Beaufort"}, {20209, "inch/s"},   {20210, "yard/s"},
+      {20211, "Furlong/Fortnight"}};
 
-  // fill in the constant strings
-  strings[20022].strTranslated = "";
-  strings[20027].strTranslated = "°F";
-  strings[20028].strTranslated = "K";
-  strings[20029].strTranslated = "°C";
-  strings[20030].strTranslated = "°Ré";
-  strings[20031].strTranslated = "°Ra";
-  strings[20032].strTranslated = "°Rø";
-  strings[20033].strTranslated = "°De";
-  strings[20034].strTranslated = "°N";
-
-  strings[20200].strTranslated = "km/h";
-  strings[20201].strTranslated = "m/min";
-  strings[20202].strTranslated = "m/s";
-  strings[20203].strTranslated = "ft/h";
-  strings[20204].strTranslated = "ft/min";
-  strings[20205].strTranslated = "ft/s";
-  strings[20206].strTranslated = "mph";
-  strings[20207].strTranslated = "kts";
-  strings[20208].strTranslated = "Beaufort";
-  strings[20209].strTranslated = "inch/s";
-  strings[20210].strTranslated = "yard/s";
-  strings[20211].strTranslated = "Furlong/Fortnight";
+  CLocalizeStringTable strings;
+  if (!LoadTable(strPathName, strLanguage, strings, constants))
+    return false;
 
   std::unique_lock<CSharedSection> lock(m_stringsMutex);
-  Clear();
   m_strings = std::move(strings);
+  m_skinStrings = {};
   return true;
 }
 
 const std::string& CLocalizeStrings::Get(uint32_t dwCode) const
 {
   std::shared_lock<CSharedSection> lock(m_stringsMutex);
-  ciStrings i = m_strings.find(dwCode);
-  if (i == m_strings.end())
+  // the skin strings only add to the core strings, apart from their own range
+  if (dwCode < SKIN_STRINGS_START || dwCode > SKIN_STRINGS_END)
   {
-    return StringUtils::Empty;
+    if (const std::string* str = m_strings.Find(dwCode))
+      return *str;
   }
-  return i->second.strTranslated;
-}
 
-void CLocalizeStrings::Clear()
-{
-  std::unique_lock<CSharedSection> lock(m_stringsMutex);
-  m_strings.clear();
+  if (const std::string* str = m_skinStrings.Find(dwCode))
+    return *str;
+
+  return StringUtils::Empty;
 }
 
-void CLocalizeStrings::Clear(uint32_t start, uint32_t end)
+void CLocalizeStrings::Clear()
 {
   std::unique_lock<CSharedSection> lock(m_stringsMutex);
-  iStrings it = m_strings.begin();
-  while (it != m_strings.end())
-  {
-    if (it->first >= start && it->first <= end)
-      m_strings.erase(it++);
-    else
-      ++it;
-  }
+  m_strings = {};
+  m_skinStrings = {};
 }
 
 bool CLocalizeStrings::LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId)
 {
-  std::map<uint32_t, LocStr> strings;
-  if (!LoadWithFallback(path, language, strings))
-    return false;
-
+  // most add-on strings are never shown, so they are loaded on first use
   std::unique_lock<CSharedSection> lock(m_addonStringsMutex);
-  auto it = m_addonStrings.find(addonId);
-  if (it != m_addonStrings.end())
-    m_addonStrings.erase(it);
-
-  return m_addonStrings.emplace(std::string(addonId), std::move(strings)).second;
+  AddonStrings& addon = m_addonStrings[addonId];
+  addon.path = path;
+  addon.language = language;
+  addon.loaded = false;
+  addon.strings = {};
+  return true;
 }
 
 std::string CLocalizeStrings::GetAddonString(const std::string& addonId, uint32_t code)
 {
-  std::shared_lock<CSharedSection> lock(m_addonStringsMutex);
+  {
+    std::shared_lock<CSharedSection> lock(m_addonStringsMutex);
+    auto i = m_addonStrings.find(addonId);
+    if (i == m_addonStrings.end())
+      return StringUtils::Empty;
+
+    if (i->second.loaded)
+    {
+      const std::string* str = i->second.strings.Find(code);
+      return str ? *str : StringUtils::Empty;
+    }
+  }
+
+  std::unique_lock<CSharedSection> lock(m_addonStringsMutex);
   auto i = m_addonStrings.find(addonId);
   if (i == m_addonStrings.end())
     return StringUtils::Empty;
 
-  auto j = i->second.find(code);
-  if (j == i->second.end())
-    return StringUtils::Empty;
+  AddonStrings& addon = i->second;
+  if (!addon.loaded)
+  {
+    LoadTable(addon.path, addon.language, addon.strings);
+    addon.loaded = true;
+  }
 
-  return j->second.strTranslated;
+  const std::string* str = addon.strings.Find(code);
+  return str ? *str : StringUtils::Empty;
 }
@@ -13,6 +13,7 @@
 \brief
 */
 
+#include "LocalizeStringTable.h"
 #include "threads/SharedSection.h"
 #include "utils/ILocalizer.h"
 
@@ -42,6 +43,12 @@ public:
   ~CLocalizeStrings(void) override;
   bool Load(const std::string& strPathName, const std::string& strLanguage);
   bool LoadSkinStrings(const std::string& path, const std::string& language);
+  /*!
+   \brief Set the strings of an add-on. They are loaded on first use.
+   \param path the language folder of the add-on
+   \param language the language to load
+   \param addonId the id of the add-on
+   */
   bool LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId);
   void ClearSkinStrings();
   const std::string& Get(uint32_t code) const;
@@ -52,12 +59,17 @@ public:
   std::string Localize(std::uint32_t code) const override { return Get(code); }
 
 protected:
-  void Clear(uint32_t start, uint32_t end);
+  struct AddonStrings
+  {
+    std::string path;
+    std::string language;
+    bool loaded = false;
+    CLocalizeStringTable strings;
+  };
 
-  std::map<uint32_t, LocStr> m_strings;
-  std::map<std::string, std::map<uint32_t, LocStr>> m_addonStrings;
-  typedef std::map<uint32_t, LocStr>::const_iterator ciStrings;
-  typedef std::map<uint32_t, LocStr>::iterator       iStrings;
+  CLocalizeStringTable m_strings;
+  CLocalizeStringTable m_skinStrings;
+  std::map<std::string, AddonStrings> m_addonStrings;
 
   mutable CSharedSection m_stringsMutex;
   CSharedSection m_addonStringsMutex;
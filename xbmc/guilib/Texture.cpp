@@ -10,6 +10,7 @@
 
 #include "DDSImage.h"
 #include "ServiceBroker.h"
+#include "TextureCache.h"
 #include "URL.h"
 #include "commons/ilog.h"
 #include "filesystem/File.h"
@@ -130,6 +131,18 @@ std::unique_ptr<CTexture> CTexture::LoadFromFile(const std::string& texturePath,
   return {};
 }
 
+std::unique_ptr<CTexture> CTexture::LoadFromFileForDownscale(const std::string& texturePath,
+                                                             unsigned int maxWidth,
+                                                             unsigned int maxHeight,
+                                                             const std::string& strMimeType)
+{
+  std::unique_ptr<CTexture> texture = CTexture::CreateTexture();
+  if (texture->LoadFromFileInternal(texturePath, 0, 0, CAspectRatio::CENTER, strMimeType, maxWidth,
+                                    maxHeight))
+    return texture;
+  return {};
+}
+
 std::unique_ptr<CTexture> CTexture::LoadFromFileInMemory(unsigned char* buffer,
                                                          size_t bufferSize,
                                                          const std::string& mimeType,
@@ -148,7 +161,9 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
                                     unsigned int idealWidth,
                                     unsigned int idealHeight,
                                     CAspectRatio::AspectRatio aspectRatio,
-                                    const std::string& strMimeType)
+                                    const std::string& strMimeType,
+                                    unsigned int fitWidth,
+                                    unsigned int fitHeight)
 {
   if (URIUtils::HasExtension(texturePath, ".dds"))
   { // special case for DDS images
@@ -161,6 +176,27 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
     return false;
   }
 
+  // cached images stored in the image pack are decoded straight from the mapped pack
+  const std::shared_ptr<CTextureCache> textureCache = CServiceBroker::GetTextureCache();
+  if (textureCache)
+  {
+    const auto packed = textureCache->GetPackedImage(texturePath);
+    if (packed)
+    {
+      IImage* pImage = strMimeType.empty() ? ImageFactory::CreateLoader(texturePath)
+                                           : ImageFactory::CreateLoaderFromMimeType(strMimeType);
+      const bool loaded =
+          LoadIImage(pImage, const_cast<unsigned char*>(packed->data),
+                     static_cast<unsigned int>(packed->size), idealWidth, idealHeight, aspectRatio,
+                     fitWidth, fitHeight);
+      if (!loaded)
+        CLog::Log(LOGDEBUG, "{} - Load of packed {} failed.", __FUNCTION__,
+                  CURL::GetRedacted(texturePath));
+      delete pImage;
+      return loaded;
+    }
+  }
+
   // Read image into memory to use our vfs
   XFILE::CFile file;
   std::vector<uint8_t> buf;
@@ -207,7 +243,8 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
   else
     pImage = ImageFactory::CreateLoaderFromMimeType(strMimeType);
 
-  if (!LoadIImage(pImage, buf.data(), buf.size(), idealWidth, idealHeight, aspectRatio))
+  if (!LoadIImage(pImage, buf.data(), buf.size(), idealWidth, idealHeight, aspectRatio, fitWidth,
+                  fitHeight))
   {
     CLog::Log(LOGDEBUG, "{} - Load of {} failed.", __FUNCTION__, CURL::GetRedacted(texturePath));
     delete pImage;
@@ -243,13 +280,17 @@ bool CTexture::LoadIImage(IImage* pImage,
                           unsigned int bufSize,
                           unsigned int idealWidth,
                           unsigned int idealHeight,
-                          CAspectRatio::AspectRatio aspectRatio)
+                          CAspectRatio::AspectRatio aspectRatio,
+                          unsigned int fitWidth,
+                          unsigned int fitHeight)
 {
   if (pImage == nullptr)
     return false;
 
   unsigned int maxTextureSize = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
-  if (!pImage->LoadImageFromMemory(buffer, bufSize, maxTextureSize, maxTextureSize))
+  if (!pImage->LoadImageFromMemory(buffer, bufSize,
+                                   fitWidth ? std::min(fitWidth, maxTextureSize) : maxTextureSize,
+                                   fitHeight ? std::min(fitHeight, maxTextureSize) : maxTextureSize))
     return false;
 
   if (pImage->Width() == 0 || pImage->Height() == 0)
@@ -55,6 +55,20 @@ public:
       CAspectRatio::AspectRatio aspectRatio = CAspectRatio::CENTER,
       const std::string& strMimeType = "");
 
+  /*! \brief Load a texture from a file that will be scaled down to fit within maxWidth x maxHeight
+   Lets the image decoder skip detail that won't survive the downscale (e.g. JPEG IDCT scaling),
+   so the returned texture may be smaller than the image, but still covers the downscaled size.
+   \param texturePath the path of the texture to load.
+   \param maxWidth the width the texture will be scaled down to fit in.
+   \param maxHeight the height the texture will be scaled down to fit in.
+   \param strMimeType mimetype of the given texture if available (defaults to empty)
+   \return a CTexture std::unique_ptr to the created texture - nullptr if the texture failed to load.
+   */
+  static std::unique_ptr<CTexture> LoadFromFileForDownscale(const std::string& texturePath,
+                                                            unsigned int maxWidth,
+                                                            unsigned int maxHeight,
+                                                            const std::string& strMimeType = "");
+
   /*! \brief Load a texture from a file in memory
    Loads a texture from a file in memory, restricting in size if needed based on maxHeight and maxWidth.
    Note that these are the ideal size to load at - the returned texture may be smaller or larger than these.
@@ -151,11 +165,19 @@ protected:
                             unsigned int idealWidth,
                             unsigned int idealHeight,
                             CAspectRatio::AspectRatio aspectRatio,
-                            const std::string& strMimeType = "");
+                            const std::string& strMimeType = "",
+                            unsigned int fitWidth = 0,
+                            unsigned int fitHeight = 0);
+  /*!
+   \param fitWidth,fitHeight size the image will be scaled down to fit in after loading, lets the
+   decoder reduce the resolution (defaults to 0, full resolution)
+   */
   bool LoadIImage(IImage* pImage,
                   unsigned char* buffer,
                   unsigned int bufSize,
                   unsigned int idealWidth,
                   unsigned int idealHeight,
-                  CAspectRatio::AspectRatio aspectRatio);
+                  CAspectRatio::AspectRatio aspectRatio,
+                  unsigned int fitWidth = 0,
+                  unsigned int fitHeight = 0);
 };
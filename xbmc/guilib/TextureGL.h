@@ -48,6 +48,8 @@ public:
     return true;
   }
 
+  GLuint GetTextureObject() const { return m_texture; }
+
 protected:
   void SetSwizzle();
   TextureFormat GetFormatGL(KD_TEX_FMT textureFormat);
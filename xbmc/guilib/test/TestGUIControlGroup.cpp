@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIControlGroup.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// a control drawing outside its render region, like the EPG grid
+class CUnboundedControl : public CGUIControl
+{
+public:
+  CUnboundedControl() : CGUIControl(0, 0, 0, 0, 10, 10) { ControlType = GUICONTAINER_EPGGRID; }
+  CUnboundedControl* Clone() const override { return new CUnboundedControl(*this); }
+};
+
+class CBoundedControl : public CGUIControl
+{
+public:
+  CBoundedControl() : CGUIControl(0, 0, 0, 0, 10, 10) {}
+  CBoundedControl* Clone() const override { return new CBoundedControl(*this); }
+};
+} // unnamed namespace
+
+TEST(TestGUIControlGroup, RenderRegionBounding)
+{
+  CGUIControlGroup group(0, 1, 0, 0, 100, 100);
+  group.AddControl(new CBoundedControl);
+  EXPECT_TRUE(group.IsRenderRegionBounding());
+
+  auto* unbounded = new CUnboundedControl;
+  group.AddControl(unbounded);
+  EXPECT_FALSE(group.IsRenderRegionBounding());
+
+  ASSERT_TRUE(group.RemoveControl(unbounded));
+  EXPECT_TRUE(group.IsRenderRegionBounding());
+  delete unbounded;
+}
+
+TEST(TestGUIControlGroup, NestedRenderRegionBounding)
+{
+  CGUIControlGroup outer(0, 1, 0, 0, 100, 100);
+  auto* middle = new CGUIControlGroup(0, 2, 0, 0, 50, 50);
+  auto* inner = new CGUIControlGroup(0, 3, 0, 0, 20, 20);
+  outer.AddControl(new CBoundedControl);
+  outer.AddControl(middle);
+  middle->AddControl(inner);
+  EXPECT_TRUE(outer.IsRenderRegionBounding());
+
+  // added below groups which are already part of the tree
+  auto* unbounded = new CUnboundedControl;
+  inner->AddControl(unbounded);
+  EXPECT_FALSE(inner->IsRenderRegionBounding());
+  EXPECT_FALSE(middle->IsRenderRegionBounding());
+  EXPECT_FALSE(outer.IsRenderRegionBounding());
+
+  // a second one keeps the groups unbounded when the first is removed
+  middle->AddControl(new CUnboundedControl);
+  ASSERT_TRUE(outer.RemoveControl(unbounded));
+  delete unbounded;
+  EXPECT_TRUE(inner->IsRenderRegionBounding());
+  EXPECT_FALSE(middle->IsRenderRegionBounding());
+  EXPECT_FALSE(outer.IsRenderRegionBounding());
+
+  middle->ClearAll();
+  EXPECT_TRUE(middle->IsRenderRegionBounding());
+  EXPECT_TRUE(outer.IsRenderRegionBounding());
+
+  // and when the unbounded subtree is added as a whole
+  auto* group = new CGUIControlGroup(0, 4, 0, 0, 20, 20);
+  group->AddControl(new CUnboundedControl);
+  middle->AddControl(group);
+  EXPECT_FALSE(outer.IsRenderRegionBounding());
+}
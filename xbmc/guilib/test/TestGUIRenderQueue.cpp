@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIRenderQueue.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class CRecordingRenderer : public CGUIRenderQueue::IRenderer
+{
+public:
+  void ApplyState(const CGUIRenderQueue::State& state) override
+  {
+    calls.emplace_back("state " + std::to_string(state.texture));
+  }
+
+  unsigned int DrawQuads(const CGUIRenderQueue::State& state,
+                         const std::vector<CGUIRenderQueue::Vertex>& vertices) override
+  {
+    calls.emplace_back("draw " + std::to_string(state.texture) + " " +
+                       std::to_string(vertices.size() / 4));
+    for (size_t i = 0; i < vertices.size(); i += 4)
+      firstX.emplace_back(vertices[i].x);
+    return 1;
+  }
+
+  std::vector<float> firstX;
+};
+
+CGUIRenderQueue::State MakeState(uintptr_t texture)
+{
+  CGUIRenderQueue::State state;
+  state.texture = texture;
+  state.blend = CGUIRenderQueue::BlendMode::ALPHA_KEEP_DEST;
+  return state;
+}
+
+void AddQuad(CGUIRenderQueue& queue, uintptr_t texture, float x, float y, float size = 10.0f)
+{
+  const CGUIRenderQueue::Vertex vertices[4] = {{x, y, 0, 0, 0, 0, 0},
+                                               {x + size, y, 0, 1, 0, 0, 0},
+                                               {x + size, y + size, 0, 1, 1, 0, 0},
+                                               {x, y + size, 0, 0, 1, 0, 0}};
+  queue.AddQuads(MakeState(texture), vertices, 4);
+}
+} // unnamed namespace
+
+TEST(TestGUIRenderQueue, MergesDisjointQuads)
+{
+  CGUIRenderQueue queue;
+  // a list of icons with labels, alternating between two textures
+  for (int i = 0; i < 10; ++i)
+  {
+    AddQuad(queue, 1, i * 20.0f, 0);
+    AddQuad(queue, 2, i * 20.0f, 20);
+  }
+
+  CRecordingRenderer renderer;
+  queue.Flush(renderer);
+  EXPECT_TRUE(queue.IsEmpty());
+
+  const std::vector<std::string> expected = {"state 1", "draw 1 10", "state 2", "draw 2 10"};
+  EXPECT_EQ(expected, renderer.calls);
+
+  queue.EndFrame();
+  const CGUIRenderQueue::Stats& stats = queue.GetFrameStats();
+  EXPECT_EQ(2u, stats.drawCalls);
+  EXPECT_EQ(2u, stats.stateChanges);
+  EXPECT_EQ(20u, stats.quads);
+  EXPECT_EQ(20u, stats.items);
+}
+
+TEST(TestGUIRenderQueue, KeepsOrderOfOverlappingQuads)
+{
+  CGUIRenderQueue queue;
+  AddQuad(queue, 1, 0, 0);
+  AddQuad(queue, 2, 5, 5);
+  // overlaps the quad of texture 2, so it must be drawn after it
+  AddQuad(queue, 1, 8, 8);
+  // doesn't overlap anything in between, so may join the last batch of texture 1
+  AddQuad(queue, 1, 100, 100);
+
+  CRecordingRenderer renderer;
+  queue.Flush(renderer);
+
+  const std::vector<std::string> expected = {"state 1", "draw 1 1", "state 2", "draw 2 1",
+                                             "state 1", "draw 1 2"};
+  EXPECT_EQ(expected, renderer.calls);
+  const std::vector<float> firstX = {0, 5, 8, 100};
+  EXPECT_EQ(firstX, renderer.firstX);
+}
+
+TEST(TestGUIRenderQueue, Commands)
+{
+  CGUIRenderQueue queue;
+  CRecordingRenderer renderer;
+
+  AddQuad(queue, 1, 0, 0);
+  queue.AddCommand(MakeState(1), CRect(50, 50, 60, 60), [&renderer]() {
+    renderer.calls.emplace_back("command");
+    return 3u;
+  });
+  // commands are never merged with, but quads may be moved across them if they don't overlap
+  AddQuad(queue, 1, 100, 0);
+  AddQuad(queue, 2, 55, 55);
+  AddQuad(queue, 1, 200, 0);
+
+  queue.Flush(renderer);
+
+  const std::vector<std::string> expected = {"state 1", "draw 1 3", "command", "state 2",
+                                             "draw 2 1"};
+  EXPECT_EQ(expected, renderer.calls);
+
+  queue.EndFrame();
+  EXPECT_EQ(5u, queue.GetFrameStats().drawCalls);
+  EXPECT_EQ(2u, queue.GetFrameStats().stateChanges);
+}
+
+TEST(TestGUIRenderQueue, Clear)
+{
+  CGUIRenderQueue queue;
+  bool called = false;
+  queue.AddCommand(MakeState(1), CRect(0, 0, 10, 10), [&called]() {
+    called = true;
+    return 1u;
+  });
+  AddQuad(queue, 1, 0, 0);
+  queue.Clear();
+  EXPECT_TRUE(queue.IsEmpty());
+
+  CRecordingRenderer renderer;
+  queue.Flush(renderer);
+  EXPECT_FALSE(called);
+  EXPECT_TRUE(renderer.calls.empty());
+}
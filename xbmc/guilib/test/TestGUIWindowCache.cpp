@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIWindowCache.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const char* WINDOW = R"(<window type="dialog">
+  <defaultcontrol always="true">9000</defaultcontrol>
+  <!-- a comment -->
+  <controls>
+    <control type="label" id="9000">
+      <left>40</left>
+      <top>40</top>
+      <label>$INFO[ListItem.Label] &amp; more</label>
+      <visible>!String.IsEmpty(ListItem.Label)</visible>
+    </control>
+    <control type="image">
+      <texture border="10" colordiffuse="ff000000">dialogs/dialog-bg.png</texture>
+      <animation effect="fade" start="0" end="100" time="200">WindowOpen</animation>
+      <animation effect="fade" start="100" end="0" time="200">WindowClose</animation>
+    </control>
+    <control type="textbox">
+      <label><![CDATA[<b>bold</b>]]></label>
+    </control>
+  </controls>
+</window>)";
+
+std::string Print(const TiXmlNode& node)
+{
+  TiXmlPrinter printer;
+  node.Accept(&printer);
+  return printer.Str();
+}
+} // namespace
+
+TEST(TestGUIWindowCache, SerializeTree)
+{
+  CXBMCTinyXML doc;
+  ASSERT_TRUE(doc.Parse(WINDOW));
+
+  const std::string data = CGUIWindowCache::SerializeTree(*doc.RootElement());
+  // names and values repeated in the tree are stored once
+  EXPECT_LT(data.size(), std::string(WINDOW).size());
+
+  auto tree = CGUIWindowCache::DeserializeTree(data);
+  ASSERT_NE(nullptr, tree);
+
+  // the comment is dropped, everything else is kept
+  doc.RootElement()->RemoveChild(doc.RootElement()->FirstChildElement("controls")->PreviousSibling());
+  EXPECT_EQ(Print(*doc.RootElement()), Print(*tree));
+
+  const TiXmlElement* label =
+      tree->FirstChildElement("controls")->LastChild()->FirstChildElement("label");
+  ASSERT_NE(nullptr, label);
+  ASSERT_NE(nullptr, label->FirstChild()->ToText());
+  EXPECT_TRUE(label->FirstChild()->ToText()->CDATA());
+}
+
+TEST(TestGUIWindowCache, DeserializeInvalidTree)
+{
+  CXBMCTinyXML doc;
+  ASSERT_TRUE(doc.Parse(WINDOW));
+  const std::string data = CGUIWindowCache::SerializeTree(*doc.RootElement());
+
+  EXPECT_EQ(nullptr, CGUIWindowCache::DeserializeTree(data.substr(0, data.size() - 1)));
+  EXPECT_EQ(nullptr, CGUIWindowCache::DeserializeTree(data + '\0'));
+  EXPECT_EQ(nullptr, CGUIWindowCache::DeserializeTree("garbage"));
+  EXPECT_EQ(nullptr, CGUIWindowCache::DeserializeTree(""));
+}
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LangInfo.h"
+#include "filesystem/Directory.h"
+#include "guilib/LocalizeStringTable.h"
+#include "guilib/LocalizeStrings.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const std::string COMPILED_STRINGS_FOLDER = "special://temp/languagecache/";
+
+std::map<uint32_t, std::string> CreateStrings()
+{
+  std::map<uint32_t, std::string> strings;
+  // clustered ranges like in the strings files, with gaps and single strings far apart
+  for (uint32_t id = 0; id < 1000; id += 1 + id % 3)
+    strings[id] = "string " + std::to_string(id);
+  for (uint32_t id = 31000; id < 31100; ++id)
+    strings[id] = std::to_string(id);
+  strings[65535] = "";
+  strings[4000000000] = "far away";
+  return strings;
+}
+} // namespace
+
+TEST(TestLocalizeStringTable, Find)
+{
+  const std::map<uint32_t, std::string> strings = CreateStrings();
+  const CLocalizeStringTable table(strings);
+  EXPECT_EQ(strings.size(), table.Size());
+
+  for (uint32_t id = 0; id < 70000; ++id)
+  {
+    const std::string* str = table.Find(id);
+    const auto it = strings.find(id);
+    if (it == strings.end())
+      EXPECT_EQ(nullptr, str) << id;
+    else
+    {
+      ASSERT_NE(nullptr, str) << id;
+      EXPECT_EQ(it->second, *str);
+    }
+  }
+  ASSERT_NE(nullptr, table.Find(4000000000));
+  EXPECT_EQ("far away", *table.Find(4000000000));
+  EXPECT_EQ(nullptr, table.Find(UINT32_MAX));
+
+  EXPECT_EQ(nullptr, CLocalizeStringTable().Find(0));
+}
+
+TEST(TestLocalizeStringTable, Serialize)
+{
+  const std::map<uint32_t, std::string> strings = CreateStrings();
+  const CLocalizeStringTable table(strings);
+  const std::string data = table.Serialize();
+
+  CLocalizeStringTable restored;
+  ASSERT_TRUE(restored.Deserialize(data));
+  EXPECT_EQ(strings.size(), restored.Size());
+  for (const auto& [id, str] : strings)
+  {
+    ASSERT_NE(nullptr, restored.Find(id));
+    EXPECT_EQ(str, *restored.Find(id));
+  }
+  EXPECT_EQ(data, restored.Serialize());
+
+  EXPECT_FALSE(restored.Deserialize(data.substr(0, data.size() - 1)));
+  EXPECT_TRUE(restored.IsEmpty());
+  EXPECT_FALSE(restored.Deserialize(data + "x"));
+  EXPECT_FALSE(restored.Deserialize("garbage"));
+  EXPECT_FALSE(restored.Deserialize(""));
+}
+
+TEST(TestLocalizeStrings, CompiledStrings)
+{
+  XFILE::CDirectory::RemoveRecursive(COMPILED_STRINGS_FOLDER);
+
+  CLocalizeStrings parsed;
+  ASSERT_TRUE(parsed.Load(g_langInfo.GetLanguagePath(), "resource.language.en_gb"));
+  CLocalizeStrings compiled;
+  ASSERT_TRUE(compiled.Load(g_langInfo.GetLanguagePath(), "resource.language.en_gb"));
+
+  unsigned int strings = 0;
+  for (uint32_t id = 0; id < 100000; ++id)
+  {
+    EXPECT_EQ(parsed.Get(id), compiled.Get(id)) << id;
+    if (!parsed.Get(id).empty())
+      ++strings;
+  }
+  EXPECT_GT(strings, 1000u);
+  EXPECT_EQ("°C", compiled.Get(20029));
+}
+
+// Load and lookup cost of the strings files against the compiled tables, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestLocalizeStrings.DISABLED_Benchmark
+TEST(TestLocalizeStrings, DISABLED_Benchmark)
+{
+  constexpr int ROUNDS = 10;
+
+  for (bool compiled : {false, true})
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+      if (!compiled)
+        XFILE::CDirectory::RemoveRecursive(COMPILED_STRINGS_FOLDER);
+      CLocalizeStrings strings;
+      ASSERT_TRUE(strings.Load(g_langInfo.GetLanguagePath(), "resource.language.en_gb"));
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << (compiled ? "compiled table" : "strings.po") << ": "
+              << elapsed.count() / ROUNDS << " ms per load" << std::endl;
+  }
+
+  CLocalizeStrings localizeStrings;
+  ASSERT_TRUE(localizeStrings.Load(g_langInfo.GetLanguagePath(), "resource.language.en_gb"));
+  std::map<uint32_t, std::string> map;
+  for (uint32_t id = 0; id < 100000; ++id)
+  {
+    if (!localizeStrings.Get(id).empty())
+      map[id] = localizeStrings.Get(id);
+  }
+  const CLocalizeStringTable table(map);
+
+  constexpr int LOOKUPS = 100;
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < LOOKUPS; ++round)
+  {
+    for (uint32_t id = 0; id < 40000; ++id)
+      found += map.find(id) != map.end();
+  }
+  const std::chrono::duration<double, std::nano> mapElapsed =
+      std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < LOOKUPS; ++round)
+  {
+    for (uint32_t id = 0; id < 40000; ++id)
+      found += table.Find(id) != nullptr;
+  }
+  const std::chrono::duration<double, std::nano> tableElapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << map.size() << " strings, found " << found << ", map: "
+            << mapElapsed.count() / (LOOKUPS * 40000) << " ns per lookup, table: "
+            << tableElapsed.count() / (LOOKUPS * 40000) << " ns per lookup" << std::endl;
+}
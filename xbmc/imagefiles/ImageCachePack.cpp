@@ -0,0 +1,546 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ImageCachePack.h"
+
+#include "utils/EndianSwap.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include "platform/posix/utils/Mmap.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(TARGET_WINDOWS)
+#include "utils/CharsetConverter.h"
+
+#include <io.h>
+#include <windows.h>
+#endif
+
+using namespace IMAGE_FILES;
+
+namespace
+{
+constexpr char PACK_MAGIC[4] = {'K', 'T', 'C', 'P'};
+constexpr uint32_t PACK_VERSION = 1;
+constexpr size_t PACK_HEADER_SIZE = sizeof(PACK_MAGIC) + sizeof(uint32_t);
+constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr uint32_t TOMBSTONE = 0xFFFFFFFF;
+constexpr uint32_t MAX_NAME_LENGTH = 1024;
+// Compact once removed/replaced images take more than half the pack and at least this much
+constexpr uint64_t MIN_WASTED_BYTES_FOR_COMPACTION = 16 * 1024 * 1024;
+
+FILE* OpenFile(const std::string& path, const char* mode)
+{
+#ifdef TARGET_WINDOWS
+  std::wstring pathW;
+  std::wstring modeW;
+  g_charsetConverter.utf8ToW(path, pathW, false);
+  g_charsetConverter.utf8ToW(mode, modeW, false);
+  return _wfopen(pathW.c_str(), modeW.c_str());
+#else
+  return fopen(path.c_str(), mode);
+#endif
+}
+
+bool RenameFile(const std::string& from, const std::string& to)
+{
+#ifdef TARGET_WINDOWS
+  std::wstring fromW;
+  std::wstring toW;
+  g_charsetConverter.utf8ToW(from, fromW, false);
+  g_charsetConverter.utf8ToW(to, toW, false);
+  return MoveFileExW(fromW.c_str(), toW.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+bool TruncateFile(FILE* file, uint64_t size)
+{
+#ifdef TARGET_WINDOWS
+  return _chsize_s(_fileno(file), static_cast<__int64>(size)) == 0;
+#else
+  return ftruncate(fileno(file), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+bool SeekFile(FILE* file, int64_t offset, int whence)
+{
+#ifdef TARGET_WINDOWS
+  return _fseeki64(file, offset, whence) == 0;
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence) == 0;
+#endif
+}
+
+int64_t TellFile(FILE* file)
+{
+#ifdef TARGET_WINDOWS
+  return _ftelli64(file);
+#else
+  return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+bool ReadUInt32(FILE* file, uint32_t& value)
+{
+  if (fread(&value, sizeof(value), 1, file) != 1)
+    return false;
+  value = Endian_SwapLE32(value);
+  return true;
+}
+
+bool WriteUInt32(FILE* file, uint32_t value)
+{
+  value = Endian_SwapLE32(value);
+  return fwrite(&value, sizeof(value), 1, file) == 1;
+}
+} // unnamed namespace
+
+/*!
+ * \brief Read only view of the whole pack file. Memory mapped where supported,
+ * otherwise a copy of the file, made of chunks shared with the previous view so
+ * only what was appended since is read.
+ */
+class CImageCachePack::CMapping
+{
+public:
+  static std::shared_ptr<const CMapping> Create(const std::string& path,
+                                                uint64_t size,
+                                                const std::shared_ptr<const CMapping>& previous)
+  {
+    auto mapping = std::make_shared<CMapping>();
+    if (size == 0)
+      return mapping;
+
+#if defined(TARGET_POSIX)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return {};
+    try
+    {
+      mapping->m_mmap = std::make_unique<KODI::UTILS::POSIX::CMmap>(
+          nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    catch (const std::system_error& e)
+    {
+      CLog::LogF(LOGERROR, "failed to map '{}': {}", path, e.what());
+      close(fd);
+      return {};
+    }
+    close(fd);
+    mapping->m_data = static_cast<const uint8_t*>(mapping->m_mmap->Data());
+#else
+    uint64_t start = 0;
+    if (previous && previous->m_size <= size)
+    {
+      mapping->m_chunks = previous->m_chunks;
+      start = previous->m_size;
+    }
+
+    if (start < size)
+    {
+      FILE* file = OpenFile(path, "rb");
+      if (!file)
+        return {};
+      auto chunk = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(size - start));
+      const bool ok = SeekFile(file, static_cast<int64_t>(start), SEEK_SET) &&
+                      fread(chunk->data(), chunk->size(), 1, file) == 1;
+      fclose(file);
+      if (!ok)
+        return {};
+      mapping->m_chunks.emplace_back(Chunk{start, std::move(chunk)});
+    }
+#endif
+    mapping->m_size = size;
+    return mapping;
+  }
+
+  /*! \brief Get the bytes at the given offset, which has to be within a record */
+  const uint8_t* Data(uint64_t offset) const
+  {
+#if defined(TARGET_POSIX)
+    return m_data + offset;
+#else
+    // chunks end at record boundaries, so a record never spans two of them
+    auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), offset,
+                               [](uint64_t value, const Chunk& chunk) { return value < chunk.start; });
+    if (it == m_chunks.begin())
+      return nullptr;
+    --it;
+    return it->data->data() + (offset - it->start);
+#endif
+  }
+
+  uint64_t Size() const { return m_size; }
+
+private:
+  uint64_t m_size = 0;
+#if defined(TARGET_POSIX)
+  const uint8_t* m_data = nullptr;
+  std::unique_ptr<KODI::UTILS::POSIX::CMmap> m_mmap;
+#else
+  struct Chunk
+  {
+    uint64_t start;
+    std::shared_ptr<const std::vector<uint8_t>> data;
+  };
+  std::vector<Chunk> m_chunks;
+#endif
+};
+
+CImageCachePack::~CImageCachePack()
+{
+  Close();
+}
+
+bool CImageCachePack::Open(const std::string& path)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (m_file && path == m_path)
+    return true;
+
+  if (m_file)
+  {
+    fclose(m_file);
+    m_file = nullptr;
+  }
+  m_mapping.reset();
+  m_path = path;
+
+  m_file = OpenFile(m_path, "r+b");
+  if (!m_file || !ReadIndex())
+  {
+    if (m_file)
+    {
+      CLog::LogF(LOGWARNING, "invalid image cache pack '{}', recreating", m_path);
+      fclose(m_file);
+      m_file = nullptr;
+    }
+    if (!CreateEmpty())
+      return false;
+  }
+
+  CLog::LogF(LOGDEBUG, "opened image cache pack '{}' with {} images, {} of {} bytes unused",
+             m_path, m_index.size(), m_wastedBytes, m_fileSize);
+  return true;
+}
+
+void CImageCachePack::Close()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (m_file)
+  {
+    fclose(m_file);
+    m_file = nullptr;
+  }
+  m_index.clear();
+  m_mapping.reset();
+  m_fileSize = 0;
+  m_wastedBytes = 0;
+}
+
+bool CImageCachePack::IsOpen() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_file != nullptr;
+}
+
+bool CImageCachePack::CreateEmpty()
+{
+  m_index.clear();
+  m_mapping.reset();
+  m_wastedBytes = 0;
+  m_fileSize = 0;
+
+  m_file = OpenFile(m_path, "w+b");
+  if (!m_file)
+  {
+    CLog::LogF(LOGERROR, "unable to create image cache pack '{}'", m_path);
+    return false;
+  }
+
+  if (fwrite(PACK_MAGIC, sizeof(PACK_MAGIC), 1, m_file) != 1 ||
+      !WriteUInt32(m_file, PACK_VERSION) || fflush(m_file) != 0)
+  {
+    fclose(m_file);
+    m_file = nullptr;
+    return false;
+  }
+  m_fileSize = PACK_HEADER_SIZE;
+  return true;
+}
+
+bool CImageCachePack::ReadIndex()
+{
+  char magic[sizeof(PACK_MAGIC)];
+  uint32_t version;
+  if (fread(magic, sizeof(magic), 1, m_file) != 1 ||
+      memcmp(magic, PACK_MAGIC, sizeof(magic)) != 0 || !ReadUInt32(m_file, version) ||
+      version != PACK_VERSION)
+    return false;
+
+  m_index.clear();
+  m_wastedBytes = 0;
+  uint64_t position = PACK_HEADER_SIZE;
+  std::string name;
+  while (true)
+  {
+    uint32_t nameLength;
+    uint32_t dataLength;
+    if (!ReadUInt32(m_file, nameLength) || !ReadUInt32(m_file, dataLength))
+      break;
+    if (nameLength == 0 || nameLength > MAX_NAME_LENGTH)
+      break;
+    name.resize(nameLength);
+    if (fread(name.data(), nameLength, 1, m_file) != 1)
+      break;
+
+    const uint64_t dataOffset = position + RECORD_HEADER_SIZE + nameLength;
+    const uint64_t recordEnd = dataOffset + (dataLength == TOMBSTONE ? 0 : dataLength);
+    if (dataLength != TOMBSTONE && !SeekFile(m_file, dataLength, SEEK_CUR))
+      break;
+
+    // an earlier version of the image, or a tombstone, is dead space from now on
+    auto it = m_index.find(name);
+    if (it != m_index.end())
+    {
+      m_wastedBytes += RECORD_HEADER_SIZE + it->first.size() + it->second.size;
+      m_index.erase(it);
+    }
+    if (dataLength == TOMBSTONE)
+      m_wastedBytes += RECORD_HEADER_SIZE + nameLength;
+    else
+      m_index.emplace(name, Entry{dataOffset, dataLength});
+
+    position = recordEnd;
+  }
+
+  // check the last record is complete, e.g. after a crash while appending
+  if (!SeekFile(m_file, 0, SEEK_END))
+    return false;
+  const uint64_t fileSize = static_cast<uint64_t>(TellFile(m_file));
+  if (fileSize < position)
+  {
+    // data of the last record is missing
+    for (auto it = m_index.begin(); it != m_index.end();)
+    {
+      if (it->second.offset + it->second.size > fileSize)
+      {
+        position = it->second.offset - RECORD_HEADER_SIZE - it->first.size();
+        it = m_index.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+  if (fileSize != position)
+  {
+    CLog::LogF(LOGWARNING, "truncating incomplete record at {} in '{}'", position, m_path);
+    if (!TruncateFile(m_file, position))
+      return false;
+  }
+
+  m_fileSize = position;
+  return Remap();
+}
+
+bool CImageCachePack::Remap()
+{
+  if (m_mapping && m_mapping->Size() == m_fileSize)
+    return true;
+
+  m_mapping = CMapping::Create(m_path, m_fileSize, m_mapping);
+  return m_mapping != nullptr;
+}
+
+bool CImageCachePack::AppendRecord(const std::string& name, const uint8_t* data, uint32_t size)
+{
+  if (!SeekFile(m_file, static_cast<int64_t>(m_fileSize), SEEK_SET))
+    return false;
+
+  const uint32_t nameLength = static_cast<uint32_t>(name.size());
+  const bool ok = WriteUInt32(m_file, nameLength) && WriteUInt32(m_file, size) &&
+                  fwrite(name.data(), nameLength, 1, m_file) == 1 &&
+                  (size == TOMBSTONE || size == 0 || fwrite(data, size, 1, m_file) == 1) &&
+                  fflush(m_file) == 0;
+  if (!ok)
+  {
+    CLog::LogF(LOGERROR, "failed to append '{}' to '{}'", name, m_path);
+    TruncateFile(m_file, m_fileSize);
+    return false;
+  }
+
+  m_fileSize += RECORD_HEADER_SIZE + nameLength + (size == TOMBSTONE ? 0 : size);
+  return true;
+}
+
+bool CImageCachePack::Add(const std::string& name, const uint8_t* data, size_t size)
+{
+  if (name.empty() || name.size() > MAX_NAME_LENGTH || size >= TOMBSTONE)
+    return false;
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (!m_file)
+    return false;
+
+  const uint64_t dataOffset = m_fileSize + RECORD_HEADER_SIZE + name.size();
+  if (!AppendRecord(name, data, static_cast<uint32_t>(size)))
+    return false;
+
+  auto it = m_index.find(name);
+  if (it != m_index.end())
+  {
+    m_wastedBytes += RECORD_HEADER_SIZE + name.size() + it->second.size;
+    it->second = Entry{dataOffset, static_cast<uint32_t>(size)};
+  }
+  else
+    m_index.emplace(name, Entry{dataOffset, static_cast<uint32_t>(size)});
+
+  return true;
+}
+
+bool CImageCachePack::Remove(const std::string& name)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  auto it = m_index.find(name);
+  if (!m_file || it == m_index.end())
+    return false;
+
+  if (!AppendRecord(name, nullptr, TOMBSTONE))
+    return false;
+
+  m_wastedBytes += 2 * RECORD_HEADER_SIZE + 2 * name.size() + it->second.size;
+  m_index.erase(it);
+  return true;
+}
+
+bool CImageCachePack::Has(const std::string& name) const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_index.find(name) != m_index.end();
+}
+
+std::optional<CImageCachePack::Blob> CImageCachePack::Get(const std::string& name)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  auto it = m_index.find(name);
+  if (it == m_index.end())
+    return {};
+
+  const Entry& entry = it->second;
+  if (!m_mapping || entry.offset + entry.size > m_mapping->Size())
+  {
+    // appended since the last mapping
+    if (!Remap())
+      return {};
+  }
+
+  return Blob{m_mapping, m_mapping->Data(entry.offset), entry.size};
+}
+
+bool CImageCachePack::NeedsCompaction() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_wastedBytes >= MIN_WASTED_BYTES_FOR_COMPACTION && m_wastedBytes * 2 > m_fileSize;
+}
+
+bool CImageCachePack::Compact()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (!m_file)
+    return false;
+  if (m_wastedBytes == 0)
+    return true;
+
+  if (!Remap())
+    return false;
+
+  const std::string tempPath = m_path + ".tmp";
+  FILE* file = OpenFile(tempPath, "wb");
+  if (!file)
+    return false;
+
+  bool ok = fwrite(PACK_MAGIC, sizeof(PACK_MAGIC), 1, file) == 1 &&
+            WriteUInt32(file, PACK_VERSION);
+  uint64_t position = PACK_HEADER_SIZE;
+  std::unordered_map<std::string, Entry> index;
+  index.reserve(m_index.size());
+  for (const auto& [name, entry] : m_index)
+  {
+    if (!ok)
+      break;
+    const uint32_t nameLength = static_cast<uint32_t>(name.size());
+    ok = WriteUInt32(file, nameLength) && WriteUInt32(file, entry.size) &&
+         fwrite(name.data(), nameLength, 1, file) == 1 &&
+         (entry.size == 0 ||
+          fwrite(m_mapping->Data(entry.offset), entry.size, 1, file) == 1);
+    index.emplace(name, Entry{position + RECORD_HEADER_SIZE + nameLength, entry.size});
+    position += RECORD_HEADER_SIZE + nameLength + entry.size;
+  }
+  ok = fclose(file) == 0 && ok;
+
+  if (!ok)
+  {
+    CLog::LogF(LOGERROR, "failed to write compacted image cache pack '{}'", tempPath);
+    remove(tempPath.c_str());
+    return false;
+  }
+
+  // readers may still hold blobs of the current mapping, which stays valid
+  fclose(m_file);
+  m_file = nullptr;
+  if (!RenameFile(tempPath, m_path))
+  {
+    CLog::LogF(LOGERROR, "failed to replace image cache pack '{}'", m_path);
+    m_file = OpenFile(m_path, "r+b");
+    return false;
+  }
+
+  m_file = OpenFile(m_path, "r+b");
+  if (!m_file)
+  {
+    m_index.clear();
+    m_mapping.reset();
+    return false;
+  }
+
+  CLog::LogF(LOGDEBUG, "compacted image cache pack '{}' from {} to {} bytes", m_path, m_fileSize,
+             position);
+  m_index = std::move(index);
+  m_fileSize = position;
+  m_wastedBytes = 0;
+  m_mapping.reset();
+  return Remap();
+}
+
+size_t CImageCachePack::GetImageCount() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_index.size();
+}
+
+uint64_t CImageCachePack::GetFileSize() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_fileSize;
+}
+
+uint64_t CImageCachePack::GetWastedBytes() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_wastedBytes;
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace IMAGE_FILES
+{
+/*!
+ * \brief Append-only pack of cached images, read through a memory mapping.
+ *
+ * Stores encoded cached images (JPEG/PNG) keyed by their cache file name (see
+ * CTextureCache::GetCacheFile) in a single file instead of one file per image.
+ * An in-memory hash index maps names to their location in the pack. Removal
+ * appends a tombstone record, space is reclaimed by Compact().
+ *
+ * Layout, all integers little endian:
+ *   header: "KTCP" magic, uint32 version
+ *   record: uint32 name length, uint32 data length (or TOMBSTONE), name, data
+ */
+class CImageCachePack
+{
+  class CMapping;
+
+public:
+  /*! \brief View of a packed image. Stays valid while the object is alive, even if the pack
+   is appended to or compacted in the meantime.
+   */
+  struct Blob
+  {
+    std::shared_ptr<const CMapping> mapping;
+    const uint8_t* data;
+    size_t size;
+  };
+
+  CImageCachePack() = default;
+  ~CImageCachePack();
+
+  /*! \brief Open the pack, creating it if needed, and build the index
+   \param path local filesystem path of the pack file
+   \return true if the pack can be used
+   */
+  bool Open(const std::string& path);
+  void Close();
+  bool IsOpen() const;
+
+  /*! \brief Add or replace an image */
+  bool Add(const std::string& name, const uint8_t* data, size_t size);
+
+  /*! \brief Remove an image, the space is reclaimed on the next compaction */
+  bool Remove(const std::string& name);
+
+  bool Has(const std::string& name) const;
+
+  /*! \brief Get the stored bytes of an image without copying them */
+  std::optional<Blob> Get(const std::string& name);
+
+  /*! \brief Whether enough space is taken by removed or replaced images to warrant a Compact()
+   */
+  bool NeedsCompaction() const;
+
+  /*! \brief Rewrite the pack with only the live images */
+  bool Compact();
+
+  size_t GetImageCount() const;
+  uint64_t GetFileSize() const;
+  uint64_t GetWastedBytes() const;
+
+private:
+  struct Entry
+  {
+    uint64_t offset; //!< position of the data in the pack
+    uint32_t size;
+  };
+
+  bool CreateEmpty();
+  bool ReadIndex();
+  bool AppendRecord(const std::string& name, const uint8_t* data, uint32_t size);
+  bool Remap();
+
+  std::string m_path;
+  mutable CCriticalSection m_section;
+  FILE* m_file = nullptr;
+  uint64_t m_fileSize = 0;
+  uint64_t m_wastedBytes = 0;
+  std::unordered_map<std::string, Entry> m_index;
+  std::shared_ptr<const CMapping> m_mapping;
+};
+} // namespace IMAGE_FILES
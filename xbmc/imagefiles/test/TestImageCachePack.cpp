@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "imagefiles/ImageCachePack.h"
+#include "test/TestUtils.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace IMAGE_FILES;
+
+namespace
+{
+std::vector<uint8_t> MakeImage(size_t size, uint8_t seed)
+{
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<uint8_t>(seed + i * 7);
+  return data;
+}
+
+bool Matches(const std::optional<CImageCachePack::Blob>& blob, const std::vector<uint8_t>& data)
+{
+  return blob && blob->size == data.size() && memcmp(blob->data, data.data(), data.size()) == 0;
+}
+} // unnamed namespace
+
+class TestImageCachePack : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_tempFile = XBMC_CREATETEMPFILE(".pack");
+    ASSERT_NE(nullptr, m_tempFile);
+    m_tempFile->Close();
+    m_path = XBMC_TEMPFILEPATH(m_tempFile);
+  }
+
+  void TearDown() override { XBMC_DELETETEMPFILE(m_tempFile); }
+
+  XFILE::CFile* m_tempFile = nullptr;
+  std::string m_path;
+};
+
+TEST_F(TestImageCachePack, AddGetRemove)
+{
+  CImageCachePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+
+  const auto image1 = MakeImage(1000, 1);
+  const auto image2 = MakeImage(5000, 2);
+  EXPECT_TRUE(pack.Add("a/a1b2c3d4.jpg", image1.data(), image1.size()));
+  EXPECT_TRUE(pack.Add("b/b1b2c3d4.png", image2.data(), image2.size()));
+  EXPECT_EQ(2u, pack.GetImageCount());
+
+  EXPECT_TRUE(Matches(pack.Get("a/a1b2c3d4.jpg"), image1));
+  EXPECT_TRUE(Matches(pack.Get("b/b1b2c3d4.png"), image2));
+  EXPECT_FALSE(pack.Get("c/c1b2c3d4.jpg"));
+
+  EXPECT_TRUE(pack.Remove("a/a1b2c3d4.jpg"));
+  EXPECT_FALSE(pack.Has("a/a1b2c3d4.jpg"));
+  EXPECT_FALSE(pack.Remove("a/a1b2c3d4.jpg"));
+  EXPECT_GT(pack.GetWastedBytes(), image1.size());
+}
+
+TEST_F(TestImageCachePack, BlobOutlivesAppend)
+{
+  CImageCachePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+
+  const auto image1 = MakeImage(1000, 1);
+  ASSERT_TRUE(pack.Add("a/a1b2c3d4.jpg", image1.data(), image1.size()));
+  const auto blob = pack.Get("a/a1b2c3d4.jpg");
+
+  // remaps the pack, the earlier blob keeps the previous mapping alive
+  const auto image2 = MakeImage(100000, 2);
+  ASSERT_TRUE(pack.Add("b/b1b2c3d4.jpg", image2.data(), image2.size()));
+  EXPECT_TRUE(Matches(pack.Get("b/b1b2c3d4.jpg"), image2));
+  EXPECT_TRUE(Matches(blob, image1));
+}
+
+TEST_F(TestImageCachePack, GetBetweenAppends)
+{
+  CImageCachePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+
+  // every get after an append extends the view of the pack by what was appended
+  std::vector<std::vector<uint8_t>> images;
+  for (int i = 0; i < 20; ++i)
+  {
+    images.emplace_back(MakeImage(1000 + i * 100, static_cast<uint8_t>(i)));
+    ASSERT_TRUE(pack.Add(std::to_string(i) + ".jpg", images.back().data(), images.back().size()));
+    for (int j = 0; j <= i; ++j)
+      EXPECT_TRUE(Matches(pack.Get(std::to_string(j) + ".jpg"), images[j]));
+  }
+
+  ASSERT_TRUE(pack.Remove("3.jpg"));
+  EXPECT_TRUE(Matches(pack.Get("19.jpg"), images[19]));
+}
+
+TEST_F(TestImageCachePack, Reopen)
+{
+  const auto image1 = MakeImage(1000, 1);
+  const auto image2 = MakeImage(2000, 2);
+  const auto image3 = MakeImage(3000, 3);
+  {
+    CImageCachePack pack;
+    ASSERT_TRUE(pack.Open(m_path));
+    pack.Add("a/a1b2c3d4.jpg", image1.data(), image1.size());
+    pack.Add("b/b1b2c3d4.jpg", image2.data(), image2.size());
+    pack.Add("a/a1b2c3d4.jpg", image3.data(), image3.size());
+    pack.Remove("b/b1b2c3d4.jpg");
+  }
+
+  CImageCachePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+  EXPECT_EQ(1u, pack.GetImageCount());
+  EXPECT_TRUE(Matches(pack.Get("a/a1b2c3d4.jpg"), image3));
+  EXPECT_FALSE(pack.Has("b/b1b2c3d4.jpg"));
+}
+
+TEST_F(TestImageCachePack, Compact)
+{
+  CImageCachePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+
+  const auto keep = MakeImage(1000, 1);
+  const auto drop = MakeImage(50000, 2);
+  pack.Add("a/a1b2c3d4.jpg", drop.data(), drop.size());
+  pack.Add("b/b1b2c3d4.jpg", keep.data(), keep.size());
+  pack.Remove("a/a1b2c3d4.jpg");
+
+  const uint64_t before = pack.GetFileSize();
+  ASSERT_TRUE(pack.Compact());
+  EXPECT_LT(pack.GetFileSize(), before - drop.size());
+  EXPECT_EQ(0u, pack.GetWastedBytes());
+  EXPECT_TRUE(Matches(pack.Get("b/b1b2c3d4.jpg"), keep));
+
+  pack.Close();
+  ASSERT_TRUE(pack.Open(m_path));
+  EXPECT_EQ(1u, pack.GetImageCount());
+  EXPECT_TRUE(Matches(pack.Get("b/b1b2c3d4.jpg"), keep));
+}
+
+TEST_F(TestImageCachePack, IncompleteRecord)
+{
+  const auto image1 = MakeImage(1000, 1);
+  const auto image2 = MakeImage(2000, 2);
+  uint64_t size;
+  {
+    CImageCachePack pack;
+    ASSERT_TRUE(pack.Open(m_path));
+    pack.Add("a/a1b2c3d4.jpg", image1.data(), image1.size());
+    size = pack.GetFileSize();
+    pack.Add("b/b1b2c3d4.jpg", image2.data(), image2.size());
+  }
+
+  // simulate a crash while appending the second image
+  std::error_code ec;
+  std::filesystem::resize_file(m_path, size + 100, ec);
+  ASSERT_FALSE(ec);
+
+  CImageCachePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+  EXPECT_EQ(size, pack.GetFileSize());
+  EXPECT_TRUE(Matches(pack.Get("a/a1b2c3d4.jpg"), image1));
+  EXPECT_FALSE(pack.Has("b/b1b2c3d4.jpg"));
+
+  // appending works again after the truncated tail
+  EXPECT_TRUE(pack.Add("b/b1b2c3d4.jpg", image2.data(), image2.size()));
+  EXPECT_TRUE(Matches(pack.Get("b/b1b2c3d4.jpg"), image2));
+}
@@ -10,6 +10,7 @@
 
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
+#include "utils/FrameTracer.h"
 #include "utils/StringUtils.h"
 
 /*! \brief Execute a system executable.
@@ -141,6 +142,39 @@ static int Shutdown(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Start recording a frame timeline trace.
+ *  \param params (ignored)
+ */
+static int StartTrace(const std::vector<std::string>& params)
+{
+  CFrameTracer::Start();
+
+  return 0;
+}
+
+/*! \brief Stop recording the frame timeline trace.
+ *  \param params (ignored)
+ */
+static int StopTrace(const std::vector<std::string>& params)
+{
+  CFrameTracer::Stop();
+
+  return 0;
+}
+
+/*! \brief Export the recorded frame timeline as a Chrome trace.
+ *  \param params The parameters.
+ *  \details params[0] = The file to write to (optional).
+ */
+static int ExportTrace(const std::vector<std::string>& params)
+{
+  const std::string path = params.empty() ? "special://temp/kodi-trace.json" : params[0];
+  if (!CFrameTracer::Export(path))
+    return -1;
+
+  return 0;
+}
+
 /*! \brief Suspend system.
  *  \param params (ignored)
  */
@@ -237,6 +271,22 @@ static int Suspend(const std::vector<std::string>& params)
 ///     @param[in] exec                  The path to the executable
 ///   }
 ///   \table_row2_l{
+///     <b>`System.StartTrace`</b>
+///     ,
+///     Start recording a timeline of the application, player and audio engine threads
+///   }
+///   \table_row2_l{
+///     <b>`System.StopTrace`</b>
+///     ,
+///     Stop recording the timeline
+///   }
+///   \table_row2_l{
+///     <b>`System.ExportTrace(path)`</b>
+///     ,
+///     Write the recorded timeline as Chrome trace JSON\, to be opened in chrome://tracing or Perfetto
+///     @param[in] path                  File to write to (optional\, defaults to special://temp/kodi-trace.json)
+///   }
+///   \table_row2_l{
 ///     <b>`System.ExecWait(exec)`</b>
 ///     ,
 ///     Execute shell commands and freezes Kodi until shell is closed
@@ -263,5 +313,8 @@ CBuiltins::CommandMap CSystemBuiltins::GetOperations() const
           {"suspend", {"Suspends the system", 0, Suspend}},
           {"system.exec", {"Execute shell commands", 1, Exec<0>}},
           {"system.execwait",
-           {"Execute shell commands and freezes Kodi until shell is closed", 1, Exec<1>}}};
+           {"Execute shell commands and freezes Kodi until shell is closed", 1, Exec<1>}},
+          {"system.starttrace", {"Start recording a frame timeline trace", 0, StartTrace}},
+          {"system.stoptrace", {"Stop recording the frame timeline trace", 0, StopTrace}},
+          {"system.exporttrace", {"Export the frame timeline as a Chrome trace", 0, ExportTrace}}};
 }
@@ -33,6 +33,7 @@
 #include "filesystem/Directory.h"
 #include "filesystem/DirectoryCache.h"
 #include "filesystem/File.h"
+#include "filesystem/FileExistsChecker.h"
 #include "filesystem/MusicDatabaseDirectory/DirectoryNode.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
@@ -4226,7 +4227,9 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string& strSongIds)
       m_pDS->close();
       return true;
     }
-    std::vector<std::string> songsToDelete;
+    // check the files at once, one listing per folder
+    CFileExistsChecker checker;
+    std::vector<std::pair<std::string, std::string>> songFiles;
     while (!m_pDS->eof())
     { // get the full song path
       std::string strFileName = URIUtils::AddFileToFolder(
@@ -4243,14 +4246,23 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string& strSongIds)
         URIUtils::RemoveSlashAtEnd(strFileName);
       }
 
-      if (!CFile::Exists(strFileName, false))
-      { // file no longer exists, so add to deletion list
-        songsToDelete.push_back(m_pDS->fv("song.idSong").get_asString());
-      }
+      checker.Add(strFileName);
+      songFiles.emplace_back(m_pDS->fv("song.idSong").get_asString(), strFileName);
       m_pDS->next();
     }
     m_pDS->close();
 
+    checker.Run();
+
+    std::vector<std::string> songsToDelete;
+    for (const auto& [idSong, strFileName] : songFiles)
+    {
+      if (!checker.Exists(strFileName))
+      { // file no longer exists, so add to deletion list
+        songsToDelete.push_back(idSong);
+      }
+    }
+
     if (!songsToDelete.empty())
     {
       std::string strSongsToDelete = "(" + StringUtils::Join(songsToDelete, ",") + ")";
@@ -14,6 +14,7 @@
 #include "GUIUserMessages.h"
 #include "MusicAlbumInfo.h"
 #include "MusicInfoScraper.h"
+#include "MusicTagReadPipeline.h"
 #include "NfoFile.h"
 #include "ServiceBroker.h"
 #include "TextureCache.h"
@@ -44,7 +45,6 @@
 #include "music/MusicThumbLoader.h"
 #include "music/MusicUtils.h"
 #include "music/tags/MusicInfoTag.h"
-#include "music/tags/MusicInfoTagLoaderFactory.h"
 #include "playlists/PlayListFileItemClassify.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -571,8 +571,12 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 CInfoScanner::InfoRet CMusicInfoScanner::ScanTags(const CFileItemList& items,
                                                   CFileItemList& scannedItems)
 {
-  std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const std::vector<std::string>& regexps = advancedSettings->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> tagItems;
+  tagItems.reserve(items.Size());
   for (int i = 0; i < items.Size(); ++i)
   {
     if (m_bStop)
@@ -587,23 +591,27 @@ CInfoScanner::InfoRet CMusicInfoScanner::ScanTags(const CFileItemList& items,
         MUSIC::IsLyrics(*pItem))
       continue;
 
-    m_currentItem++;
+    tagItems.emplace_back(std::move(pItem));
+  }
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
-    }
+  // Tags are read concurrently, results are processed here in the original item order
+  const CMusicTagReadPipeline pipeline(
+      static_cast<unsigned int>(advancedSettings->m_iMusicLibraryTagReadThreads));
+  const bool completed = pipeline.Run(tagItems, [this, &scannedItems](const CFileItemPtr& pItem) {
+    if (m_bStop)
+      return false;
+
+    m_currentItem++;
 
-    if (m_handle && m_itemCount>0)
-      m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+    if (m_handle && m_itemCount > 0)
+      m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) /
+                              static_cast<float>(m_itemCount));
 
+    const CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
     if (!tag.Loaded() && !pItem->HasCueDocument())
     {
       CLog::Log(LOGDEBUG, "{} - No tag found for: {}", __FUNCTION__, pItem->GetPath());
-      continue;
+      return true;
     }
     else
     {
@@ -615,7 +623,13 @@ CInfoScanner::InfoRet CMusicInfoScanner::ScanTags(const CFileItemList& items,
       pItem->LoadTracksFromCueDocument(scannedItems);
     else
       scannedItems.Add(pItem);
-  }
+
+    return true;
+  });
+
+  if (!completed || m_bStop)
+    return InfoRet::CANCELLED;
+
   return InfoRet::ADDED;
 }
 
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MusicTagReadPipeline.h"
+
+#include "FileItem.h"
+#include "URL.h"
+#include "music/tags/ImusicInfoTagLoader.h"
+#include "music/tags/MusicInfoTag.h"
+#include "music/tags/MusicInfoTagLoaderFactory.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using namespace MUSIC_INFO;
+
+namespace
+{
+// How many items the workers may run ahead of the consumer, per worker
+constexpr size_t READ_AHEAD_PER_WORKER = 4;
+} // unnamed namespace
+
+CMusicTagReadPipeline::CMusicTagReadPipeline(unsigned int maxParallelReads, LoadFunc loader)
+  : m_maxParallelReads(maxParallelReads), m_loader(std::move(loader))
+{
+}
+
+void CMusicTagReadPipeline::LoadMusicTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (tag.Loaded())
+    return;
+
+  std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+  if (pLoader)
+    pLoader->Load(item.GetPath(), tag);
+}
+
+void CMusicTagReadPipeline::LoadItem(CFileItem& item) const
+{
+  // the workers are plain threads, an exception escaping the loader must not terminate the scan
+  try
+  {
+    m_loader(item);
+  }
+  catch (const std::exception& e)
+  {
+    CLog::Log(LOGERROR, "{} - failed to read tag of {}: {}", __FUNCTION__,
+              CURL::GetRedacted(item.GetPath()), e.what());
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} - failed to read tag of {}", __FUNCTION__,
+              CURL::GetRedacted(item.GetPath()));
+  }
+}
+
+bool CMusicTagReadPipeline::RunSerial(const std::vector<CFileItemPtr>& items,
+                                      const ResultFunc& onResult) const
+{
+  for (const auto& item : items)
+  {
+    LoadItem(*item);
+    if (!onResult(item))
+      return false;
+  }
+  return true;
+}
+
+bool CMusicTagReadPipeline::Run(const std::vector<CFileItemPtr>& items,
+                                const ResultFunc& onResult) const
+{
+  const size_t workers = std::min<size_t>(m_maxParallelReads, items.size());
+  if (workers <= 1)
+    return RunSerial(items, onResult);
+
+  const size_t window = workers * READ_AHEAD_PER_WORKER;
+
+  CCriticalSection section;
+  XbmcThreads::ConditionVariable workerCond;
+  XbmcThreads::ConditionVariable resultCond;
+  std::vector<bool> loaded(items.size(), false);
+  size_t next = 0; // next item to be picked up by a worker
+  size_t consumed = 0; // items already handed to onResult
+  bool cancelled = false;
+
+  auto worker = [&]() {
+    while (true)
+    {
+      size_t index;
+      {
+        std::unique_lock<CCriticalSection> lock(section);
+        workerCond.wait(lock, [&]() {
+          return cancelled || next >= items.size() || next < consumed + window;
+        });
+        if (cancelled || next >= items.size())
+          return;
+        index = next++;
+      }
+
+      LoadItem(*items[index]);
+
+      std::unique_lock<CCriticalSection> lock(section);
+      loaded[index] = true;
+      if (index == consumed)
+        resultCond.notifyAll();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers);
+  for (size_t i = 0; i < workers; ++i)
+    threads.emplace_back(worker);
+
+  bool completed = true;
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(section);
+      resultCond.wait(lock, [&]() { return static_cast<bool>(loaded[i]); });
+    }
+
+    const bool proceed = onResult(items[i]);
+
+    std::unique_lock<CCriticalSection> lock(section);
+    consumed = i + 1;
+    if (!proceed)
+    {
+      cancelled = true;
+      completed = false;
+    }
+    workerCond.notifyAll();
+    if (!proceed)
+      break;
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  return completed;
+}
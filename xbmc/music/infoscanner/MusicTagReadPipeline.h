@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CFileItem;
+using CFileItemPtr = std::shared_ptr<CFileItem>;
+
+namespace MUSIC_INFO
+{
+/*! \brief Bounded parallel tag reader used by the music library scanner.
+
+ Tags are loaded by a small pool of worker threads, while results are handed back to the caller on
+ the calling thread in the same order as the input items. This keeps the per-file latency of
+ remote sources (SMB, NFS, ...) overlapped without changing the order in which scanned items are
+ grouped into albums.
+ */
+class CMusicTagReadPipeline
+{
+public:
+  /*! \brief Loads the tag of a single item, called concurrently from the worker threads */
+  using LoadFunc = std::function<void(CFileItem& item)>;
+
+  /*! \brief Called on the caller thread, in input order, once an item has been loaded.
+   \return false to cancel reading of the remaining items
+   */
+  using ResultFunc = std::function<bool(const CFileItemPtr& item)>;
+
+  /*!
+   \param maxParallelReads number of tags read concurrently. 0 or 1 reads serially on the
+   calling thread.
+   \param loader function used to read an item's tag, defaults to LoadMusicTag()
+   */
+  explicit CMusicTagReadPipeline(unsigned int maxParallelReads, LoadFunc loader = LoadMusicTag);
+
+  /*! \brief Read the tags of all the given items
+   \param items the items to read, in the order results should be delivered
+   \param onResult called for every item once its tag has been read
+   \return true if all items were processed, false if cancelled by onResult
+   */
+  bool Run(const std::vector<CFileItemPtr>& items, const ResultFunc& onResult) const;
+
+  /*! \brief Default loader, reads the tag through CMusicInfoTagLoaderFactory unless already loaded
+   */
+  static void LoadMusicTag(CFileItem& item);
+
+private:
+  void LoadItem(CFileItem& item) const;
+  bool RunSerial(const std::vector<CFileItemPtr>& items, const ResultFunc& onResult) const;
+
+  unsigned int m_maxParallelReads;
+  LoadFunc m_loader;
+};
+} // namespace MUSIC_INFO
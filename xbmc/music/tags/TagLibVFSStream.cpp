@@ -8,7 +8,10 @@
 #include "TagLibVFSStream.h"
 
 #include "filesystem/File.h"
+#include "filesystem/IFile.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits.h>
 
 #include <taglib/taglib.h>
@@ -18,6 +21,30 @@ using namespace XFILE;
 using namespace TagLib;
 using namespace MUSIC_INFO;
 
+namespace
+{
+// Granularity of reads from the underlying file
+constexpr int64_t CACHE_BLOCK_SIZE = 64 * 1024;
+// Reads near the start or end of the file fetch the whole head / tail window,
+// which is where ID3v2, FLAC, Ogg, MP4 (moov at start), ID3v1 and APE tags live
+constexpr int64_t HEAD_PREFETCH_SIZE = 256 * 1024;
+constexpr int64_t TAIL_PREFETCH_SIZE = 128 * 1024;
+// Upper bound of cached data per stream
+constexpr size_t MAX_CACHED_BYTES = 4 * 1024 * 1024;
+// Larger reads (e.g. big embedded pictures) bypass the cache
+constexpr size_t DIRECT_READ_SIZE = 1024 * 1024;
+
+int64_t AlignDown(int64_t value)
+{
+  return value - value % CACHE_BLOCK_SIZE;
+}
+
+int64_t AlignUp(int64_t value)
+{
+  return AlignDown(value + CACHE_BLOCK_SIZE - 1);
+}
+} // unnamed namespace
+
 /*!
  * Construct a File object and opens the \a file.  \a file should be a
  * be an XBMC Vfile.
@@ -27,7 +54,8 @@ TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
   m_bIsOpen = true;
   if (readOnly)
   {
-    if (!m_file.Open(strFileName))
+    // Short reads are fine, ReadSource() loops until the requested range is filled
+    if (!m_file.Open(strFileName, READ_TRUNCATED))
       m_bIsOpen = false;
   }
   else
@@ -37,6 +65,17 @@ TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
   }
   m_strFileName = strFileName;
   m_bIsReadOnly = readOnly || !m_bIsOpen;
+  if (m_bIsReadOnly && m_bIsOpen)
+    m_length = SourceLength();
+}
+
+TagLibVFSStream::TagLibVFSStream(const std::string& strFileName,
+                                 std::unique_ptr<XFILE::IFile> file)
+  : m_strFileName(strFileName), m_source(std::move(file)), m_bIsReadOnly(true)
+{
+  m_bIsOpen = m_source != nullptr;
+  if (m_bIsOpen)
+    m_length = SourceLength();
 }
 
 /*!
@@ -44,9 +83,125 @@ TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
  */
 TagLibVFSStream::~TagLibVFSStream()
 {
+  if (m_source)
+    m_source->Close();
   m_file.Close();
 }
 
+int64_t TagLibVFSStream::SourceLength()
+{
+  return m_source ? m_source->GetLength() : m_file.GetLength();
+}
+
+ssize_t TagLibVFSStream::ReadSource(uint8_t* buffer, int64_t position, size_t length)
+{
+  const int64_t pos = m_source ? m_source->Seek(position, SEEK_SET) : m_file.Seek(position, SEEK_SET);
+  if (pos != position)
+    return -1;
+
+  size_t done = 0;
+  while (done < length)
+  {
+    const ssize_t read = m_source ? m_source->Read(buffer + done, length - done)
+                                  : m_file.Read(buffer + done, length - done);
+    if (read < 0)
+      return done > 0 ? static_cast<ssize_t>(done) : read;
+    if (read == 0)
+      break;
+    done += static_cast<size_t>(read);
+  }
+  return static_cast<ssize_t>(done);
+}
+
+const TagLibVFSStream::CachedRange* TagLibVFSStream::FetchRange(int64_t position, size_t length)
+{
+  int64_t start = AlignDown(position);
+  int64_t end = AlignUp(position + static_cast<int64_t>(length));
+
+  if (position < HEAD_PREFETCH_SIZE)
+  {
+    start = 0;
+    end = std::max(end, HEAD_PREFETCH_SIZE);
+  }
+  else if (m_length > 0 && position >= m_length - TAIL_PREFETCH_SIZE)
+  {
+    start = std::min(start, AlignDown(std::max<int64_t>(0, m_length - TAIL_PREFETCH_SIZE)));
+    end = std::max(end, m_length);
+  }
+
+  // Don't read again what is already cached after the requested position
+  for (const auto& range : m_cache)
+  {
+    if (range.start > position)
+      end = std::min(end, range.start);
+    else if (range.start + static_cast<int64_t>(range.data.size()) <= position)
+      start = std::max(start, range.start + static_cast<int64_t>(range.data.size()));
+  }
+
+  // a length of 0 means unknown, e.g. for streams, read until EOF then
+  if (m_length > 0)
+    end = std::min(end, m_length);
+  if (end <= start)
+    return nullptr;
+
+  CachedRange range;
+  range.start = start;
+  range.data.resize(static_cast<size_t>(end - start));
+  const ssize_t read = ReadSource(range.data.data(), start, range.data.size());
+  if (read <= 0 || start + read <= position)
+    return nullptr;
+  range.data.resize(static_cast<size_t>(read));
+
+  m_cachedBytes += range.data.size();
+  m_cache.emplace_front(std::move(range));
+  while (m_cachedBytes > MAX_CACHED_BYTES && m_cache.size() > 1)
+  {
+    m_cachedBytes -= m_cache.back().data.size();
+    m_cache.pop_back();
+  }
+
+  return &m_cache.front();
+}
+
+size_t TagLibVFSStream::ReadCached(uint8_t* buffer, size_t length)
+{
+  if (m_length > 0 && m_position >= m_length)
+    return 0;
+
+  const CachedRange* range = nullptr;
+  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+  {
+    if (m_position >= it->start && m_position < it->start + static_cast<int64_t>(it->data.size()))
+    {
+      m_cache.splice(m_cache.begin(), m_cache, it);
+      range = &m_cache.front();
+      break;
+    }
+  }
+
+  if (!range)
+  {
+    if (length >= DIRECT_READ_SIZE)
+    {
+      const ssize_t read = ReadSource(buffer, m_position, length);
+      if (read <= 0)
+        return 0;
+      m_position += read;
+      return static_cast<size_t>(read);
+    }
+
+    range = FetchRange(m_position, length);
+    if (!range)
+      return 0;
+  }
+
+  const size_t offset = static_cast<size_t>(m_position - range->start);
+  const size_t copy = std::min(length, range->data.size() - offset);
+  std::memcpy(buffer, range->data.data() + offset, copy);
+  m_position += copy;
+  return copy;
+}
+
 /*!
  * Returns the file name in the local file system encoding.
  */
@@ -69,6 +224,21 @@ ByteVector TagLibVFSStream::readBlock(TagLib::ulong length)
 #else
   ByteVector byteVector(static_cast<TagLib::uint>(length));
 #endif
+  if (m_bIsReadOnly)
+  {
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(byteVector.data());
+    size_t done = 0;
+    while (done < length)
+    {
+      const size_t read = ReadCached(buffer + done, length - done);
+      if (read == 0)
+        break;
+      done += read;
+    }
+    byteVector.resize(static_cast<unsigned int>(done));
+    return byteVector;
+  }
+
   ssize_t read = m_file.Read(byteVector.data(), length);
   if (read > 0)
     byteVector.resize(read);
@@ -284,36 +454,35 @@ bool TagLibVFSStream::isOpen() const
  */
 void TagLibVFSStream::seek(long offset, Position p)
 {
-  const long fileLen = length();
-  if (m_bIsReadOnly && fileLen > 0)
+  if (m_bIsReadOnly)
   {
-    long startPos;
+    // Only the logical position moves, the file is read on the next cache miss
+    int64_t target;
     if (p == Beginning)
-      startPos = 0;
+      target = offset;
     else if (p == Current)
-      startPos = tell();
+      target = m_position + offset;
+    else if (p == End && m_length > 0)
+      target = m_length + offset;
     else if (p == End)
-      startPos = fileLen;
+    {
+      // unknown length, only the file knows where it ends
+      target = m_source ? m_source->Seek(offset, SEEK_END) : m_file.Seek(offset, SEEK_END);
+      if (target < 0)
+        return;
+    }
     else
       return; // wrong Position value
 
     // When parsing some broken files, taglib may try to seek above end of file.
-    // If underlying VFS does not move I/O pointer in this case, taglib will parse
-    // same part of file several times and ends with error. To prevent this
-    // situation, force seek to last valid position so VFS move I/O pointer.
-    if (startPos >= 0)
-    {
-      if (offset < 0 && startPos + offset < 0)
-      {
-        m_file.Seek(0, SEEK_SET);
-        return;
-      }
-      if (offset > 0 && startPos + offset > fileLen)
-      {
-        m_file.Seek(fileLen, SEEK_SET);
-        return;
-      }
-    }
+    // Clamp to the valid range so taglib doesn't parse the same part of the
+    // file several times.
+    if (target < 0)
+      target = 0;
+    if (m_length > 0 && target > m_length)
+      target = m_length;
+    m_position = target;
+    return;
   }
 
   switch(p)
@@ -342,7 +511,7 @@ void TagLibVFSStream::clear()
  */
 long TagLibVFSStream::tell() const
 {
-  int64_t pos = m_file.GetPosition();
+  int64_t pos = m_bIsReadOnly ? m_position : m_file.GetPosition();
   if(pos > LONG_MAX)
     return -1;
   else
@@ -354,6 +523,8 @@ long TagLibVFSStream::tell() const
  */
 long TagLibVFSStream::length()
 {
+  if (m_bIsReadOnly)
+    return m_bIsOpen ? static_cast<long>(m_length) : 0;
   return (long)m_file.GetLength();
 }
 
@@ -10,11 +10,24 @@
 
 #include "filesystem/File.h"
 
+#include <list>
+#include <memory>
+#include <vector>
+
 #include <taglib/taglib.h>
 #include <taglib/tiostream.h>
 
 namespace MUSIC_INFO
 {
+  /*!
+   * TagLib IOStream on top of the Kodi VFS.
+   *
+   * TagLib parses tags with many small reads and seeks (ID3v2 frames, FLAC
+   * metadata blocks, MP4 atoms). When opened read only, reads are served from
+   * an aligned block cache that is filled with a large prefetch of the head or
+   * tail of the file, where tags live, so that scanning a file over SMB/NFS
+   * costs one or two reads of the underlying file instead of dozens.
+   */
   class TagLibVFSStream : public TagLib::IOStream
   {
   public:
@@ -24,6 +37,11 @@ namespace MUSIC_INFO
      */
     TagLibVFSStream(const std::string& strFileName, bool readOnly);
 
+    /*!
+     * Construct a read only stream on top of an already opened \a file.
+     */
+    TagLibVFSStream(const std::string& strFileName, std::unique_ptr<XFILE::IFile> file);
+
     /*!
      * Destroys this ByteVectorStream instance.
      */
@@ -132,10 +150,42 @@ namespace MUSIC_INFO
 #endif
 
   private:
+    struct CachedRange
+    {
+      int64_t start;
+      std::vector<uint8_t> data;
+    };
+
+    /*!
+     * Copy up to \a length bytes at the current position from the block cache,
+     * fetching from the file on a miss. Returns the number of bytes copied.
+     */
+    size_t ReadCached(uint8_t* buffer, size_t length);
+
+    /*!
+     * Read the aligned range covering \a length bytes at \a position into the
+     * cache, extended to the head or tail prefetch window when applicable.
+     */
+    const CachedRange* FetchRange(int64_t position, size_t length);
+
+    /*!
+     * Read exactly \a length bytes at \a position from the underlying file,
+     * short only at end of file.
+     */
+    ssize_t ReadSource(uint8_t* buffer, int64_t position, size_t length);
+
+    int64_t SourceLength();
+
     std::string   m_strFileName;
     XFILE::CFile  m_file;
+    std::unique_ptr<XFILE::IFile> m_source;
     bool          m_bIsReadOnly;
     bool          m_bIsOpen;
+
+    int64_t m_position = 0; //!< logical read position when read only
+    int64_t m_length = -1; //!< file length, queried once when read only
+    std::list<CachedRange> m_cache; //!< most recently used first
+    size_t m_cachedBytes = 0;
   };
 }
 
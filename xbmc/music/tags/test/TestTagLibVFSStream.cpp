@@ -0,0 +1,158 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "URL.h"
+#include "filesystem/IFile.h"
+#include "music/tags/TagLibVFSStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace MUSIC_INFO;
+
+namespace
+{
+// In-memory file counting the reads that reach it
+class CCountingFile : public XFILE::IFile
+{
+public:
+  CCountingFile(const std::vector<uint8_t>& data, int& reads, bool knownLength = true)
+    : m_data(data), m_reads(reads), m_knownLength(knownLength)
+  {
+  }
+
+  bool Open(const CURL& url) override { return true; }
+  bool Exists(const CURL& url) override { return true; }
+  int Stat(const CURL& url, struct __stat64* buffer) override { return -1; }
+  ssize_t Read(void* bufPtr, size_t bufSize) override
+  {
+    m_reads++;
+    const size_t size = std::min(bufSize, m_data.size() - static_cast<size_t>(m_position));
+    std::memcpy(bufPtr, m_data.data() + m_position, size);
+    m_position += size;
+    return static_cast<ssize_t>(size);
+  }
+  int64_t Seek(int64_t iFilePosition, int iWhence = SEEK_SET) override
+  {
+    if (iWhence == SEEK_CUR)
+      iFilePosition += m_position;
+    else if (iWhence == SEEK_END)
+      iFilePosition += static_cast<int64_t>(m_data.size());
+    if (iFilePosition < 0 || iFilePosition > static_cast<int64_t>(m_data.size()))
+      return -1;
+    m_position = iFilePosition;
+    return m_position;
+  }
+  void Close() override {}
+  int64_t GetPosition() override { return m_position; }
+  int64_t GetLength() override { return m_knownLength ? static_cast<int64_t>(m_data.size()) : 0; }
+
+private:
+  const std::vector<uint8_t>& m_data;
+  int& m_reads;
+  const bool m_knownLength;
+  int64_t m_position = 0;
+};
+
+class TestTagLibVFSStream : public ::testing::Test
+{
+protected:
+  TestTagLibVFSStream() : m_data(8 * 1024 * 1024)
+  {
+    for (size_t i = 0; i < m_data.size(); ++i)
+      m_data[i] = static_cast<uint8_t>(i * 31 + (i >> 8));
+  }
+
+  std::unique_ptr<TagLibVFSStream> CreateStream(bool knownLength = true)
+  {
+    return std::make_unique<TagLibVFSStream>(
+        "memory://file.mp3", std::make_unique<CCountingFile>(m_data, m_reads, knownLength));
+  }
+
+  void ExpectBlock(TagLibVFSStream& stream, long offset, unsigned long length)
+  {
+    stream.seek(offset);
+    const TagLib::ByteVector block = stream.readBlock(length);
+    ASSERT_EQ(length, block.size());
+    EXPECT_EQ(0, std::memcmp(m_data.data() + offset, block.data(), length));
+    EXPECT_EQ(offset + static_cast<long>(length), stream.tell());
+  }
+
+  std::vector<uint8_t> m_data;
+  int m_reads = 0;
+};
+} // unnamed namespace
+
+TEST_F(TestTagLibVFSStream, TagReadPattern)
+{
+  auto stream = CreateStream();
+  ASSERT_TRUE(stream->isOpen());
+  EXPECT_EQ(static_cast<long>(m_data.size()), stream->length());
+
+  // ID3v2 header and frames
+  ExpectBlock(*stream, 0, 10);
+  for (long offset = 10; offset < 4096; offset += 110)
+    ExpectBlock(*stream, offset, 100);
+  // First MPEG frame after the tag
+  ExpectBlock(*stream, 8192, 4);
+  EXPECT_EQ(1, m_reads);
+
+  // APE footer and ID3v1 tag
+  stream->seek(-160, TagLib::IOStream::End);
+  EXPECT_EQ(static_cast<long>(m_data.size()) - 160, stream->tell());
+  ExpectBlock(*stream, static_cast<long>(m_data.size()) - 160, 32);
+  ExpectBlock(*stream, static_cast<long>(m_data.size()) - 128, 128);
+  EXPECT_EQ(2, m_reads);
+
+  // Rereading the head doesn't hit the file again
+  ExpectBlock(*stream, 0, 1024);
+  EXPECT_EQ(2, m_reads);
+}
+
+TEST_F(TestTagLibVFSStream, ReadAcrossBlocks)
+{
+  auto stream = CreateStream();
+
+  ExpectBlock(*stream, 250 * 1024, 20 * 1024);
+  ExpectBlock(*stream, 1024 * 1024 + 17, 200 * 1024);
+  ExpectBlock(*stream, 3 * 1024 * 1024 - 5, 10);
+  // Large reads (e.g. embedded pictures) go straight to the file
+  ExpectBlock(*stream, 4 * 1024 * 1024 + 3, 2 * 1024 * 1024);
+}
+
+TEST_F(TestTagLibVFSStream, SeekClamp)
+{
+  auto stream = CreateStream();
+
+  stream->seek(-10);
+  EXPECT_EQ(0, stream->tell());
+  stream->seek(10, TagLib::IOStream::End);
+  EXPECT_EQ(static_cast<long>(m_data.size()), stream->tell());
+  EXPECT_TRUE(stream->readBlock(16).isEmpty());
+  stream->seek(-4, TagLib::IOStream::Current);
+  EXPECT_EQ(4u, stream->readBlock(16).size());
+}
+
+TEST_F(TestTagLibVFSStream, UnknownLength)
+{
+  // streams may not know their length, they are read until EOF
+  auto stream = CreateStream(false);
+  ASSERT_TRUE(stream->isOpen());
+  EXPECT_EQ(0, stream->length());
+
+  ExpectBlock(*stream, 0, 10);
+  ExpectBlock(*stream, 5 * 1024 * 1024 + 3, 100);
+
+  stream->seek(-128, TagLib::IOStream::End);
+  EXPECT_EQ(static_cast<long>(m_data.size()) - 128, stream->tell());
+  ExpectBlock(*stream, static_cast<long>(m_data.size()) - 128, 128);
+  EXPECT_TRUE(stream->readBlock(16).isEmpty());
+}
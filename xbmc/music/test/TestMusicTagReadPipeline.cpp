@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "filesystem/File.h"
+#include "music/infoscanner/MusicTagReadPipeline.h"
+#include "music/tags/MusicInfoTag.h"
+#include "test/TestUtils.h"
+#include "utils/Stopwatch.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace MUSIC_INFO;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int FIXTURE_FILES = 64;
+// Simulated per-file round-trip latency of a network share
+constexpr auto READ_LATENCY = 5ms;
+
+class TestMusicTagReadPipeline : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Local fixture directory: one small temp file per "track"
+    for (int i = 0; i < FIXTURE_FILES; ++i)
+    {
+      XFILE::CFile* file = XBMC_CREATETEMPFILE(".mp3");
+      ASSERT_NE(nullptr, file);
+      const std::string title = "track " + std::to_string(i);
+      file->Close();
+      ASSERT_TRUE(file->OpenForWrite(XBMC_TEMPFILEPATH(file), true));
+      file->Write(title.c_str(), title.size());
+      file->Close();
+      m_files.push_back(file);
+      m_items.push_back(std::make_shared<CFileItem>(XBMC_TEMPFILEPATH(file), false));
+    }
+  }
+
+  void TearDown() override
+  {
+    for (XFILE::CFile* file : m_files)
+      XBMC_DELETETEMPFILE(file);
+  }
+
+  // Reads the whole fixture file as the title, after waiting for the simulated latency
+  static void LoadFixture(CFileItem& item)
+  {
+    std::this_thread::sleep_for(READ_LATENCY);
+    XFILE::CFile file;
+    if (!file.Open(item.GetPath()))
+      return;
+    char buf[64] = {};
+    const ssize_t read = file.Read(buf, sizeof(buf) - 1);
+    if (read <= 0)
+      return;
+    CMusicInfoTag& tag = *item.GetMusicInfoTag();
+    tag.SetTitle(std::string(buf, read));
+    tag.SetLoaded(true);
+  }
+
+  std::vector<XFILE::CFile*> m_files;
+  std::vector<CFileItemPtr> m_items;
+};
+} // unnamed namespace
+
+TEST_F(TestMusicTagReadPipeline, KeepsInputOrder)
+{
+  const CMusicTagReadPipeline pipeline(8, LoadFixture);
+
+  int index = 0;
+  EXPECT_TRUE(pipeline.Run(m_items, [&index, this](const CFileItemPtr& item) {
+    EXPECT_EQ(m_items[index], item);
+    EXPECT_TRUE(item->GetMusicInfoTag()->Loaded());
+    EXPECT_EQ("track " + std::to_string(index), item->GetMusicInfoTag()->GetTitle());
+    ++index;
+    return true;
+  }));
+  EXPECT_EQ(FIXTURE_FILES, index);
+}
+
+TEST_F(TestMusicTagReadPipeline, Cancel)
+{
+  std::atomic<int> loads{0};
+  const CMusicTagReadPipeline pipeline(4, [&loads](CFileItem& item) {
+    ++loads;
+    LoadFixture(item);
+  });
+
+  int results = 0;
+  EXPECT_FALSE(pipeline.Run(m_items, [&results](const CFileItemPtr&) { return ++results < 10; }));
+  EXPECT_EQ(10, results);
+  // Workers stop shortly after cancellation, bounded by the read-ahead window
+  EXPECT_LT(loads, FIXTURE_FILES);
+}
+
+TEST_F(TestMusicTagReadPipeline, LoaderThrows)
+{
+  std::set<const CFileItem*> corrupt;
+  for (size_t i = 1; i < m_items.size(); i += 2)
+    corrupt.insert(m_items[i].get());
+
+  const CMusicTagReadPipeline pipeline(8, [&corrupt](CFileItem& item) {
+    if (corrupt.find(&item) != corrupt.end())
+      throw std::runtime_error("corrupt tag");
+    LoadFixture(item);
+  });
+
+  // a failing item is handed back unloaded, the others are still read
+  int index = 0;
+  EXPECT_TRUE(pipeline.Run(m_items, [&index](const CFileItemPtr& item) {
+    EXPECT_EQ(index % 2 == 0, item->GetMusicInfoTag()->Loaded());
+    ++index;
+    return true;
+  }));
+  EXPECT_EQ(FIXTURE_FILES, index);
+}
+
+// Serial vs. parallel tag read throughput over a simulated network share, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestMusicTagReadPipeline.DISABLED_Benchmark
+TEST_F(TestMusicTagReadPipeline, DISABLED_Benchmark)
+{
+  auto measure = [this](unsigned int threads) {
+    for (const auto& item : m_items)
+      item->GetMusicInfoTag()->Clear();
+
+    const CMusicTagReadPipeline pipeline(threads, LoadFixture);
+    CStopWatch watch;
+    watch.StartZero();
+    pipeline.Run(m_items, [](const CFileItemPtr&) { return true; });
+    return watch.GetElapsedSeconds();
+  };
+
+  const float serial = measure(1);
+  const float parallel = measure(8);
+
+  std::cout << "Tag read throughput, " << FIXTURE_FILES << " files: serial "
+            << FIXTURE_FILES / serial << " files/s, 8 threads " << FIXTURE_FILES / parallel
+            << " files/s" << std::endl;
+}
@@ -787,7 +787,9 @@ PLT_MediaObject* BuildObject(CFileItem& item,
           imageProfile = GetImageDLNAProfile(cachedImagePath);
           if (imageProfile.has_value())
           {
-            thumb = cachedImagePath;
+            // packed images are no files of their own, they are served through the original url
+            if (!CServiceBroker::GetTextureCache()->GetPackedImage(cachedImagePath))
+              thumb = cachedImagePath;
             art.dlna_profile = imageProfile.value().c_str();
           }
         }
@@ -22,6 +22,12 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 extern "C" {
 #include <libswscale/swscale.h>
@@ -29,6 +35,188 @@ extern "C" {
 
 using namespace XFILE;
 
+namespace
+{
+/*!
+ \brief Scaler contexts recently used by the current thread
+
+ Setting up a scaler context (filter coefficients) costs more than scaling a thumbnail sized image,
+ and a thread caching thumbnails mostly scales between a few size pairs (e.g. all photos from
+ one camera), so contexts are kept for reuse.
+ */
+class CScalerCache
+{
+public:
+  struct Key
+  {
+    int srcWidth;
+    int srcHeight;
+    AVPixelFormat srcFormat;
+    int dstWidth;
+    int dstHeight;
+    AVPixelFormat dstFormat;
+    int flags;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  CScalerCache() = default;
+  CScalerCache(const CScalerCache&) = delete;
+  CScalerCache& operator=(const CScalerCache&) = delete;
+  ~CScalerCache()
+  {
+    for (const auto& entry : m_entries)
+      sws_freeContext(entry.second);
+  }
+
+  SwsContext* Get(const Key& key)
+  {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&key](const auto& entry) { return entry.first == key; });
+    if (it != m_entries.end())
+    { // move to the front, the back is evicted first
+      std::rotate(m_entries.begin(), it, it + 1);
+      return m_entries.front().second;
+    }
+
+    SwsContext* context =
+        sws_getContext(key.srcWidth, key.srcHeight, key.srcFormat, key.dstWidth, key.dstHeight,
+                       key.dstFormat, key.flags, nullptr, nullptr, nullptr);
+    if (!context)
+      return nullptr;
+
+    if (m_entries.size() == MAX_CONTEXTS)
+    {
+      sws_freeContext(m_entries.back().second);
+      m_entries.pop_back();
+    }
+    m_entries.emplace(m_entries.begin(), key, context);
+    return context;
+  }
+
+private:
+  static constexpr size_t MAX_CONTEXTS = 4;
+  std::vector<std::pair<Key, SwsContext*>> m_entries;
+};
+
+thread_local CScalerCache scalerCache;
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+inline __m128i Reverse4(__m128i pixels)
+{
+  return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+// load 4 pixels, going backwards in memory if step is negative
+inline __m128i Load4(const uint32_t* pixels, ptrdiff_t step)
+{
+  if (step > 0)
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+  return Reverse4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels - 3)));
+}
+
+inline void Transpose4x4(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3)
+{
+  const __m128i t0 = _mm_unpacklo_epi32(r0, r1); // a0 b0 a1 b1
+  const __m128i t1 = _mm_unpacklo_epi32(r2, r3); // c0 d0 c1 d1
+  const __m128i t2 = _mm_unpackhi_epi32(r0, r1); // a2 b2 a3 b3
+  const __m128i t3 = _mm_unpackhi_epi32(r2, r3); // c2 d2 c3 d3
+  r0 = _mm_unpacklo_epi64(t0, t1); // a0 b0 c0 d0
+  r1 = _mm_unpackhi_epi64(t0, t1); // a1 b1 c1 d1
+  r2 = _mm_unpacklo_epi64(t2, t3); // a2 b2 c2 d2
+  r3 = _mm_unpackhi_epi64(t2, t3); // a3 b3 c3 d3
+}
+#endif
+
+void ReverseRow(uint32_t* line, unsigned int width)
+{
+  unsigned int x = 0;
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  for (; 2 * x + 8 <= width; x += 4)
+  {
+    uint32_t* left = line + x;
+    uint32_t* right = line + width - 4 - x;
+    const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+    const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(left), Reverse4(r));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(right), Reverse4(l));
+  }
+#endif
+  for (; x < width / 2; ++x)
+    std::swap(line[x], line[width - 1 - x]);
+}
+
+void SwapRowsReversed(uint32_t* line1, uint32_t* line2, unsigned int width)
+{
+  unsigned int x = 0;
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  for (; x + 4 <= width; x += 4)
+  {
+    uint32_t* p1 = line1 + x;
+    uint32_t* p2 = line2 + width - 4 - x;
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p1));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p1), Reverse4(v2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p2), Reverse4(v1));
+  }
+#endif
+  for (; x < width; ++x)
+    std::swap(line1[x], line2[width - 1 - x]);
+}
+
+/*!
+ \brief Write dst(x, y) = src[x * stepX + y * stepY]
+ With |stepY| == 1 and |stepX| the source stride, rows of the destination are columns of the
+ source, which covers transposing and rotating by 90 degrees depending on the signs of the steps.
+ */
+void TransposeImage(const uint32_t* src,
+                    ptrdiff_t stepX,
+                    ptrdiff_t stepY,
+                    uint32_t* dst,
+                    unsigned int dstWidth,
+                    unsigned int dstHeight)
+{
+  // work in tiles so that the reads walking down the source columns stay in cache
+  constexpr unsigned int TILE = 64;
+  for (unsigned int tileY = 0; tileY < dstHeight; tileY += TILE)
+  {
+    const unsigned int endY = std::min(tileY + TILE, dstHeight);
+    for (unsigned int tileX = 0; tileX < dstWidth; tileX += TILE)
+    {
+      const unsigned int endX = std::min(tileX + TILE, dstWidth);
+      unsigned int y = tileY;
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+      // 4x4 blocks: load four source column runs, transpose, store four destination row runs
+      for (; y + 4 <= endY; y += 4)
+      {
+        unsigned int x = tileX;
+        for (; x + 4 <= endX; x += 4)
+        {
+          const uint32_t* block = src + y * stepY + x * stepX;
+          __m128i r0 = Load4(block, stepY);
+          __m128i r1 = Load4(block + stepX, stepY);
+          __m128i r2 = Load4(block + 2 * stepX, stepY);
+          __m128i r3 = Load4(block + 3 * stepX, stepY);
+          Transpose4x4(r0, r1, r2, r3);
+          uint32_t* out = dst + y * dstWidth + x;
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r0);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out + dstWidth), r1);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * dstWidth), r2);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * dstWidth), r3);
+        }
+        for (unsigned int row = y; row < y + 4; ++row)
+          for (unsigned int col = x; col < endX; ++col)
+            dst[row * dstWidth + col] = src[row * stepY + col * stepX];
+      }
+#endif
+      for (; y < endY; ++y)
+        for (unsigned int x = tileX; x < endX; ++x)
+          dst[y * dstWidth + x] = src[y * stepY + x * stepX];
+    }
+  }
+}
+} // unnamed namespace
+
 bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size)
 {
   unsigned char *thumb = NULL;
@@ -205,6 +393,45 @@ bool CPicture::CacheTexture(CTexture* texture,
 bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, uint32_t pitch, int orientation,
   uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
   CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
+{
+  return CacheTexture(pixels, width, height, pitch, orientation, dest_width, dest_height,
+                      [&dest](const unsigned char* buffer, int w, int h, int stride)
+                      { return CreateThumbnailFromSurface(buffer, w, h, stride, dest); },
+                      scalingAlgorithm);
+}
+
+bool CPicture::CacheTextureToMemory(CTexture* texture,
+                                    uint32_t& dest_width,
+                                    uint32_t& dest_height,
+                                    const std::string& dest,
+                                    std::vector<uint8_t>& result,
+                                    CPictureScalingAlgorithm::Algorithm
+                                        scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
+{
+  return CacheTexture(texture->GetPixels(), texture->GetWidth(), texture->GetHeight(),
+                      texture->GetPitch(), texture->GetOrientation(), dest_width, dest_height,
+                      [&dest, &result](const unsigned char* buffer, int w, int h, int stride)
+                      {
+                        uint8_t* thumb = nullptr;
+                        size_t thumbSize = 0;
+                        if (!GetThumbnailFromSurface(buffer, w, h, stride, dest, thumb, thumbSize))
+                          return false;
+                        result.assign(thumb, thumb + thumbSize);
+                        delete[] thumb;
+                        return true;
+                      },
+                      scalingAlgorithm);
+}
+
+bool CPicture::CacheTexture(uint8_t* pixels,
+                            uint32_t width,
+                            uint32_t height,
+                            uint32_t pitch,
+                            int orientation,
+                            uint32_t& dest_width,
+                            uint32_t& dest_height,
+                            const SurfaceWriter& writer,
+                            CPictureScalingAlgorithm::Algorithm scalingAlgorithm)
 {
   const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
 
@@ -254,8 +481,8 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
       if (!orientation ||
           OrientateImage(buffer, dest_width, dest_height, orientation, dest_width_aligned))
       {
-        success = CreateThumbnailFromSurface(reinterpret_cast<unsigned char*>(buffer.get()),
-                                             dest_width, dest_height, dest_width_aligned * 4, dest);
+        success = writer(reinterpret_cast<unsigned char*>(buffer.get()), dest_width,
+                         dest_height, dest_width_aligned * 4);
       }
     }
     return success;
@@ -264,7 +491,7 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
   { // no orientation needed
     dest_width = width;
     dest_height = height;
-    return CreateThumbnailFromSurface(pixels, width, height, pitch, dest);
+    return writer(pixels, width, height, pitch);
   }
   return false;
 }
@@ -355,9 +582,10 @@ bool CPicture::ScaleImage(uint8_t* in_pixels,
                           CPictureScalingAlgorithm::Algorithm
                               scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext* context =
-      sws_getContext(in_width, in_height, in_format, out_width, out_height, out_format,
-                     CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
+  struct SwsContext* context = scalerCache.Get(
+      {static_cast<int>(in_width), static_cast<int>(in_height), in_format,
+       static_cast<int>(out_width), static_cast<int>(out_height), out_format,
+       CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm)});
 
   uint8_t *src[] = { in_pixels, 0, 0, 0 };
   int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
@@ -367,7 +595,6 @@ bool CPicture::ScaleImage(uint8_t* in_pixels,
   if (context)
   {
     sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
     return true;
   }
   return false;
@@ -418,11 +645,7 @@ bool CPicture::FlipHorizontal(std::unique_ptr<uint32_t[]>& pixels,
 {
   // this can be done in-place easily enough
   for (unsigned int y = 0; y < height; ++y)
-  {
-    uint32_t* line = pixels.get() + y * stridePixels;
-    for (unsigned int x = 0; x < width / 2; ++x)
-      std::swap(line[x], line[width - 1 - x]);
-  }
+    ReverseRow(pixels.get() + y * stridePixels, width);
   return true;
 }
 
@@ -436,8 +659,7 @@ bool CPicture::FlipVertical(std::unique_ptr<uint32_t[]>& pixels,
   {
     uint32_t* line1 = pixels.get() + y * stridePixels;
     uint32_t* line2 = pixels.get() + (height - 1 - y) * stridePixels;
-    for (unsigned int x = 0; x < width; ++x)
-      std::swap(*line1++, *line2++);
+    std::swap_ranges(line1, line1 + width, line2);
   }
   return true;
 }
@@ -449,17 +671,11 @@ bool CPicture::Rotate180CCW(std::unique_ptr<uint32_t[]>& pixels,
 {
   // this can be done in-place easily enough
   for (unsigned int y = 0; y < height / 2; ++y)
-  {
-    uint32_t* line1 = pixels.get() + y * stridePixels;
-    uint32_t* line2 = pixels.get() + (height - 1 - y) * stridePixels + width - 1;
-    for (unsigned int x = 0; x < width; ++x)
-      std::swap(*line1++, *line2--);
-  }
+    SwapRowsReversed(pixels.get() + y * stridePixels,
+                     pixels.get() + (height - 1 - y) * stridePixels, width);
   if (height % 2)
   { // height is odd, so flip the middle row as well
-    uint32_t* line = pixels.get() + (height - 1) / 2 * stridePixels;
-    for (unsigned int x = 0; x < width / 2; ++x)
-      std::swap(line[x], line[width - 1 - x]);
+    ReverseRow(pixels.get() + (height - 1) / 2 * stridePixels, width);
   }
   return true;
 }
@@ -469,18 +685,10 @@ bool CPicture::Rotate90CCW(std::unique_ptr<uint32_t[]>& pixels,
                            unsigned int& height,
                            unsigned int& stridePixels)
 {
-  auto dest = std::make_unique<uint32_t[]>(width * height * 4);
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
-  {
-    const uint32_t* src = pixels.get() + (d_height - 1 - y); // y-th col from right, starting at top
-    uint32_t* dst = dest.get() + d_width * y; // y-th row from top, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
-    {
-      *dst++ = *src;
-      src += stridePixels;
-    }
-  }
+  auto dest = std::make_unique<uint32_t[]>(width * height);
+  // y-th row from top is the y-th column from right, starting at top
+  TransposeImage(pixels.get() + width - 1, stridePixels, -1, dest.get(), height, width);
+
   pixels = std::move(dest);
   std::swap(width, height);
   stridePixels = width;
@@ -492,19 +700,10 @@ bool CPicture::Rotate270CCW(std::unique_ptr<uint32_t[]>& pixels,
                             unsigned int& height,
                             unsigned int& stridePixels)
 {
-  auto dest = std::make_unique<uint32_t[]>(width * height * 4);
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
-  {
-    const uint32_t* src =
-        pixels.get() + stridePixels * (d_width - 1) + y; // y-th col from left, starting at bottom
-    uint32_t* dst = dest.get() + d_width * y; // y-th row from top, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
-    {
-      *dst++ = *src;
-      src -= stridePixels;
-    }
-  }
+  auto dest = std::make_unique<uint32_t[]>(width * height);
+  // y-th row from top is the y-th column from left, starting at bottom
+  const ptrdiff_t stride = stridePixels;
+  TransposeImage(pixels.get() + stride * (height - 1), -stride, 1, dest.get(), height, width);
 
   pixels = std::move(dest);
   std::swap(width, height);
@@ -517,18 +716,9 @@ bool CPicture::Transpose(std::unique_ptr<uint32_t[]>& pixels,
                          unsigned int& height,
                          unsigned int& stridePixels)
 {
-  auto dest = std::make_unique<uint32_t[]>(width * height * 4);
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
-  {
-    const uint32_t* src = pixels.get() + y; // y-th col from left, starting at top
-    uint32_t* dst = dest.get() + d_width * y; // y-th row from top, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
-    {
-      *dst++ = *src;
-      src += stridePixels;
-    }
-  }
+  auto dest = std::make_unique<uint32_t[]>(width * height);
+  // y-th row from top is the y-th column from left, starting at top
+  TransposeImage(pixels.get(), stridePixels, 1, dest.get(), height, width);
 
   pixels = std::move(dest);
   std::swap(width, height);
@@ -541,19 +731,11 @@ bool CPicture::TransposeOffAxis(std::unique_ptr<uint32_t[]>& pixels,
                                 unsigned int& height,
                                 unsigned int& stridePixels)
 {
-  auto dest = std::make_unique<uint32_t[]>(width * height * 4);
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
-  {
-    const uint32_t* src = pixels.get() + stridePixels * (d_width - 1) +
-                          (d_height - 1 - y); // y-th col from right, starting at bottom
-    uint32_t* dst = dest.get() + d_width * y; // y-th row, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
-    {
-      *dst++ = *src;
-      src -= stridePixels;
-    }
-  }
+  auto dest = std::make_unique<uint32_t[]>(width * height);
+  // y-th row from top is the y-th column from right, starting at bottom
+  const ptrdiff_t stride = stridePixels;
+  TransposeImage(pixels.get() + stride * (height - 1) + width - 1, -stride, -1, dest.get(), height,
+                 width);
 
   pixels = std::move(dest);
   std::swap(width, height);
@@ -13,6 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,6 +62,22 @@ public:
     uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
     CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
 
+  /*! \brief Cache a texture like CacheTexture(), returning the encoded JPG or PNG instead of saving it
+   \param texture a pointer to a CTexture
+   \param dest_width [in/out] maximum width in pixels of cached version - replaced with actual cached width
+   \param dest_height [in/out] maximum height in pixels of cached version - replaced with actual cached height
+   \param dest name of the cache file, its extension selects the encoding
+   \param result [out] the encoded image
+   \return true if successful, false otherwise
+   */
+  static bool CacheTextureToMemory(
+      CTexture* texture,
+      uint32_t& dest_width,
+      uint32_t& dest_height,
+      const std::string& dest,
+      std::vector<uint8_t>& result,
+      CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
+
   static void GetScale(unsigned int width, unsigned int height, unsigned int &out_width, unsigned int &out_height);
   static bool ScaleImage(
       uint8_t* in_pixels,
@@ -75,13 +92,34 @@ public:
       AVPixelFormat out_format,
       CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
 
-private:
+  /*! \brief Apply an EXIF orientation to an image
+   \param pixels [in/out] the image, replaced by a new buffer when rotating by 90 or 270 degrees
+   \param width [in/out] width of the image in pixels
+   \param height [in/out] height of the image in pixels
+   \param orientation EXIF orientation minus one, see CTexture::GetOrientation
+   \param stridePixels [in/out] distance between rows of the image in pixels
+   \return true if successful, false otherwise
+   */
   static bool OrientateImage(std::unique_ptr<uint32_t[]>& pixels,
                              unsigned int& width,
                              unsigned int& height,
                              int orientation,
                              unsigned int& stridePixels);
 
+private:
+  using SurfaceWriter =
+      std::function<bool(const unsigned char* buffer, int width, int height, int stride)>;
+
+  static bool CacheTexture(uint8_t* pixels,
+                           uint32_t width,
+                           uint32_t height,
+                           uint32_t pitch,
+                           int orientation,
+                           uint32_t& dest_width,
+                           uint32_t& dest_height,
+                           const SurfaceWriter& writer,
+                           CPictureScalingAlgorithm::Algorithm scalingAlgorithm);
+
   static bool FlipHorizontal(std::unique_ptr<uint32_t[]>& pixels,
                              const unsigned int& width,
                              const unsigned int& height,
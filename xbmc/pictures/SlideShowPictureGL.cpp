@@ -23,6 +23,9 @@ std::unique_ptr<CSlideShowPic> CSlideShowPic::CreateSlideShowPicture()
 void CSlideShowPicGL::Render(float* x, float* y, CTexture* pTexture, Color color)
 {
   CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  // the GUI queued so far is drawn below the picture, before the state is changed here
+  renderSystem->FlushGUIRenderQueue();
+
   if (pTexture)
   {
     pTexture->LoadToGPU();
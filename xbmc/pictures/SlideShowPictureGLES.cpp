@@ -26,6 +26,9 @@ void CSlideShowPicGLES::Render(float* x,
 {
   CRenderSystemGLES* renderSystem =
       dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  // the GUI queued so far is drawn below the picture, before the state is changed here
+  renderSystem->FlushGUIRenderQueue();
+
   if (pTexture)
   {
     pTexture->LoadToGPU();
@@ -0,0 +1,271 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/FFmpegImage.h"
+#include "guilib/TextureFormats.h"
+#include "pictures/Picture.h"
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include <sys/resource.h>
+#endif
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Image
+{
+  std::unique_ptr<uint32_t[]> pixels;
+  unsigned int width;
+  unsigned int height;
+  unsigned int stride;
+};
+
+Image MakeImage(unsigned int width, unsigned int height, unsigned int stride)
+{
+  Image image{std::make_unique<uint32_t[]>(stride * height), width, height, stride};
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < stride; ++x)
+      image.pixels[y * stride + x] = x < width ? (y << 16) | x : 0xdeadbeef;
+  }
+  return image;
+}
+
+// straightforward per-pixel version of each EXIF orientation, see CPicture::OrientateImage
+std::vector<uint32_t> Orientate(const Image& image, int orientation)
+{
+  const unsigned int w = image.width;
+  const unsigned int h = image.height;
+  const bool swapped = orientation >= 4;
+  const unsigned int dw = swapped ? h : w;
+  const unsigned int dh = swapped ? w : h;
+
+  std::vector<uint32_t> result(dw * dh);
+  for (unsigned int y = 0; y < dh; ++y)
+  {
+    for (unsigned int x = 0; x < dw; ++x)
+    {
+      unsigned int sx = x;
+      unsigned int sy = y;
+      switch (orientation)
+      {
+        case 1: // flip horizontal
+          sx = w - 1 - x;
+          break;
+        case 2: // rotate 180
+          sx = w - 1 - x;
+          sy = h - 1 - y;
+          break;
+        case 3: // flip vertical
+          sy = h - 1 - y;
+          break;
+        case 4: // transpose
+          sx = y;
+          sy = x;
+          break;
+        case 5: // rotate 270
+          sx = y;
+          sy = h - 1 - x;
+          break;
+        case 6: // transpose off axis
+          sx = w - 1 - y;
+          sy = h - 1 - x;
+          break;
+        case 7: // rotate 90
+          sx = w - 1 - y;
+          sy = x;
+          break;
+      }
+      result[y * dw + x] = image.pixels[sy * image.stride + sx];
+    }
+  }
+  return result;
+}
+
+std::vector<uint8_t> MakeJpeg(unsigned int width, unsigned int height)
+{
+  std::vector<uint32_t> pixels(width * height);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+      pixels[y * width + x] = 0xff000000 | ((x * 255 / width) << 16) |
+                              ((y * 255 / height) << 8) | ((x ^ y) & 0xff);
+  }
+
+  CFFmpegImage encoder("image/jpeg");
+  unsigned char* buffer = nullptr;
+  unsigned int size = 0;
+  std::vector<uint8_t> jpeg;
+  if (encoder.CreateThumbnailFromSurface(reinterpret_cast<unsigned char*>(pixels.data()), width,
+                                         height, XB_FMT_A8R8G8B8, width * 4, "fixture.jpg",
+                                         buffer, size))
+    jpeg.assign(buffer, buffer + size);
+  encoder.ReleaseThumbnailBuffer();
+  return jpeg;
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path)
+{
+  std::vector<uint8_t> data;
+  XFILE::CFile file;
+  if (file.LoadFile(path, data) <= 0)
+    data.clear();
+  return data;
+}
+
+// create a thumbnail of at most 1280x720 the way CTextureCacheJob does
+bool MakeThumbnail(std::vector<uint8_t>& jpeg, bool fitOnDecode, std::vector<uint8_t>& thumb)
+{
+  constexpr unsigned int MAX_WIDTH = 1280;
+  constexpr unsigned int MAX_HEIGHT = 720;
+
+  CFFmpegImage image("image/jpeg");
+  if (!image.LoadImageFromMemory(jpeg.data(), jpeg.size(), fitOnDecode ? MAX_WIDTH : 0,
+                                 fitOnDecode ? MAX_HEIGHT : 0))
+    return false;
+
+  const unsigned int width = image.Width();
+  const unsigned int height = image.Height();
+  std::vector<uint32_t> decoded(width * height);
+  if (!image.Decode(reinterpret_cast<unsigned char*>(decoded.data()), width, height, width * 4,
+                    XB_FMT_A8R8G8B8))
+    return false;
+
+  const double scale =
+      std::min({1.0, static_cast<double>(MAX_WIDTH) / image.originalWidth(),
+                static_cast<double>(MAX_HEIGHT) / image.originalHeight()});
+  unsigned int thumbWidth = std::max(1u, static_cast<unsigned int>(image.originalWidth() * scale));
+  unsigned int thumbHeight =
+      std::max(1u, static_cast<unsigned int>(image.originalHeight() * scale));
+  unsigned int stride = thumbWidth;
+  auto scaled = std::make_unique<uint32_t[]>(thumbWidth * thumbHeight);
+  if (!CPicture::ScaleImage(reinterpret_cast<uint8_t*>(decoded.data()), width, height, width * 4,
+                            AV_PIX_FMT_BGRA, reinterpret_cast<uint8_t*>(scaled.get()),
+                            thumbWidth, thumbHeight, thumbWidth * 4, AV_PIX_FMT_BGRA))
+    return false;
+
+  // portrait photos are usually stored sideways
+  if (!CPicture::OrientateImage(scaled, thumbWidth, thumbHeight, 7, stride))
+    return false;
+
+  CFFmpegImage encoder("image/jpeg");
+  unsigned char* buffer = nullptr;
+  unsigned int size = 0;
+  const bool encoded = encoder.CreateThumbnailFromSurface(
+      reinterpret_cast<unsigned char*>(scaled.get()), thumbWidth, thumbHeight, XB_FMT_A8R8G8B8,
+      stride * 4, "thumb.jpg", buffer, size);
+  if (encoded)
+    thumb.assign(buffer, buffer + size);
+  encoder.ReleaseThumbnailBuffer();
+  return encoded;
+}
+
+long PeakResidentKB()
+{
+#if defined(TARGET_POSIX)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return usage.ru_maxrss;
+#endif
+  return -1;
+}
+} // unnamed namespace
+
+TEST(TestPicture, OrientateImage)
+{
+  // odd sizes and padded rows to hit both the blocked and remaining pixel paths
+  const std::vector<std::pair<unsigned int, unsigned int>> sizes = {
+      {1, 1}, {3, 5}, {4, 4}, {17, 9}, {64, 64}, {130, 67}};
+
+  for (const auto& [width, height] : sizes)
+  {
+    for (int orientation = 1; orientation <= 7; ++orientation)
+    {
+      SCOPED_TRACE(std::to_string(width) + "x" + std::to_string(height) + " orientation " +
+                   std::to_string(orientation));
+      Image image = MakeImage(width, height, width + 3);
+      const std::vector<uint32_t> expected = Orientate(image, orientation);
+
+      ASSERT_TRUE(CPicture::OrientateImage(image.pixels, image.width, image.height, orientation,
+                                           image.stride));
+      ASSERT_EQ(orientation >= 4 ? height : width, image.width);
+      ASSERT_EQ(orientation >= 4 ? width : height, image.height);
+
+      std::vector<uint32_t> actual;
+      for (unsigned int y = 0; y < image.height; ++y)
+        actual.insert(actual.end(), image.pixels.get() + y * image.stride,
+                      image.pixels.get() + y * image.stride + image.width);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(TestPicture, DecodeToFit)
+{
+  std::vector<uint8_t> jpeg = MakeJpeg(3000, 2000);
+  ASSERT_FALSE(jpeg.empty());
+
+  CFFmpegImage image("image/jpeg");
+  ASSERT_TRUE(image.LoadImageFromMemory(jpeg.data(), jpeg.size(), 640, 360));
+  // decoded at reduced resolution, but still large enough to fill the requested size
+  EXPECT_EQ(3000u, image.originalWidth());
+  EXPECT_EQ(2000u, image.originalHeight());
+  EXPECT_LT(image.Width(), 3000u);
+  EXPECT_GE(image.Width(), 640u);
+  EXPECT_GE(image.Height(), 360u);
+}
+
+// Thumbnail generation throughput over a set of fixture images, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestPicture.DISABLED_ThumbnailBenchmark
+TEST(TestPicture, DISABLED_ThumbnailBenchmark)
+{
+  std::vector<std::vector<uint8_t>> fixtures;
+  for (const auto& [width, height] : std::vector<std::pair<unsigned int, unsigned int>>{
+           {6000, 4000}, {4000, 3000}, {3000, 4000}, {1920, 1080}})
+    fixtures.emplace_back(MakeJpeg(width, height));
+  for (const char* file : {"xbmc/pictures/metadata/test/testdata/exifgps.jpg",
+                           "xbmc/pictures/metadata/test/testdata/iptc.jpg"})
+    fixtures.emplace_back(ReadFile(XBMC_REF_FILE_PATH(file)));
+
+  for (const auto& fixture : fixtures)
+    ASSERT_FALSE(fixture.empty());
+
+  constexpr int ROUNDS = 3;
+  for (bool fitOnDecode : {false, true})
+  {
+    int thumbnails = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+      for (auto& fixture : fixtures)
+      {
+        std::vector<uint8_t> thumb;
+        ASSERT_TRUE(MakeThumbnail(fixture, fitOnDecode, thumb));
+        ++thumbnails;
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // peak RSS only ever grows, so the full resolution run goes first
+    std::cout << (fitOnDecode ? "decode to fit" : "full decode") << ": " << thumbnails
+              << " thumbnails in " << elapsed.count() << " s, "
+              << thumbnails / elapsed.count() << " thumbnails/s, peak RSS " << PeakResidentKB()
+              << " kB" << std::endl;
+  }
+}
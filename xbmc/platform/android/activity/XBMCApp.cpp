@@ -838,6 +838,8 @@ void CXBMCApp::UpdateSessionMetadata()
   }
   bool needrecaching = false;
   std::string cachefile = CServiceBroker::GetTextureCache()->CheckCachedImage(thumb, needrecaching);
+  if (!cachefile.empty())
+    cachefile = CServiceBroker::GetTextureCache()->GetCachedImageFile(cachefile);
   if (!cachefile.empty())
   {
     std::string actualfile = CSpecialProtocol::TranslatePath(cachefile);
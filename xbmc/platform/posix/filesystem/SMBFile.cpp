@@ -27,6 +27,8 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <inttypes.h>
 #include <mutex>
@@ -93,6 +95,9 @@ void CSMB::Deinit()
 {
   std::unique_lock<CCriticalSection> lock(*this);
 
+  // files still open keep their context until they are closed
+  m_contexts.clear();
+
   /* samba goes loco if deinited while it has some files opened */
   if (m_context)
   {
@@ -188,6 +193,10 @@ void CSMB::Init()
     // 32 bytes -> set_param_opt
     // 16 bytes -> set_param_opt
     smbc_init(xb_smbc_auth, 0);
+#ifdef DEPRECATED_SMBC_INTERFACE
+    // the contexts of the shares are used by several threads at once
+    smbc_thread_posix();
+#endif
 
     // setup our context
     m_context = smbc_new_context();
@@ -195,35 +204,7 @@ void CSMB::Init()
     // restore HOME
     setenv("HOME", truehome.c_str(), 1);
 
-#ifdef DEPRECATED_SMBC_INTERFACE
-    smbc_setDebug(m_context, CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
-    smbc_setLogCallback(m_context, this, xb_smbc_log);
-    smbc_setFunctionAuthData(m_context, xb_smbc_auth);
-    orig_cache = smbc_getFunctionGetCachedServer(m_context);
-    smbc_setFunctionGetCachedServer(m_context, xb_smbc_cache);
-    smbc_setOptionOneSharePerServer(m_context, false);
-    smbc_setOptionBrowseMaxLmbCount(m_context, 0);
-    smbc_setTimeout(m_context, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000);
-    // we do not need to strdup these, smbc_setXXX below will make their own copies
-    if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
-      //! @bug libsmbclient < 4.9 isn't const correct
-      smbc_setWorkgroup(m_context, const_cast<char*>(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str()));
-    std::string guest = "guest";
-    //! @bug libsmbclient < 4.8 isn't const correct
-    smbc_setUser(m_context, const_cast<char*>(guest.c_str()));
-#else
-    m_context->debug = (CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
-    m_context->callbacks.auth_fn = xb_smbc_auth;
-    orig_cache = m_context->callbacks.get_cached_srv_fn;
-    m_context->callbacks.get_cached_srv_fn = xb_smbc_cache;
-    m_context->options.one_share_per_server = false;
-    m_context->options.browse_max_lmb_count = 0;
-    m_context->timeout = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000;
-    // we need to strdup these, they will get free'd on smbc_free_context
-    if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
-      m_context->workgroup = strdup(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str());
-    m_context->user = strdup("guest");
-#endif
+    SetupContext(m_context);
 
     // initialize samba and do some hacking into the settings
     if (smbc_init_context(m_context))
@@ -251,6 +232,59 @@ void CSMB::Init()
   m_IdleTimeout = 180;
 }
 
+void CSMB::SetupContext(SMBCCTX* context)
+{
+  const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+
+#ifdef DEPRECATED_SMBC_INTERFACE
+  smbc_setDebug(context, CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
+  smbc_setLogCallback(context, &smb, xb_smbc_log);
+  smbc_setFunctionAuthData(context, xb_smbc_auth);
+  orig_cache = smbc_getFunctionGetCachedServer(context);
+  smbc_setFunctionGetCachedServer(context, xb_smbc_cache);
+  smbc_setOptionOneSharePerServer(context, false);
+  smbc_setOptionBrowseMaxLmbCount(context, 0);
+  smbc_setTimeout(context, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000);
+  // we do not need to strdup these, smbc_setXXX below will make their own copies
+  if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
+    //! @bug libsmbclient < 4.9 isn't const correct
+    smbc_setWorkgroup(context, const_cast<char*>(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str()));
+  std::string guest = "guest";
+  //! @bug libsmbclient < 4.8 isn't const correct
+  smbc_setUser(context, const_cast<char*>(guest.c_str()));
+#else
+  context->debug = (CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
+  context->callbacks.auth_fn = xb_smbc_auth;
+  orig_cache = context->callbacks.get_cached_srv_fn;
+  context->callbacks.get_cached_srv_fn = xb_smbc_cache;
+  context->options.one_share_per_server = false;
+  context->options.browse_max_lmb_count = 0;
+  context->timeout = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000;
+  // we need to strdup these, they will get free'd on smbc_free_context
+  if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
+    context->workgroup = strdup(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str());
+  context->user = strdup("guest");
+#endif
+}
+
+std::shared_ptr<CSMBContext> CSMB::GetContext(const CURL& url)
+{
+  std::unique_lock<CCriticalSection> lock(*this);
+  Init();
+  if (!m_context)
+    return {};
+
+  // libsmbclient keeps one connection per server and share in a context
+  std::string share = url.GetFileName().substr(0, url.GetFileName().find('/'));
+  std::string key = StringUtils::ToLower(url.GetHostName() + "/" + share);
+
+  auto it = m_contexts.find(key);
+  if (it == m_contexts.end())
+    it = m_contexts.emplace(key, std::make_shared<CSMBContext>(key)).first;
+
+  return it->second;
+}
+
 std::string CSMB::URLEncode(const CURL &url)
 {
   /* due to smb wanting encoded urls we have to build it manually */
@@ -357,12 +391,148 @@ CURL CSMB::GetResolvedUrl(const CURL& url)
   return tmpUrl;
 }
 
+CSMBContext::CSMBContext(std::string share) : m_context(smbc_new_context()), m_share(std::move(share))
+{
+  if (!m_context)
+    return;
+
+  CSMB::SetupContext(m_context);
+  if (!smbc_init_context(m_context))
+  {
+    CLog::Log(LOGERROR, "CSMBContext::{} - unable to initialize context for {}", __func__,
+              m_share);
+    smbc_free_context(m_context, 1);
+    m_context = nullptr;
+  }
+}
+
+CSMBContext::~CSMBContext()
+{
+  if (m_stats.reads > 0)
+    CLog::Log(LOGDEBUG,
+              "CSMBContext::{} - {}: {} reads, {} bytes, average latency {} us, max latency {} us",
+              __func__, m_share, m_stats.reads, m_stats.bytes,
+              m_stats.totalTimeUs / m_stats.reads, m_stats.maxTimeUs);
+
+  if (m_context)
+    smbc_free_context(m_context, 1);
+}
+
+SMBCFILE* CSMBContext::Open(const std::string& path, int flags, mode_t mode)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionOpen(m_context)(m_context, path.c_str(), flags, mode);
+#else
+  return m_context->open(m_context, path.c_str(), flags, mode);
+#endif
+}
+
+SMBCFILE* CSMBContext::Create(const std::string& path, mode_t mode)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionCreat(m_context)(m_context, path.c_str(), mode);
+#else
+  return m_context->creat(m_context, path.c_str(), mode);
+#endif
+}
+
+ssize_t CSMBContext::Read(SMBCFILE* file, void* buf, size_t size)
+{
+  // a read larger than the negotiated maximum is split by libsmbclient into several
+  // SMB2 reads kept in flight at once, so the whole buffer is requested in one call
+  const auto start = std::chrono::steady_clock::now();
+#ifdef DEPRECATED_SMBC_INTERFACE
+  const ssize_t result = smbc_getFunctionRead(m_context)(m_context, file, buf, size);
+#else
+  const ssize_t result = m_context->read(m_context, file, buf, size);
+#endif
+  const uint64_t time = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+  m_stats.reads++;
+  m_stats.bytes += result > 0 ? result : 0;
+  m_stats.totalTimeUs += time;
+  m_stats.maxTimeUs = std::max(m_stats.maxTimeUs, time);
+  return result;
+}
+
+ssize_t CSMBContext::Write(SMBCFILE* file, const void* buf, size_t size)
+{
+  // buf can be safely casted to void* since the write will only read from it.
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionWrite(m_context)(m_context, file, const_cast<void*>(buf), size);
+#else
+  return m_context->write(m_context, file, const_cast<void*>(buf), size);
+#endif
+}
+
+off_t CSMBContext::Seek(SMBCFILE* file, off_t offset, int whence)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionLseek(m_context)(m_context, file, offset, whence);
+#else
+  return m_context->lseek(m_context, file, offset, whence);
+#endif
+}
+
+int CSMBContext::Stat(const std::string& path, struct stat* buffer)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionStat(m_context)(m_context, path.c_str(), buffer);
+#else
+  return m_context->stat(m_context, path.c_str(), buffer);
+#endif
+}
+
+int CSMBContext::Stat(SMBCFILE* file, struct stat* buffer)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionFstat(m_context)(m_context, file, buffer);
+#else
+  return m_context->fstat(m_context, file, buffer);
+#endif
+}
+
+int CSMBContext::Close(SMBCFILE* file)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionClose(m_context)(m_context, file);
+#else
+  return m_context->close_fn(m_context, file);
+#endif
+}
+
+int CSMBContext::Unlink(const std::string& path)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionUnlink(m_context)(m_context, path.c_str());
+#else
+  return m_context->unlink(m_context, path.c_str());
+#endif
+}
+
+int CSMBContext::Rename(const std::string& path, const std::string& newPath)
+{
+#ifdef DEPRECATED_SMBC_INTERFACE
+  return smbc_getFunctionRename(m_context)(m_context, path.c_str(), m_context, newPath.c_str());
+#else
+  return m_context->rename(m_context, path.c_str(), m_context, newPath.c_str());
+#endif
+}
+
+CSMBContext::Stats CSMBContext::GetStats()
+{
+  std::unique_lock<CCriticalSection> lock(*this);
+  return m_stats;
+}
+
 CSMB smb;
 
 CSMBFile::CSMBFile()
 {
   smb.Init();
-  m_fd = -1;
+  m_file = nullptr;
   smb.AddActiveConnection();
   m_allowRetry = true;
 }
@@ -375,17 +545,17 @@ CSMBFile::~CSMBFile()
 
 int64_t CSMBFile::GetPosition()
 {
-  if (m_fd == -1)
+  if (!m_file)
     return -1;
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return -1;
-  return smbc_lseek(m_fd, 0, SEEK_CUR);
+  return m_context->Seek(m_file, 0, SEEK_CUR);
 }
 
 int64_t CSMBFile::GetLength()
 {
-  if (m_fd == -1)
+  if (!m_file)
     return -1;
   return m_fileSize;
 }
@@ -408,10 +578,11 @@ bool CSMBFile::Open(const CURL& url)
   // listed, which will create lot's of open sessions.
 
   std::string strFileName;
-  m_fd = OpenFile(url, strFileName);
+  m_file = OpenFile(url, strFileName);
 
-  CLog::Log(LOGDEBUG, "CSMBFile::Open - opened {}, fd={}", url.GetRedacted(), m_fd);
-  if (m_fd == -1)
+  CLog::Log(LOGDEBUG, "CSMBFile::Open - opened {}, share={}", url.GetRedacted(),
+            m_file ? m_context->GetShare() : "none");
+  if (!m_file)
   {
     // write error to logfile
     CLog::Log(LOGERROR, "SMBFile->Open: Unable to open file : '{}'\nunix_err:'{:x}' error : '{}'",
@@ -419,24 +590,24 @@ bool CSMBFile::Open(const CURL& url)
     return false;
   }
 
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return false;
   struct stat tmpBuffer;
-  if (smbc_stat(strFileName.c_str(), &tmpBuffer) < 0)
+  if (m_context->Stat(m_file, &tmpBuffer) < 0)
   {
-    smbc_close(m_fd);
-    m_fd = -1;
+    m_context->Close(m_file);
+    m_file = nullptr;
     return false;
   }
 
   m_fileSize = tmpBuffer.st_size;
 
-  int64_t ret = smbc_lseek(m_fd, 0, SEEK_SET);
+  int64_t ret = m_context->Seek(m_file, 0, SEEK_SET);
   if ( ret < 0 )
   {
-    smbc_close(m_fd);
-    m_fd = -1;
+    m_context->Close(m_file);
+    m_file = nullptr;
     return false;
   }
   // We've successfully opened the file!
@@ -469,24 +640,28 @@ int CSMBFile::OpenFile(std::string& strAuth)
 }
 */
 
-int CSMBFile::OpenFile(const CURL &url, std::string& strAuth)
+SMBCFILE* CSMBFile::OpenFile(const CURL& url, std::string& strAuth)
 {
-  int fd = -1;
-  smb.Init();
+  SMBCFILE* file = nullptr;
+
+  const CURL resolvedUrl = CSMB::GetResolvedUrl(url);
+  m_context = smb.GetContext(resolvedUrl);
+  if (!m_context)
+    return nullptr;
 
-  strAuth = GetAuthenticatedPath(CSMB::GetResolvedUrl(url));
+  strAuth = GetAuthenticatedPath(resolvedUrl);
   std::string strPath = strAuth;
 
   {
-    std::unique_lock<CCriticalSection> lock(smb);
-    if (smb.IsSmbValid())
-      fd = smbc_open(strPath.c_str(), O_RDONLY, 0);
+    std::unique_lock<CCriticalSection> lock(*m_context);
+    if (m_context->IsValid())
+      file = m_context->Open(strPath, O_RDONLY, 0);
   }
 
-  if (fd >= 0)
+  if (file)
     strAuth = strPath;
 
-  return fd;
+  return file;
 }
 
 bool CSMBFile::Exists(const CURL& url)
@@ -495,15 +670,18 @@ bool CSMBFile::Exists(const CURL& url)
   // if a file matches the if below return false, it can't exist on a samba share.
   if (!IsValidFile(url.GetFileName())) return false;
 
-  smb.Init();
-  std::string strFileName = GetAuthenticatedPath(CSMB::GetResolvedUrl(url));
+  const CURL resolvedUrl = CSMB::GetResolvedUrl(url);
+  const std::shared_ptr<CSMBContext> context = smb.GetContext(resolvedUrl);
+  if (!context)
+    return false;
+  std::string strFileName = GetAuthenticatedPath(resolvedUrl);
 
   struct stat info;
 
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*context);
+  if (!context->IsValid())
     return false;
-  int iResult = smbc_stat(strFileName.c_str(), &info);
+  int iResult = context->Stat(strFileName, &info);
 
   if (iResult < 0) return false;
   return true;
@@ -511,36 +689,39 @@ bool CSMBFile::Exists(const CURL& url)
 
 int CSMBFile::Stat(struct __stat64* buffer)
 {
-  if (m_fd == -1)
+  if (!m_file)
     return -1;
 
   struct stat tmpBuffer = {};
 
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return -1;
-  int iResult = smbc_fstat(m_fd, &tmpBuffer);
+  int iResult = m_context->Stat(m_file, &tmpBuffer);
   CUtil::StatToStat64(buffer, &tmpBuffer);
   return iResult;
 }
 
 int CSMBFile::Stat(const CURL& url, struct __stat64* buffer)
 {
-  smb.Init();
-  std::string strFileName = GetAuthenticatedPath(CSMB::GetResolvedUrl(url));
-  std::unique_lock<CCriticalSection> lock(smb);
+  const CURL resolvedUrl = CSMB::GetResolvedUrl(url);
+  const std::shared_ptr<CSMBContext> context = smb.GetContext(resolvedUrl);
+  if (!context)
+    return -1;
+  std::string strFileName = GetAuthenticatedPath(resolvedUrl);
+  std::unique_lock<CCriticalSection> lock(*context);
 
-  if (!smb.IsSmbValid())
+  if (!context->IsValid())
     return -1;
   struct stat tmpBuffer = {};
-  int iResult = smbc_stat(strFileName.c_str(), &tmpBuffer);
+  int iResult = context->Stat(strFileName, &tmpBuffer);
   CUtil::StatToStat64(buffer, &tmpBuffer);
   return iResult;
 }
 
 int CSMBFile::Truncate(int64_t size)
 {
-  if (m_fd == -1) return 0;
+  if (!m_file) return 0;
   /*
  * This would force us to be dependant on SMBv3.2 which is GPLv3
  * This is only used by the TagLib writers, which are not currently in use
@@ -562,7 +743,7 @@ ssize_t CSMBFile::Read(void *lpBuf, size_t uiBufSize)
   if (uiBufSize > SSIZE_MAX)
     uiBufSize = SSIZE_MAX;
 
-  if (m_fd == -1)
+  if (!m_file)
     return -1;
 
   // Some external libs (libass) use test read with zero size and
@@ -573,19 +754,19 @@ ssize_t CSMBFile::Read(void *lpBuf, size_t uiBufSize)
   if (uiBufSize == 0 && lpBuf == NULL)
     return 0;
 
-  std::unique_lock<CCriticalSection> lock(
-      smb); // Init not called since it has to be "inited" by now
-  if (!smb.IsSmbValid())
+  // only the context of this share is locked, reads from other shares go on meanwhile
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return -1;
   smb.SetActivityTime();
 
-  ssize_t bytesRead = smbc_read(m_fd, lpBuf, (int)uiBufSize);
+  ssize_t bytesRead = m_context->Read(m_file, lpBuf, uiBufSize);
 
   if (m_allowRetry && bytesRead < 0 && errno == EINVAL )
   {
     CLog::Log(LOGERROR, "{} - Error( {}, {}, {} ) - Retrying", __FUNCTION__, bytesRead, errno,
               strerror(errno));
-    bytesRead = smbc_read(m_fd, lpBuf, (int)uiBufSize);
+    bytesRead = m_context->Read(m_file, lpBuf, uiBufSize);
   }
 
   if ( bytesRead < 0 )
@@ -597,14 +778,13 @@ ssize_t CSMBFile::Read(void *lpBuf, size_t uiBufSize)
 
 int64_t CSMBFile::Seek(int64_t iFilePosition, int iWhence)
 {
-  if (m_fd == -1) return -1;
+  if (!m_file) return -1;
 
-  std::unique_lock<CCriticalSection> lock(
-      smb); // Init not called since it has to be "inited" by now
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return -1;
   smb.SetActivityTime();
-  int64_t pos = smbc_lseek(m_fd, iFilePosition, iWhence);
+  int64_t pos = m_context->Seek(m_file, iFilePosition, iWhence);
 
   if ( pos < 0 )
   {
@@ -617,39 +797,41 @@ int64_t CSMBFile::Seek(int64_t iFilePosition, int iWhence)
 
 void CSMBFile::Close()
 {
-  if (m_fd != -1)
+  if (m_file)
   {
-    CLog::Log(LOGDEBUG, "CSMBFile::Close closing fd {}", m_fd);
-    std::unique_lock<CCriticalSection> lock(smb);
-    if (!smb.IsSmbValid())
-      return;
-    smbc_close(m_fd);
+    CLog::Log(LOGDEBUG, "CSMBFile::Close closing {}", m_url.GetRedacted());
+    std::unique_lock<CCriticalSection> lock(*m_context);
+    if (m_context->IsValid())
+      m_context->Close(m_file);
   }
-  m_fd = -1;
+  m_file = nullptr;
+  m_context.reset();
 }
 
 ssize_t CSMBFile::Write(const void* lpBuf, size_t uiBufSize)
 {
-  if (m_fd == -1) return -1;
+  if (!m_file) return -1;
 
-  // lpBuf can be safely casted to void* since xbmc_write will only read from it.
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return -1;
 
-  return  smbc_write(m_fd, lpBuf, uiBufSize);
+  return m_context->Write(m_file, lpBuf, uiBufSize);
 }
 
 bool CSMBFile::Delete(const CURL& url)
 {
-  smb.Init();
-  std::string strFile = GetAuthenticatedPath(CSMB::GetResolvedUrl(url));
+  const CURL resolvedUrl = CSMB::GetResolvedUrl(url);
+  const std::shared_ptr<CSMBContext> context = smb.GetContext(resolvedUrl);
+  if (!context)
+    return false;
+  std::string strFile = GetAuthenticatedPath(resolvedUrl);
 
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*context);
+  if (!context->IsValid())
     return false;
 
-  int result = smbc_unlink(strFile.c_str());
+  int result = context->Unlink(strFile);
 
   if(result != 0)
     CLog::Log(LOGERROR, "{} - Error( {} )", __FUNCTION__, strerror(errno));
@@ -659,14 +841,17 @@ bool CSMBFile::Delete(const CURL& url)
 
 bool CSMBFile::Rename(const CURL& url, const CURL& urlnew)
 {
-  smb.Init();
-  std::string strFile = GetAuthenticatedPath(CSMB::GetResolvedUrl(url));
+  const CURL resolvedUrl = CSMB::GetResolvedUrl(url);
+  const std::shared_ptr<CSMBContext> context = smb.GetContext(resolvedUrl);
+  if (!context)
+    return false;
+  std::string strFile = GetAuthenticatedPath(resolvedUrl);
   std::string strFileNew = GetAuthenticatedPath(CSMB::GetResolvedUrl(urlnew));
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  std::unique_lock<CCriticalSection> lock(*context);
+  if (!context->IsValid())
     return false;
 
-  int result = smbc_rename(strFile.c_str(), strFileNew.c_str());
+  int result = context->Rename(strFile, strFileNew);
 
   if(result != 0)
     CLog::Log(LOGERROR, "{} - Error( {} )", __FUNCTION__, strerror(errno));
@@ -684,23 +869,27 @@ bool CSMBFile::OpenForWrite(const CURL& url, bool bOverWrite)
   // if a file matches the if below return false, it can't exist on a samba share.
   if (!IsValidFile(url.GetFileName())) return false;
 
-  std::string strFileName = GetAuthenticatedPath(CSMB::GetResolvedUrl(url));
-  std::unique_lock<CCriticalSection> lock(smb);
-  if (!smb.IsSmbValid())
+  const CURL resolvedUrl = CSMB::GetResolvedUrl(url);
+  m_context = smb.GetContext(resolvedUrl);
+  if (!m_context)
+    return false;
+  std::string strFileName = GetAuthenticatedPath(resolvedUrl);
+  std::unique_lock<CCriticalSection> lock(*m_context);
+  if (!m_context->IsValid())
     return false;
 
   if (bOverWrite)
   {
     CLog::Log(LOGWARNING, "SMBFile::OpenForWrite() called with overwriting enabled! - {}",
               CURL::GetRedacted(strFileName));
-    m_fd = smbc_creat(strFileName.c_str(), 0);
+    m_file = m_context->Create(strFileName, 0);
   }
   else
   {
-    m_fd = smbc_open(strFileName.c_str(), O_RDWR, 0);
+    m_file = m_context->Open(strFileName, O_RDWR, 0);
   }
 
-  if (m_fd == -1)
+  if (!m_file)
   {
     // write error to logfile
     CLog::Log(LOGERROR, "SMBFile->Open: Unable to open file : '{}'\nunix_err:'{:x}' error : '{}'",
@@ -19,6 +19,13 @@
 #include "filesystem/IFile.h"
 #include "threads/CriticalSection.h"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <sys/types.h>
+
 #define NT_STATUS_CONNECTION_REFUSED long(0xC0000000 | 0x0236)
 #define NT_STATUS_INVALID_HANDLE long(0xC0000000 | 0x0008)
 #define NT_STATUS_ACCESS_DENIED long(0xC0000000 | 0x0022)
@@ -27,6 +34,53 @@
 
 struct _SMBCCTX;
 typedef _SMBCCTX SMBCCTX;
+struct _SMBCFILE;
+typedef _SMBCFILE SMBCFILE;
+
+/*!
+ \brief A libsmbclient context of its own for the files of a server share.
+
+ All calls into a context are serialized by its lock, but different contexts can be
+ used concurrently, so reading from one share does not stall the others.
+ */
+class CSMBContext : public CCriticalSection
+{
+public:
+  struct Stats
+  {
+    uint64_t reads{0};
+    uint64_t bytes{0};
+    uint64_t totalTimeUs{0};
+    uint64_t maxTimeUs{0};
+  };
+
+  explicit CSMBContext(std::string share);
+  ~CSMBContext();
+  CSMBContext(const CSMBContext&) = delete;
+  CSMBContext& operator=(const CSMBContext&) = delete;
+
+  /* Makes sense to be called after acquiring the lock */
+  bool IsValid() const { return m_context != nullptr; }
+  const std::string& GetShare() const { return m_share; }
+
+  SMBCFILE* Open(const std::string& path, int flags, mode_t mode);
+  SMBCFILE* Create(const std::string& path, mode_t mode);
+  ssize_t Read(SMBCFILE* file, void* buf, size_t size);
+  ssize_t Write(SMBCFILE* file, const void* buf, size_t size);
+  off_t Seek(SMBCFILE* file, off_t offset, int whence);
+  int Stat(const std::string& path, struct stat* buffer);
+  int Stat(SMBCFILE* file, struct stat* buffer);
+  int Close(SMBCFILE* file);
+  int Unlink(const std::string& path);
+  int Rename(const std::string& path, const std::string& newPath);
+
+  Stats GetStats();
+
+private:
+  SMBCCTX* m_context;
+  const std::string m_share;
+  Stats m_stats;
+};
 
 class CSMB : public CCriticalSection
 {
@@ -47,8 +101,18 @@ public:
   DWORD ConvertUnixToNT(int error);
   static CURL GetResolvedUrl(const CURL& url);
 
+  /*!
+   \brief Get the context for the files of the share of an url.
+   \param url the url of a file, with resolved host name
+   \return the context, shared by all files of the share until Deinit
+   */
+  std::shared_ptr<CSMBContext> GetContext(const CURL& url);
+
+  static void SetupContext(SMBCCTX* context);
+
 private:
   SMBCCTX *m_context;
+  std::map<std::string, std::shared_ptr<CSMBContext>> m_contexts;
   int m_OpenConnections;
   unsigned int m_IdleTimeout;
   static bool IsFirstInit;
@@ -62,7 +126,7 @@ class CSMBFile : public IFile
 {
 public:
   CSMBFile();
-  int OpenFile(const CURL &url, std::string& strAuth);
+  SMBCFILE* OpenFile(const CURL& url, std::string& strAuth);
   ~CSMBFile() override;
   void Close() override;
   int64_t Seek(int64_t iFilePosition, int iWhence = SEEK_SET) override;
@@ -87,7 +151,8 @@ protected:
   bool IsValidFile(const std::string& strFileName);
   std::string GetAuthenticatedPath(const CURL &url);
   int64_t m_fileSize;
-  int m_fd;
+  std::shared_ptr<CSMBContext> m_context;
+  SMBCFILE* m_file;
   bool m_allowRetry;
 };
 }
@@ -16,6 +16,7 @@
 #include "pvr/PVRComponentRegistration.h"
 #include "pvr/PVRConstants.h" // PVR_CLIENT_INVALID_UID
 #include "pvr/PVRDatabase.h"
+#include "pvr/PVRManagerJobQueue.h"
 #include "pvr/PVRPlaybackState.h"
 #include "pvr/addons/PVRClient.h"
 #include "pvr/addons/PVRClients.h"
@@ -46,6 +47,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -57,141 +59,10 @@ using namespace std::chrono_literals;
 
 namespace
 {
-
-class CPVRJob
-{
-public:
-  virtual ~CPVRJob() = default;
-
-  virtual bool DoWork() = 0;
-  virtual const std::string GetType() const = 0;
-
-protected:
-};
-
-template<typename F>
-class CPVRLambdaJob : public CPVRJob
-{
-public:
-  CPVRLambdaJob() = delete;
-  CPVRLambdaJob(const std::string& type, F&& f) : m_type(type), m_f(std::forward<F>(f)) {}
-
-  bool DoWork() override
-  {
-    m_f();
-    return true;
-  }
-
-  const std::string GetType() const override { return m_type; }
-
-private:
-  std::string m_type;
-  F m_f;
-};
-
+// clients tend to trigger a burst of updates, e.g. one per timer of a series they just scheduled
+constexpr auto CLIENT_UPDATE_COALESCE_DELAY = 500ms;
 } // unnamed namespace
 
-namespace PVR
-{
-
-class CPVRManagerJobQueue
-{
-public:
-  CPVRManagerJobQueue() : m_triggerEvent(false) {}
-
-  void Start();
-  void Stop();
-  void Clear();
-
-  template<typename F>
-  void Append(const std::string& type, F&& f)
-  {
-    AppendJob(new CPVRLambdaJob<F>(type, std::forward<F>(f)));
-  }
-
-  void ExecutePendingJobs();
-
-  bool WaitForJobs(unsigned int milliSeconds)
-  {
-    return m_triggerEvent.Wait(std::chrono::milliseconds(milliSeconds));
-  }
-
-private:
-  void AppendJob(CPVRJob* job);
-
-  CCriticalSection m_critSection;
-  CEvent m_triggerEvent;
-  std::vector<CPVRJob*> m_pendingUpdates;
-  bool m_bStopped = true;
-};
-
-} // namespace PVR
-
-void CPVRManagerJobQueue::Start()
-{
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  m_bStopped = false;
-  m_triggerEvent.Set();
-}
-
-void CPVRManagerJobQueue::Stop()
-{
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  m_bStopped = true;
-  m_triggerEvent.Reset();
-}
-
-void CPVRManagerJobQueue::Clear()
-{
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  for (CPVRJob* updateJob : m_pendingUpdates)
-    delete updateJob;
-
-  m_pendingUpdates.clear();
-  m_triggerEvent.Set();
-}
-
-void CPVRManagerJobQueue::AppendJob(CPVRJob* job)
-{
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-
-  // check for another pending job of given type...
-  if (std::any_of(m_pendingUpdates.cbegin(), m_pendingUpdates.cend(),
-                  [job](CPVRJob* updateJob) { return updateJob->GetType() == job->GetType(); }))
-  {
-    delete job;
-    return;
-  }
-
-  m_pendingUpdates.push_back(job);
-  m_triggerEvent.Set();
-}
-
-void CPVRManagerJobQueue::ExecutePendingJobs()
-{
-  std::vector<CPVRJob*> pendingUpdates;
-
-  {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-
-    if (m_bStopped)
-      return;
-
-    pendingUpdates = std::move(m_pendingUpdates);
-    m_triggerEvent.Reset();
-  }
-
-  CPVRJob* job = nullptr;
-  while (!pendingUpdates.empty())
-  {
-    job = pendingUpdates.front();
-    pendingUpdates.erase(pendingUpdates.begin());
-
-    job->DoWork();
-    delete job;
-  }
-}
-
 CPVRManager::CPVRManager()
   : CThread("PVRManager"),
     m_providers(new CPVRProviders),
@@ -881,14 +752,17 @@ void CPVRManager::TriggerRecordingsSizeInProgressUpdate()
 
 void CPVRManager::TriggerRecordingsUpdate(int clientId)
 {
-  m_pendingUpdates->Append("pvr-update-recordings-" + std::to_string(clientId), [this, clientId]() {
-    if (!IsKnownClient(clientId))
-      return;
+  m_pendingUpdates->Append(
+      "pvr-update-recordings-" + std::to_string(clientId),
+      [this, clientId]() {
+        if (!IsKnownClient(clientId))
+          return;
 
-    const std::shared_ptr<CPVRClient> client = GetClient(clientId);
-    if (client)
-      Recordings()->UpdateFromClients({client});
-  });
+        const std::shared_ptr<CPVRClient> client = GetClient(clientId);
+        if (client)
+          Recordings()->UpdateFromClients({client});
+      },
+      CLIENT_UPDATE_COALESCE_DELAY);
 }
 
 void CPVRManager::TriggerRecordingsUpdate()
@@ -899,14 +773,17 @@ void CPVRManager::TriggerRecordingsUpdate()
 
 void CPVRManager::TriggerTimersUpdate(int clientId)
 {
-  m_pendingUpdates->Append("pvr-update-timers-" + std::to_string(clientId), [this, clientId]() {
-    if (!IsKnownClient(clientId))
-      return;
-
-    const std::shared_ptr<CPVRClient> client = GetClient(clientId);
-    if (client)
-      Timers()->UpdateFromClients({client});
-  });
+  m_pendingUpdates->Append(
+      "pvr-update-timers-" + std::to_string(clientId),
+      [this, clientId]() {
+        if (!IsKnownClient(clientId))
+          return;
+
+        const std::shared_ptr<CPVRClient> client = GetClient(clientId);
+        if (client)
+          Timers()->UpdateFromClients({client});
+      },
+      CLIENT_UPDATE_COALESCE_DELAY);
 }
 
 void CPVRManager::TriggerTimersUpdate()
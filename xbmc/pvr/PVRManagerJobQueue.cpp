@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRManagerJobQueue.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace PVR;
+
+void CPVRManagerJobQueue::Start()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_bStopped = false;
+  m_triggerEvent.Set();
+}
+
+void CPVRManagerJobQueue::Stop()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_bStopped = true;
+  m_triggerEvent.Reset();
+}
+
+void CPVRManagerJobQueue::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (CPVRJob* updateJob : m_pendingUpdates)
+    delete updateJob;
+
+  m_pendingUpdates.clear();
+  m_triggerEvent.Set();
+}
+
+void CPVRManagerJobQueue::AppendJob(CPVRJob* job, std::chrono::milliseconds delay)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  // check for another pending job of given type...
+  if (std::any_of(m_pendingUpdates.cbegin(), m_pendingUpdates.cend(),
+                  [job](CPVRJob* updateJob) { return updateJob->GetType() == job->GetType(); }))
+  {
+    delete job;
+    return;
+  }
+
+  job->SetDelay(delay);
+  m_pendingUpdates.push_back(job);
+  m_triggerEvent.Set();
+}
+
+void CPVRManagerJobQueue::ExecutePendingJobs()
+{
+  std::vector<CPVRJob*> pendingUpdates;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+
+    if (m_bStopped)
+      return;
+
+    // delayed jobs stay pending until they are due
+    const auto now = std::chrono::steady_clock::now();
+    const auto it = std::stable_partition(m_pendingUpdates.begin(), m_pendingUpdates.end(),
+                                          [&now](CPVRJob* job) { return job->GetDueTime() <= now; });
+    pendingUpdates.assign(m_pendingUpdates.begin(), it);
+    m_pendingUpdates.erase(m_pendingUpdates.begin(), it);
+    m_triggerEvent.Reset();
+  }
+
+  CPVRJob* job = nullptr;
+  while (!pendingUpdates.empty())
+  {
+    job = pendingUpdates.front();
+    pendingUpdates.erase(pendingUpdates.begin());
+
+    job->DoWork();
+    delete job;
+  }
+}
+
+bool CPVRManagerJobQueue::WaitForJobs(unsigned int milliSeconds)
+{
+  std::chrono::milliseconds timeout(milliSeconds);
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+
+    // wake up in time for the first delayed job
+    const auto now = std::chrono::steady_clock::now();
+    for (const CPVRJob* job : m_pendingUpdates)
+      timeout = std::min(timeout, std::chrono::ceil<std::chrono::milliseconds>(
+                                      std::max(job->GetDueTime() - now,
+                                               std::chrono::steady_clock::duration::zero())));
+  }
+
+  return m_triggerEvent.Wait(timeout);
+}
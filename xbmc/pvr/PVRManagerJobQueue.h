@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+class CPVRJob
+{
+public:
+  virtual ~CPVRJob() = default;
+
+  virtual bool DoWork() = 0;
+  virtual const std::string GetType() const = 0;
+
+  void SetDelay(std::chrono::milliseconds delay)
+  {
+    m_dueTime = std::chrono::steady_clock::now() + delay;
+  }
+  std::chrono::steady_clock::time_point GetDueTime() const { return m_dueTime; }
+
+protected:
+  std::chrono::steady_clock::time_point m_dueTime;
+};
+
+template<typename F>
+class CPVRLambdaJob : public CPVRJob
+{
+public:
+  CPVRLambdaJob() = delete;
+  CPVRLambdaJob(const std::string& type, F&& f) : m_type(type), m_f(std::forward<F>(f)) {}
+
+  bool DoWork() override
+  {
+    m_f();
+    return true;
+  }
+
+  const std::string GetType() const override { return m_type; }
+
+private:
+  std::string m_type;
+  F m_f;
+};
+
+class CPVRManagerJobQueue
+{
+public:
+  CPVRManagerJobQueue() : m_triggerEvent(false) {}
+
+  void Start();
+  void Stop();
+  void Clear();
+
+  /*!
+   * @brief Append a job, unless a job of the same type is already pending.
+   * @param type The type of the job.
+   * @param f The function to execute.
+   * @param delay The time to wait before executing the job, to let further requests for the same
+   * job be merged into this one.
+   */
+  template<typename F>
+  void Append(const std::string& type,
+              F&& f,
+              std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+  {
+    AppendJob(new CPVRLambdaJob<F>(type, std::forward<F>(f)), delay);
+  }
+
+  void ExecutePendingJobs();
+
+  bool WaitForJobs(unsigned int milliSeconds);
+
+private:
+  void AppendJob(CPVRJob* job, std::chrono::milliseconds delay);
+
+  CCriticalSection m_critSection;
+  CEvent m_triggerEvent;
+  std::vector<CPVRJob*> m_pendingUpdates;
+  bool m_bStopped = true;
+};
+} // namespace PVR
@@ -0,0 +1,27 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+namespace PVR
+{
+
+/*!
+ * @brief The entries touched by a synchronization of local data with the data of the clients.
+ */
+struct PVRSyncStats
+{
+  bool HasChanges() const { return added > 0 || changed > 0 || removed > 0; }
+
+  unsigned int added{0};
+  unsigned int changed{0};
+  unsigned int removed{0};
+  unsigned int unchanged{0};
+};
+
+} // namespace PVR
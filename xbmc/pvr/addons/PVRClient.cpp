@@ -1717,6 +1717,23 @@ PVR_ERROR CPVRClient::DemuxRead(DemuxPacket*& packet)
       m_clientCapabilities.HandlesDemuxing());
 }
 
+PVR_ERROR CPVRClient::DemuxReadBatch(DemuxPacket** packets, int maxPackets, int& count)
+{
+  count = 0;
+  return DoAddonCall(
+      __func__,
+      [packets, maxPackets, &count](const AddonInstance* addon)
+      {
+        if (!addon->toAddon->DemuxReadBatch)
+          return PVR_ERROR_NOT_IMPLEMENTED;
+
+        count = addon->toAddon->DemuxReadBatch(addon, reinterpret_cast<DEMUX_PACKET**>(packets),
+                                               maxPackets);
+        return count > 0 ? PVR_ERROR_NO_ERROR : PVR_ERROR_NOT_IMPLEMENTED;
+      },
+      m_clientCapabilities.SupportsDemuxBatch());
+}
+
 const char* CPVRClient::ToString(const PVR_ERROR error)
 {
   switch (error)
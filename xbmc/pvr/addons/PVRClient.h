@@ -756,6 +756,15 @@ public:
    */
   PVR_ERROR DemuxRead(DemuxPacket*& packet);
 
+  /*!
+   * @brief Read as many packets as available from the demultiplexer, up to the given count.
+   * @param packets The array to store the packets read in.
+   * @param maxPackets The size of the array.
+   * @param count The count of packets read.
+   * @return PVR_ERROR_NO_ERROR on success, respective error code otherwise.
+   */
+  PVR_ERROR DemuxReadBatch(DemuxPacket** packets, int maxPackets, int& count);
+
   static const char* ToString(const PVR_ERROR error);
 
   /*!
@@ -277,6 +277,16 @@ public:
     return m_addonCapabilities && m_addonCapabilities->bHandlesDemuxing;
   }
 
+  /*!
+   * @brief Check whether this add-on reads many demux packets at once.
+   * @return True if supported, false otherwise.
+   */
+  bool SupportsDemuxBatch() const
+  {
+    return m_addonCapabilities && m_addonCapabilities->bHandlesDemuxing &&
+           m_addonCapabilities->bSupportsDemuxBatch;
+  }
+
 private:
   void InitRecordingsLifetimeValues();
 
@@ -19,6 +19,7 @@
 #include "pvr/addons/PVRClients.h"
 #include "pvr/channels/PVRChannel.h"
 #include "pvr/channels/PVRChannelGroupMember.h"
+#include "pvr/channels/PVRChannelGroupMemberIndex.h"
 #include "pvr/channels/PVRChannelsPath.h"
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgChannelData.h"
@@ -27,6 +28,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -127,6 +129,7 @@ void CPVRChannelGroup::Unload()
   m_sortedMembers.clear();
   m_members.clear();
   m_failedClients.clear();
+  UpdateIndex();
 }
 
 int CPVRChannelGroup::GetClientID() const
@@ -216,12 +219,31 @@ void CPVRChannelGroup::SortByClientChannelNumber()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+  UpdateIndex();
 }
 
 void CPVRChannelGroup::SortByChannelNumber()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+  UpdateIndex();
+}
+
+void CPVRChannelGroup::UpdateIndex()
+{
+  std::atomic_store(&m_index,
+                    std::shared_ptr<const CPVRChannelGroupMemberIndex>(
+                        std::make_shared<CPVRChannelGroupMemberIndex>(
+                            m_sortedMembers, GetSettings()->UseBackendChannelNumbers())));
+}
+
+std::shared_ptr<const CPVRChannelGroupMemberIndex> CPVRChannelGroup::GetIndex() const
+{
+  static const auto emptyIndex = std::make_shared<const CPVRChannelGroupMemberIndex>(
+      std::vector<std::shared_ptr<CPVRChannelGroupMember>>{}, false);
+
+  const std::shared_ptr<const CPVRChannelGroupMemberIndex> index = std::atomic_load(&m_index);
+  return index ? index : emptyIndex;
 }
 
 void CPVRChannelGroup::UpdateClientPriorities()
@@ -299,6 +321,11 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByUniqueID(int iUniqueChannelI
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelID(int iChannelID) const
 {
+  std::shared_ptr<CPVRChannel> channel = GetIndex()->GetByChannelID(iChannelID);
+  if (channel)
+    return channel;
+
+  // the channel may have got its id after the index was built
   std::unique_lock<CCriticalSection> lock(m_critSection);
   const auto it =
       std::find_if(m_members.cbegin(), m_members.cend(), [iChannelID](const auto& member) {
@@ -307,31 +334,14 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelID(int iChannelID) co
   return it != m_members.cend() ? (*it).second->Channel() : std::shared_ptr<CPVRChannel>();
 }
 
-namespace
-{
-bool MatchProvider(const std::shared_ptr<CPVRChannel>& channel, int clientId, int providerId)
-{
-  return channel->ClientID() == clientId &&
-         (providerId == PVR_PROVIDER_INVALID_UID || channel->ClientProviderUid() == providerId);
-}
-} // unnamed namespace
-
 bool CPVRChannelGroup::HasChannelForProvider(int clientId, int providerId) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  return std::any_of(m_members.cbegin(), m_members.cend(),
-                     [clientId, providerId](const auto& member)
-                     { return MatchProvider(member.second->Channel(), clientId, providerId); });
+  return GetIndex()->GetChannelCountByProvider(clientId, providerId) > 0;
 }
 
 unsigned int CPVRChannelGroup::GetChannelCountByProvider(int clientId, int providerId) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  auto channels =
-      std::count_if(m_members.cbegin(), m_members.cend(),
-                    [clientId, providerId](const auto& member)
-                    { return MatchProvider(member.second->Channel(), clientId, providerId); });
-  return static_cast<unsigned int>(channels);
+  return GetIndex()->GetChannelCountByProvider(clientId, providerId);
 }
 
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetLastPlayedChannelGroupMember(
@@ -399,73 +409,19 @@ CPVRChannelNumber CPVRChannelGroup::GetClientChannelNumber(
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetByChannelNumber(
     const CPVRChannelNumber& channelNumber) const
 {
-  std::unique_lock<CCriticalSection> lock(m_critSection);
-  const bool bUseBackendChannelNumbers = GetSettings()->UseBackendChannelNumbers();
-  for (const auto& member : m_sortedMembers)
-  {
-    CPVRChannelNumber activeChannelNumber =
-        bUseBackendChannelNumbers ? member->ClientChannelNumber() : member->ChannelNumber();
-    if (activeChannelNumber == channelNumber)
-      return member;
-  }
-
-  return {};
+  return GetIndex()->GetByChannelNumber(channelNumber);
 }
 
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetNextChannelGroupMember(
     const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const
 {
-  std::shared_ptr<CPVRChannelGroupMember> nextMember;
-
-  if (groupMember)
-  {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-    for (auto it = m_sortedMembers.cbegin(); !nextMember && it != m_sortedMembers.cend(); ++it)
-    {
-      if (*it == groupMember)
-      {
-        do
-        {
-          if ((++it) == m_sortedMembers.cend())
-            it = m_sortedMembers.cbegin();
-          if ((*it)->Channel() && !(*it)->Channel()->IsHidden())
-            nextMember = *it;
-        } while (!nextMember && *it != groupMember);
-
-        break;
-      }
-    }
-  }
-
-  return nextMember;
+  return GetIndex()->GetNext(groupMember);
 }
 
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetPreviousChannelGroupMember(
     const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const
 {
-  std::shared_ptr<CPVRChannelGroupMember> previousMember;
-
-  if (groupMember)
-  {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-    for (auto it = m_sortedMembers.crbegin(); !previousMember && it != m_sortedMembers.crend();
-         ++it)
-    {
-      if (*it == groupMember)
-      {
-        do
-        {
-          if ((++it) == m_sortedMembers.crend())
-            it = m_sortedMembers.crbegin();
-          if ((*it)->Channel() && !(*it)->Channel()->IsHidden())
-            previousMember = *it;
-        } while (!previousMember && *it != groupMember);
-
-        break;
-      }
-    }
-  }
-  return previousMember;
+  return GetIndex()->GetPrevious(groupMember);
 }
 
 std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::GetMembers(
@@ -755,6 +711,9 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::RemoveDel
     ++it;
   }
 
+  if (!membersToRemove.empty())
+    UpdateIndex();
+
   DeleteGroupMembersFromDb(membersToRemove);
 
   return membersToRemove;
@@ -813,6 +772,7 @@ bool CPVRChannelGroup::RemoveFromGroup(
   // no need to delete and renumber if nothing was removed
   if (bReturn)
   {
+    UpdateIndex();
     DeleteGroupMembersFromDb({std::make_shared<CPVRChannelGroupMember>(*groupMember)});
     Renumber();
   }
@@ -37,6 +37,7 @@ enum class PVREvent;
 
 class CPVRChannel;
 class CPVRChannelGroupMember;
+class CPVRChannelGroupMemberIndex;
 class CPVRClient;
 class CPVREpgInfoTag;
 
@@ -574,6 +575,18 @@ protected:
    */
   bool UpdateMembersClientPriority();
 
+  /*!
+   * @brief Rebuild the lookup index from the current members. Must be called with the lock held,
+   * after the members were sorted or members were removed.
+   */
+  void UpdateIndex();
+
+  /*!
+   * @brief Get the current lookup index. Does not lock the group.
+   * @return The index, never nullptr.
+   */
+  std::shared_ptr<const CPVRChannelGroupMemberIndex> GetIndex() const;
+
   std::shared_ptr<CPVRChannelGroupSettings> GetSettings() const;
 
   int m_iGroupId = INVALID_GROUP_ID; /*!< The ID of this group in the database */
@@ -588,6 +601,8 @@ protected:
       m_sortedMembers; /*!< members sorted by channel number */
   std::map<std::pair<int, int>, std::shared_ptr<CPVRChannelGroupMember>>
       m_members; /*!< members with key clientid+uniqueid */
+  std::shared_ptr<const CPVRChannelGroupMemberIndex>
+      m_index; /*!< lookup index of the sorted members, only accessed atomically */
   mutable CCriticalSection m_critSection;
   std::vector<int> m_failedClients;
   CEventSource<PVREvent> m_events;
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRChannelGroupMemberIndex.h"
+
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelGroupMember.h"
+#include "pvr/channels/PVRChannelNumber.h"
+
+using namespace PVR;
+
+CPVRChannelGroupMemberIndex::CPVRChannelGroupMemberIndex(
+    const std::vector<std::shared_ptr<CPVRChannelGroupMember>>& sortedMembers,
+    bool useBackendChannelNumbers)
+  : m_sortedMembers(sortedMembers)
+{
+  m_channels.reserve(m_sortedMembers.size());
+  m_positions.reserve(m_sortedMembers.size());
+  m_byChannelNumber.reserve(m_sortedMembers.size());
+  m_byChannelId.reserve(m_sortedMembers.size());
+
+  for (size_t i = 0; i < m_sortedMembers.size(); ++i)
+  {
+    const auto& member = m_sortedMembers[i];
+    m_positions.emplace(member.get(), i);
+
+    // the first member with a number wins, like when searching the sorted members
+    const CPVRChannelNumber& number =
+        useBackendChannelNumbers ? member->ClientChannelNumber() : member->ChannelNumber();
+    m_byChannelNumber.emplace(MakeKey(number.GetChannelNumber(), number.GetSubChannelNumber()),
+                              member);
+
+    const std::shared_ptr<CPVRChannel> channel = member->Channel();
+    m_channels.emplace_back(channel);
+    if (!channel)
+      continue;
+
+    m_byChannelId.emplace(channel->ChannelID(), channel);
+    m_providerCounts[MakeKey(channel->ClientID(), channel->ClientProviderUid())]++;
+    m_clientCounts[channel->ClientID()]++;
+  }
+}
+
+std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroupMemberIndex::GetByChannelNumber(
+    const CPVRChannelNumber& channelNumber) const
+{
+  // the numbers of the members may only be read under the lock of the group, use the copy
+  const auto it = m_byChannelNumber.find(
+      MakeKey(channelNumber.GetChannelNumber(), channelNumber.GetSubChannelNumber()));
+  return it != m_byChannelNumber.end() ? it->second : std::shared_ptr<CPVRChannelGroupMember>();
+}
+
+std::shared_ptr<CPVRChannel> CPVRChannelGroupMemberIndex::GetByChannelID(int channelId) const
+{
+  // channels get their id when they are persisted, which may be after the index was built
+  const auto it = m_byChannelId.find(channelId);
+  if (it == m_byChannelId.end() || it->second->ChannelID() != channelId)
+    return {};
+
+  return it->second;
+}
+
+std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroupMemberIndex::GetNext(
+    const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const
+{
+  return Step(groupMember, true);
+}
+
+std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroupMemberIndex::GetPrevious(
+    const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const
+{
+  return Step(groupMember, false);
+}
+
+std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroupMemberIndex::Step(
+    const std::shared_ptr<const CPVRChannelGroupMember>& groupMember, bool forward) const
+{
+  if (!groupMember)
+    return {};
+
+  const auto it = m_positions.find(groupMember.get());
+  if (it == m_positions.end())
+    return {};
+
+  // skip hidden channels, up to the current member itself
+  const size_t size = m_sortedMembers.size();
+  for (size_t i = 1; i <= size; ++i)
+  {
+    const size_t position = forward ? (it->second + i) % size : (it->second + size - i) % size;
+    const std::shared_ptr<CPVRChannel>& channel = m_channels[position];
+    if (channel && !channel->IsHidden())
+      return m_sortedMembers[position];
+  }
+
+  return {};
+}
+
+unsigned int CPVRChannelGroupMemberIndex::GetChannelCountByProvider(int clientId,
+                                                                    int providerId) const
+{
+  if (providerId == PVR_PROVIDER_INVALID_UID)
+  {
+    const auto it = m_clientCounts.find(clientId);
+    return it != m_clientCounts.end() ? it->second : 0;
+  }
+
+  const auto it = m_providerCounts.find(MakeKey(clientId, providerId));
+  return it != m_providerCounts.end() ? it->second : 0;
+}
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace PVR
+{
+class CPVRChannel;
+class CPVRChannelGroupMember;
+class CPVRChannelNumber;
+
+/*!
+ * @brief Lookup tables for the members of a channel group.
+ *
+ * An index is immutable once built. The group builds a new one whenever its members are sorted
+ * or removed and publishes it atomically, so readers can use the index they got without holding
+ * the lock of the group, while the group goes on changing.
+ *
+ * The index reflects the members when it was built: the channel numbers and the channel of the
+ * members are copied while the group is locked, as members are renumbered under the lock of the
+ * group only. Renumbering always ends with sorting the members, which publishes a new index.
+ * Data of a channel which changes without the group being sorted again, e.g. the hidden state,
+ * has to be checked on the channel itself, whose accessors are locked.
+ */
+class CPVRChannelGroupMemberIndex
+{
+public:
+  /*!
+   * @brief Build the index.
+   * @param sortedMembers The members of the group, sorted.
+   * @param useBackendChannelNumbers Whether the client channel numbers are the active ones.
+   */
+  CPVRChannelGroupMemberIndex(
+      const std::vector<std::shared_ptr<CPVRChannelGroupMember>>& sortedMembers,
+      bool useBackendChannelNumbers);
+
+  size_t Size() const { return m_sortedMembers.size(); }
+
+  /*!
+   * @brief Get the first member with the given active channel number.
+   * @param channelNumber The channel number.
+   * @return The member or nullptr if it wasn't found.
+   */
+  std::shared_ptr<CPVRChannelGroupMember> GetByChannelNumber(
+      const CPVRChannelNumber& channelNumber) const;
+
+  /*!
+   * @brief Get the channel with the given channel database id.
+   * @param channelId The channel id.
+   * @return The channel or nullptr if it wasn't found.
+   */
+  std::shared_ptr<CPVRChannel> GetByChannelID(int channelId) const;
+
+  /*!
+   * @brief Get the next member which has a visible channel, wrapping around at the end.
+   * @param groupMember The current member.
+   * @return The member or nullptr if the current member wasn't found.
+   */
+  std::shared_ptr<CPVRChannelGroupMember> GetNext(
+      const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const;
+
+  /*!
+   * @brief Get the previous member which has a visible channel, wrapping around at the start.
+   * @param groupMember The current member.
+   * @return The member or nullptr if the current member wasn't found.
+   */
+  std::shared_ptr<CPVRChannelGroupMember> GetPrevious(
+      const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const;
+
+  /*!
+   * @brief Get the count of channels offered by the given provider.
+   * @param clientId The client id.
+   * @param providerId The provider uid, PVR_PROVIDER_INVALID_UID for any provider of the client.
+   * @return The count of matching channels.
+   */
+  unsigned int GetChannelCountByProvider(int clientId, int providerId) const;
+
+private:
+  static uint64_t MakeKey(unsigned int high, unsigned int low)
+  {
+    return (static_cast<uint64_t>(high) << 32) | low;
+  }
+
+  std::shared_ptr<CPVRChannelGroupMember> Step(
+      const std::shared_ptr<const CPVRChannelGroupMember>& groupMember, bool forward) const;
+
+  const std::vector<std::shared_ptr<CPVRChannelGroupMember>> m_sortedMembers;
+  std::vector<std::shared_ptr<CPVRChannel>> m_channels; // the channels of the sorted members
+  std::unordered_map<const CPVRChannelGroupMember*, size_t> m_positions;
+  std::unordered_map<uint64_t, std::shared_ptr<CPVRChannelGroupMember>>
+      m_byChannelNumber; // channel number + sub channel number
+  std::unordered_map<int, std::shared_ptr<CPVRChannel>> m_byChannelId;
+  std::unordered_map<uint64_t, unsigned int> m_providerCounts; // client id + provider uid
+  std::unordered_map<int, unsigned int> m_clientCounts; // client id
+};
+} // namespace PVR
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelGroupMember.h"
+#include "pvr/channels/PVRChannelGroupMemberIndex.h"
+#include "pvr/channels/PVRChannelNumber.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+std::shared_ptr<CPVRChannelGroupMember> CreateMember(unsigned int uid,
+                                                     unsigned int number,
+                                                     int providerUid,
+                                                     bool hidden = false)
+{
+  PVR_CHANNEL data{};
+  data.iUniqueId = uid;
+  data.iChannelNumber = number;
+  data.strChannelName = "channel";
+  data.bIsHidden = hidden;
+  data.iClientProviderUid = providerUid;
+
+  // no channel id, setting it creates the EPG of the channel, which needs the PVR manager
+  const auto channel = std::make_shared<CPVRChannel>(data, 1);
+
+  // not constructed from the channel, which would look up the client to build the path
+  auto member = std::make_shared<CPVRChannelGroupMember>();
+  member->SetChannel(channel);
+  member->SetClientChannelNumber(channel->ClientChannelNumber());
+  member->SetChannelNumber(CPVRChannelNumber(number, 0));
+  return member;
+}
+} // unnamed namespace
+
+TEST(TestPVRChannelGroupMemberIndex, Navigation)
+{
+  const std::vector<std::shared_ptr<CPVRChannelGroupMember>> members{
+      CreateMember(1, 1, 10), CreateMember(2, 2, 10, true), CreateMember(3, 3, 20)};
+  const CPVRChannelGroupMemberIndex index(members, false);
+
+  // hidden channels are skipped, navigation wraps around
+  EXPECT_EQ(members[2], index.GetNext(members[0]));
+  EXPECT_EQ(members[0], index.GetNext(members[2]));
+  EXPECT_EQ(members[2], index.GetPrevious(members[0]));
+  EXPECT_EQ(members[0], index.GetPrevious(members[2]));
+
+  // the channel of the current member may be hidden after the index was built
+  members[2]->Channel()->SetHidden(true);
+  EXPECT_EQ(members[0], index.GetNext(members[0]));
+
+  EXPECT_EQ(nullptr, index.GetNext(CreateMember(4, 4, 10)));
+  EXPECT_EQ(nullptr, index.GetNext(nullptr));
+}
+
+TEST(TestPVRChannelGroupMemberIndex, Lookup)
+{
+  const std::vector<std::shared_ptr<CPVRChannelGroupMember>> members{
+      CreateMember(1, 1, 10), CreateMember(2, 2, 10), CreateMember(3, 3, PVR_PROVIDER_INVALID_UID)};
+  const CPVRChannelGroupMemberIndex index(members, false);
+
+  EXPECT_EQ(members[1], index.GetByChannelNumber(CPVRChannelNumber(2, 0)));
+  EXPECT_EQ(nullptr, index.GetByChannelNumber(CPVRChannelNumber(2, 1)));
+  EXPECT_EQ(nullptr, index.GetByChannelID(103));
+
+  EXPECT_EQ(2u, index.GetChannelCountByProvider(1, 10));
+  EXPECT_EQ(0u, index.GetChannelCountByProvider(1, 20));
+  EXPECT_EQ(3u, index.GetChannelCountByProvider(1, PVR_PROVIDER_INVALID_UID));
+  EXPECT_EQ(0u, index.GetChannelCountByProvider(2, PVR_PROVIDER_INVALID_UID));
+
+  // an index keeps the numbers it was built with, renumbering publishes a new one
+  members[1]->SetChannelNumber(CPVRChannelNumber(5, 0));
+  EXPECT_EQ(members[1], index.GetByChannelNumber(CPVRChannelNumber(2, 0)));
+  EXPECT_EQ(nullptr, index.GetByChannelNumber(CPVRChannelNumber(5, 0)));
+
+  const CPVRChannelGroupMemberIndex renumbered(members, false);
+  EXPECT_EQ(nullptr, renumbered.GetByChannelNumber(CPVRChannelNumber(2, 0)));
+  EXPECT_EQ(members[1], renumbered.GetByChannelNumber(CPVRChannelNumber(5, 0)));
+}
+
+TEST(TestPVRChannelGroupMemberIndex, BackendChannelNumbers)
+{
+  const std::vector<std::shared_ptr<CPVRChannelGroupMember>> members{CreateMember(1, 7, 10),
+                                                                      CreateMember(2, 8, 10)};
+  members[0]->SetChannelNumber(CPVRChannelNumber(1, 0));
+  members[1]->SetChannelNumber(CPVRChannelNumber(2, 0));
+  const CPVRChannelGroupMemberIndex index(members, true);
+
+  EXPECT_EQ(members[1], index.GetByChannelNumber(CPVRChannelNumber(8, 0)));
+  EXPECT_EQ(nullptr, index.GetByChannelNumber(CPVRChannelNumber(2, 0)));
+}
@@ -29,15 +29,57 @@
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace PVR;
 
 using namespace std::chrono_literals;
 
+namespace
+{
+void HashCombine(size_t& hash, size_t value)
+{
+  hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+void HashCombine(size_t& hash, const char* str)
+{
+  HashCombine(hash, std::hash<std::string_view>{}(str ? str : ""));
+}
+
+size_t GetClientDataHash(const PVR_RECORDING& recording)
+{
+  size_t hash = 0;
+  for (const char* str :
+       {recording.strRecordingId, recording.strTitle, recording.strTitleExtraInfo,
+        recording.strEpisodeName, recording.strDirectory, recording.strPlotOutline,
+        recording.strPlot, recording.strGenreDescription, recording.strChannelName,
+        recording.strIconPath, recording.strThumbnailPath, recording.strFanartPath,
+        recording.strFirstAired, recording.strProviderName, recording.strParentalRatingCode,
+        recording.strParentalRatingIcon, recording.strParentalRatingSource})
+    HashCombine(hash, str);
+
+  for (const int64_t value :
+       {int64_t{recording.iSeriesNumber}, int64_t{recording.iEpisodeNumber},
+        int64_t{recording.iEpisodePartNumber}, int64_t{recording.iYear},
+        static_cast<int64_t>(recording.recordingTime), int64_t{recording.iDuration},
+        int64_t{recording.iPriority}, int64_t{recording.iLifetime}, int64_t{recording.iGenreType},
+        int64_t{recording.iGenreSubType}, int64_t{recording.iPlayCount},
+        int64_t{recording.iLastPlayedPosition}, int64_t{recording.bIsDeleted},
+        int64_t{recording.iEpgEventId}, int64_t{recording.iChannelUid},
+        int64_t{recording.channelType}, int64_t{recording.iFlags}, recording.sizeInBytes,
+        int64_t{recording.iClientProviderUid}, int64_t{recording.iParentalRating}})
+    HashCombine(hash, std::hash<int64_t>{}(value));
+
+  return hash;
+}
+} // unnamed namespace
+
 CPVRRecordingUid::CPVRRecordingUid(int iClientId, const std::string& strRecordingId)
   : m_iClientId(iClientId), m_strRecordingId(strRecordingId)
 {
@@ -170,6 +212,10 @@ CPVRRecording::CPVRRecording(const PVR_RECORDING& recording, unsigned int iClien
   }
 
   UpdatePath();
+
+  // the channel type may be taken from the channel, which is not part of the client's data
+  m_clientDataHash = GetClientDataHash(recording);
+  HashCombine(m_clientDataHash, std::hash<bool>{}(m_bRadio));
 }
 
 bool CPVRRecording::operator==(const CPVRRecording& right) const
@@ -478,6 +524,7 @@ void CPVRRecording::Update(const CPVRRecording& tag, const CPVRClient& client)
   m_bRadio = tag.m_bRadio;
   m_firstAired = tag.m_firstAired;
   m_iFlags = tag.m_iFlags;
+  m_clientDataHash = tag.m_clientDataHash;
   {
     std::unique_lock<CCriticalSection> lock(m_critSection);
     m_sizeInBytes = tag.m_sizeInBytes;
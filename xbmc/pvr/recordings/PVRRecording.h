@@ -482,6 +482,12 @@ public:
    */
   bool IsDirty() const { return m_bDirty; }
 
+  /*!
+   * @brief Get the hash of the data the client delivered for this recording.
+   * @return The hash, 0 if the recording was not created from client data.
+   */
+  size_t ClientDataHash() const { return m_clientDataHash; }
+
   /*!
    * @brief Get the uid of the provider on the client which this recording is from
    * @return the client uid of the provider or PVR_PROVIDER_INVALID_UID
@@ -582,6 +588,7 @@ private:
   mutable XbmcThreads::EndTime<> m_recordingSizeRefetchTimeout;
   int64_t m_sizeInBytes = 0; /*!< the size of the recording in bytes */
   bool m_bDirty = false;
+  size_t m_clientDataHash = 0; /*!< hash of the data delivered by the client */
   std::string m_strProviderName; /*!< name of the provider this recording is from */
   int m_iClientProviderUid =
       PVR_PROVIDER_INVALID_UID; /*!< provider uid associated with this recording on the client */
@@ -45,6 +45,7 @@ bool CPVRRecordings::UpdateFromClients(const std::vector<std::shared_ptr<CPVRCli
     return false;
 
   m_bIsUpdating = true;
+  m_syncStats = {};
 
   for (const auto& recording : m_recordings)
     recording.second->SetDirty(true);
@@ -58,13 +59,23 @@ bool CPVRRecordings::UpdateFromClients(const std::vector<std::shared_ptr<CPVRCli
   {
     if ((*it).second->IsDirty() && std::find(failedClients.begin(), failedClients.end(),
                                              (*it).second->ClientID()) == failedClients.end())
+    {
       it = m_recordings.erase(it);
+      ++m_syncStats.removed;
+    }
     else
       ++it;
   }
 
   m_bIsUpdating = false;
-  CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
+
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Recordings synced: {} added, {} changed, {} removed, {} unchanged",
+              m_syncStats.added, m_syncStats.changed, m_syncStats.removed,
+              m_syncStats.unchanged);
+
+  if (m_syncStats.HasChanges())
+    CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
+
   return true;
 }
 
@@ -234,7 +245,17 @@ void CPVRRecordings::UpdateFromClient(const std::shared_ptr<CPVRRecording>& tag,
   std::shared_ptr<CPVRRecording> existingTag = GetById(tag->ClientID(), tag->ClientRecordingID());
   if (existingTag)
   {
-    existingTag->Update(*tag, client);
+    // most recordings don't change between two updates; skip merging the data of those
+    if (existingTag->ClientDataHash() == 0 ||
+        existingTag->ClientDataHash() != tag->ClientDataHash())
+    {
+      existingTag->Update(*tag, client);
+      ++m_syncStats.changed;
+    }
+    else
+    {
+      ++m_syncStats.unchanged;
+    }
     existingTag->SetDirty(false);
   }
   else
@@ -246,9 +267,16 @@ void CPVRRecordings::UpdateFromClient(const std::shared_ptr<CPVRRecording>& tag,
       ++m_iRadioRecordings;
     else
       ++m_iTVRecordings;
+    ++m_syncStats.added;
   }
 }
 
+PVRSyncStats CPVRRecordings::GetLastSyncStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_syncStats;
+}
+
 std::shared_ptr<CPVRRecording> CPVRRecordings::GetRecordingForEpgTag(
     const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
 {
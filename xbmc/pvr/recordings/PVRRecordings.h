@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "pvr/PVRSyncStats.h"
 #include "threads/CriticalSection.h"
 
 #include <map>
@@ -57,6 +58,12 @@ public:
    */
   void UpdateFromClient(const std::shared_ptr<CPVRRecording>& tag, const CPVRClient& client);
 
+  /*!
+   * @brief Get the entries touched by the last update from the clients.
+   * @return The counters of the added, changed, removed and unchanged recordings.
+   */
+  PVRSyncStats GetLastSyncStats() const;
+
   /*!
    * @brief refresh the size of any in progress recordings from the clients.
    */
@@ -175,5 +182,6 @@ private:
   bool m_bDeletedRadioRecordings = false;
   unsigned int m_iTVRecordings = 0;
   unsigned int m_iRadioRecordings = 0;
+  PVRSyncStats m_syncStats;
 };
 } // namespace PVR
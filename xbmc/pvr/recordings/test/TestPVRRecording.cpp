@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_recordings.h"
+#include "pvr/recordings/PVRRecording.h"
+
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+PVR_RECORDING CreateRecording()
+{
+  PVR_RECORDING recording{};
+  recording.strRecordingId = "42";
+  recording.strTitle = "Title";
+  recording.strTitleExtraInfo = "Extra";
+  recording.iSeriesNumber = 1;
+  recording.iEpisodeNumber = 2;
+  recording.iEpisodePartNumber = 1;
+  recording.strEpisodeName = "Episode";
+  recording.iYear = 2020;
+  recording.strDirectory = "/dir";
+  recording.strPlotOutline = "Outline";
+  recording.strPlot = "Plot";
+  recording.strGenreDescription = "Genre";
+  recording.strChannelName = "Channel";
+  recording.strIconPath = "icon.png";
+  recording.strThumbnailPath = "thumb.png";
+  recording.strFanartPath = "fanart.png";
+  recording.recordingTime = 1700000000;
+  recording.iDuration = 3600;
+  recording.iPriority = 50;
+  recording.iLifetime = 99;
+  recording.iGenreType = 0x10;
+  recording.iGenreSubType = 1;
+  recording.iPlayCount = 0;
+  recording.iLastPlayedPosition = 60;
+  recording.bIsDeleted = false;
+  recording.iEpgEventId = 7;
+  recording.iChannelUid = 3;
+  // a channel type, so the channel isn't looked up
+  recording.channelType = PVR_RECORDING_CHANNEL_TYPE_TV;
+  recording.strFirstAired = "2020-01-01";
+  recording.iFlags = 0;
+  recording.sizeInBytes = 1000000;
+  recording.iClientProviderUid = 5;
+  recording.strProviderName = "Provider";
+  recording.iParentalRating = 12;
+  recording.strParentalRatingCode = "FSK12";
+  recording.strParentalRatingIcon = "fsk12.png";
+  recording.strParentalRatingSource = "FSK";
+  return recording;
+}
+} // unnamed namespace
+
+TEST(TestPVRRecording, ClientDataHash)
+{
+  const PVR_RECORDING data = CreateRecording();
+  const size_t hash = CPVRRecording(data, 1).ClientDataHash();
+  EXPECT_NE(0u, hash);
+  EXPECT_EQ(hash, CPVRRecording(data, 1).ClientDataHash());
+
+  // recordings not delivered by a client are always merged
+  EXPECT_EQ(0u, CPVRRecording().ClientDataHash());
+
+  // any field delivered by the client changes the hash
+  const std::vector<std::function<void(PVR_RECORDING&)>> changes{
+      [](PVR_RECORDING& r) { r.strRecordingId = "43"; },
+      [](PVR_RECORDING& r) { r.strTitle = "Other"; },
+      [](PVR_RECORDING& r) { r.strTitleExtraInfo = nullptr; },
+      [](PVR_RECORDING& r) { r.iSeriesNumber = 2; },
+      [](PVR_RECORDING& r) { r.iEpisodeNumber = 3; },
+      [](PVR_RECORDING& r) { r.iEpisodePartNumber = 2; },
+      [](PVR_RECORDING& r) { r.strEpisodeName = "Other"; },
+      [](PVR_RECORDING& r) { r.iYear = 2021; },
+      [](PVR_RECORDING& r) { r.strDirectory = "/other"; },
+      [](PVR_RECORDING& r) { r.strPlotOutline = "Other"; },
+      [](PVR_RECORDING& r) { r.strPlot = "Other"; },
+      [](PVR_RECORDING& r) { r.strGenreDescription = "Other"; },
+      [](PVR_RECORDING& r) { r.strChannelName = "Other"; },
+      [](PVR_RECORDING& r) { r.strIconPath = "other.png"; },
+      [](PVR_RECORDING& r) { r.strThumbnailPath = "other.png"; },
+      [](PVR_RECORDING& r) { r.strFanartPath = "other.png"; },
+      [](PVR_RECORDING& r) { r.recordingTime += 60; },
+      [](PVR_RECORDING& r) { r.iDuration = 3601; },
+      [](PVR_RECORDING& r) { r.iPriority = 51; },
+      [](PVR_RECORDING& r) { r.iLifetime = 98; },
+      [](PVR_RECORDING& r) { r.iGenreType = 0x20; },
+      [](PVR_RECORDING& r) { r.iGenreSubType = 2; },
+      [](PVR_RECORDING& r) { r.iPlayCount = 1; },
+      [](PVR_RECORDING& r) { r.iLastPlayedPosition = 61; },
+      [](PVR_RECORDING& r) { r.bIsDeleted = true; },
+      [](PVR_RECORDING& r) { r.iEpgEventId = 8; },
+      [](PVR_RECORDING& r) { r.iChannelUid = 4; },
+      [](PVR_RECORDING& r) { r.channelType = PVR_RECORDING_CHANNEL_TYPE_RADIO; },
+      [](PVR_RECORDING& r) { r.strFirstAired = "2020-01-02"; },
+      [](PVR_RECORDING& r) { r.iFlags = PVR_RECORDING_FLAG_IS_SERIES; },
+      [](PVR_RECORDING& r) { r.sizeInBytes = 1000001; },
+      [](PVR_RECORDING& r) { r.iClientProviderUid = 6; },
+      [](PVR_RECORDING& r) { r.strProviderName = "Other"; },
+      [](PVR_RECORDING& r) { r.iParentalRating = 16; },
+      [](PVR_RECORDING& r) { r.strParentalRatingCode = "FSK16"; },
+      [](PVR_RECORDING& r) { r.strParentalRatingIcon = "fsk16.png"; },
+      [](PVR_RECORDING& r) { r.strParentalRatingSource = "Other"; },
+  };
+
+  for (size_t i = 0; i < changes.size(); ++i)
+  {
+    PVR_RECORDING changed = data;
+    changes[i](changed);
+    EXPECT_NE(hash, CPVRRecording(changed, 1).ClientDataHash()) << "change " << i;
+  }
+}
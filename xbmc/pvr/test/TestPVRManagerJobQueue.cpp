@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/PVRManagerJobQueue.h"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr auto DELAY = 500ms;
+
+class CJobCounter
+{
+public:
+  void Append(CPVRManagerJobQueue& queue, const std::string& type, std::chrono::milliseconds delay)
+  {
+    queue.Append(type, [this]() { ++m_runs; }, delay);
+  }
+
+  int Runs() const { return m_runs; }
+
+private:
+  int m_runs = 0;
+};
+} // unnamed namespace
+
+TEST(TestPVRManagerJobQueue, DelayedJobsCoalesce)
+{
+  CPVRManagerJobQueue queue;
+  queue.Start();
+  CJobCounter timers;
+  CJobCounter channels;
+
+  // a burst of triggers, like a client scheduling the timers of a series
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i)
+    timers.Append(queue, "pvr-update-timers-1", DELAY);
+  channels.Append(queue, "pvr-update-channels-1", 0ms);
+
+  // jobs which are not delayed don't wait for the delayed ones
+  queue.ExecutePendingJobs();
+  EXPECT_EQ(1, channels.Runs());
+  EXPECT_EQ(0, timers.Runs());
+
+  // later triggers within the window are merged into the pending job
+  timers.Append(queue, "pvr-update-timers-1", DELAY);
+  queue.ExecutePendingJobs();
+  EXPECT_EQ(0, timers.Runs());
+
+  // like the PVR manager thread, which waits until the delayed job is due
+  while (timers.Runs() == 0 && std::chrono::steady_clock::now() - start < 10 * DELAY)
+  {
+    queue.WaitForJobs(1000);
+    queue.ExecutePendingJobs();
+  }
+  EXPECT_EQ(1, timers.Runs());
+  EXPECT_GE(std::chrono::steady_clock::now() - start, DELAY);
+
+  // a trigger after the job ran starts a new window
+  timers.Append(queue, "pvr-update-timers-1", DELAY);
+  queue.ExecutePendingJobs();
+  EXPECT_EQ(1, timers.Runs());
+
+  queue.Clear();
+  queue.ExecutePendingJobs();
+  EXPECT_EQ(1, timers.Runs());
+}
+
+TEST(TestPVRManagerJobQueue, WaitForDelayedJob)
+{
+  CPVRManagerJobQueue queue;
+  queue.Start();
+  CJobCounter counter;
+
+  const auto start = std::chrono::steady_clock::now();
+  counter.Append(queue, "pvr-update-recordings-1", DELAY);
+  queue.ExecutePendingJobs();
+  EXPECT_EQ(0, counter.Runs());
+
+  // the wait ends when the job is due, so a single wait is enough to run it
+  queue.WaitForJobs(5000);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, DELAY);
+
+  queue.ExecutePendingJobs();
+  EXPECT_EQ(1, counter.Runs());
+  queue.Clear();
+}
@@ -33,6 +33,7 @@
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 
 using namespace PVR;
 
@@ -594,45 +595,11 @@ bool CPVRTimerInfoTag::UpdateEntry(const std::shared_ptr<const CPVRTimerInfoTag>
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
-  m_iClientId = tag->m_iClientId;
-  m_iClientIndex = tag->m_iClientIndex;
-  m_iParentClientIndex = tag->m_iParentClientIndex;
-  m_strTitle = tag->m_strTitle;
-  m_strEpgSearchString = tag->m_strEpgSearchString;
-  m_bFullTextEpgSearch = tag->m_bFullTextEpgSearch;
-  m_strDirectory = tag->m_strDirectory;
-  m_iClientChannelUid = tag->m_iClientChannelUid;
-  m_StartTime = tag->m_StartTime;
-  m_StopTime = tag->m_StopTime;
-  m_bStartAnyTime = tag->m_bStartAnyTime;
-  m_bEndAnyTime = tag->m_bEndAnyTime;
-  m_FirstDay = tag->m_FirstDay;
-  m_iPriority = tag->m_iPriority;
-  m_iLifetime = tag->m_iLifetime;
-  m_iMaxRecordings = tag->m_iMaxRecordings;
-  m_state = tag->m_state;
-  m_iPreventDupEpisodes = tag->m_iPreventDupEpisodes;
-  m_iRecordingGroup = tag->m_iRecordingGroup;
-  m_iWeekdays = tag->m_iWeekdays;
-  m_bIsRadio = tag->m_bIsRadio;
-  m_iMarginStart = tag->m_iMarginStart;
-  m_iMarginEnd = tag->m_iMarginEnd;
-  m_strSeriesLink = tag->m_strSeriesLink;
-  m_iEpgUid = tag->m_iEpgUid;
-  m_epgTag = tag->m_epgTag;
+  const auto copy = [this, &tag](auto... members)
+  { ((this->*members = tag.get()->*members), ...); };
+  std::apply(copy, ClientDataMembers());
+  std::apply(copy, DerivedDataMembers());
   m_strSummary = tag->m_strSummary;
-  m_channel = tag->m_channel;
-  m_bProbedEpgTag = tag->m_bProbedEpgTag;
-  m_customProps = tag->m_customProps;
-
-  m_iTVChildTimersActive = tag->m_iTVChildTimersActive;
-  m_iTVChildTimersConflictNOK = tag->m_iTVChildTimersConflictNOK;
-  m_iTVChildTimersRecording = tag->m_iTVChildTimersRecording;
-  m_iTVChildTimersErrors = tag->m_iTVChildTimersErrors;
-  m_iRadioChildTimersActive = tag->m_iRadioChildTimersActive;
-  m_iRadioChildTimersConflictNOK = tag->m_iRadioChildTimersConflictNOK;
-  m_iRadioChildTimersRecording = tag->m_iRadioChildTimersRecording;
-  m_iRadioChildTimersErrors = tag->m_iRadioChildTimersErrors;
 
   SetTimerType(tag->m_timerType);
 
@@ -644,6 +611,21 @@ bool CPVRTimerInfoTag::UpdateEntry(const std::shared_ptr<const CPVRTimerInfoTag>
   return true;
 }
 
+bool CPVRTimerInfoTag::HasSameClientData(const CPVRTimerInfoTag& tag) const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  bool bTypesMatch = m_timerType == tag.m_timerType;
+  if (!bTypesMatch && m_timerType && tag.m_timerType)
+    bTypesMatch = *m_timerType == *tag.m_timerType;
+
+  // a summary not given by the client is generated from the other data
+  return bTypesMatch && (tag.m_strSummary.empty() || m_strSummary == tag.m_strSummary) &&
+         std::apply([this, &tag](auto... members)
+                    { return ((this->*members == tag.*members) && ...); },
+                    ClientDataMembers());
+}
+
 bool CPVRTimerInfoTag::UpdateChildState(const std::shared_ptr<const CPVRTimerInfoTag>& childTimer,
                                         bool bAdd)
 {
@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 
 struct PVR_TIMER;
 
@@ -38,6 +39,8 @@ class CPVRTimerInfoTag final : public ISerializable
   // allow these classes direct access to members as they act as timer tag instance factories.
   friend class CGUIDialogPVRTimerSettings;
   friend class CPVRDatabase;
+  // checks the lists of members merged by UpdateEntry
+  friend class TestPVRTimerInfoTagHelper;
 
 public:
   explicit CPVRTimerInfoTag(bool bRadio = false);
@@ -137,6 +140,14 @@ public:
    */
   bool UpdateEntry(const std::shared_ptr<const CPVRTimerInfoTag>& tag);
 
+  /*!
+   * @brief check whether merging the given timer into this timer would change this timer.
+   * @param tag The timer to compare with, usually a timer just delivered by the client.
+   * @return true if the data of both timers is equal, ignoring the local timer id and the data
+   * derived from the other timers and the EPG, like the state of any children.
+   */
+  bool HasSameClientData(const CPVRTimerInfoTag& tag) const;
+
   /*!
    * @brief merge in the state of this child timer.
    * @param childTimer The child timer
@@ -634,6 +645,45 @@ private:
   std::string GetWeekdaysString() const;
   void UpdateEpgInfoTag();
 
+  /*!
+   * @brief The members holding data delivered by the client. UpdateEntry copies them and
+   * HasSameClientData compares them. The summary and the timer type are handled on their own.
+   */
+  static constexpr auto ClientDataMembers()
+  {
+    return std::make_tuple(
+        &CPVRTimerInfoTag::m_iClientId, &CPVRTimerInfoTag::m_iClientIndex,
+        &CPVRTimerInfoTag::m_iParentClientIndex, &CPVRTimerInfoTag::m_strTitle,
+        &CPVRTimerInfoTag::m_strEpgSearchString, &CPVRTimerInfoTag::m_bFullTextEpgSearch,
+        &CPVRTimerInfoTag::m_strDirectory, &CPVRTimerInfoTag::m_iClientChannelUid,
+        &CPVRTimerInfoTag::m_StartTime, &CPVRTimerInfoTag::m_StopTime,
+        &CPVRTimerInfoTag::m_bStartAnyTime, &CPVRTimerInfoTag::m_bEndAnyTime,
+        &CPVRTimerInfoTag::m_FirstDay, &CPVRTimerInfoTag::m_iPriority,
+        &CPVRTimerInfoTag::m_iLifetime, &CPVRTimerInfoTag::m_iMaxRecordings,
+        &CPVRTimerInfoTag::m_state, &CPVRTimerInfoTag::m_iPreventDupEpisodes,
+        &CPVRTimerInfoTag::m_iRecordingGroup, &CPVRTimerInfoTag::m_iWeekdays,
+        &CPVRTimerInfoTag::m_bIsRadio, &CPVRTimerInfoTag::m_iMarginStart,
+        &CPVRTimerInfoTag::m_iMarginEnd, &CPVRTimerInfoTag::m_strSeriesLink,
+        &CPVRTimerInfoTag::m_iEpgUid, &CPVRTimerInfoTag::m_customProps);
+  }
+
+  /*!
+   * @brief The members UpdateEntry copies as well, which are derived from the other timers and the
+   * EPG rather than delivered by the client.
+   */
+  static constexpr auto DerivedDataMembers()
+  {
+    return std::make_tuple(
+        &CPVRTimerInfoTag::m_epgTag, &CPVRTimerInfoTag::m_channel,
+        &CPVRTimerInfoTag::m_bProbedEpgTag, &CPVRTimerInfoTag::m_iTVChildTimersActive,
+        &CPVRTimerInfoTag::m_iTVChildTimersConflictNOK,
+        &CPVRTimerInfoTag::m_iTVChildTimersRecording, &CPVRTimerInfoTag::m_iTVChildTimersErrors,
+        &CPVRTimerInfoTag::m_iRadioChildTimersActive,
+        &CPVRTimerInfoTag::m_iRadioChildTimersConflictNOK,
+        &CPVRTimerInfoTag::m_iRadioChildTimersRecording,
+        &CPVRTimerInfoTag::m_iRadioChildTimersErrors);
+  }
+
   static std::shared_ptr<CPVRTimerInfoTag> CreateFromDate(
       const std::shared_ptr<CPVRChannel>& channel,
       const CDateTime& start,
@@ -74,9 +74,20 @@ CDateTime CPVRTimerRuleMatcher::GetNextTimerStart() const
 
 bool CPVRTimerRuleMatcher::Matches(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
 {
-  return epgTag && CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->EndAsUTC()) > m_start &&
-         MatchSeriesLink(epgTag) && MatchChannel(epgTag) && MatchStart(epgTag) &&
-         MatchEnd(epgTag) && MatchDayOfWeek(epgTag) && MatchSearchText(epgTag);
+  return epgTag &&
+         MatchesExceptSearchText(epgTag,
+                                 CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC()),
+                                 CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->EndAsUTC())) &&
+         MatchSearchText(epgTag);
+}
+
+bool CPVRTimerRuleMatcher::MatchesExceptSearchText(
+    const std::shared_ptr<const CPVREpgInfoTag>& epgTag,
+    const CDateTime& startLocal,
+    const CDateTime& endLocal) const
+{
+  return endLocal > m_start && MatchSeriesLink(epgTag) && MatchChannel(epgTag) &&
+         MatchStart(startLocal) && MatchEnd(endLocal) && MatchDayOfWeek(startLocal);
 }
 
 bool CPVRTimerRuleMatcher::MatchSeriesLink(
@@ -104,12 +115,11 @@ bool CPVRTimerRuleMatcher::MatchChannel(const std::shared_ptr<const CPVREpgInfoT
     return true;
 }
 
-bool CPVRTimerRuleMatcher::MatchStart(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
+bool CPVRTimerRuleMatcher::MatchStart(const CDateTime& startEpgLocal) const
 {
   if (m_timerRule->GetTimerType()->SupportsFirstDay())
   {
     // only year, month and day do matter here...
-    const CDateTime startEpgLocal = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC());
     const CDateTime startEpg(startEpgLocal.GetYear(), startEpgLocal.GetMonth(),
                              startEpgLocal.GetDay(), 0, 0, 0);
     const CDateTime firstDayLocal = m_timerRule->FirstDayAsLocalTime();
@@ -125,7 +135,6 @@ bool CPVRTimerRuleMatcher::MatchStart(const std::shared_ptr<const CPVREpgInfoTag
   if (m_timerRule->GetTimerType()->SupportsStartTime())
   {
     // only hours and minutes do matter here...
-    const CDateTime startEpgLocal = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC());
     const CDateTime startEpg(2000, 1, 1, startEpgLocal.GetHour(), startEpgLocal.GetMinute(), 0);
     const CDateTime startTimerLocal = m_timerRule->StartAsLocalTime();
     const CDateTime startTimer(2000, 1, 1, startTimerLocal.GetHour(), startTimerLocal.GetMinute(),
@@ -136,7 +145,7 @@ bool CPVRTimerRuleMatcher::MatchStart(const std::shared_ptr<const CPVREpgInfoTag
     return true;
 }
 
-bool CPVRTimerRuleMatcher::MatchEnd(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
+bool CPVRTimerRuleMatcher::MatchEnd(const CDateTime& endEpgLocal) const
 {
   if (m_timerRule->GetTimerType()->SupportsEndAnyTime() && m_timerRule->IsEndAnyTime())
     return true; // matches any end time
@@ -144,7 +153,6 @@ bool CPVRTimerRuleMatcher::MatchEnd(const std::shared_ptr<const CPVREpgInfoTag>&
   if (m_timerRule->GetTimerType()->SupportsEndTime())
   {
     // only hours and minutes do matter here...
-    const CDateTime endEpgLocal = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->EndAsUTC());
     const CDateTime endEpg(2000, 1, 1, endEpgLocal.GetHour(), endEpgLocal.GetMinute(), 0);
     const CDateTime endTimerLocal = m_timerRule->EndAsLocalTime();
     const CDateTime endTimer(2000, 1, 1, endTimerLocal.GetHour(), endTimerLocal.GetMinute(), 0);
@@ -154,13 +162,12 @@ bool CPVRTimerRuleMatcher::MatchEnd(const std::shared_ptr<const CPVREpgInfoTag>&
     return true;
 }
 
-bool CPVRTimerRuleMatcher::MatchDayOfWeek(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
+bool CPVRTimerRuleMatcher::MatchDayOfWeek(const CDateTime& startEpgLocal) const
 {
   if (m_timerRule->GetTimerType()->SupportsWeekdays())
   {
     if (m_timerRule->WeekDays() != PVR_WEEKDAY_ALLDAYS)
     {
-      const CDateTime startEpgLocal = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC());
       int startWeekday = startEpgLocal.GetDayOfWeek();
       if (startWeekday == 0)
         startWeekday = 7;
@@ -171,30 +178,34 @@ bool CPVRTimerRuleMatcher::MatchDayOfWeek(const std::shared_ptr<const CPVREpgInf
   return true;
 }
 
+CPVRTimerRuleMatcher::SearchScope CPVRTimerRuleMatcher::GetSearchScope() const
+{
+  if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() && m_timerRule->IsFullTextEpgSearch())
+    return SearchScope::FULLTEXT;
+  else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
+    return SearchScope::TITLE;
+  else
+    return SearchScope::NONE;
+}
+
 bool CPVRTimerRuleMatcher::MatchSearchText(
     const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
 {
-  if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() && m_timerRule->IsFullTextEpgSearch())
+  const SearchScope scope = GetSearchScope();
+  if (scope == SearchScope::NONE)
+    return true;
+
+  if (!m_textSearch)
   {
-    if (!m_textSearch)
-    {
-      m_textSearch = std::make_unique<CRegExp>(true /* case insensitive */);
-      m_textSearch->RegComp(m_timerRule->EpgSearchString());
-    }
+    m_textSearch = std::make_unique<CRegExp>(true /* case insensitive */);
+    m_textSearch->RegComp(m_timerRule->EpgSearchString());
+  }
+
+  if (scope == SearchScope::FULLTEXT)
     return m_textSearch->RegFind(epgTag->Title()) >= 0 ||
            m_textSearch->RegFind(epgTag->EpisodeName()) >= 0 ||
            m_textSearch->RegFind(epgTag->PlotOutline()) >= 0 ||
            m_textSearch->RegFind(epgTag->Plot()) >= 0;
-  }
-  else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
-  {
-    if (!m_textSearch)
-    {
-      m_textSearch = std::make_unique<CRegExp>(true /* case insensitive */);
-      m_textSearch->RegComp(m_timerRule->EpgSearchString());
-    }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0;
-  }
-  else
-    return true;
+
+  return m_textSearch->RegFind(epgTag->Title()) >= 0;
 }
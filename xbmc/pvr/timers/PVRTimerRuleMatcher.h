@@ -32,13 +32,38 @@ public:
   CDateTime GetNextTimerStart() const;
   bool Matches(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
 
+  /*!
+   * @brief Check whether an EPG tag matches the rule, not looking at the search text.
+   * @param epgTag The tag.
+   * @param startLocal The start of the tag, as local time.
+   * @param endLocal The end of the tag, as local time.
+   * @return True if the tag matches, false otherwise.
+   */
+  bool MatchesExceptSearchText(const std::shared_ptr<const CPVREpgInfoTag>& epgTag,
+                               const CDateTime& startLocal,
+                               const CDateTime& endLocal) const;
+
+  enum class SearchScope
+  {
+    NONE, // no search text, every tag matches
+    TITLE, // the search text has to be found in the title
+    FULLTEXT // the search text has to be found in the title, episode name or plot
+  };
+
+  /*!
+   * @brief Get which texts of an EPG tag the search text of the rule has to be found in.
+   * @return The scope.
+   */
+  SearchScope GetSearchScope() const;
+
+  bool MatchSearchText(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
+
 private:
   bool MatchSeriesLink(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
   bool MatchChannel(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
-  bool MatchStart(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
-  bool MatchEnd(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
-  bool MatchDayOfWeek(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
-  bool MatchSearchText(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
+  bool MatchStart(const CDateTime& startLocal) const;
+  bool MatchEnd(const CDateTime& endLocal) const;
+  bool MatchDayOfWeek(const CDateTime& startLocal) const;
 
   const std::shared_ptr<CPVRTimerInfoTag> m_timerRule;
   CDateTime m_start;
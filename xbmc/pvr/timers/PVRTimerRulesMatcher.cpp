@@ -0,0 +1,278 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRTimerRulesMatcher.h"
+
+#include "XBDateTime.h"
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_channels.h" // PVR_CHANNEL_INVALID_UID
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/timers/PVRTimerInfoTag.h"
+#include "pvr/timers/PVRTimerRuleMatcher.h"
+#include "pvr/timers/PVRTimerType.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <ctime>
+#include <deque>
+#include <functional>
+
+using namespace PVR;
+
+namespace
+{
+uint8_t FoldCase(char c)
+{
+  return static_cast<uint8_t>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+}
+
+void HashCombine(size_t& hash, size_t value)
+{
+  hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+} // unnamed namespace
+
+CPVRTimerRuleLiterals::CPVRTimerRuleLiterals() : m_states(1)
+{
+}
+
+size_t CPVRTimerRuleLiterals::Add(const std::string& literal)
+{
+  int state = 0;
+  for (const char c : literal)
+  {
+    const uint8_t character = FoldCase(c);
+    int child = Child(state, character);
+    if (child == 0)
+    {
+      child = static_cast<int>(m_states.size());
+      auto& next = m_states[state].next;
+      next.insert(std::upper_bound(next.begin(), next.end(), std::make_pair(character, 0),
+                                   [](const auto& a, const auto& b) { return a.first < b.first; }),
+                  {character, child});
+      m_states.emplace_back();
+    }
+    state = child;
+  }
+  m_states[state].literals.emplace_back(m_count);
+  return m_count++;
+}
+
+void CPVRTimerRuleLiterals::Compile()
+{
+  // breadth first, so the fail state of a state is always done before the state itself
+  std::deque<int> queue;
+  for (const auto& [character, child] : m_states[0].next)
+  {
+    m_states[child].fail = 0;
+    queue.emplace_back(child);
+  }
+
+  while (!queue.empty())
+  {
+    const int state = queue.front();
+    queue.pop_front();
+
+    for (const auto& [character, child] : m_states[state].next)
+    {
+      const int fail = Next(m_states[state].fail, character);
+      m_states[child].fail = fail;
+      m_states[child].literals.insert(m_states[child].literals.end(),
+                                      m_states[fail].literals.begin(),
+                                      m_states[fail].literals.end());
+      queue.emplace_back(child);
+    }
+  }
+}
+
+void CPVRTimerRuleLiterals::Find(const std::string& text, std::vector<bool>& found) const
+{
+  // empty strings are found in every text
+  for (const size_t literal : m_states[0].literals)
+    found[literal] = true;
+
+  int state = 0;
+  for (const char c : text)
+  {
+    state = Next(state, FoldCase(c));
+    for (const size_t literal : m_states[state].literals)
+      found[literal] = true;
+  }
+}
+
+bool CPVRTimerRuleLiterals::IsLiteral(const std::string& regExp)
+{
+  // a newline is not a meta character, but separates the texts searched at once
+  return regExp.find_first_of("\\^$.|?*+()[]{}\n") == std::string::npos;
+}
+
+int CPVRTimerRuleLiterals::Child(int state, uint8_t character) const
+{
+  const auto& next = m_states[state].next;
+  const auto it = std::lower_bound(next.begin(), next.end(), std::make_pair(character, 0),
+                                   [](const auto& a, const auto& b) { return a.first < b.first; });
+  return (it != next.end() && it->first == character) ? it->second : 0;
+}
+
+int CPVRTimerRuleLiterals::Next(int state, uint8_t character) const
+{
+  while (true)
+  {
+    const int child = Child(state, character);
+    if (child != 0 || state == 0)
+      return child;
+    state = m_states[state].fail;
+  }
+}
+
+CPVRTimerRulesMatcher::CPVRTimerRulesMatcher() = default;
+
+CPVRTimerRulesMatcher::~CPVRTimerRulesMatcher() = default;
+
+bool CPVRTimerRulesMatcher::SetRules(const std::vector<std::shared_ptr<CPVRTimerInfoTag>>& rules,
+                                     const CDateTime& start)
+{
+  std::vector<std::string> ruleKeys;
+  ruleKeys.reserve(rules.size());
+
+  m_channelRules.clear();
+  m_otherRules.clear();
+  m_literals = CPVRTimerRuleLiterals();
+
+  for (const auto& rule : rules)
+  {
+    ruleKeys.emplace_back(GetRuleKey(*rule));
+
+    Rule entry{std::make_shared<CPVRTimerRuleMatcher>(rule, start), NO_LITERAL};
+    if (entry.matcher->GetSearchScope() != CPVRTimerRuleMatcher::SearchScope::NONE &&
+        CPVRTimerRuleLiterals::IsLiteral(rule->EpgSearchString()))
+      entry.literal = m_literals.Add(rule->EpgSearchString());
+
+    if (rule->GetTimerType()->SupportsChannels() &&
+        rule->ClientChannelUID() != PVR_CHANNEL_INVALID_UID)
+      m_channelRules[{rule->ClientID(), rule->ClientChannelUID()}].emplace_back(std::move(entry));
+    else
+      m_otherRules.emplace_back(std::move(entry));
+  }
+
+  m_literals.Compile();
+
+  std::sort(ruleKeys.begin(), ruleKeys.end());
+  if (ruleKeys == m_ruleKeys)
+    return false;
+
+  // tags which did not match the old rules may match the new ones
+  m_ruleKeys = std::move(ruleKeys);
+  m_seenTags.clear();
+  m_visitedTags.clear();
+  return true;
+}
+
+bool CPVRTimerRulesMatcher::IsNewOrChanged(const std::shared_ptr<const CPVREpgInfoTag>& epgTag)
+{
+  const std::pair<int, unsigned int> key{epgTag->EpgID(), epgTag->UniqueBroadcastID()};
+  const size_t hash = GetTagHash(*epgTag);
+  m_visitedTags[key] = hash;
+
+  const auto it = m_seenTags.find(key);
+  return it == m_seenTags.end() || it->second != hash;
+}
+
+void CPVRTimerRulesMatcher::Commit()
+{
+  m_seenTags = std::move(m_visitedTags);
+  m_visitedTags.clear();
+}
+
+std::vector<std::shared_ptr<CPVRTimerInfoTag>> CPVRTimerRulesMatcher::Match(
+    const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
+{
+  std::vector<std::shared_ptr<CPVRTimerInfoTag>> matches;
+
+  const auto channelRules = m_channelRules.find({epgTag->ClientID(), epgTag->UniqueChannelID()});
+  if (channelRules == m_channelRules.end() && m_otherRules.empty())
+    return matches;
+
+  // convert the times and search the texts once for all rules
+  const CDateTime startLocal = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC());
+  const CDateTime endLocal = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->EndAsUTC());
+  std::vector<bool> inTitle;
+  std::vector<bool> inText;
+
+  const auto matchRule = [&](const Rule& rule) {
+    if (!rule.matcher->MatchesExceptSearchText(epgTag, startLocal, endLocal))
+      return;
+
+    if (rule.literal == NO_LITERAL)
+    {
+      if (!rule.matcher->MatchSearchText(epgTag))
+        return;
+    }
+    else
+    {
+      if (inTitle.empty())
+      {
+        inTitle.resize(m_literals.Size());
+        m_literals.Find(epgTag->Title(), inTitle);
+      }
+      if (!inTitle[rule.literal])
+      {
+        if (rule.matcher->GetSearchScope() != CPVRTimerRuleMatcher::SearchScope::FULLTEXT)
+          return;
+
+        if (inText.empty())
+        {
+          // a string can't be found across the texts, as no search string contains a newline
+          inText.resize(m_literals.Size());
+          m_literals.Find(epgTag->EpisodeName() + "\n" + epgTag->PlotOutline() + "\n" +
+                              epgTag->Plot(),
+                          inText);
+        }
+        if (!inText[rule.literal])
+          return;
+      }
+    }
+    matches.emplace_back(rule.matcher->GetTimerRule());
+  };
+
+  if (channelRules != m_channelRules.end())
+    std::for_each(channelRules->second.cbegin(), channelRules->second.cend(), matchRule);
+  std::for_each(m_otherRules.cbegin(), m_otherRules.cend(), matchRule);
+
+  return matches;
+}
+
+std::string CPVRTimerRulesMatcher::GetRuleKey(const CPVRTimerInfoTag& rule)
+{
+  return StringUtils::Format(
+      "{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}", rule.ClientID(), rule.ClientIndex(),
+      rule.GetTimerType()->GetTypeId(), rule.ClientChannelUID(), rule.IsFullTextEpgSearch(),
+      rule.IsStartAnyTime(), rule.IsEndAnyTime(), rule.WeekDays(),
+      rule.StartAsUTC().GetAsDBDateTime(), rule.EndAsUTC().GetAsDBDateTime(),
+      rule.FirstDayAsUTC().GetAsDBDateTime(), rule.SeriesLink(), rule.EpgSearchString().size(),
+      rule.EpgSearchString());
+}
+
+size_t CPVRTimerRulesMatcher::GetTagHash(const CPVREpgInfoTag& epgTag)
+{
+  time_t start;
+  time_t end;
+  epgTag.StartAsUTC().GetAsTime(start);
+  epgTag.EndAsUTC().GetAsTime(end);
+
+  size_t hash = 0;
+  HashCombine(hash, std::hash<time_t>{}(start));
+  HashCombine(hash, std::hash<time_t>{}(end));
+  HashCombine(hash, std::hash<int>{}(epgTag.ClientID()));
+  HashCombine(hash, std::hash<int>{}(epgTag.UniqueChannelID()));
+  HashCombine(hash, std::hash<std::string>{}(epgTag.Title()));
+  HashCombine(hash, std::hash<std::string>{}(epgTag.EpisodeName()));
+  HashCombine(hash, std::hash<std::string>{}(epgTag.PlotOutline()));
+  HashCombine(hash, std::hash<std::string>{}(epgTag.Plot()));
+  HashCombine(hash, std::hash<std::string>{}(epgTag.SeriesLink()));
+  return hash;
+}
@@ -0,0 +1,147 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CDateTime;
+
+namespace PVR
+{
+class CPVREpgInfoTag;
+class CPVRTimerInfoTag;
+class CPVRTimerRuleMatcher;
+
+/*!
+ * @brief Finds which of a set of strings occur in a text, in a single pass over the text.
+ *
+ * An Aho-Corasick automaton over the bytes of the strings. Matching ignores the case of ASCII
+ * characters only, like a case insensitive CRegExp does.
+ */
+class CPVRTimerRuleLiterals
+{
+public:
+  CPVRTimerRuleLiterals();
+
+  /*!
+   * @brief Add a string to find.
+   * @param literal The string.
+   * @return The index of the string, for Find.
+   */
+  size_t Add(const std::string& literal);
+
+  /*!
+   * @brief Prepare finding the strings added. Has to be called after the last call to Add.
+   */
+  void Compile();
+
+  /*!
+   * @brief Find the strings in a text.
+   * @param text The text.
+   * @param found Set to true for the index of every string found, has Size() elements.
+   */
+  void Find(const std::string& text, std::vector<bool>& found) const;
+
+  size_t Size() const { return m_count; }
+
+  /*!
+   * @brief Check whether a regular expression only matches itself, ignoring case.
+   * @param regExp The regular expression.
+   * @return True if the regular expression contains no meta characters, false otherwise.
+   */
+  static bool IsLiteral(const std::string& regExp);
+
+private:
+  struct State
+  {
+    std::vector<std::pair<uint8_t, int>> next; // sorted by character
+    int fail{0};
+    std::vector<size_t> literals; // the strings ending here, including those of the fail states
+  };
+
+  int Next(int state, uint8_t character) const;
+  int Child(int state, uint8_t character) const;
+
+  std::vector<State> m_states;
+  size_t m_count{0};
+};
+
+/*!
+ * @brief A set of epg-based timer rules, compiled for matching all tags of the EPG.
+ *
+ * Rules for a certain channel are indexed by channel, so a tag is only checked against the
+ * rules for its channel and the rules for any channel. Search strings without meta characters
+ * are found in one pass over the texts of a tag for all rules. Only search strings which are
+ * real regular expressions are matched per rule.
+ *
+ * The set keeps track of the tags it has seen, so after an EPG update only the tags which were
+ * added or changed need to be matched, as long as the rules stay the same.
+ */
+class CPVRTimerRulesMatcher
+{
+public:
+  CPVRTimerRulesMatcher();
+  virtual ~CPVRTimerRulesMatcher();
+
+  /*!
+   * @brief Set the rules to match.
+   * @param rules The rules.
+   * @param start Tags ending before this time do not match.
+   * @return True if the rules differ from the previous ones, false otherwise.
+   */
+  bool SetRules(const std::vector<std::shared_ptr<CPVRTimerInfoTag>>& rules,
+                const CDateTime& start);
+
+  /*!
+   * @brief Check whether a tag was added or changed since the previous call to Commit.
+   * All tags are new after the rules changed.
+   * @param epgTag The tag.
+   * @return True if the tag has to be matched, false otherwise.
+   */
+  bool IsNewOrChanged(const std::shared_ptr<const CPVREpgInfoTag>& epgTag);
+
+  /*!
+   * @brief Forget about the tags which were not passed to IsNewOrChanged since the previous
+   * call to Commit, e.g. because they were deleted from the EPG.
+   */
+  void Commit();
+
+  /*!
+   * @brief Get the rules matching a tag.
+   * @param epgTag The tag.
+   * @return The matching rules.
+   */
+  std::vector<std::shared_ptr<CPVRTimerInfoTag>> Match(
+      const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
+
+private:
+  struct Rule
+  {
+    std::shared_ptr<CPVRTimerRuleMatcher> matcher;
+    size_t literal; // index of the search string, NO_LITERAL if it is matched by regexp
+  };
+
+  static constexpr size_t NO_LITERAL = static_cast<size_t>(-1);
+
+  static std::string GetRuleKey(const CPVRTimerInfoTag& rule);
+  static size_t GetTagHash(const CPVREpgInfoTag& epgTag);
+
+  std::vector<std::string> m_ruleKeys;
+  std::map<std::pair<int, int>, std::vector<Rule>> m_channelRules; // client id, channel uid
+  std::vector<Rule> m_otherRules;
+  CPVRTimerRuleLiterals m_literals;
+  std::map<std::pair<int, unsigned int>, size_t> m_seenTags; // epg id, broadcast uid
+  std::map<std::pair<int, unsigned int>, size_t> m_visitedTags;
+};
+} // namespace PVR
@@ -25,11 +25,12 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -169,6 +170,12 @@ bool CPVRTimers::UpdateFromClients(const std::vector<std::shared_ptr<CPVRClient>
   return UpdateEntries(newTimerList, failedClients);
 }
 
+PVRSyncStats CPVRTimers::GetLastSyncStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_syncStats;
+}
+
 void CPVRTimers::Process()
 {
   while (!m_bStop)
@@ -239,21 +246,46 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers,
 
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
+  m_syncStats = {};
+
+  /* look up the timers by client once, instead of searching both lists for every timer */
+  std::map<std::pair<int, int>, std::shared_ptr<CPVRTimerInfoTag>> existingTimers;
+  for (const auto& tagsEntry : m_tags)
+  {
+    for (const auto& timersEntry : tagsEntry.second)
+      existingTimers.emplace(std::make_pair(timersEntry->ClientID(), timersEntry->ClientIndex()),
+                             timersEntry);
+  }
+
+  std::set<std::pair<int, int>> clientTimers;
+
   /* go through the timer list and check for updated or new timers */
   for (const auto& tagsEntry : timers.GetTags())
   {
     for (const auto& timersEntry : tagsEntry.second)
     {
+      clientTimers.emplace(timersEntry->ClientID(), timersEntry->ClientIndex());
+
       /* check if this timer is present in this container */
-      const std::shared_ptr<CPVRTimerInfoTag> existingTimer =
-          GetByClient(timersEntry->ClientID(), timersEntry->ClientIndex());
-      if (existingTimer)
+      const auto it =
+          existingTimers.find(std::make_pair(timersEntry->ClientID(), timersEntry->ClientIndex()));
+      if (it != existingTimers.end())
       {
+        const std::shared_ptr<CPVRTimerInfoTag>& existingTimer = it->second;
+
+        /* most timers don't change between two updates */
+        if (existingTimer->HasSameClientData(*timersEntry))
+        {
+          ++m_syncStats.unchanged;
+          continue;
+        }
+
         /* if it's present, update the current tag */
         bool bStateChanged(existingTimer->State() != timersEntry->State());
         if (existingTimer->UpdateEntry(timersEntry))
         {
           bChanged = true;
+          ++m_syncStats.changed;
           existingTimer->ResetChildState();
 
           if (bStateChanged)
@@ -273,6 +305,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers,
 
         bChanged = true;
         bAddedOrDeleted = true;
+        ++m_syncStats.added;
 
         CheckAndAppendTimerNotification(timerNotifications, newTimer, false);
 
@@ -291,7 +324,8 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers,
     for (auto it2 = it->second.begin(); it2 != it->second.end();)
     {
       const std::shared_ptr<CPVRTimerInfoTag> timer = *it2;
-      if (!timers.GetByClient(timer->ClientID(), timer->ClientIndex()))
+      if (clientTimers.find(std::make_pair(timer->ClientID(), timer->ClientIndex())) ==
+          clientTimers.end())
       {
         /* timer was not found */
         bool bIgnoreTimer = !timer->IsOwnedByClient();
@@ -317,6 +351,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers,
 
         bChanged = true;
         bAddedOrDeleted = true;
+        ++m_syncStats.removed;
       }
       else if ((timer->IsStartAnyTime() && it->first != CDateTime()) ||
                (!timer->IsStartAnyTime() && timer->StartAsUTC() != it->first))
@@ -372,6 +407,10 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers,
   m_bFirstUpdate = false;
   m_bIsUpdating = false;
 
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Timers synced: {} added, {} changed, {} removed, {} unchanged",
+              m_syncStats.added, m_syncStats.changed, m_syncStats.removed,
+              m_syncStats.unchanged);
+
   if (bChanged)
   {
     UpdateChannels();
@@ -438,58 +477,6 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsForTimerRule(
 
   return matches;
 }
-
-void AddTimerRuleToEpgMap(
-    const std::shared_ptr<CPVRTimerInfoTag>& timer,
-    const CDateTime& now,
-    std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>>& epgMap,
-    bool& bFetchedAllEpgs)
-{
-  const std::shared_ptr<const CPVRChannel> channel = timer->Channel();
-  if (channel)
-  {
-    const std::shared_ptr<CPVREpg> epg = channel->GetEPG();
-    if (epg)
-    {
-      const std::shared_ptr<CPVRTimerRuleMatcher> matcher =
-          std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-      auto it = epgMap.find(epg);
-      if (it == epgMap.end())
-        epgMap.insert({epg, {matcher}});
-      else
-        it->second.emplace_back(matcher);
-    }
-  }
-  else
-  {
-    // rule matches "any channel" => we need to check all channels
-    if (!bFetchedAllEpgs)
-    {
-      const std::vector<std::shared_ptr<CPVREpg>> epgs =
-          CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
-      for (const auto& epg : epgs)
-      {
-        const std::shared_ptr<CPVRTimerRuleMatcher> matcher =
-            std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-        auto it = epgMap.find(epg);
-        if (it == epgMap.end())
-          epgMap.insert({epg, {matcher}});
-        else
-          it->second.emplace_back(matcher);
-      }
-      bFetchedAllEpgs = true;
-    }
-    else
-    {
-      for (auto& epgMapEntry : epgMap)
-      {
-        const std::shared_ptr<CPVRTimerRuleMatcher> matcher =
-            std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-        epgMapEntry.second.emplace_back(matcher);
-      }
-    }
-  }
-}
 } // unnamed namespace
 
 bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
@@ -499,8 +486,7 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
       childTimersToInsert;
   bool bChanged = false;
   const CDateTime now = CDateTime::GetUTCDateTime();
-  bool bFetchedAllEpgs = false;
-  std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>> epgMap;
+  std::vector<std::shared_ptr<CPVRTimerInfoTag>> reminderRules;
 
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
@@ -612,7 +598,7 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
           if (timer->IsEpgBased())
           {
             if (m_bReminderRulesUpdatePending)
-              AddTimerRuleToEpgMap(timer, now, epgMap, bFetchedAllEpgs);
+              reminderRules.emplace_back(timer);
           }
           else
           {
@@ -677,34 +663,13 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   }
 
   // create new children of local epg-based reminder timer rules
-  for (const auto& epgMapEntry : epgMap)
-  {
-    const auto epgTags = epgMapEntry.first->GetTags();
-    for (const auto& epgTag : epgTags)
-    {
-      if (GetTimerForEpgTag(epgTag))
-        continue;
-
-      for (const auto& matcher : epgMapEntry.second)
-      {
-        if (!matcher->Matches(epgTag))
-          continue;
-
-        const std::shared_ptr<CPVRTimerInfoTag> childTimer =
-            CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, matcher->GetTimerRule());
-        if (childTimer)
-        {
-          bChanged = true;
-          childTimersToInsert.emplace_back(matcher->GetTimerRule(),
-                                           childTimer); // remember and insert/save later
-        }
-      }
-    }
-  }
+  if (m_bReminderRulesUpdatePending)
+    MatchReminderRules(reminderRules, now, childTimersToInsert);
 
   // persist and insert/update new children of local time-based and epg-based reminder timer rules
   for (const auto& timerPair : childTimersToInsert)
   {
+    bChanged = true;
     PersistAndUpdateLocalTimer(timerPair.second, timerPair.first);
   }
 
@@ -720,6 +685,69 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   return bChanged;
 }
 
+void CPVRTimers::MatchReminderRules(
+    const std::vector<std::shared_ptr<CPVRTimerInfoTag>>& rules,
+    const CDateTime& now,
+    std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>>&
+        childTimersToInsert)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  const bool bRulesChanged = m_reminderRulesMatcher.SetRules(rules, now);
+  if (rules.empty())
+    return;
+
+  std::vector<std::shared_ptr<CPVREpg>> epgs;
+  if (std::any_of(rules.cbegin(), rules.cend(), [](const auto& rule) { return !rule->Channel(); }))
+  {
+    // a rule matches "any channel" => we need to check all channels
+    epgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
+  }
+  else
+  {
+    for (const auto& rule : rules)
+    {
+      const std::shared_ptr<CPVREpg> epg = rule->Channel()->GetEPG();
+      if (epg && std::find(epgs.cbegin(), epgs.cend(), epg) == epgs.cend())
+        epgs.emplace_back(epg);
+    }
+  }
+
+  size_t tags = 0;
+  size_t matchedTags = 0;
+  for (const auto& epg : epgs)
+  {
+    const auto epgTags = epg->GetTags();
+    tags += epgTags.size();
+    for (const auto& epgTag : epgTags)
+    {
+      // tags which did not change can't match now if they did not match before
+      if (!m_reminderRulesMatcher.IsNewOrChanged(epgTag))
+        continue;
+
+      matchedTags++;
+      if (GetTimerForEpgTag(epgTag))
+        continue;
+
+      for (const auto& rule : m_reminderRulesMatcher.Match(epgTag))
+      {
+        const std::shared_ptr<CPVRTimerInfoTag> childTimer =
+            CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, rule);
+        if (childTimer)
+          childTimersToInsert.emplace_back(rule, childTimer); // remember and insert/save later
+      }
+    }
+  }
+  m_reminderRulesMatcher.Commit();
+
+  CLog::LogFC(LOGDEBUG, LOGPVR,
+              "Matched {} of {} epg tags against {} reminder rules{} in {} ms", matchedTags, tags,
+              rules.size(), bRulesChanged ? " (rules changed)" : "",
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count());
+}
+
 std::shared_ptr<CPVRTimerInfoTag> CPVRTimers::GetNextReminderToAnnnounce()
 {
   std::shared_ptr<CPVRTimerInfoTag> ret;
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "pvr/PVRSyncStats.h"
 #include "pvr/settings/PVRSettings.h"
+#include "pvr/timers/PVRTimerRulesMatcher.h"
 #include "threads/Thread.h"
 
 #include <map>
@@ -101,6 +103,12 @@ public:
    */
   bool UpdateFromClients(const std::vector<std::shared_ptr<CPVRClient>>& clients);
 
+  /*!
+   * @brief Get the entries touched by the last update from the clients.
+   * @return The counters of the added, changed, removed and unchanged timers.
+   */
+  PVRSyncStats GetLastSyncStats() const;
+
   /*!
    * @param bIgnoreReminders include or ignore reminders
    * @return The tv or radio timer that will be active next (state scheduled), or nullptr if none.
@@ -291,6 +299,20 @@ private:
   void RemoveEntry(const std::shared_ptr<const CPVRTimerInfoTag>& tag);
   bool UpdateEntries(const CPVRTimersContainer& timers, const std::vector<int>& failedClients);
   bool UpdateEntries(int iMaxNotificationDelay);
+
+  /*!
+   * @brief Create the children of epg-based reminder timer rules for the EPG tags matching them.
+   * Only the tags which were added or changed since the previous call are matched, unless the
+   * rules changed.
+   * @param rules The active epg-based reminder timer rules.
+   * @param now The current time.
+   * @param childTimersToInsert The rules and new children to insert.
+   */
+  void MatchReminderRules(
+      const std::vector<std::shared_ptr<CPVRTimerInfoTag>>& rules,
+      const CDateTime& now,
+      std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>>&
+          childTimersToInsert);
   std::shared_ptr<CPVRTimerInfoTag> UpdateEntry(
       const std::shared_ptr<const CPVRTimerInfoTag>& timer);
 
@@ -326,8 +348,10 @@ private:
   CPVRSettings m_settings;
   std::queue<std::shared_ptr<CPVRTimerInfoTag>> m_remindersToAnnounce;
   bool m_bReminderRulesUpdatePending = false;
+  CPVRTimerRulesMatcher m_reminderRulesMatcher;
 
   bool m_bFirstUpdate = true;
   std::vector<int> m_failedClients;
+  PVRSyncStats m_syncStats;
 };
 } // namespace PVR
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/timers/PVRTimerInfoTag.h"
+
+#include <tuple>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+namespace PVR
+{
+class TestPVRTimerInfoTagHelper
+{
+public:
+  static constexpr auto ClientDataMembers() { return CPVRTimerInfoTag::ClientDataMembers(); }
+  static constexpr auto DerivedDataMembers() { return CPVRTimerInfoTag::DerivedDataMembers(); }
+
+  // members UpdateEntry must not copy, or copies on their own
+  static constexpr auto OtherMembers()
+  {
+    return std::make_tuple(&CPVRTimerInfoTag::m_iTimerId, &CPVRTimerInfoTag::m_strFileNameAndPath,
+                           &CPVRTimerInfoTag::m_strSummary, &CPVRTimerInfoTag::m_timerType);
+  }
+};
+} // namespace PVR
+
+using namespace PVR;
+
+namespace
+{
+template<typename X, typename Y>
+bool IsSameMember(X x, Y y)
+{
+  if constexpr (std::is_same_v<X, Y>)
+    return x == y;
+  else
+    return false;
+}
+
+// the count of pairs of the same member in both lists
+template<typename A, typename B>
+int CountCommonMembers(const A& a, const B& b)
+{
+  int count = 0;
+  std::apply(
+      [&count, &b](auto... x)
+      {
+        (std::apply([&count, x](auto... y) { ((count += IsSameMember(x, y)), ...); }, b), ...);
+      },
+      a);
+  return count;
+}
+} // unnamed namespace
+
+TEST(TestPVRTimerInfoTag, ClientDataMembers)
+{
+  constexpr auto client = TestPVRTimerInfoTagHelper::ClientDataMembers();
+  constexpr auto derived = TestPVRTimerInfoTagHelper::DerivedDataMembers();
+  constexpr auto other = TestPVRTimerInfoTagHelper::OtherMembers();
+
+  // every member UpdateEntry copies from the client is compared by HasSameClientData once, and
+  // nothing derived from other timers or the EPG is
+  EXPECT_EQ(26, CountCommonMembers(client, client));
+  EXPECT_EQ(11, CountCommonMembers(derived, derived));
+  EXPECT_EQ(0, CountCommonMembers(client, derived));
+  EXPECT_EQ(0, CountCommonMembers(client, other));
+  EXPECT_EQ(0, CountCommonMembers(derived, other));
+}
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/timers/PVRTimerRulesMatcher.h"
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+TEST(TestPVRTimerRuleLiterals, IsLiteral)
+{
+  EXPECT_TRUE(CPVRTimerRuleLiterals::IsLiteral("Doctor Who"));
+  EXPECT_TRUE(CPVRTimerRuleLiterals::IsLiteral("Tatort: München"));
+  EXPECT_TRUE(CPVRTimerRuleLiterals::IsLiteral(""));
+  EXPECT_FALSE(CPVRTimerRuleLiterals::IsLiteral("^News"));
+  EXPECT_FALSE(CPVRTimerRuleLiterals::IsLiteral("Star (Trek|Wars)"));
+  EXPECT_FALSE(CPVRTimerRuleLiterals::IsLiteral("F1.*Race"));
+  EXPECT_FALSE(CPVRTimerRuleLiterals::IsLiteral("a\\d"));
+  EXPECT_FALSE(CPVRTimerRuleLiterals::IsLiteral("two\nlines"));
+}
+
+TEST(TestPVRTimerRuleLiterals, FindAll)
+{
+  CPVRTimerRuleLiterals literals;
+  const size_t he = literals.Add("he");
+  const size_t she = literals.Add("she");
+  const size_t his = literals.Add("his");
+  const size_t hers = literals.Add("hers");
+  literals.Compile();
+
+  std::vector<bool> found(literals.Size());
+  literals.Find("ushers", found);
+  EXPECT_TRUE(found[he]);
+  EXPECT_TRUE(found[she]);
+  EXPECT_FALSE(found[his]);
+  EXPECT_TRUE(found[hers]);
+}
+
+TEST(TestPVRTimerRuleLiterals, CaseInsensitiveAscii)
+{
+  CPVRTimerRuleLiterals literals;
+  const size_t news = literals.Add("NEWS");
+  const size_t umlaut = literals.Add("Ärger");
+  literals.Compile();
+
+  std::vector<bool> found(literals.Size());
+  literals.Find("The Evening News", found);
+  EXPECT_TRUE(found[news]);
+  EXPECT_FALSE(found[umlaut]);
+
+  // like a case insensitive CRegExp, only ASCII characters are folded
+  found.assign(literals.Size(), false);
+  literals.Find("Viel ärger", found);
+  EXPECT_FALSE(found[umlaut]);
+  literals.Find("Viel Ärger", found);
+  EXPECT_TRUE(found[umlaut]);
+}
+
+TEST(TestPVRTimerRuleLiterals, EmptyAndDuplicates)
+{
+  CPVRTimerRuleLiterals literals;
+  const size_t empty = literals.Add("");
+  const size_t first = literals.Add("Sport");
+  const size_t second = literals.Add("sport");
+  literals.Compile();
+
+  std::vector<bool> found(literals.Size());
+  literals.Find("", found);
+  EXPECT_TRUE(found[empty]);
+  EXPECT_FALSE(found[first]);
+
+  literals.Find("Motorsport", found);
+  EXPECT_TRUE(found[first]);
+  EXPECT_TRUE(found[second]);
+}
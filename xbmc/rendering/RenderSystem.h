@@ -29,6 +29,7 @@ enum DEPTH_CULLING
 };
 
 class CGUIImage;
+class CGUIRenderQueue;
 class CGUITextLayout;
 
 class CRenderSystemBase
@@ -76,6 +77,17 @@ public:
 
   virtual std::string GetShaderPath(const std::string &filename) { return ""; }
 
+  /*!
+   * \brief Queue of batched GUI draws, if the render system batches them
+   */
+  virtual const CGUIRenderQueue* GetGUIRenderQueue() const { return nullptr; }
+
+  /*!
+   * \brief Draw any batched GUI draws. Needs to be called before rendering
+   * anything that bypasses the GUI render queue.
+   */
+  virtual void FlushGUIRenderQueue() {}
+
   void GetRenderVersion(unsigned int& major, unsigned int& minor) const;
   const std::string& GetRenderVendor() const { return m_RenderVendor; }
   const std::string& GetRenderRenderer() const { return m_RenderRenderer; }
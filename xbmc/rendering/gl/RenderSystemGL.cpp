@@ -22,7 +22,12 @@
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <exception>
+#include <utility>
+#include <vector>
 
 #if defined(TARGET_LINUX)
 #include "utils/EGLUtils.h"
@@ -30,6 +35,139 @@
 
 using namespace std::chrono_literals;
 
+namespace
+{
+// quads per draw call, limited by the 16 bit indices
+constexpr size_t GUI_QUADS_PER_DRAW = 65536 / 4;
+} // unnamed namespace
+
+class CRenderSystemGL::CGUIQueueRenderer : public CGUIRenderQueue::IRenderer
+{
+public:
+  explicit CGUIQueueRenderer(CRenderSystemGL& renderSystem) : m_renderSystem(renderSystem) {}
+
+  void ApplyState(const CGUIRenderQueue::State& state) override
+  {
+    m_renderSystem.EnableQueuedShader(static_cast<ShaderMethodGL>(state.shader));
+
+    if (state.diffuse)
+    {
+      glActiveTexture(GL_TEXTURE1);
+      glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(state.diffuse));
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(state.texture));
+
+    switch (state.blend)
+    {
+      case CGUIRenderQueue::BlendMode::NONE:
+        glDisable(GL_BLEND);
+        break;
+      case CGUIRenderQueue::BlendMode::ALPHA:
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_BLEND);
+        break;
+      case CGUIRenderQueue::BlendMode::ALPHA_KEEP_DEST:
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+        glEnable(GL_BLEND);
+        break;
+    }
+
+    glUniform1f(m_renderSystem.ShaderGetDepth(), state.depth);
+
+    const GLint uniColLoc = m_renderSystem.ShaderGetUniCol();
+    if (uniColLoc >= 0)
+    {
+      using namespace KODI::UTILS::GL;
+      glUniform4f(uniColLoc, GetChannelFromARGB(ColorChannel::R, state.color) / 255.0f,
+                  GetChannelFromARGB(ColorChannel::G, state.color) / 255.0f,
+                  GetChannelFromARGB(ColorChannel::B, state.color) / 255.0f,
+                  GetChannelFromARGB(ColorChannel::A, state.color) / 255.0f);
+    }
+  }
+
+  unsigned int DrawQuads(const CGUIRenderQueue::State& state,
+                         const std::vector<CGUIRenderQueue::Vertex>& vertices) override
+  {
+    using Vertex = CGUIRenderQueue::Vertex;
+
+    if (m_renderSystem.m_guiQuadVertexBuffer == GL_NONE)
+      CreateBuffers();
+
+    const GLint posLoc = m_renderSystem.ShaderGetPos();
+    const GLint tex0Loc = state.texture ? m_renderSystem.ShaderGetCoord0() : -1;
+    const GLint tex1Loc = state.diffuse ? m_renderSystem.ShaderGetCoord1() : -1;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_renderSystem.m_guiQuadVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), vertices.data(),
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_renderSystem.m_guiQuadIndexBuffer);
+
+    glEnableVertexAttribArray(posLoc);
+    if (tex0Loc >= 0)
+      glEnableVertexAttribArray(tex0Loc);
+    if (tex1Loc >= 0)
+      glEnableVertexAttribArray(tex1Loc);
+
+    unsigned int drawCalls = 0;
+    const size_t quads = vertices.size() / 4;
+    for (size_t first = 0; first < quads; first += GUI_QUADS_PER_DRAW)
+    {
+      const size_t count = std::min(quads - first, GUI_QUADS_PER_DRAW);
+      const size_t offset = first * 4 * sizeof(Vertex);
+
+      glVertexAttribPointer(posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                            reinterpret_cast<const GLvoid*>(offset + offsetof(Vertex, x)));
+      if (tex0Loc >= 0)
+        glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                              reinterpret_cast<const GLvoid*>(offset + offsetof(Vertex, u1)));
+      if (tex1Loc >= 0)
+        glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                              reinterpret_cast<const GLvoid*>(offset + offsetof(Vertex, u2)));
+
+      glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, 0);
+      drawCalls++;
+    }
+
+    glDisableVertexAttribArray(posLoc);
+    if (tex0Loc >= 0)
+      glDisableVertexAttribArray(tex0Loc);
+    if (tex1Loc >= 0)
+      glDisableVertexAttribArray(tex1Loc);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return drawCalls;
+  }
+
+private:
+  void CreateBuffers()
+  {
+    glGenBuffers(1, &m_renderSystem.m_guiQuadVertexBuffer);
+    glGenBuffers(1, &m_renderSystem.m_guiQuadIndexBuffer);
+
+    // every quad is drawn as two triangles, the same indices are used by all draws
+    std::vector<GLushort> indices(GUI_QUADS_PER_DRAW * 6);
+    for (size_t i = 0; i < GUI_QUADS_PER_DRAW; ++i)
+    {
+      const GLushort vertex = static_cast<GLushort>(i * 4);
+      indices[i * 6 + 0] = vertex;
+      indices[i * 6 + 1] = vertex + 1;
+      indices[i * 6 + 2] = vertex + 2;
+      indices[i * 6 + 3] = vertex + 2;
+      indices[i * 6 + 4] = vertex + 3;
+      indices[i * 6 + 5] = vertex;
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_renderSystem.m_guiQuadIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  }
+
+  CRenderSystemGL& m_renderSystem;
+};
+
 CRenderSystemGL::CRenderSystemGL() : CRenderSystemBase()
 {
 }
@@ -167,6 +305,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIRenderQueue();
+
   m_width = width;
   m_height = height;
 
@@ -245,6 +385,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  ReleaseGUIRenderQueue();
+
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -278,6 +420,7 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIRenderQueue();
   return true;
 }
 
@@ -290,6 +433,8 @@ void CRenderSystemGL::InvalidateColorBuffer()
   if (m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return;
 
+  FlushGUIRenderQueue();
+
   // some platforms prefer a clear, instead of rendering over
   if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiGeometryClear)
   {
@@ -314,6 +459,8 @@ bool CRenderSystemGL::ClearBuffers(KODI::UTILS::COLOR::Color color)
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
 
+  FlushGUIRenderQueue();
+
   float r = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color) / 255.0f;
   float g = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color) / 255.0f;
   float b = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color) / 255.0f;
@@ -370,6 +517,9 @@ void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+  m_guiRenderQueue.EndFrame();
+
   PresentRenderImpl(rendered);
 
   if (!rendered)
@@ -400,6 +550,8 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -431,6 +583,8 @@ void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, i
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
 
@@ -506,6 +660,8 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -540,6 +696,7 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+  FlushGUIRenderQueue();
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
@@ -554,6 +711,9 @@ void CRenderSystemGL::ResetScissors()
 
 void CRenderSystemGL::SetDepthCulling(DEPTH_CULLING culling)
 {
+  FlushGUIRenderQueue();
+  m_depthCulling = culling;
+
   if (culling == DEPTH_CULLING_OFF)
   {
     glDisable(GL_DEPTH_TEST);
@@ -633,6 +793,7 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  FlushGUIRenderQueue();
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -825,6 +986,13 @@ void CRenderSystemGL::ReleaseShaders()
 }
 
 void CRenderSystemGL::EnableShader(ShaderMethodGL method)
+{
+  // anything queued has to be drawn before the caller draws directly
+  FlushGUIRenderQueue();
+  EnableQueuedShader(method);
+}
+
+void CRenderSystemGL::EnableQueuedShader(ShaderMethodGL method)
 {
   m_method = method;
   if (m_pShader[m_method])
@@ -926,6 +1094,85 @@ GLint CRenderSystemGL::ShaderGetCoordStep()
   return -1;
 }
 
+void CRenderSystemGL::FlushGUIRenderQueue()
+{
+  // commands may change state that triggers a flush themselves, e.g. scissors
+  if (m_guiRenderQueueFlushing || m_guiRenderQueue.IsEmpty())
+    return;
+
+  m_guiRenderQueueFlushing = true;
+
+  // draw with the matrices in effect when the quads were queued
+  glMatrixProject.Push();
+  glMatrixModview.Push();
+  glMatrixProject.Get() = m_guiRenderQueueProject;
+  glMatrixModview.Get() = m_guiRenderQueueModview;
+
+  CGUIQueueRenderer renderer(*this);
+  m_guiRenderQueue.Flush(renderer);
+
+  glMatrixProject.Pop();
+  glMatrixModview.Pop();
+
+  // leave the state as drawing GUI textures directly used to
+  DisableShader();
+  glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  m_guiRenderQueueFlushing = false;
+}
+
+void CRenderSystemGL::QueueGUIQuads(CGUIRenderQueue::State state,
+                                    const CGUIRenderQueue::Vertex* vertices,
+                                    size_t count)
+{
+  // without depth testing the depth has no effect, don't let it split batches
+  if (m_depthCulling == DEPTH_CULLING_OFF)
+    state.depth = 0.0f;
+
+  // quads are drawn with the matrices current at flush time, so they must not change in between
+  const GLfloat* project = glMatrixProject.Get();
+  const GLfloat* modview = glMatrixModview.Get();
+  if (!m_guiRenderQueue.IsEmpty() &&
+      (memcmp(project, m_guiRenderQueueProject, sizeof(GLfloat) * 16) != 0 ||
+       memcmp(modview, m_guiRenderQueueModview, sizeof(GLfloat) * 16) != 0))
+    FlushGUIRenderQueue();
+
+  if (m_guiRenderQueue.IsEmpty())
+  {
+    m_guiRenderQueueProject = glMatrixProject.Get();
+    m_guiRenderQueueModview = glMatrixModview.Get();
+  }
+
+  m_guiRenderQueue.AddQuads(state, vertices, count);
+}
+
+void CRenderSystemGL::QueueGUICommand(const CGUIRenderQueue::State& state,
+                                      const CRect& bounds,
+                                      CGUIRenderQueue::Command command)
+{
+  if (m_guiRenderQueue.IsEmpty())
+  {
+    m_guiRenderQueueProject = glMatrixProject.Get();
+    m_guiRenderQueueModview = glMatrixModview.Get();
+  }
+
+  m_guiRenderQueue.AddCommand(state, bounds, std::move(command));
+}
+
+void CRenderSystemGL::ReleaseGUIRenderQueue()
+{
+  m_guiRenderQueue.Clear();
+
+  if (m_guiQuadVertexBuffer != GL_NONE)
+  {
+    glDeleteBuffers(1, &m_guiQuadVertexBuffer);
+    glDeleteBuffers(1, &m_guiQuadIndexBuffer);
+    m_guiQuadVertexBuffer = GL_NONE;
+    m_guiQuadIndexBuffer = GL_NONE;
+  }
+}
+
 std::string CRenderSystemGL::GetShaderPath(const std::string &filename)
 {
   std::string path = "GL/1.2/";
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "GLShader.h"
+#include "guilib/GUIRenderQueue.h"
+#include "rendering/MatrixGL.h"
 #include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 #include "utils/Map.h"
@@ -105,6 +107,24 @@ public:
 
   std::string GetShaderPath(const std::string &filename) override;
 
+  const CGUIRenderQueue* GetGUIRenderQueue() const override { return &m_guiRenderQueue; }
+  void FlushGUIRenderQueue() override;
+
+  /*!
+   * \brief Queue quads of a GUI texture, see CGUIRenderQueue::AddQuads
+   * \param state the state to draw with, shader is a ShaderMethodGL and textures are GL texture names
+   */
+  void QueueGUIQuads(CGUIRenderQueue::State state,
+                     const CGUIRenderQueue::Vertex* vertices,
+                     size_t count);
+
+  /*!
+   * \brief Queue a custom GUI draw, see CGUIRenderQueue::AddCommand
+   */
+  void QueueGUICommand(const CGUIRenderQueue::State& state,
+                       const CRect& bounds,
+                       CGUIRenderQueue::Command command);
+
   void GetGLVersion(int& major, int& minor);
   void GetGLSLVersion(int& major, int& minor);
 
@@ -112,6 +132,11 @@ public:
 
   // shaders
   void EnableShader(ShaderMethodGL method);
+  /*!
+   * \brief Enable a shader without drawing the GUI render queue first. Only for code
+   * that queues its own draws and needs the shader to be current, e.g. to query clipping.
+   */
+  void EnableQueuedShader(ShaderMethodGL method);
   void DisableShader();
   GLint ShaderGetPos();
   GLint ShaderGetCol();
@@ -145,4 +170,19 @@ protected:
   std::map<ShaderMethodGL, std::unique_ptr<CGLShader>> m_pShader;
   ShaderMethodGL m_method = ShaderMethodGL::SM_DEFAULT;
   GLuint m_vertexArray = GL_NONE;
+
+  DEPTH_CULLING m_depthCulling = DEPTH_CULLING_OFF;
+
+private:
+  class CGUIQueueRenderer;
+
+  void ReleaseGUIRenderQueue();
+
+  CGUIRenderQueue m_guiRenderQueue;
+  bool m_guiRenderQueueFlushing = false;
+  // matrices in effect when the queued quads were added
+  CMatrixGL m_guiRenderQueueProject;
+  CMatrixGL m_guiRenderQueueModview;
+  GLuint m_guiQuadVertexBuffer = GL_NONE;
+  GLuint m_guiQuadIndexBuffer = GL_NONE;
 };
@@ -24,12 +24,151 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #if defined(TARGET_LINUX)
 #include "utils/EGLUtils.h"
 #endif
 
 using namespace std::chrono_literals;
 
+namespace
+{
+// quads per draw call, limited by the 16 bit indices
+constexpr size_t GUI_QUADS_PER_DRAW = 65536 / 4;
+} // unnamed namespace
+
+class CRenderSystemGLES::CGUIQueueRenderer : public CGUIRenderQueue::IRenderer
+{
+public:
+  explicit CGUIQueueRenderer(CRenderSystemGLES& renderSystem) : m_renderSystem(renderSystem) {}
+
+  void ApplyState(const CGUIRenderQueue::State& state) override
+  {
+    m_renderSystem.EnableQueuedGUIShader(static_cast<ShaderMethodGLES>(state.shader));
+
+    if (state.diffuse)
+    {
+      glActiveTexture(GL_TEXTURE1);
+      glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(state.diffuse));
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(state.texture));
+
+    switch (state.blend)
+    {
+      case CGUIRenderQueue::BlendMode::NONE:
+        glDisable(GL_BLEND);
+        break;
+      case CGUIRenderQueue::BlendMode::ALPHA:
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_BLEND);
+        break;
+      case CGUIRenderQueue::BlendMode::ALPHA_KEEP_DEST:
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+        glEnable(GL_BLEND);
+        break;
+    }
+
+    glUniform1f(m_renderSystem.GUIShaderGetDepth(), state.depth);
+
+    const GLint uniColLoc = m_renderSystem.GUIShaderGetUniCol();
+    if (uniColLoc >= 0)
+    {
+      using namespace KODI::UTILS::GL;
+      glUniform4f(uniColLoc, GetChannelFromARGB(ColorChannel::R, state.color) / 255.0f,
+                  GetChannelFromARGB(ColorChannel::G, state.color) / 255.0f,
+                  GetChannelFromARGB(ColorChannel::B, state.color) / 255.0f,
+                  GetChannelFromARGB(ColorChannel::A, state.color) / 255.0f);
+    }
+  }
+
+  unsigned int DrawQuads(const CGUIRenderQueue::State& state,
+                         const std::vector<CGUIRenderQueue::Vertex>& vertices) override
+  {
+    using Vertex = CGUIRenderQueue::Vertex;
+
+    if (m_renderSystem.m_guiQuadVertexBuffer == GL_NONE)
+      CreateBuffers();
+
+    const GLint posLoc = m_renderSystem.GUIShaderGetPos();
+    const GLint tex0Loc = state.texture ? m_renderSystem.GUIShaderGetCoord0() : -1;
+    const GLint tex1Loc = state.diffuse ? m_renderSystem.GUIShaderGetCoord1() : -1;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_renderSystem.m_guiQuadVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), vertices.data(),
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_renderSystem.m_guiQuadIndexBuffer);
+
+    glEnableVertexAttribArray(posLoc);
+    if (tex0Loc >= 0)
+      glEnableVertexAttribArray(tex0Loc);
+    if (tex1Loc >= 0)
+      glEnableVertexAttribArray(tex1Loc);
+
+    unsigned int drawCalls = 0;
+    const size_t quads = vertices.size() / 4;
+    for (size_t first = 0; first < quads; first += GUI_QUADS_PER_DRAW)
+    {
+      const size_t count = std::min(quads - first, GUI_QUADS_PER_DRAW);
+      const size_t offset = first * 4 * sizeof(Vertex);
+
+      glVertexAttribPointer(posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                            reinterpret_cast<const GLvoid*>(offset + offsetof(Vertex, x)));
+      if (tex0Loc >= 0)
+        glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                              reinterpret_cast<const GLvoid*>(offset + offsetof(Vertex, u1)));
+      if (tex1Loc >= 0)
+        glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                              reinterpret_cast<const GLvoid*>(offset + offsetof(Vertex, u2)));
+
+      glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, 0);
+      drawCalls++;
+    }
+
+    glDisableVertexAttribArray(posLoc);
+    if (tex0Loc >= 0)
+      glDisableVertexAttribArray(tex0Loc);
+    if (tex1Loc >= 0)
+      glDisableVertexAttribArray(tex1Loc);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return drawCalls;
+  }
+
+private:
+  void CreateBuffers()
+  {
+    glGenBuffers(1, &m_renderSystem.m_guiQuadVertexBuffer);
+    glGenBuffers(1, &m_renderSystem.m_guiQuadIndexBuffer);
+
+    // every quad is drawn as two triangles, the same indices are used by all draws
+    std::vector<GLushort> indices(GUI_QUADS_PER_DRAW * 6);
+    for (size_t i = 0; i < GUI_QUADS_PER_DRAW; ++i)
+    {
+      const GLushort vertex = static_cast<GLushort>(i * 4);
+      indices[i * 6 + 0] = vertex;
+      indices[i * 6 + 1] = vertex + 1;
+      indices[i * 6 + 2] = vertex + 2;
+      indices[i * 6 + 3] = vertex + 2;
+      indices[i * 6 + 4] = vertex + 3;
+      indices[i * 6 + 5] = vertex;
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_renderSystem.m_guiQuadIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  }
+
+  CRenderSystemGLES& m_renderSystem;
+};
+
 CRenderSystemGLES::CRenderSystemGLES()
  : CRenderSystemBase()
 {
@@ -121,6 +260,8 @@ bool CRenderSystemGLES::InitRenderSystem()
 
 bool CRenderSystemGLES::ResetRenderSystem(int width, int height)
 {
+  FlushGUIRenderQueue();
+
   m_width = width;
   m_height = height;
 
@@ -162,6 +303,7 @@ bool CRenderSystemGLES::DestroyRenderSystem()
   glFinish();
   PresentRenderImpl(true);
 
+  ReleaseGUIRenderQueue();
   ReleaseShaders();
   m_bRenderCreated = false;
 
@@ -178,6 +320,7 @@ bool CRenderSystemGLES::BeginRender()
 
   if (m_limitedColorRange != useLimited || m_transferPQ != usePQ)
   {
+    FlushGUIRenderQueue();
     ReleaseShaders();
 
     m_limitedColorRange = useLimited;
@@ -194,6 +337,7 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIRenderQueue();
   return true;
 }
 
@@ -202,6 +346,8 @@ void CRenderSystemGLES::InvalidateColorBuffer()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   // some platforms prefer a clear, instead of rendering over
   if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiGeometryClear)
     ClearBuffers(0);
@@ -219,6 +365,8 @@ bool CRenderSystemGLES::ClearBuffers(KODI::UTILS::COLOR::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIRenderQueue();
+
   float r = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color) / 255.0f;
   float g = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color) / 255.0f;
   float b = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color) / 255.0f;
@@ -265,6 +413,9 @@ void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+  m_guiRenderQueue.EndFrame();
+
   PresentRenderImpl(rendered);
 
   // if video is rendered to a separate layer, we should not block this thread
@@ -295,6 +446,8 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -324,6 +477,8 @@ void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth,
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
   float w = (float)m_viewPort[2]*0.5f;
@@ -372,6 +527,8 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIRenderQueue();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -406,6 +563,7 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+  FlushGUIRenderQueue();
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
@@ -420,6 +578,9 @@ void CRenderSystemGLES::ResetScissors()
 
 void CRenderSystemGLES::SetDepthCulling(DEPTH_CULLING culling)
 {
+  FlushGUIRenderQueue();
+  m_depthCulling = culling;
+
   if (culling == DEPTH_CULLING_OFF)
   {
     glDisable(GL_DEPTH_TEST);
@@ -686,6 +847,13 @@ void CRenderSystemGLES::ReleaseShaders()
 }
 
 void CRenderSystemGLES::EnableGUIShader(ShaderMethodGLES method)
+{
+  // anything queued has to be drawn before the caller draws directly
+  FlushGUIRenderQueue();
+  EnableQueuedGUIShader(method);
+}
+
+void CRenderSystemGLES::EnableQueuedGUIShader(ShaderMethodGLES method)
 {
   m_method = method;
   if (m_pShader[m_method])
@@ -832,6 +1000,85 @@ GLint CRenderSystemGLES::GUIShaderGetCoordStep()
   return -1;
 }
 
+void CRenderSystemGLES::FlushGUIRenderQueue()
+{
+  // commands may change state that triggers a flush themselves, e.g. scissors
+  if (m_guiRenderQueueFlushing || m_guiRenderQueue.IsEmpty())
+    return;
+
+  m_guiRenderQueueFlushing = true;
+
+  // draw with the matrices in effect when the quads were queued
+  glMatrixProject.Push();
+  glMatrixModview.Push();
+  glMatrixProject.Get() = m_guiRenderQueueProject;
+  glMatrixModview.Get() = m_guiRenderQueueModview;
+
+  CGUIQueueRenderer renderer(*this);
+  m_guiRenderQueue.Flush(renderer);
+
+  glMatrixProject.Pop();
+  glMatrixModview.Pop();
+
+  // leave the state as drawing GUI textures directly used to
+  DisableGUIShader();
+  glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  m_guiRenderQueueFlushing = false;
+}
+
+void CRenderSystemGLES::QueueGUIQuads(CGUIRenderQueue::State state,
+                                      const CGUIRenderQueue::Vertex* vertices,
+                                      size_t count)
+{
+  // without depth testing the depth has no effect, don't let it split batches
+  if (m_depthCulling == DEPTH_CULLING_OFF)
+    state.depth = 0.0f;
+
+  // quads are drawn with the matrices current at flush time, so they must not change in between
+  const GLfloat* project = glMatrixProject.Get();
+  const GLfloat* modview = glMatrixModview.Get();
+  if (!m_guiRenderQueue.IsEmpty() &&
+      (memcmp(project, m_guiRenderQueueProject, sizeof(GLfloat) * 16) != 0 ||
+       memcmp(modview, m_guiRenderQueueModview, sizeof(GLfloat) * 16) != 0))
+    FlushGUIRenderQueue();
+
+  if (m_guiRenderQueue.IsEmpty())
+  {
+    m_guiRenderQueueProject = glMatrixProject.Get();
+    m_guiRenderQueueModview = glMatrixModview.Get();
+  }
+
+  m_guiRenderQueue.AddQuads(state, vertices, count);
+}
+
+void CRenderSystemGLES::QueueGUICommand(const CGUIRenderQueue::State& state,
+                                        const CRect& bounds,
+                                        CGUIRenderQueue::Command command)
+{
+  if (m_guiRenderQueue.IsEmpty())
+  {
+    m_guiRenderQueueProject = glMatrixProject.Get();
+    m_guiRenderQueueModview = glMatrixModview.Get();
+  }
+
+  m_guiRenderQueue.AddCommand(state, bounds, std::move(command));
+}
+
+void CRenderSystemGLES::ReleaseGUIRenderQueue()
+{
+  m_guiRenderQueue.Clear();
+
+  if (m_guiQuadVertexBuffer != GL_NONE)
+  {
+    glDeleteBuffers(1, &m_guiQuadVertexBuffer);
+    glDeleteBuffers(1, &m_guiQuadIndexBuffer);
+    m_guiQuadVertexBuffer = GL_NONE;
+    m_guiQuadIndexBuffer = GL_NONE;
+  }
+}
+
 std::string CRenderSystemGLES::GetShaderPath(const std::string& filename)
 {
   std::string path = "GLES/2.0/";
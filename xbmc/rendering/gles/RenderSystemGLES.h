@@ -9,6 +9,8 @@
 #pragma once
 
 #include "GLESShader.h"
+#include "guilib/GUIRenderQueue.h"
+#include "rendering/MatrixGL.h"
 #include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 #include "utils/Map.h"
@@ -123,9 +125,32 @@ public:
 
   std::string GetShaderPath(const std::string& filename) override;
 
+  const CGUIRenderQueue* GetGUIRenderQueue() const override { return &m_guiRenderQueue; }
+  void FlushGUIRenderQueue() override;
+
+  /*!
+   * \brief Queue quads of a GUI texture, see CGUIRenderQueue::AddQuads
+   * \param state the state to draw with, shader is a ShaderMethodGLES and textures are GL texture names
+   */
+  void QueueGUIQuads(CGUIRenderQueue::State state,
+                     const CGUIRenderQueue::Vertex* vertices,
+                     size_t count);
+
+  /*!
+   * \brief Queue a custom GUI draw, see CGUIRenderQueue::AddCommand
+   */
+  void QueueGUICommand(const CGUIRenderQueue::State& state,
+                       const CRect& bounds,
+                       CGUIRenderQueue::Command command);
+
   void InitialiseShaders();
   void ReleaseShaders();
   void EnableGUIShader(ShaderMethodGLES method);
+  /*!
+   * \brief Enable a shader without drawing the GUI render queue first. Only for code
+   * that queues its own draws and needs the shader to be current, e.g. to query clipping.
+   */
+  void EnableQueuedGUIShader(ShaderMethodGLES method);
   void DisableGUIShader();
 
   GLint GUIShaderGetPos();
@@ -159,4 +184,19 @@ protected:
   ShaderMethodGLES m_method = ShaderMethodGLES::SM_DEFAULT;
 
   GLint      m_viewPort[4];
+
+  DEPTH_CULLING m_depthCulling = DEPTH_CULLING_OFF;
+
+private:
+  class CGUIQueueRenderer;
+
+  void ReleaseGUIRenderQueue();
+
+  CGUIRenderQueue m_guiRenderQueue;
+  bool m_guiRenderQueueFlushing = false;
+  // matrices in effect when the queued quads were added
+  CMatrixGL m_guiRenderQueueProject;
+  CMatrixGL m_guiRenderQueueModview;
+  GLuint m_guiQuadVertexBuffer = GL_NONE;
+  GLuint m_guiQuadIndexBuffer = GL_NONE;
 };
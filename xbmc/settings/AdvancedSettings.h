@@ -246,6 +246,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
     unsigned int
         m_imageQualityJpeg; ///< \brief the stored jpeg quality the lower the better (default: 4)
+    bool m_imageCachePacked; ///< \brief store cached images in a single pack file instead of one file each
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
@@ -260,6 +261,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReadThreads; //!< number of files whose tags are read concurrently
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
@@ -13,8 +13,21 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/SettingsManager.h"
+#include "utils/StringAtom.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+#include <malloc.h>
+#define HAS_MALLINFO2
+#endif
+#endif
 
 using ::testing::Test;
 using ::testing::WithParamInterface;
@@ -73,3 +86,154 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_SUITE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+TEST(TestFileItem, Properties)
+{
+  CFileItem item;
+  EXPECT_FALSE(item.HasProperties());
+  EXPECT_TRUE(item.GetProperty("TestFileItem.Unknown").isNull());
+
+  item.SetProperty("IsPlayable", "true");
+  item.SetProperty("TotalTime", 42);
+  EXPECT_TRUE(item.HasProperties());
+
+  // keys are compared ignoring case and keep the spelling they were first set with
+  EXPECT_TRUE(item.HasProperty("isplayable"));
+  EXPECT_EQ("true", item.GetProperty("ISPLAYABLE").asString());
+  item.SetProperty("totaltime", 43);
+  EXPECT_EQ(43, item.GetProperty("TotalTime").asInteger());
+
+  CVariant serialized;
+  item.Serialize(serialized);
+  EXPECT_TRUE(serialized["customproperties"].isMember("TotalTime"));
+
+  const CFileItem copy(item);
+  EXPECT_EQ(43, copy.GetProperty("totalTime").asInteger());
+
+  item.ClearProperty("TOTALTIME");
+  EXPECT_FALSE(item.HasProperty("TotalTime"));
+  EXPECT_TRUE(copy.HasProperty("TotalTime"));
+
+  item.ClearProperties();
+  EXPECT_FALSE(item.HasProperties());
+}
+
+TEST(TestFileItem, PropertyKeys)
+{
+  CFileItem item;
+  item.SetProperty("IsPlayable", "true");
+
+  // keys set by add-ons, e.g. contextmenulabel(0), are not kept once the items are gone
+  const size_t atoms = CStringAtom::Size();
+  item.SetProperty("TestFileItem.PropertyKeys", 1);
+  item.SetProperty("ISPLAYABLE", "false");
+  EXPECT_EQ(atoms, CStringAtom::Size());
+  EXPECT_FALSE(CStringAtom::Find("TestFileItem.PropertyKeys"));
+
+  EXPECT_EQ("false", item.GetProperty("isplayable").asString());
+  EXPECT_EQ(1, item.GetProperty("testfileitem.propertykeys").asInteger());
+  item.SetProperty("TESTFILEITEM.PROPERTYKEYS", 2);
+  EXPECT_EQ(2, item.GetProperty("TestFileItem.PropertyKeys").asInteger());
+  EXPECT_FALSE(item.HasProperty("TestFileItem.Property"));
+
+  const CFileItem copy(item);
+  EXPECT_EQ(2, copy.GetProperty("TestFileItem.PropertyKeys").asInteger());
+
+  CVariant serialized;
+  item.Serialize(serialized);
+  EXPECT_TRUE(serialized["customproperties"].isMember("TestFileItem.PropertyKeys"));
+  EXPECT_TRUE(serialized["customproperties"].isMember("IsPlayable"));
+  EXPECT_EQ(atoms, CStringAtom::Size());
+}
+
+TEST(TestFileItem, ArtFallback)
+{
+  CFileItem item;
+  item.SetArt("poster", "poster.jpg");
+  EXPECT_EQ("", item.GetArt("thumb"));
+
+  item.SetArtFallback("thumb", "poster");
+  EXPECT_EQ("poster.jpg", item.GetArt("thumb"));
+
+  const CFileItem copy(item);
+  EXPECT_EQ("poster.jpg", copy.GetArt("thumb"));
+
+  item.ClearArt();
+  EXPECT_EQ("", item.GetArt("thumb"));
+  EXPECT_EQ("poster.jpg", copy.GetArt("thumb"));
+}
+
+namespace
+{
+size_t HeapInUse()
+{
+#ifdef HAS_MALLINFO2
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+} // unnamed namespace
+
+// Memory and construct/copy time of items like those of a large music or EPG listing, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestFileItem.DISABLED_Benchmark
+TEST(TestFileItem, DISABLED_Benchmark)
+{
+  constexpr int ITEMS = 50000;
+
+  const size_t heapBefore = HeapInUse();
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::unique_ptr<CFileItem>> items;
+  items.reserve(ITEMS);
+  for (int i = 0; i < ITEMS; ++i)
+  {
+    auto item = std::make_unique<CFileItem>("Track " + std::to_string(i));
+    item->SetPath("smb://server/music/artist/album/" + std::to_string(i) + ".flac");
+    item->SetArt("thumb", "image://music@smb://server/music/artist/album/folder.jpg/");
+    item->SetArt("albumartist.fanart", "image://smb://server/music/artist/fanart.jpg/");
+    item->SetProperty("IsPlayable", "true");
+    item->SetProperty("TotalTime", 240 + i % 60);
+    item->SetProperty("ResumeTime", 0);
+    item->SetProperty("StartOffset", 0);
+    item->SetProperty("Artist_Description", "A rather long property key");
+    items.emplace_back(std::move(item));
+  }
+
+  const std::chrono::duration<double, std::nano> constructElapsed =
+      std::chrono::steady_clock::now() - start;
+  const size_t heapAfter = HeapInUse();
+
+  start = std::chrono::steady_clock::now();
+  std::vector<std::unique_ptr<CFileItem>> copies;
+  copies.reserve(ITEMS);
+  for (const auto& item : items)
+    copies.emplace_back(std::make_unique<CFileItem>(*item));
+  const std::chrono::duration<double, std::nano> copyElapsed =
+      std::chrono::steady_clock::now() - start;
+
+  // a key set by the core and one set by a skin or an add-on, spelled differently than when set
+  size_t found = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& item : items)
+    found += item->GetProperty("totaltime").asInteger() > 0;
+  const std::chrono::duration<double, std::nano> lookupElapsed =
+      std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(static_cast<size_t>(ITEMS), found);
+
+  found = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& item : items)
+    found += item->HasProperty("artist_description");
+  const std::chrono::duration<double, std::nano> otherLookupElapsed =
+      std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(static_cast<size_t>(ITEMS), found);
+
+  std::cout << ITEMS << " items, " << sizeof(CFileItem) << " bytes per CFileItem, "
+            << (heapAfter - heapBefore) / ITEMS << " bytes on the heap per item" << std::endl;
+  std::cout << "construct: " << constructElapsed.count() / ITEMS
+            << " ns per item, copy: " << copyElapsed.count() / ITEMS
+            << " ns per item, property lookup: " << lookupElapsed.count() / ITEMS
+            << " ns, other property lookup: " << otherLookupElapsed.count() / ITEMS << " ns"
+            << std::endl;
+}
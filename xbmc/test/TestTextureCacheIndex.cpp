@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureCacheIndex.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+CTextureCacheIndex::Entry MakeEntry(int id)
+{
+  CTextureCacheIndex::Entry entry;
+  entry.cached = true;
+  entry.details.id = id;
+  entry.details.file = "a/" + std::to_string(id) + ".jpg";
+  entry.details.hash = "hash" + std::to_string(id);
+  return entry;
+}
+
+std::string MakeUrl(int id)
+{
+  return "image://smb%3a%2f%2fserver%2fposters%2f" + std::to_string(id) + ".jpg/";
+}
+} // unnamed namespace
+
+TEST(TestTextureCacheIndex, InsertLookup)
+{
+  CTextureCacheIndex index;
+  EXPECT_FALSE(index.Lookup(MakeUrl(1)));
+
+  index.Insert(MakeUrl(1), MakeEntry(1));
+  index.Insert(MakeUrl(2), {});
+
+  const auto cached = index.Lookup(MakeUrl(1));
+  ASSERT_TRUE(cached);
+  EXPECT_TRUE(cached->cached);
+  EXPECT_EQ(1, cached->details.id);
+  EXPECT_EQ("a/1.jpg", cached->details.file);
+  EXPECT_EQ("hash1", cached->details.hash);
+
+  // known not to be cached
+  const auto uncached = index.Lookup(MakeUrl(2));
+  ASSERT_TRUE(uncached);
+  EXPECT_FALSE(uncached->cached);
+}
+
+TEST(TestTextureCacheIndex, UpdateErase)
+{
+  CTextureCacheIndex index;
+  index.Insert(MakeUrl(1), MakeEntry(1));
+  index.Insert(MakeUrl(2), MakeEntry(2));
+
+  EXPECT_TRUE(index.Update(MakeUrl(1), [](CTextureCacheIndex::Entry& entry) {
+    entry.details.hash.clear();
+  }));
+  EXPECT_FALSE(index.Update(MakeUrl(3), [](CTextureCacheIndex::Entry&) {}));
+  EXPECT_TRUE(index.Lookup(MakeUrl(1))->details.hash.empty());
+
+  index.Erase(MakeUrl(1));
+  EXPECT_FALSE(index.Lookup(MakeUrl(1)));
+
+  index.EraseById(2);
+  EXPECT_FALSE(index.Lookup(MakeUrl(2)));
+
+  index.Insert(MakeUrl(3), MakeEntry(3));
+  index.Clear();
+  EXPECT_EQ(0u, index.GetStats().entries);
+}
+
+TEST(TestTextureCacheIndex, EvictsLeastRecentlyUsed)
+{
+  constexpr int MAX_ENTRIES = 256;
+  CTextureCacheIndex index(MAX_ENTRIES);
+
+  index.Insert(MakeUrl(0), MakeEntry(0));
+  for (int i = 1; i < MAX_ENTRIES * 4; ++i)
+  {
+    index.Insert(MakeUrl(i), MakeEntry(i));
+    // keep the first entry in use
+    ASSERT_TRUE(index.Lookup(MakeUrl(0)));
+  }
+
+  EXPECT_LE(index.GetStats().entries, static_cast<size_t>(MAX_ENTRIES));
+  EXPECT_TRUE(index.Lookup(MakeUrl(MAX_ENTRIES * 4 - 1)));
+}
+
+TEST(TestTextureCacheIndex, Stats)
+{
+  CTextureCacheIndex index;
+  index.Insert(MakeUrl(1), MakeEntry(1));
+  index.RecordLookup(true, std::chrono::microseconds(1));
+  index.RecordLookup(true, std::chrono::microseconds(3));
+  index.RecordLookup(false, std::chrono::microseconds(100));
+
+  const auto stats = index.GetStats();
+  EXPECT_EQ(1u, stats.entries);
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(std::chrono::microseconds(4), stats.hitTime);
+  EXPECT_EQ(std::chrono::microseconds(100), stats.missTime);
+}
+
+TEST(TestTextureCacheIndex, ConcurrentAccess)
+{
+  constexpr int THREADS = 4;
+  constexpr int URLS = 1000;
+  CTextureCacheIndex index;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t)
+  {
+    threads.emplace_back([&index, t]() {
+      for (int i = 0; i < URLS; ++i)
+      {
+        const int id = t * URLS + i;
+        index.Insert(MakeUrl(id), MakeEntry(id));
+        const auto entry = index.Lookup(MakeUrl(id));
+        ASSERT_TRUE(entry);
+        EXPECT_EQ(id, entry->details.id);
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(static_cast<size_t>(THREADS * URLS), index.GetStats().entries);
+}
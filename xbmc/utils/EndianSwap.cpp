@@ -8,12 +8,31 @@
 
 #include "EndianSwap.h"
 
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(HAS_NEON) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 /* based on libavformat/spdif.c */
 void Endian_Swap16_buf(uint16_t *dst, uint16_t *src, int w)
 {
-  int i;
+  int i = 0;
+
+  /* dst may be src, but the buffers must not overlap otherwise */
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  for (; i + 8 <= w; i += 8) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+  }
+#elif defined(HAS_NEON) && defined(__ARM_NEON)
+  for (; i + 8 <= w; i += 8)
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + i),
+             vrev16q_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(src + i))));
+#endif
 
-  for (i = 0; i + 8 <= w; i += 8) {
+  for (; i + 8 <= w; i += 8) {
     dst[i + 0] = Endian_Swap16(src[i + 0]);
     dst[i + 1] = Endian_Swap16(src[i + 1]);
     dst[i + 2] = Endian_Swap16(src[i + 2]);
@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FrameTracer.h"
+
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "messaging/ApplicationMessenger.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> CFrameTracer::m_enabled{false};
+
+namespace
+{
+struct TraceEvent
+{
+  // written by the owning thread only, read while exporting
+  std::atomic<const char*> name{nullptr};
+  std::atomic<int64_t> begin{0};
+  std::atomic<int64_t> end{0};
+};
+
+struct ThreadBuffer
+{
+  std::array<TraceEvent, CFrameTracer::EVENTS_PER_THREAD> events;
+  std::atomic<uint64_t> written{0};
+  std::atomic<bool> retired{false};
+  // only accessed with the registry locked
+  uint64_t threadId{0};
+  std::string threadName;
+};
+
+struct Registry
+{
+  CCriticalSection section;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  uint64_t nextThreadId{1};
+  std::atomic<int64_t> startTime{0};
+};
+
+Registry& GetRegistry()
+{
+  // never destroyed, threads may still record while static objects are destroyed on exit
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+int64_t ToNanoseconds(CFrameTracer::Clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+ThreadBuffer* AcquireBuffer()
+{
+  Registry& registry = GetRegistry();
+  std::unique_lock<CCriticalSection> lock(registry.section);
+
+  ThreadBuffer* buffer = nullptr;
+  if (registry.buffers.size() >= CFrameTracer::MAX_THREADS)
+  {
+    // buffers of threads that exited are kept for export until a new thread needs one
+    for (const auto& retired : registry.buffers)
+    {
+      if (retired->retired.load(std::memory_order_acquire))
+      {
+        buffer = retired.get();
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->retired.store(false, std::memory_order_relaxed);
+        break;
+      }
+    }
+    if (!buffer)
+      return nullptr;
+  }
+  else
+  {
+    registry.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+    buffer = registry.buffers.back().get();
+  }
+
+  buffer->threadId = registry.nextThreadId++;
+  const CThread* thread = CThread::GetCurrentThread();
+  if (thread)
+    buffer->threadName = thread->GetName();
+  else if (CServiceBroker::GetAppMessenger() &&
+           CServiceBroker::GetAppMessenger()->IsProcessThread())
+    buffer->threadName = "Application";
+  else
+    buffer->threadName = StringUtils::Format("Thread {}", buffer->threadId);
+  return buffer;
+}
+
+struct ThreadBufferRef
+{
+  ~ThreadBufferRef()
+  {
+    if (buffer)
+      buffer->retired.store(true, std::memory_order_release);
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  //! set once no buffer was left for the thread, it is then not traced at all
+  bool untraced = false;
+};
+
+thread_local ThreadBufferRef t_buffer;
+} // unnamed namespace
+
+void CFrameTracer::Start()
+{
+  GetRegistry().startTime.store(ToNanoseconds(Clock::now()), std::memory_order_relaxed);
+  m_enabled.store(true, std::memory_order_relaxed);
+  CLog::Log(LOGINFO, "CFrameTracer::{} - tracing started", __func__);
+}
+
+void CFrameTracer::Stop()
+{
+  m_enabled.store(false, std::memory_order_relaxed);
+  CLog::Log(LOGINFO, "CFrameTracer::{} - tracing stopped", __func__);
+}
+
+void CFrameTracer::Record(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+  if (!t_buffer.buffer)
+  {
+    if (t_buffer.untraced)
+      return;
+
+    t_buffer.buffer = AcquireBuffer();
+    if (!t_buffer.buffer)
+    {
+      t_buffer.untraced = true;
+      CLog::Log(LOGWARNING, "CFrameTracer::{} - more than {} threads, not tracing this one",
+                __func__, MAX_THREADS);
+      return;
+    }
+  }
+
+  ThreadBuffer& buffer = *t_buffer.buffer;
+  const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  TraceEvent& event = buffer.events[index % EVENTS_PER_THREAD];
+  event.name.store(name, std::memory_order_relaxed);
+  event.begin.store(ToNanoseconds(begin), std::memory_order_relaxed);
+  event.end.store(ToNanoseconds(end), std::memory_order_relaxed);
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool CFrameTracer::Export(const std::string& path)
+{
+  Registry& registry = GetRegistry();
+  const int64_t startTime = registry.startTime.load(std::memory_order_relaxed);
+
+  struct Thread
+  {
+    const ThreadBuffer* buffer;
+    uint64_t threadId;
+    std::string threadName;
+  };
+  std::vector<Thread> threads;
+  {
+    // buffers are never freed, only their events are read after releasing the lock
+    std::unique_lock<CCriticalSection> lock(registry.section);
+    threads.reserve(registry.buffers.size());
+    for (const auto& buffer : registry.buffers)
+      threads.push_back({buffer.get(), buffer->threadId, buffer->threadName});
+  }
+
+  CVariant events(CVariant::VariantTypeArray);
+  for (const Thread& thread : threads)
+  {
+    const ThreadBuffer& buffer = *thread.buffer;
+    const uint64_t written = buffer.written.load(std::memory_order_acquire);
+    const uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+
+    struct Copy
+    {
+      const char* name;
+      int64_t begin;
+      int64_t end;
+    };
+    std::vector<Copy> copies;
+    copies.reserve(written - first);
+    for (uint64_t i = first; i < written; ++i)
+    {
+      const TraceEvent& event = buffer.events[i % EVENTS_PER_THREAD];
+      copies.push_back({event.name.load(std::memory_order_relaxed),
+                        event.begin.load(std::memory_order_relaxed),
+                        event.end.load(std::memory_order_relaxed)});
+    }
+
+    // the thread kept recording while copying, drop what it may have overwritten
+    const uint64_t writtenAfter = buffer.written.load(std::memory_order_acquire);
+    if (writtenAfter < written)
+      continue; // handed to a new thread meanwhile, the copied events may belong to either
+
+    const uint64_t valid =
+        writtenAfter + 1 > EVENTS_PER_THREAD ? writtenAfter + 1 - EVENTS_PER_THREAD : 0;
+
+    CVariant threadName(CVariant::VariantTypeObject);
+    threadName["name"] = "thread_name";
+    threadName["ph"] = "M";
+    threadName["pid"] = 1;
+    threadName["tid"] = thread.threadId;
+    threadName["args"]["name"] = thread.threadName;
+    events.push_back(threadName);
+
+    for (uint64_t i = std::max(first, valid); i < written; ++i)
+    {
+      const Copy& copy = copies[i - first];
+      if (!copy.name || copy.begin < startTime)
+        continue;
+
+      CVariant event(CVariant::VariantTypeObject);
+      event["name"] = copy.name;
+      event["ph"] = "X";
+      event["pid"] = 1;
+      event["tid"] = thread.threadId;
+      // microseconds
+      event["ts"] = (copy.begin - startTime) / 1000.0;
+      event["dur"] = (copy.end - copy.begin) / 1000.0;
+      events.push_back(event);
+    }
+  }
+
+  CVariant trace(CVariant::VariantTypeObject);
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(trace, json, true))
+    return false;
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CFrameTracer::{} - unable to write trace to {}", __func__, path);
+    return false;
+  }
+
+  CLog::Log(LOGINFO, "CFrameTracer::{} - wrote {} trace events to {}", __func__, events.size(),
+            path);
+  return true;
+}
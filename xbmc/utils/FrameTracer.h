@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/*!
+ \brief Timeline tracing of scoped sections across threads, exported in the Chrome trace
+ event format (chrome://tracing, https://ui.perfetto.dev).
+
+ Trace points are always compiled in but tracing is off by default, a trace point then costs
+ a relaxed atomic load. While tracing, every thread records into a ring buffer of its own
+ without locking, keeping its most recent events.
+
+ \code
+ void CFoo::Process()
+ {
+   FRAME_TRACE_SCOPE("CFoo::Process");
+   ...
+ }
+ \endcode
+ */
+class CFrameTracer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  //! events kept per thread, older events are overwritten
+  static constexpr size_t EVENTS_PER_THREAD = 8192;
+
+  //! threads traced at the same time, threads started while this many are traced are skipped
+  static constexpr size_t MAX_THREADS = 64;
+
+  /*! \brief Start recording. Events recorded before are not exported. */
+  static void Start();
+
+  /*! \brief Stop recording, the events recorded so far can still be exported. */
+  static void Stop();
+
+  static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+  /*! \brief Write the events recorded since tracing was started as Chrome trace JSON
+   \param path file to write to
+   \return true on success
+   */
+  static bool Export(const std::string& path);
+
+  /*! \brief Record a section on the calling thread
+   \param name name of the section, has to stay valid for the lifetime of the application,
+   e.g. a string literal
+   */
+  static void Record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+  /*! \brief Records the lifetime of the object as a section, if tracing is enabled */
+  class CScope
+  {
+  public:
+    explicit CScope(const char* name)
+    {
+      if (IsEnabled())
+      {
+        m_name = name;
+        m_begin = Clock::now();
+      }
+    }
+
+    ~CScope()
+    {
+      if (m_name)
+        Record(m_name, m_begin, Clock::now());
+    }
+
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+
+  private:
+    const char* m_name = nullptr;
+    Clock::time_point m_begin;
+  };
+
+private:
+  static std::atomic<bool> m_enabled;
+};
+
+#define FRAME_TRACE_SCOPE(name) CFrameTracer::CScope frameTraceScope(name)
@@ -9,6 +9,7 @@
 #include "JobManager.h"
 
 #include "ServiceBroker.h"
+#include "utils/FrameTracer.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
@@ -52,6 +53,8 @@ void CJobWorker::Process()
     bool success = false;
     try
     {
+      const char* type = job->GetType();
+      FRAME_TRACE_SCOPE(*type ? type : "CJob::DoWork");
       success = job->DoWork();
     }
     catch (...)
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "StringAtom.h"
+
+#include "threads/SharedSection.h"
+#include "utils/StringUtils.h"
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+struct CStringAtom::Table
+{
+  const Entry* Insert(const std::string& str, const Entry* folded)
+  {
+    const auto it = entries.find(str);
+    if (it != entries.end())
+      return it->second.get();
+
+    auto entry = std::make_unique<Entry>(Entry{str, folded});
+    if (!folded)
+      entry->folded = entry.get();
+    // the key points into the entry, which never moves
+    const std::string_view key(entry->str);
+    return entries.emplace(key, std::move(entry)).first->second.get();
+  }
+
+  CSharedSection lock;
+  std::unordered_map<std::string_view, std::unique_ptr<Entry>> entries;
+};
+
+CStringAtom::Table& CStringAtom::GetTable()
+{
+  // never destroyed, as items in static storage may still look up their keys on exit
+  static Table* table = new Table;
+  return *table;
+}
+
+CStringAtom CStringAtom::Intern(const std::string& str)
+{
+  if (const CStringAtom atom = Find(str))
+    return atom;
+
+  Table& table = GetTable();
+  std::unique_lock<CSharedSection> lock(table.lock);
+
+  const std::string lower = StringUtils::ToLower(str);
+  const Entry* folded = table.Insert(lower, nullptr);
+  return CStringAtom(lower == str ? folded : table.Insert(str, folded));
+}
+
+CStringAtom CStringAtom::Find(const std::string& str)
+{
+  Table& table = GetTable();
+  std::shared_lock<CSharedSection> lock(table.lock);
+
+  const auto it = table.entries.find(str);
+  if (it == table.entries.end())
+    return CStringAtom();
+  return CStringAtom(it->second.get());
+}
+
+CStringAtom CStringAtom::FindFolded(const std::string& str)
+{
+  if (const CStringAtom atom = Find(str))
+    return atom.Folded();
+
+  // the lower case spelling of every string interned is interned as well
+  return Find(StringUtils::ToLower(str));
+}
+
+const std::string& CStringAtom::Get() const
+{
+  static const std::string empty;
+  return m_entry ? m_entry->str : empty;
+}
+
+size_t CStringAtom::Size()
+{
+  Table& table = GetTable();
+  std::shared_lock<CSharedSection> lock(table.lock);
+  return table.entries.size();
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+
+/*!
+ \brief A string stored once per process, compared by address.
+
+ Atoms are meant for the keys used over and over again, like the property keys the core sets on
+ list items, so every item holds a pointer rather than its own copy of the key. Interned strings
+ are never freed, so don't intern arbitrary text, e.g. anything coming from add-ons or skins.
+
+ Every atom knows the atom of its lower case spelling, which makes case insensitive
+ comparisons as cheap as case sensitive ones.
+ */
+class CStringAtom
+{
+public:
+  CStringAtom() = default;
+
+  /*!
+   \brief Get the atom of a string, adding the string to the table if needed.
+   */
+  static CStringAtom Intern(const std::string& str);
+
+  /*!
+   \brief Get the atom of a string, without adding it to the table.
+   \return the atom, or an invalid atom if the string was never interned
+   */
+  static CStringAtom Find(const std::string& str);
+
+  /*!
+   \brief Get the lower case atom of a string, without adding it to the table.
+   \return the lower case atom, or an invalid atom if the string was never interned in any case
+   */
+  static CStringAtom FindFolded(const std::string& str);
+
+  bool IsValid() const { return m_entry != nullptr; }
+  explicit operator bool() const { return IsValid(); }
+
+  /*!
+   \brief The string, empty for an invalid atom.
+   */
+  const std::string& Get() const;
+
+  /*!
+   \brief The atom of the lower case spelling of the string.
+   */
+  CStringAtom Folded() const { return CStringAtom(m_entry ? m_entry->folded : nullptr); }
+
+  bool operator==(const CStringAtom& other) const { return m_entry == other.m_entry; }
+  bool operator!=(const CStringAtom& other) const { return m_entry != other.m_entry; }
+
+  /*!
+   \brief The number of strings interned so far.
+   */
+  static size_t Size();
+
+private:
+  struct Entry
+  {
+    std::string str;
+    const Entry* folded;
+  };
+  struct Table;
+
+  static Table& GetTable();
+
+  explicit CStringAtom(const Entry* entry) : m_entry(entry) {}
+
+  const Entry* m_entry{nullptr};
+};
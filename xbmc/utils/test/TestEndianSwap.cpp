@@ -8,6 +8,8 @@
 
 #include "utils/EndianSwap.h"
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TestEndianSwap, Endian_Swap16)
@@ -26,6 +28,33 @@ TEST(TestEndianSwap, Endian_Swap32)
   EXPECT_EQ(ref, var);
 }
 
+TEST(TestEndianSwap, Endian_Swap16_buf)
+{
+  // unaligned and of every length around the vector width, copied and in place
+  for (int offset = 0; offset < 2; ++offset)
+  {
+    for (int w = 0; w < 40; ++w)
+    {
+      std::vector<uint16_t> src(w + 1), dst(w + 1, 0), ref(w + 1, 0);
+      for (int i = 0; i < w + 1; ++i)
+      {
+        src[i] = static_cast<uint16_t>(0x0102 * (i + 1));
+        ref[i] = i >= offset && i - offset < w ? Endian_Swap16(src[i]) : 0;
+      }
+
+      Endian_Swap16_buf(dst.data() + offset, src.data() + offset, w);
+      EXPECT_EQ(ref, dst);
+
+      for (int i = 0; i < offset; ++i)
+        ref[i] = src[i];
+      for (int i = offset + w; i < w + 1; ++i)
+        ref[i] = src[i];
+      Endian_Swap16_buf(src.data() + offset, src.data() + offset, w);
+      EXPECT_EQ(ref, src);
+    }
+  }
+}
+
 TEST(TestEndianSwap, Endian_Swap64)
 {
   uint64_t ref, var;
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "threads/Event.h"
+#include "utils/FrameTracer.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/Variant.h"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class TestFrameTracer : public testing::Test
+{
+protected:
+  TestFrameTracer() { file = XBMC_CREATETEMPFILE(".json"); }
+  ~TestFrameTracer() override
+  {
+    CFrameTracer::Stop();
+    EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+  }
+
+  // export the trace and count the events by name
+  std::map<std::string, int> ExportEvents()
+  {
+    std::map<std::string, int> counts;
+    const std::string path = XBMC_TEMPFILEPATH(file);
+    file->Close();
+    EXPECT_TRUE(CFrameTracer::Export(path));
+
+    std::vector<uint8_t> data;
+    XFILE::CFile trace;
+    EXPECT_GT(trace.LoadFile(path, data), 0);
+
+    CVariant value;
+    EXPECT_TRUE(CJSONVariantParser::Parse(std::string(data.begin(), data.end()), value));
+    EXPECT_TRUE(value["traceEvents"].isArray());
+    for (auto it = value["traceEvents"].begin_array(); it != value["traceEvents"].end_array(); ++it)
+    {
+      if ((*it)["ph"].asString() != "X")
+        continue;
+      EXPECT_GE((*it)["ts"].asDouble(), 0.0);
+      EXPECT_GE((*it)["dur"].asDouble(), 0.0);
+      counts[(*it)["name"].asString()]++;
+    }
+    return counts;
+  }
+
+  XFILE::CFile* file;
+};
+
+TEST_F(TestFrameTracer, RecordsScopesOfAllThreads)
+{
+  {
+    // not recorded while disabled
+    FRAME_TRACE_SCOPE("TestFrameTracer.Disabled");
+  }
+
+  CFrameTracer::Start();
+  ASSERT_TRUE(CFrameTracer::IsEnabled());
+  {
+    FRAME_TRACE_SCOPE("TestFrameTracer.Main");
+  }
+  std::thread worker([]() {
+    for (int i = 0; i < 3; ++i)
+    {
+      FRAME_TRACE_SCOPE("TestFrameTracer.Worker");
+    }
+  });
+  worker.join();
+  CFrameTracer::Stop();
+
+  const std::map<std::string, int> counts = ExportEvents();
+  EXPECT_EQ(0u, counts.count("TestFrameTracer.Disabled"));
+  EXPECT_EQ(1, counts.at("TestFrameTracer.Main"));
+  EXPECT_EQ(3, counts.at("TestFrameTracer.Worker"));
+}
+
+TEST_F(TestFrameTracer, KeepsMostRecentEvents)
+{
+  CFrameTracer::Start();
+  std::thread worker([]() {
+    for (size_t i = 0; i < CFrameTracer::EVENTS_PER_THREAD + 100; ++i)
+    {
+      FRAME_TRACE_SCOPE("TestFrameTracer.Overflow");
+    }
+  });
+  worker.join();
+  CFrameTracer::Stop();
+
+  const std::map<std::string, int> counts = ExportEvents();
+  EXPECT_EQ(static_cast<int>(CFrameTracer::EVENTS_PER_THREAD),
+            counts.at("TestFrameTracer.Overflow"));
+}
+
+TEST_F(TestFrameTracer, LimitsTracedThreads)
+{
+  constexpr size_t THREADS = CFrameTracer::MAX_THREADS + 16;
+  std::atomic<size_t> recorded{0};
+  CEvent release(true);
+
+  CFrameTracer::Start();
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < THREADS; ++i)
+  {
+    workers.emplace_back([&recorded, &release]() {
+      {
+        FRAME_TRACE_SCOPE("TestFrameTracer.Limit");
+      }
+      ++recorded;
+      // keep all threads alive, so none of them can take over the buffer of another
+      release.Wait();
+    });
+  }
+  while (recorded < THREADS)
+    std::this_thread::yield();
+  release.Set();
+  for (auto& worker : workers)
+    worker.join();
+  CFrameTracer::Stop();
+
+  const std::map<std::string, int> counts = ExportEvents();
+  EXPECT_GT(counts.at("TestFrameTracer.Limit"), 0);
+  EXPECT_LE(counts.at("TestFrameTracer.Limit"), static_cast<int>(CFrameTracer::MAX_THREADS));
+}
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/StringAtom.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestStringAtom, Intern)
+{
+  const CStringAtom atom = CStringAtom::Intern("TestStringAtom.Intern");
+  EXPECT_TRUE(atom.IsValid());
+  EXPECT_EQ("TestStringAtom.Intern", atom.Get());
+  EXPECT_EQ(atom, CStringAtom::Intern("TestStringAtom.Intern"));
+  EXPECT_EQ(atom, CStringAtom::Find("TestStringAtom.Intern"));
+  EXPECT_NE(atom, CStringAtom::Intern("TestStringAtom.Other"));
+}
+
+TEST(TestStringAtom, Find)
+{
+  EXPECT_FALSE(CStringAtom::Find("TestStringAtom.Find"));
+  EXPECT_FALSE(CStringAtom::FindFolded("TestStringAtom.Find"));
+  EXPECT_EQ("", CStringAtom().Get());
+
+  const size_t size = CStringAtom::Size();
+  EXPECT_FALSE(CStringAtom::Find("TestStringAtom.Find"));
+  EXPECT_EQ(size, CStringAtom::Size());
+}
+
+TEST(TestStringAtom, Folded)
+{
+  const CStringAtom lower = CStringAtom::Intern("teststringatom.folded");
+  EXPECT_EQ(lower, lower.Folded());
+
+  const CStringAtom mixed = CStringAtom::Intern("TestStringAtom.Folded");
+  EXPECT_NE(lower, mixed);
+  EXPECT_EQ(lower, mixed.Folded());
+
+  // any spelling finds the lower case atom, even one never interned
+  EXPECT_EQ(lower, CStringAtom::FindFolded("TestStringAtom.Folded"));
+  EXPECT_EQ(lower, CStringAtom::FindFolded("TESTSTRINGATOM.FOLDED"));
+  EXPECT_FALSE(CStringAtom::Find("TESTSTRINGATOM.FOLDED"));
+
+  // interning a string interns its lower case spelling
+  const CStringAtom upper = CStringAtom::Intern("TESTSTRINGATOM.UPPER");
+  EXPECT_EQ(CStringAtom::Find("teststringatom.upper"), upper.Folded());
+}
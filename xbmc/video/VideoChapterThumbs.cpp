@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoChapterThumbs.h"
+
+#include "DVDFileInfo.h"
+#include "FileItem.h"
+#include "guilib/Texture.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace KODI::VIDEO
+{
+
+CVideoChapterThumbs::CVideoChapterThumbs(ExtractFunc extract /* = {} */)
+  : m_extract(extract ? std::move(extract) : CDVDFileInfo::ExtractThumbsToTextures)
+{
+}
+
+std::unique_ptr<CTexture> CVideoChapterThumbs::Get(const CFileItem& item, int chapter)
+{
+  const int first = ((chapter - 1) / STRIP_SIZE) * STRIP_SIZE + 1;
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  Expire();
+
+  auto it = std::find_if(m_strips.begin(), m_strips.end(), [&](const auto& strip)
+                         { return strip->path == item.GetPath() && strip->first == first; });
+  if (it != m_strips.end())
+  {
+    std::shared_ptr<Strip> strip = *it;
+    m_extracted.wait(lock, [&strip] { return !strip->extracting; });
+
+    const size_t index = static_cast<size_t>(chapter - strip->first);
+    if (index >= strip->taken.size() || !strip->taken[index])
+      return Take(strip, chapter);
+
+    // requested again, e.g. by a second job for the same image, extract it on its own
+    lock.unlock();
+    std::vector<std::unique_ptr<CTexture>> thumbs = m_extract(item, {chapter});
+    return thumbs.empty() ? nullptr : std::move(thumbs.front());
+  }
+
+  auto strip = std::make_shared<Strip>();
+  strip->path = item.GetPath();
+  strip->first = first;
+  m_strips.push_back(strip);
+  lock.unlock();
+
+  std::vector<int> chapters(STRIP_SIZE);
+  for (int i = 0; i < STRIP_SIZE; i++)
+    chapters[i] = first + i;
+  std::vector<std::unique_ptr<CTexture>> thumbs = m_extract(item, chapters);
+
+  lock.lock();
+  strip->thumbs = std::move(thumbs);
+  strip->taken.assign(strip->thumbs.size(), false);
+  strip->failed = std::none_of(strip->thumbs.begin(), strip->thumbs.end(),
+                               [](const auto& thumb) { return thumb != nullptr; });
+  strip->extracting = false;
+  strip->time = std::chrono::steady_clock::now();
+  m_extracted.notifyAll();
+  return Take(strip, chapter);
+}
+
+std::unique_ptr<CTexture> CVideoChapterThumbs::Take(const std::shared_ptr<Strip>& strip,
+                                                    int chapter)
+{
+  std::unique_ptr<CTexture> thumb;
+  const size_t index = static_cast<size_t>(chapter - strip->first);
+  if (index < strip->thumbs.size() && strip->thumbs[index])
+  {
+    thumb = std::move(strip->thumbs[index]);
+    strip->taken[index] = true;
+  }
+
+  if (!strip->failed && std::none_of(strip->thumbs.begin(), strip->thumbs.end(),
+                                     [](const auto& thumb) { return thumb != nullptr; }))
+    m_strips.erase(std::remove(m_strips.begin(), m_strips.end(), strip), m_strips.end());
+  return thumb;
+}
+
+// thumbnails that were not requested, e.g. the dialog was closed
+void CVideoChapterThumbs::Expire()
+{
+  const auto now = std::chrono::steady_clock::now();
+  m_strips.erase(std::remove_if(m_strips.begin(), m_strips.end(),
+                                [now](const auto& strip)
+                                { return !strip->extracting && now - strip->time > MAX_AGE; }),
+                 m_strips.end());
+}
+
+} // namespace KODI::VIDEO
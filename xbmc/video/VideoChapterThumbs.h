@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CFileItem;
+class CTexture;
+
+namespace KODI::VIDEO
+{
+/*!
+ * @brief Chapter thumbnails are requested one by one, but extracted in strips of consecutive
+ * chapters with a single open of the file. The thumbnails of a strip are kept until they are
+ * requested, concurrent requests for the same strip wait for its one extraction.
+ */
+class CVideoChapterThumbs
+{
+public:
+  static constexpr int STRIP_SIZE = 8;
+
+  /*! @brief Extracts the thumbnails of the given chapters, one texture per chapter */
+  using ExtractFunc = std::function<std::vector<std::unique_ptr<CTexture>>(
+      const CFileItem& item, const std::vector<int>& chapters)>;
+
+  /*!
+   * @param extract function used to extract a strip, defaults to
+   * CDVDFileInfo::ExtractThumbsToTextures()
+   */
+  explicit CVideoChapterThumbs(ExtractFunc extract = {});
+
+  /*!
+   * @brief Get the thumbnail of a chapter.
+   * @param item the video file
+   * @param chapter the chapter, starting at 1
+   * @return the thumbnail, nullptr if it couldn't be extracted
+   */
+  std::unique_ptr<CTexture> Get(const CFileItem& item, int chapter);
+
+private:
+  static constexpr auto MAX_AGE = std::chrono::minutes(1);
+
+  struct Strip
+  {
+    std::string path;
+    int first;
+    std::vector<std::unique_ptr<CTexture>> thumbs;
+    std::vector<bool> taken;
+    bool extracting{true};
+    bool failed{false}; // kept until it expires, the file is not opened for every chapter
+    std::chrono::steady_clock::time_point time;
+  };
+
+  std::unique_ptr<CTexture> Take(const std::shared_ptr<Strip>& strip, int chapter);
+  void Expire();
+
+  ExtractFunc m_extract;
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_extracted;
+  std::vector<std::shared_ptr<Strip>> m_strips;
+};
+
+} // namespace KODI::VIDEO
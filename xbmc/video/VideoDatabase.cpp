@@ -26,6 +26,7 @@
 #include "dialogs/GUIDialogYesNo.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "filesystem/FileExistsChecker.h"
 #include "filesystem/MultiPathDirectory.h"
 #include "filesystem/PluginDirectory.h"
 #include "filesystem/StackDirectory.h"
@@ -76,6 +77,120 @@ using namespace KODI::MESSAGING;
 using namespace KODI::GUILIB;
 using namespace KODI::VIDEO;
 
+namespace
+{
+// The counters of tvshow_view and season_view are kept in the tvshowcounts and seasoncounts
+// tables. Triggers recompute the counters of the seasons and tvshows an update touches, so
+// reading the views doesn't aggregate over all episodes.
+constexpr const char* SEASONCOUNTS_COLUMNS =
+    "idShow, season, episodes, playCount, aired, inProgressCount, lastPlayed, dateAdded";
+constexpr const char* TVSHOWCOUNTS_COLUMNS =
+    "idShow, lastPlayed, totalCount, watchedcount, totalSeasons, dateAdded, inProgressCount";
+
+/*!
+ \brief Query for the counters of the seasons matching the conditions.
+ \param idShow condition on the id of the tvshow, e.g. "=new.idShow"
+ \param season condition on the season number, e.g. "=new.c12"
+ */
+std::string SeasonCountsQuery(const std::string& idShow, const std::string& season)
+{
+  return StringUtils::Format(
+      "SELECT episode.idShow AS idShow, episode.c{0:02} AS season, "
+      "COUNT(DISTINCT episode.idEpisode) AS episodes, COUNT(files.playCount) AS playCount, "
+      "MIN(episode.c{1:02}) AS aired, COUNT(bookmark.type) AS inProgressCount, "
+      "MAX(files.lastPlayed) AS lastPlayed, MAX(files.dateAdded) AS dateAdded "
+      "FROM episode "
+      "JOIN tvshow ON tvshow.idShow=episode.idShow "
+      "JOIN files ON files.idFile=episode.idFile "
+      "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+      "WHERE episode.idShow {2} AND episode.c{0:02} {3} "
+      "GROUP BY episode.idShow, episode.c{0:02}",
+      VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_EPISODE_AIRED, idShow, season);
+}
+
+/*!
+ \brief Query for the counters of the tvshows matching the condition, summed up from the
+ counters of their seasons.
+ \param idShow condition on the id of the tvshow, e.g. "=new.idShow"
+ */
+std::string TVShowCountsQuery(const std::string& idShow)
+{
+  return StringUtils::Format(
+      "SELECT tvshow.idShow AS idShow, MAX(seasoncounts.lastPlayed) AS lastPlayed, "
+      "SUM(seasoncounts.episodes) AS totalCount, "
+      "COALESCE(SUM(seasoncounts.playCount), 0) AS watchedcount, "
+      "NULLIF(COUNT(seasoncounts.season), 0) AS totalSeasons, "
+      "MAX(seasoncounts.dateAdded) AS dateAdded, "
+      "COALESCE(SUM(seasoncounts.inProgressCount), 0) AS inProgressCount "
+      "FROM tvshow "
+      "LEFT JOIN seasoncounts ON seasoncounts.idShow=tvshow.idShow "
+      "WHERE tvshow.idShow {} "
+      "GROUP BY tvshow.idShow",
+      idShow);
+}
+
+std::string RefreshSeasonCounts(const std::string& idShow, const std::string& season)
+{
+  return StringUtils::Format("DELETE FROM seasoncounts WHERE idShow {} AND season {}; "
+                             "INSERT INTO seasoncounts ({}) {}; ",
+                             idShow, season, SEASONCOUNTS_COLUMNS,
+                             SeasonCountsQuery(idShow, season));
+}
+
+std::string RefreshTVShowCounts(const std::string& idShow)
+{
+  return StringUtils::Format("DELETE FROM tvshowcounts WHERE idShow {}; "
+                             "INSERT INTO tvshowcounts ({}) {}; ",
+                             idShow, TVSHOWCOUNTS_COLUMNS, TVShowCountsQuery(idShow));
+}
+
+/*!
+ \brief Statements recomputing the counters of the season and tvshow of an episode row.
+ \param row "new" or "old"
+ */
+std::string RefreshCountsOfEpisode(const std::string& row)
+{
+  return RefreshSeasonCounts(StringUtils::Format("={}.idShow", row),
+                             StringUtils::Format("={}.c{:02}", row, VIDEODB_ID_EPISODE_SEASON)) +
+         RefreshTVShowCounts(StringUtils::Format("={}.idShow", row));
+}
+
+/*!
+ \brief Statements recomputing the counters of the seasons and tvshows of the episodes in a
+ file. Not a single episode for most files, e.g. movies, and at most a few.
+ \param where condition selecting the episodes, e.g. "idFile=new.idFile"
+ */
+std::string RefreshCountsOfFile(const std::string& where)
+{
+  const std::string idShow = StringUtils::Format("IN (SELECT idShow FROM episode WHERE {})", where);
+  const std::string season = StringUtils::Format("IN (SELECT c{:02} FROM episode WHERE {})",
+                                                 VIDEODB_ID_EPISODE_SEASON, where);
+  return RefreshSeasonCounts(idShow, season) + RefreshTVShowCounts(idShow);
+}
+
+/*!
+ \brief Query counting the rows of a counter table which differ from the expected counters.
+ */
+std::string CountsMismatchQuery(const std::string& expected,
+                                const std::string& table,
+                                const std::string& columns,
+                                const std::string& join)
+{
+  std::string where = table + ".idShow IS NULL";
+  for (const std::string& column : StringUtils::Split(columns, ", "))
+  {
+    // the keys are compared by the join
+    if (column == "idShow" || column == "season")
+      continue;
+    where += StringUtils::Format(" OR COALESCE({0}.{1}, '')<>COALESCE(expected.{1}, '')", table,
+                                 column);
+  }
+
+  return StringUtils::Format("SELECT COUNT(*) FROM ({}) AS expected LEFT JOIN {} ON {} WHERE {}",
+                             expected, table, join, where);
+}
+} // unnamed namespace
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -186,12 +301,30 @@ void CVideoDatabase::CreateTables()
     "strSubtitleLanguage text, iVideoDuration integer, strStereoMode text, strVideoLanguage text, "
     "strHdrType text)");
 
+  CLog::Log(LOGINFO, "create probecache table");
+  m_pDS->exec("CREATE TABLE probecache (idFile INTEGER PRIMARY KEY, fileSize INTEGER, "
+              "fileTime INTEGER, probeData TEXT)");
+
+  CLog::Log(LOGINFO, "create seekindex table");
+  m_pDS->exec("CREATE TABLE seekindex (idFile INTEGER PRIMARY KEY, fileSize INTEGER, "
+              "fileTime INTEGER, indexData TEXT)");
+
   CLog::Log(LOGINFO, "create sets table");
   m_pDS->exec("CREATE TABLE sets ( idSet integer primary key, strSet text, strOverview text)");
 
   CLog::Log(LOGINFO, "create seasons table");
   m_pDS->exec("CREATE TABLE seasons ( idSeason integer primary key, idShow integer, season integer, name text, userrating integer)");
 
+  CLog::Log(LOGINFO, "create tvshowcounts table");
+  m_pDS->exec("CREATE TABLE tvshowcounts (idShow INTEGER PRIMARY KEY, lastPlayed TEXT, "
+              "totalCount INTEGER, watchedcount INTEGER, totalSeasons INTEGER, dateAdded TEXT, "
+              "inProgressCount INTEGER)");
+
+  CLog::Log(LOGINFO, "create seasoncounts table");
+  m_pDS->exec("CREATE TABLE seasoncounts (idShow INTEGER, season INTEGER, episodes INTEGER, "
+              "playCount INTEGER, aired TEXT, inProgressCount INTEGER, lastPlayed TEXT, "
+              "dateAdded TEXT)");
+
   CLog::Log(LOGINFO, "create art table");
   m_pDS->exec("CREATE TABLE art(art_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, type TEXT, url TEXT)");
 
@@ -281,6 +414,7 @@ void CVideoDatabase::CreateAnalytics()
 
   m_pDS->exec("CREATE INDEX ix_streamdetails ON streamdetails (idFile)");
   m_pDS->exec("CREATE INDEX ix_seasons ON seasons (idShow, season)");
+  m_pDS->exec("CREATE INDEX ix_seasoncounts ON seasoncounts (idShow, season)");
   m_pDS->exec("CREATE INDEX ix_art ON art(media_id, media_type(20), type(20))");
 
   m_pDS->exec("CREATE INDEX ix_rating ON rating(media_id, media_type(20))");
@@ -334,7 +468,12 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; "
+              "DELETE FROM tvshowcounts WHERE idShow=old.idShow; "
+              "DELETE FROM seasoncounts WHERE idShow=old.idShow; "
               "END");
+  m_pDS->exec("CREATE TRIGGER insert_tvshow AFTER INSERT ON tvshow FOR EACH ROW BEGIN " +
+              RefreshSeasonCounts("=new.idShow", "IS NOT NULL") +
+              RefreshTVShowCounts("=new.idShow") + "END");
   m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM director_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
@@ -350,8 +489,12 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "END");
+              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; " +
+              RefreshCountsOfEpisode("old") + "END");
+  m_pDS->exec("CREATE TRIGGER insert_episode AFTER INSERT ON episode FOR EACH ROW BEGIN " +
+              RefreshCountsOfEpisode("new") + "END");
+  m_pDS->exec("CREATE TRIGGER update_episode AFTER UPDATE ON episode FOR EACH ROW BEGIN " +
+              RefreshCountsOfEpisode("old") + RefreshCountsOfEpisode("new") + "END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
               "END");
@@ -369,9 +512,21 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM settings WHERE idFile=old.idFile; "
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
+              "DELETE FROM probecache WHERE idFile=old.idFile; "
+              "DELETE FROM seekindex WHERE idFile=old.idFile; "
               "DELETE FROM videoversion WHERE idFile=old.idFile; "
-              "DELETE FROM art WHERE media_id=old.idFile AND media_type='videoversion'; "
-              "END");
+              "DELETE FROM art WHERE media_id=old.idFile AND media_type='videoversion'; " +
+              RefreshCountsOfFile("idFile=old.idFile") + "END");
+  m_pDS->exec("CREATE TRIGGER update_file AFTER UPDATE ON files FOR EACH ROW BEGIN " +
+              RefreshCountsOfFile("idFile=new.idFile") + "END");
+  // only resume points count, other bookmarks don't touch any counters
+  m_pDS->exec("CREATE TRIGGER insert_bookmark AFTER INSERT ON bookmark FOR EACH ROW BEGIN " +
+              RefreshCountsOfFile("idFile=new.idFile AND new.type=1") + "END");
+  m_pDS->exec("CREATE TRIGGER update_bookmark AFTER UPDATE ON bookmark FOR EACH ROW BEGIN " +
+              RefreshCountsOfFile("idFile=old.idFile AND old.type=1") +
+              RefreshCountsOfFile("idFile=new.idFile AND new.type=1") + "END");
+  m_pDS->exec("CREATE TRIGGER delete_bookmark AFTER DELETE ON bookmark FOR EACH ROW BEGIN " +
+              RefreshCountsOfFile("idFile=old.idFile AND old.type=1") + "END");
   m_pDS->exec("CREATE TRIGGER delete_videoversion AFTER DELETE ON videoversion FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idFile AND media_type='videoversion'; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
@@ -421,27 +576,6 @@ void CVideoDatabase::CreateViews()
       VIDEODB_ID_TV_MPAA, VIDEODB_ID_EPISODE_RATING_ID, VIDEODB_ID_EPISODE_IDENT_ID);
   m_pDS->exec(episodeview);
 
-  CLog::Log(LOGINFO, "create tvshowcounts");
-  // clang-format off
-  std::string tvshowcounts = PrepareSQL("CREATE VIEW tvshowcounts AS SELECT "
-                                       "      tvshow.idShow AS idShow,"
-                                       "      MAX(files.lastPlayed) AS lastPlayed,"
-                                       "      NULLIF(COUNT(episode.c12), 0) AS totalCount,"
-                                       "      COUNT(files.playCount) AS watchedcount,"
-                                       "      NULLIF(COUNT(DISTINCT(episode.c12)), 0) AS totalSeasons, "
-                                       "      MAX(files.dateAdded) as dateAdded, "
-                                       "      COUNT(bookmark.type) AS inProgressCount "
-                                       "    FROM tvshow"
-                                       "      LEFT JOIN episode ON"
-                                       "        episode.idShow=tvshow.idShow"
-                                       "      LEFT JOIN files ON"
-                                       "        files.idFile=episode.idFile "
-                                       "      LEFT JOIN bookmark ON"
-                                       "        bookmark.idFile=files.idFile AND bookmark.type=1 "
-                                       "GROUP BY tvshow.idShow");
-  // clang-format on
-  m_pDS->exec(tvshowcounts);
-
   CLog::Log(LOGINFO, "create tvshowlinkpath_minview");
   // This view only exists to workaround a limitation in MySQL <5.7 which is not able to
   // perform subqueries in joins.
@@ -500,34 +634,15 @@ void CVideoDatabase::CreateViews()
                                      "  tvshow_view.c%02d AS genre,"
                                      "  tvshow_view.c%02d AS studio,"
                                      "  tvshow_view.c%02d AS mpaa,"
-                                     "  count(DISTINCT episode.idEpisode) AS episodes,"
-                                     "  count(files.playCount) AS playCount,"
-                                     "  min(episode.c%02d) AS aired, "
-                                     "  count(bookmark.type) AS inProgressCount "
+                                     "  seasoncounts.episodes AS episodes,"
+                                     "  seasoncounts.playCount AS playCount,"
+                                     "  seasoncounts.aired AS aired, "
+                                     "  seasoncounts.inProgressCount AS inProgressCount "
                                      "FROM seasons"
                                      "  JOIN tvshow_view ON"
                                      "    tvshow_view.idShow = seasons.idShow"
-                                     "  JOIN episode ON"
-                                     "    episode.idShow = seasons.idShow AND episode.c%02d = seasons.season"
-                                     "  JOIN files ON"
-                                     "    files.idFile = episode.idFile "
-                                     "  LEFT JOIN bookmark ON"
-                                     "    bookmark.idFile = files.idFile AND bookmark.type = 1 "
-                                     "GROUP BY seasons.idSeason,"
-                                     "         seasons.idShow,"
-                                     "         seasons.season,"
-                                     "         seasons.name,"
-                                     "         seasons.userrating,"
-                                     "         tvshow_view.strPath,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d ",
-                                     VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_PLOT, VIDEODB_ID_TV_PREMIERED,
-                                     VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_MPAA,
-                                     VIDEODB_ID_EPISODE_AIRED, VIDEODB_ID_EPISODE_SEASON,
+                                     "  JOIN seasoncounts ON"
+                                     "    seasoncounts.idShow = seasons.idShow AND seasoncounts.season = seasons.season",
                                      VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_PLOT, VIDEODB_ID_TV_PREMIERED,
                                      VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_MPAA);
   // clang-format on
@@ -3967,6 +4082,106 @@ void CVideoDatabase::DeleteStreamDetails(int idFile)
   m_pDS->exec(PrepareSQL("DELETE FROM streamdetails WHERE idFile = %i", idFile));
 }
 
+bool CVideoDatabase::GetProbeData(const std::string& strFileNameAndPath,
+                                  int64_t size,
+                                  int64_t mtime,
+                                  std::string& data)
+{
+  return GetFileCacheData("probecache", strFileNameAndPath, size, mtime, data);
+}
+
+bool CVideoDatabase::SetProbeData(const std::string& strFileNameAndPath,
+                                  int64_t size,
+                                  int64_t mtime,
+                                  const std::string& data)
+{
+  return SetFileCacheData("probecache", strFileNameAndPath, size, mtime, data);
+}
+
+bool CVideoDatabase::GetKeyframeIndex(const std::string& strFileNameAndPath,
+                                      int64_t size,
+                                      int64_t mtime,
+                                      std::string& data)
+{
+  return GetFileCacheData("seekindex", strFileNameAndPath, size, mtime, data);
+}
+
+bool CVideoDatabase::SetKeyframeIndex(const std::string& strFileNameAndPath,
+                                      int64_t size,
+                                      int64_t mtime,
+                                      const std::string& data)
+{
+  return SetFileCacheData("seekindex", strFileNameAndPath, size, mtime, data);
+}
+
+bool CVideoDatabase::GetFileCacheData(const std::string& table,
+                                      const std::string& strFileNameAndPath,
+                                      int64_t size,
+                                      int64_t mtime,
+                                      std::string& data)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    const int idFile = GetFileId(strFileNameAndPath);
+    if (idFile < 0)
+      return false;
+
+    // the tables share the layout (idFile, fileSize, fileTime, data)
+    m_pDS->query(PrepareSQL("SELECT * FROM %s WHERE idFile = %i", table.c_str(), idFile));
+    bool found = false;
+    if (!m_pDS->eof())
+    {
+      // a changed file has to be examined again
+      found = m_pDS->fv(1).get_asInt64() == size && m_pDS->fv(2).get_asInt64() == mtime;
+      if (found)
+        data = m_pDS->fv(3).get_asString();
+    }
+    m_pDS->close();
+    return found;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} ({}, {}) failed", __FUNCTION__, table, strFileNameAndPath);
+  }
+  return false;
+}
+
+bool CVideoDatabase::SetFileCacheData(const std::string& table,
+                                      const std::string& strFileNameAndPath,
+                                      int64_t size,
+                                      int64_t mtime,
+                                      const std::string& data)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    // only files of the library are cached, anything else would leave rows behind
+    const int idFile = GetFileId(strFileNameAndPath);
+    if (idFile < 0)
+      return false;
+
+    m_pDS->exec(PrepareSQL("DELETE FROM %s WHERE idFile = %i", table.c_str(), idFile));
+    m_pDS->exec(PrepareSQL("INSERT INTO %s VALUES (%i, %lld, %lld, '%s')",
+                           table.c_str(), idFile, static_cast<long long>(size),
+                           static_cast<long long>(mtime), data.c_str()));
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} ({}, {}) failed", __FUNCTION__, table, strFileNameAndPath);
+  }
+  return false;
+}
+
 void CVideoDatabase::DeleteSet(int idSet)
 {
   try
@@ -6487,11 +6702,72 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
     m_pDS->exec("DELETE FROM episode WHERE idSeason NOT IN (SELECT idSeason from seasons)");
   }
+
+  if (iVersion < 134)
+  {
+    m_pDS->exec("CREATE TABLE probecache (idFile INTEGER PRIMARY KEY, fileSize INTEGER, "
+                "fileTime INTEGER, probeData TEXT)");
+  }
+
+  if (iVersion < 135)
+  {
+    m_pDS->exec("CREATE TABLE seekindex (idFile INTEGER PRIMARY KEY, fileSize INTEGER, "
+                "fileTime INTEGER, indexData TEXT)");
+  }
+
+  if (iVersion < 136)
+  {
+    // the views were dropped, tvshowcounts is a table from now on
+    m_pDS->exec("CREATE TABLE tvshowcounts (idShow INTEGER PRIMARY KEY, lastPlayed TEXT, "
+                "totalCount INTEGER, watchedcount INTEGER, totalSeasons INTEGER, "
+                "dateAdded TEXT, inProgressCount INTEGER)");
+    m_pDS->exec("CREATE TABLE seasoncounts (idShow INTEGER, season INTEGER, episodes INTEGER, "
+                "playCount INTEGER, aired TEXT, inProgressCount INTEGER, lastPlayed TEXT, "
+                "dateAdded TEXT)");
+    RebuildTVShowCounts();
+  }
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 133;
+  return 136;
+}
+
+void CVideoDatabase::RebuildTVShowCounts()
+{
+  CLog::Log(LOGINFO, "CVideoDatabase::{} - rebuilding tvshow and season counters", __func__);
+  m_pDS->exec("DELETE FROM seasoncounts");
+  m_pDS->exec("DELETE FROM tvshowcounts");
+  m_pDS->exec(StringUtils::Format("INSERT INTO seasoncounts ({}) {}", SEASONCOUNTS_COLUMNS,
+                                  SeasonCountsQuery("IS NOT NULL", "IS NOT NULL")));
+  m_pDS->exec(StringUtils::Format("INSERT INTO tvshowcounts ({}) {}", TVSHOWCOUNTS_COLUMNS,
+                                  TVShowCountsQuery("IS NOT NULL")));
+}
+
+bool CVideoDatabase::CheckTVShowCounts()
+{
+  const std::string seasons = SeasonCountsQuery("IS NOT NULL", "IS NOT NULL");
+  const std::string tvshows = TVShowCountsQuery("IS NOT NULL");
+
+  // every expected row has to be stored with the same counters and no other rows may be stored
+  const bool consistent =
+      GetSingleValueInt(CountsMismatchQuery(seasons, "seasoncounts", SEASONCOUNTS_COLUMNS,
+                                            "seasoncounts.idShow=expected.idShow AND "
+                                            "seasoncounts.season=expected.season")) == 0 &&
+      GetSingleValueInt("SELECT COUNT(*) FROM seasoncounts") ==
+          GetSingleValueInt("SELECT COUNT(*) FROM (" + seasons + ") AS expected") &&
+      GetSingleValueInt(CountsMismatchQuery(tvshows, "tvshowcounts", TVSHOWCOUNTS_COLUMNS,
+                                            "tvshowcounts.idShow=expected.idShow")) == 0 &&
+      GetSingleValueInt("SELECT COUNT(*) FROM tvshowcounts") ==
+          GetSingleValueInt("SELECT COUNT(*) FROM tvshow");
+
+  if (!consistent)
+  {
+    CLog::Log(LOGWARNING, "CVideoDatabase::{} - tvshow or season counters are out of date",
+              __func__);
+    RebuildTVShowCounts();
+  }
+  return consistent;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -10192,10 +10468,9 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
           *CMediaSourceSettings::GetInstance().GetSources("video"));
       CServiceBroker::GetMediaManager().GetRemovableDrives(videoSources);
 
-      int total = m_pDS2->num_rows();
-      int current = 0;
-      std::string lastDir;
-      bool gotDir = true;
+      // files on sources are checked at once, one listing per folder
+      CFileExistsChecker checker;
+      std::vector<std::pair<std::string, std::string>> filesToCheck;
 
       while (!m_pDS2->eof())
       {
@@ -10229,50 +10504,50 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
           if (!URIUtils::IsOnDVD(fullPath) &&
               CUtil::GetMatchingSource(fullPath, videoSources, bIsSource) >= 0)
           {
-            const std::string pathDir = URIUtils::GetDirectory(fullPath);
-
-            // Cache file's directory in case it's different from the previous file
-            if (lastDir != pathDir)
-            {
-              lastDir = pathDir;
-              CFileItemList items; // Dummy list
-              gotDir = CDirectory::GetDirectory(pathDir, items, "",
-                                                DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
-            }
-
-            // Keep existing files
-            if (gotDir && CFile::Exists(fullPath, true))
-              del = false;
+            checker.Add(fullPath);
+            filesToCheck.emplace_back(m_pDS2->fv("files.idFile").get_asString(), fullPath);
+            del = false;
           }
         }
         if (del)
           filesToTestForDelete += m_pDS2->fv("files.idFile").get_asString() + ",";
 
-        if (handle == NULL && progress != NULL)
-        {
-          int percentage = current * 100 / total;
-          if (percentage > progress->GetPercentage())
-          {
-            progress->SetPercentage(percentage);
-            progress->Progress();
-          }
-          if (progress->IsCanceled())
-          {
-            progress->Close();
-            m_pDS2->close();
-            CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
-                                                               "OnCleanFinished");
-            return;
-          }
-        }
-        else if (handle != NULL)
-          handle->SetPercentage(current * 100 / (float)total);
-
         m_pDS2->next();
-        current++;
       }
       m_pDS2->close();
 
+      const bool checked = checker.Run(
+          [handle, progress](size_t current, size_t total)
+          {
+            if (handle == nullptr && progress != nullptr)
+            {
+              const int percentage = static_cast<int>(current * 100 / total);
+              if (percentage > progress->GetPercentage())
+              {
+                progress->SetPercentage(percentage);
+                progress->Progress();
+              }
+              return !progress->IsCanceled();
+            }
+            else if (handle != nullptr)
+              handle->SetPercentage(current * 100 / static_cast<float>(total));
+            return true;
+          });
+      if (!checked)
+      {
+        progress->Close();
+        CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
+                                                           "OnCleanFinished");
+        return;
+      }
+
+      // Keep existing files
+      for (const auto& [idFile, fullPath] : filesToCheck)
+      {
+        if (!checker.Exists(fullPath))
+          filesToTestForDelete += idFile + ",";
+      }
+
       std::string filesToDelete;
 
       // Add any files that don't have a valid idPath entry to the filesToDelete list.
@@ -10496,6 +10771,9 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
             "WHERE NOT EXISTS (SELECT 1 FROM movie WHERE movie.idSet = sets.idSet)";
       m_pDS->exec(sql);
 
+      CLog::Log(LOGDEBUG, LOGDATABASE, "{}: Checking tvshow and season counters", __FUNCTION__);
+      CheckTVShowCounts();
+
       CommitTransaction();
 
       if (handle)
@@ -12132,6 +12410,12 @@ void CVideoDatabase::EraseAllForPath(const std::string& path)
 
       sql = "DELETE FROM streamdetails WHERE idFile IN " + itemsToDelete;
       m_pDS->exec(sql);
+
+      sql = "DELETE FROM probecache WHERE idFile IN " + itemsToDelete;
+      m_pDS->exec(sql);
+
+      sql = "DELETE FROM seekindex WHERE idFile IN " + itemsToDelete;
+      m_pDS->exec(sql);
     }
   }
   catch (...)
@@ -633,6 +633,54 @@ public:
   void DeleteMusicVideo(int idMusicVideo, bool bKeepId = false);
   void DeleteDetailsForTvShow(int idTvShow);
   void DeleteStreamDetails(int idFile);
+
+  /*! \brief Get the demuxer probe results cached for a file
+   \param strFileNameAndPath path of the file
+   \param size current size of the file
+   \param mtime current modification time of the file
+   \param[out] data the cached probe results
+   \return true if results are cached and were stored for the same size and time
+   */
+  bool GetProbeData(const std::string& strFileNameAndPath,
+                    int64_t size,
+                    int64_t mtime,
+                    std::string& data);
+
+  /*! \brief Cache the demuxer probe results of a file, replacing earlier results
+   \param strFileNameAndPath path of the file, which has to be in the database already
+   \param size size of the file that was probed
+   \param mtime modification time of the file that was probed
+   \param data the probe results
+   \return true on success, false if the file is not in the database
+   */
+  bool SetProbeData(const std::string& strFileNameAndPath,
+                    int64_t size,
+                    int64_t mtime,
+                    const std::string& data);
+
+  /*! \brief Get the keyframe index built for seeking in a file
+   \param strFileNameAndPath path of the file
+   \param size current size of the file
+   \param mtime current modification time of the file
+   \param[out] data the serialized index
+   \return true if an index is stored and was built for the same size and time
+   */
+  bool GetKeyframeIndex(const std::string& strFileNameAndPath,
+                        int64_t size,
+                        int64_t mtime,
+                        std::string& data);
+
+  /*! \brief Store the keyframe index of a file, replacing an earlier index
+   \param strFileNameAndPath path of the file, which has to be in the database already
+   \param size size of the file the index was built for
+   \param mtime modification time of the file the index was built for
+   \param data the serialized index
+   \return true on success, false if the file is not in the database
+   */
+  bool SetKeyframeIndex(const std::string& strFileNameAndPath,
+                        int64_t size,
+                        int64_t mtime,
+                        const std::string& data);
   void RemoveContentForPath(const std::string& strPath,CGUIDialogProgress *progress = NULL);
   void UpdateFanart(const CFileItem& item, VideoDbContentType type);
   void DeleteSet(int idSet);
@@ -1259,6 +1307,17 @@ protected:
   void GetDetailsFromDB(const dbiplus::sql_record* const record, int min, int max, const SDbTableOffsets *offsets, CVideoInfoTag &details, int idxOffset = 2);
   std::string GetValueString(const CVideoInfoTag &details, int min, int max, const SDbTableOffsets *offsets) const;
 
+  /*! \brief Recompute the counters of all tvshows and seasons. The triggers keep them up to date
+   from then on.
+   */
+  void RebuildTVShowCounts();
+
+  /*! \brief Compare the counters of the tvshows and seasons with their episodes and rebuild them
+   if they differ.
+   \return true if the counters were up to date
+   */
+  bool CheckTVShowCounts();
+
 private:
   void CreateTables() override;
   void CreateAnalytics() override;
@@ -1285,6 +1344,20 @@ private:
    */
   int RunQuery(const std::string &sql);
 
+  /*! \brief Get data cached per file in one of the tables laid out as
+   (idFile, fileSize, fileTime, data), if it was stored for the same size and time
+   */
+  bool GetFileCacheData(const std::string& table,
+                        const std::string& strFileNameAndPath,
+                        int64_t size,
+                        int64_t mtime,
+                        std::string& data);
+  bool SetFileCacheData(const std::string& table,
+                        const std::string& strFileNameAndPath,
+                        int64_t size,
+                        int64_t mtime,
+                        const std::string& data);
+
   void AppendIdLinkFilter(const char* field, const char *table, const MediaType& mediaType, const char *view, const char *viewKey, const CUrlOptions::UrlOptions& options, Filter &filter);
   void AppendLinkFilter(const char* field, const char *table, const MediaType& mediaType, const char *view, const char *viewKey, const CUrlOptions::UrlOptions& options, Filter &filter);
 
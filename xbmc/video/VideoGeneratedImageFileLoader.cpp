@@ -18,6 +18,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/URIUtils.h"
+#include "video/VideoChapterThumbs.h"
 #include "video/VideoFileItemClassify.h"
 #include "video/VideoInfoTag.h"
 
@@ -53,6 +54,8 @@ void SetupRarOptions(CFileItem& item, const std::string& path)
     item.SetPath(url.Get());
   g_directoryCache.ClearDirectory(url.GetWithoutFilename());
 }
+
+CVideoChapterThumbs chapterThumbs;
 } // namespace
 
 std::unique_ptr<CTexture> CVideoGeneratedImageFileLoader::Load(
@@ -74,6 +77,9 @@ std::unique_ptr<CTexture> CVideoGeneratedImageFileLoader::Load(
   int chapter = 0;
   std::from_chars(chapterOption.data(), chapterOption.data() + chapterOption.size(), chapter);
 
+  if (chapter > 0)
+    return chapterThumbs.Get(item, chapter);
+
   return CDVDFileInfo::ExtractThumbToTexture(item, chapter);
 }
 
@@ -11,7 +11,7 @@
 #include "FileItem.h"
 #include "FileItemList.h"
 #include "ServiceBroker.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "URL.h"
 #include "Util.h"
 #include "addons/Scraper.h"
@@ -38,6 +38,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 using namespace KODI;
 using namespace KODI::MESSAGING;
@@ -281,14 +282,10 @@ bool CVideoLibraryRefreshingJob::Work(CVideoDatabase &db)
     }
 
     // before we start downloading all the necessary information cleanup any existing artwork and hashes
-    CTextureDatabase textureDb;
-    if (textureDb.Open())
-    {
-      for (const auto& artwork : m_item->GetArt())
-        textureDb.InvalidateCachedTexture(artwork.second);
-
-      textureDb.Close();
-    }
+    std::vector<std::string> artwork;
+    for (const auto& art : m_item->GetArt())
+      artwork.emplace_back(art.second);
+    CServiceBroker::GetTextureCache()->InvalidateCachedImages(artwork);
     m_item->ClearArt();
 
     // put together the list of items to refresh
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "guilib/Texture.h"
+#include "video/VideoChapterThumbs.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI::VIDEO;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int CHAPTERS = 20;
+
+class CTestTexture : public CTexture
+{
+public:
+  explicit CTestTexture(int chapter) : m_chapter(chapter) {}
+
+  void CreateTextureObject() override {}
+  void DestroyTextureObject() override {}
+  void LoadToGPU() override {}
+  void BindToUnit(unsigned int unit) override {}
+
+  int m_chapter;
+};
+
+// Extracts a texture for every chapter of a video with CHAPTERS chapters
+class CTestExtractor
+{
+public:
+  explicit CTestExtractor(std::chrono::milliseconds openTime = 0ms,
+                          std::chrono::milliseconds chapterTime = 0ms)
+    : m_openTime(openTime), m_chapterTime(chapterTime)
+  {
+  }
+
+  std::vector<std::unique_ptr<CTexture>> operator()(const CFileItem& item,
+                                                     const std::vector<int>& chapters)
+  {
+    ++m_opens;
+    std::this_thread::sleep_for(m_openTime);
+    std::vector<std::unique_ptr<CTexture>> thumbs;
+    for (int chapter : chapters)
+    {
+      std::this_thread::sleep_for(m_chapterTime);
+      if (chapter <= CHAPTERS)
+        thumbs.emplace_back(std::make_unique<CTestTexture>(chapter));
+      else
+        thumbs.emplace_back();
+    }
+    return thumbs;
+  }
+
+  std::atomic<int> m_opens{0};
+
+private:
+  std::chrono::milliseconds m_openTime;
+  std::chrono::milliseconds m_chapterTime;
+};
+
+int ChapterOf(const std::unique_ptr<CTexture>& thumb)
+{
+  return thumb ? static_cast<const CTestTexture&>(*thumb).m_chapter : -1;
+}
+} // unnamed namespace
+
+TEST(TestVideoChapterThumbs, ExtractsStrips)
+{
+  CTestExtractor extractor;
+  CVideoChapterThumbs thumbs(std::ref(extractor));
+  const CFileItem item("/path/to/video.mkv", false);
+
+  for (int chapter = 1; chapter <= CHAPTERS; ++chapter)
+    EXPECT_EQ(chapter, ChapterOf(thumbs.Get(item, chapter)));
+
+  // one open per strip of chapters
+  EXPECT_EQ((CHAPTERS + CVideoChapterThumbs::STRIP_SIZE - 1) / CVideoChapterThumbs::STRIP_SIZE,
+            extractor.m_opens);
+
+  // chapters past the last one have no thumbnail
+  EXPECT_EQ(nullptr, thumbs.Get(item, CHAPTERS + 1));
+}
+
+TEST(TestVideoChapterThumbs, RequestedAgain)
+{
+  CTestExtractor extractor;
+  CVideoChapterThumbs thumbs(std::ref(extractor));
+  const CFileItem item("/path/to/video.mkv", false);
+
+  // a chapter requested twice while its strip is still kept gets a thumbnail both times
+  EXPECT_EQ(1, ChapterOf(thumbs.Get(item, 1)));
+  EXPECT_EQ(1, ChapterOf(thumbs.Get(item, 1)));
+  EXPECT_EQ(2, ChapterOf(thumbs.Get(item, 2)));
+  EXPECT_EQ(2, extractor.m_opens);
+}
+
+TEST(TestVideoChapterThumbs, ConcurrentRequests)
+{
+  CTestExtractor extractor(10ms);
+  CVideoChapterThumbs thumbs(std::ref(extractor));
+  const CFileItem item("/path/to/video.mkv", false);
+
+  std::vector<int> results(CVideoChapterThumbs::STRIP_SIZE);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < CVideoChapterThumbs::STRIP_SIZE; ++i)
+    threads.emplace_back([&, i] { results[i] = ChapterOf(thumbs.Get(item, i + 1)); });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // requests for the same strip wait for its one extraction
+  for (int i = 0; i < CVideoChapterThumbs::STRIP_SIZE; ++i)
+    EXPECT_EQ(i + 1, results[i]);
+  EXPECT_EQ(1, extractor.m_opens);
+}
+
+// Chapter thumbnails per second with a simulated cost of opening the file and of decoding a
+// chapter, strips vs. one open per chapter, run with
+// --gtest_also_run_disabled_tests --gtest_filter=TestVideoChapterThumbs.DISABLED_Benchmark
+TEST(TestVideoChapterThumbs, DISABLED_Benchmark)
+{
+  constexpr auto OPEN_TIME = 50ms;
+  constexpr auto CHAPTER_TIME = 10ms;
+  const CFileItem item("/path/to/video.mkv", false);
+
+  auto measure = [&item](const auto& get)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int chapter = 1; chapter <= CHAPTERS; ++chapter)
+      EXPECT_EQ(chapter, ChapterOf(get(chapter)));
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return CHAPTERS / elapsed.count();
+  };
+
+  CTestExtractor single(OPEN_TIME, CHAPTER_TIME);
+  const double singleRate = measure([&](int chapter)
+                                    { return std::move(single(item, {chapter}).front()); });
+
+  CTestExtractor strips(OPEN_TIME, CHAPTER_TIME);
+  CVideoChapterThumbs thumbs(std::ref(strips));
+  const double stripRate = measure([&](int chapter) { return thumbs.Get(item, chapter); });
+
+  std::cout << "Chapter thumbnails, " << CHAPTERS << " chapters: one per open " << singleRate
+            << " thumbs/s, strips of " << CVideoChapterThumbs::STRIP_SIZE << " " << stripRate
+            << " thumbs/s" << std::endl;
+}
@@ -0,0 +1,232 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "XBDateTime.h"
+#include "cores/VideoPlayer/DVDDemuxers/KeyframeIndex.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "interfaces/AnnouncementManager.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/StringUtils.h"
+#include "video/Bookmark.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr const char* DATABASE_NAME = "TestVideos.db";
+
+class CTestVideoDatabase : public CVideoDatabase
+{
+public:
+  using CVideoDatabase::CheckTVShowCounts;
+
+  void Exec(const std::string& sql) { m_pDS->exec(sql); }
+
+  // the counters of tvshow_view and season_view differing from the aggregates the views used to
+  // compute when they were read
+  int CountsMismatches()
+  {
+    const std::string tvshows = StringUtils::Format(
+        "SELECT tvshow.idShow AS idShow, MAX(files.lastPlayed) AS lastPlayed, "
+        "NULLIF(COUNT(episode.c{0:02}), 0) AS totalCount, COUNT(files.playCount) AS watchedcount, "
+        "NULLIF(COUNT(DISTINCT(episode.c{0:02})), 0) AS totalSeasons, "
+        "MAX(files.dateAdded) AS dateAdded, COUNT(bookmark.type) AS inProgressCount "
+        "FROM tvshow "
+        "LEFT JOIN episode ON episode.idShow=tvshow.idShow "
+        "LEFT JOIN files ON files.idFile=episode.idFile "
+        "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+        "GROUP BY tvshow.idShow",
+        VIDEODB_ID_EPISODE_SEASON);
+    const std::string seasons = StringUtils::Format(
+        "SELECT seasons.idSeason AS idSeason, COUNT(DISTINCT episode.idEpisode) AS episodes, "
+        "COUNT(files.playCount) AS playCount, MIN(episode.c{1:02}) AS aired, "
+        "COUNT(bookmark.type) AS inProgressCount "
+        "FROM seasons "
+        "JOIN tvshow ON tvshow.idShow=seasons.idShow "
+        "JOIN episode ON episode.idShow=seasons.idShow AND episode.c{0:02}=seasons.season "
+        "JOIN files ON files.idFile=episode.idFile "
+        "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+        "GROUP BY seasons.idSeason",
+        VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_EPISODE_AIRED);
+
+    return GetSingleValueInt(
+               "SELECT COUNT(*) FROM (" + tvshows +
+               ") AS expected "
+               "LEFT JOIN tvshow_view ON tvshow_view.idShow=expected.idShow "
+               "WHERE NOT (tvshow_view.totalCount IS expected.totalCount AND "
+               "tvshow_view.watchedcount IS expected.watchedcount AND "
+               "tvshow_view.totalSeasons IS expected.totalSeasons AND "
+               "tvshow_view.inProgressCount IS expected.inProgressCount AND "
+               "tvshow_view.lastPlayed IS expected.lastPlayed AND "
+               "tvshow_view.dateAdded IS expected.dateAdded)") +
+           GetSingleValueInt("SELECT COUNT(*) FROM (" + seasons +
+                             ") AS expected "
+                             "LEFT JOIN season_view ON season_view.idSeason=expected.idSeason "
+                             "WHERE NOT (season_view.episodes IS expected.episodes AND "
+                             "season_view.playCount IS expected.playCount AND "
+                             "season_view.aired IS expected.aired AND "
+                             "season_view.inProgressCount IS expected.inProgressCount)") +
+           std::abs(GetSingleValueInt("SELECT COUNT(*) FROM tvshow_view") -
+                    GetSingleValueInt("SELECT COUNT(*) FROM tvshow")) +
+           std::abs(GetSingleValueInt("SELECT COUNT(*) FROM season_view") -
+                    GetSingleValueInt("SELECT COUNT(*) FROM (" + seasons + ") AS expected"));
+  }
+};
+
+std::string EpisodePath(int season, int episode)
+{
+  return StringUtils::Format("/tv/Show/S{:02}E{:02}.mkv", season, episode);
+}
+} // unnamed namespace
+
+class TestVideoDatabase : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // removing items announces them
+    CServiceBroker::RegisterAnnouncementManager(
+        std::make_shared<ANNOUNCEMENT::CAnnouncementManager>());
+
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    ASSERT_TRUE(m_db.Connect(DATABASE_NAME, settings, true));
+  }
+
+  void TearDown() override
+  {
+    m_db.Close();
+    XFILE::CFile::Delete(std::string("special://temp/") + DATABASE_NAME);
+    CServiceBroker::UnregisterAnnouncementManager();
+  }
+
+  CTestVideoDatabase m_db;
+};
+
+TEST_F(TestVideoDatabase, KeyframeIndex)
+{
+  const std::string path = "/movies/movie.ts";
+  CKeyframeIndex index;
+  // the first delta is zero, which ended the text stored once
+  index.Add(0, 0);
+  for (int64_t i = 1; i < 1000; ++i)
+    index.Add(i * 2000, i * 1880000 + (i % 7) * 188);
+  ASSERT_EQ(1000u, index.Size());
+
+  // only files of the library have an index
+  EXPECT_FALSE(m_db.SetKeyframeIndex(path, 1000000, 100, index.Serialize()));
+  std::string data;
+  EXPECT_FALSE(m_db.GetKeyframeIndex(path, 1000000, 100, data));
+
+  ASSERT_GT(m_db.AddFile(path), 0);
+  ASSERT_TRUE(m_db.SetKeyframeIndex(path, 1000000, 100, index.Serialize()));
+  ASSERT_TRUE(m_db.GetKeyframeIndex(path, 1000000, 100, data));
+
+  CKeyframeIndex restored;
+  ASSERT_TRUE(restored.Deserialize(data));
+  EXPECT_EQ(index.GetEntries(), restored.GetEntries());
+
+  // the file changed since the index was built
+  EXPECT_FALSE(m_db.GetKeyframeIndex(path, 1000001, 100, data));
+  EXPECT_FALSE(m_db.GetKeyframeIndex(path, 1000000, 101, data));
+}
+
+TEST_F(TestVideoDatabase, TVShowCounts)
+{
+  CVideoInfoTag show;
+  show.m_strTitle = "Show";
+  const int idShow = m_db.SetDetailsForTvShow({{"/tv/Show/", "/tv/"}}, show, {}, {});
+  ASSERT_GT(idShow, 0);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+
+  std::vector<int> episodes;
+  for (int season = 1; season <= 2; ++season)
+  {
+    for (int episode = 1; episode <= 3; ++episode)
+    {
+      CVideoInfoTag details;
+      details.SetFileNameAndPath(EpisodePath(season, episode));
+      details.m_strTitle = StringUtils::Format("Episode {}", episode);
+      details.m_iSeason = season;
+      details.m_iEpisode = episode;
+      details.m_firstAired.SetDate(2020, season, episode);
+      details.m_dateAdded.SetDateTime(2024, season, episode, 12, 0, 0);
+      episodes.push_back(m_db.SetDetailsForEpisode(details, {}, idShow));
+      ASSERT_GT(episodes.back(), 0);
+      EXPECT_EQ(0, m_db.CountsMismatches());
+    }
+  }
+
+  CFileItem watched(EpisodePath(1, 2), false);
+  m_db.SetPlayCount(watched, 1, CDateTime(2024, 6, 1, 20, 0, 0));
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  m_db.SetPlayCount(CFileItem(EpisodePath(2, 1), false), 2, CDateTime(2024, 6, 2, 20, 0, 0));
+  EXPECT_EQ(0, m_db.CountsMismatches());
+
+  CBookmark resume;
+  resume.timeInSeconds = 600;
+  resume.totalTimeInSeconds = 1800;
+  m_db.AddBookMarkToFile(EpisodePath(1, 3), resume, CBookmark::RESUME);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  m_db.ClearBookMarksOfFile(EpisodePath(1, 3), CBookmark::RESUME);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  m_db.AddBookMarkToFile(EpisodePath(2, 3), resume, CBookmark::RESUME);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+
+  m_db.SetPlayCount(watched, 0);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+
+  m_db.DeleteEpisode(episodes[0]);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  // the last episode of a season
+  m_db.DeleteEpisode(episodes[3]);
+  m_db.DeleteEpisode(episodes[4]);
+  m_db.DeleteEpisode(episodes[5]);
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  EXPECT_TRUE(m_db.CheckTVShowCounts());
+
+  m_db.DeleteTvShow(idShow);
+  EXPECT_EQ(0, m_db.GetSingleValueInt("SELECT COUNT(*) FROM tvshowcounts"));
+  EXPECT_EQ(0, m_db.GetSingleValueInt("SELECT COUNT(*) FROM seasoncounts"));
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  EXPECT_TRUE(m_db.CheckTVShowCounts());
+}
+
+TEST_F(TestVideoDatabase, RebuildTVShowCounts)
+{
+  CVideoInfoTag show;
+  show.m_strTitle = "Show";
+  const int idShow = m_db.SetDetailsForTvShow({{"/tv/Show/", "/tv/"}}, show, {}, {});
+  ASSERT_GT(idShow, 0);
+  CVideoInfoTag details;
+  details.SetFileNameAndPath(EpisodePath(1, 1));
+  details.m_iSeason = 1;
+  details.m_iEpisode = 1;
+  ASSERT_GT(m_db.SetDetailsForEpisode(details, {}, idShow), 0);
+  EXPECT_TRUE(m_db.CheckTVShowCounts());
+
+  // counters which drifted, e.g. changed by another client without the triggers
+  m_db.Exec("UPDATE tvshowcounts SET totalCount=5");
+  m_db.Exec("DELETE FROM seasoncounts");
+  EXPECT_NE(0, m_db.CountsMismatches());
+  EXPECT_FALSE(m_db.CheckTVShowCounts());
+  EXPECT_EQ(0, m_db.CountsMismatches());
+  EXPECT_TRUE(m_db.CheckTVShowCounts());
+}
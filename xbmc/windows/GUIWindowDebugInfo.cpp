@@ -17,9 +17,11 @@
 #include "guilib/GUIControlFactory.h"
 #include "guilib/GUIControlProfiler.h"
 #include "guilib/GUIFontManager.h"
+#include "guilib/GUIRenderQueue.h"
 #include "guilib/GUITextLayout.h"
 #include "guilib/GUIWindowManager.h"
 #include "input/WindowTranslator.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/CPUInfo.h"
@@ -129,6 +131,14 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                    .GetFPS(),
                                strCores, ucAppName, dCPU, profiling);
 #endif
+
+    const CGUIRenderQueue* renderQueue = CServiceBroker::GetRenderSystem()->GetGUIRenderQueue();
+    if (renderQueue)
+    {
+      const CGUIRenderQueue::Stats& stats = renderQueue->GetFrameStats();
+      info += StringUtils::Format("\nDRAW: {} calls, {} state changes, {} quads from {} items",
+                                  stats.drawCalls, stats.stateChanges, stats.quads, stats.items);
+    }
   }
 
   // render the skin debug info